@@ -14,10 +14,12 @@
 #include <tftp/clients/Client.hpp>
 #include <tftp/clients/WriteOperation.hpp>
 
+#include <tftp/files/DigestFile.hpp>
 #include <tftp/files/StreamFile.hpp>
 
 #include <tftp/packets/PacketStatistic.hpp>
 
+#include <tftp/PacketCapture.hpp>
 #include <tftp/TftpConfiguration.hpp>
 #include <tftp/TftpException.hpp>
 #include <tftp/TftpOptionsConfiguration.hpp>
@@ -33,6 +35,7 @@
 #include <boost/program_options.hpp>
 
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -81,8 +84,8 @@ static void operationCompleted( boost::asio::io_context &ioContext, Tftp::Transf
  *   TFTP Configuration
  * @param[in] tftpOptionsConfiguration
  *   TFTP Options Configuration
- * @param[in] localFile
- *   Local Filename
+ * @param[in] file
+ *   Local File
  * @param[in] remoteFile
  *   Remote Filename
  * @param[in] address
@@ -94,7 +97,7 @@ static Tftp::Clients::OperationPtr readOperation(
   const Tftp::Clients::ClientPtr &tftpClient,
   const Tftp::TftpConfiguration &tftpConfiguration,
   const Tftp::TftpOptionsConfiguration &tftpOptionsConfiguration,
-  const std::filesystem::path &localFile,
+  Tftp::Files::FilePtr file,
   const std::string &remoteFile,
   const boost::asio::ip::address &address,
   boost::asio::io_context &ioContext );
@@ -108,8 +111,8 @@ static Tftp::Clients::OperationPtr readOperation(
  *   TFTP Configuration
  * @param[in] tftpOptionsConfiguration
  *   TFTP Options Configuration
- * @param[in] localFile
- *   Local Filename
+ * @param[in] file
+ *   Local File
  * @param[in] remoteFile
  *   Remote Filename
  * @param[in] address
@@ -121,7 +124,7 @@ static Tftp::Clients::OperationPtr writeOperation(
   const Tftp::Clients::ClientPtr &tftpClient,
   const Tftp::TftpConfiguration &tftpConfiguration,
   const Tftp::TftpOptionsConfiguration &tftpOptionsConfiguration,
-  const std::filesystem::path &localFile,
+  Tftp::Files::FilePtr file,
   const std::string &remoteFile,
   const boost::asio::ip::address &address,
   boost::asio::io_context &ioContext );
@@ -136,6 +139,8 @@ int main( const int argc, char * argv[] )
     std::filesystem::path localFile;
     std::string remoteFile;
     boost::asio::ip::address address;
+    bool digest{ false };
+    std::filesystem::path captureFile;
     Tftp::TftpConfiguration tftpConfiguration;
     Tftp::TftpOptionsConfiguration tftpOptionsConfiguration;
 
@@ -171,6 +176,17 @@ int main( const int argc, char * argv[] )
       boost::program_options::value( &address )
         ->required(),
       "Remote address of the TFTP server."
+    )
+    (
+      "digest",
+      boost::program_options::bool_switch( &digest ),
+      "Print CRC32C and SHA-256 of the transferred file."
+    )
+    (
+      "capture-file",
+      boost::program_options::value( &captureFile )
+        ->value_name( "filename" ),
+      "File, where the transmitted and received packets are captured. Replay them with tftp_replay."
     );
 
     // Add TFTP options
@@ -193,7 +209,8 @@ int main( const int argc, char * argv[] )
     boost::program_options::notify( variablesMap );
 
     // Assemble TFTP configuration
-    boost::asio::io_context ioContext;
+    // the TFTP library requires an I/O context run by a single thread
+    boost::asio::io_context ioContext{ 1 };
 
     auto tftpClient{ Tftp::Clients::Client::instance( ioContext ) };
 
@@ -211,6 +228,34 @@ int main( const int argc, char * argv[] )
       remoteFile,
       localFile.string() );
 
+    Tftp::Files::FilePtr file{};
+
+    switch ( requestType )
+    {
+      case Tftp::RequestType::Read:
+        file = std::make_shared< Tftp::Files::StreamFile >( Tftp::Files::File::Operation::Receive, localFile );
+        break;
+
+      case Tftp::RequestType::Write:
+        file = std::make_shared< Tftp::Files::StreamFile >(
+          Tftp::Files::File::Operation::Transmit,
+          localFile,
+          std::filesystem::file_size( localFile ) );
+        break;
+
+      default:
+        std::cerr << "Internal invalid operation\n";
+        return EXIT_FAILURE;
+    }
+
+    std::shared_ptr< Tftp::Files::DigestFile > digestFile{};
+
+    if ( digest )
+    {
+      digestFile = std::make_shared< Tftp::Files::DigestFile >( std::move( file ) );
+      file = digestFile;
+    }
+
     switch ( requestType )
     {
       case Tftp::RequestType::Read:
@@ -218,7 +263,7 @@ int main( const int argc, char * argv[] )
           tftpClient,
           tftpConfiguration,
           tftpOptionsConfiguration,
-          localFile,
+          std::move( file ),
           remoteFile,
           address,
           ioContext );
@@ -229,7 +274,7 @@ int main( const int argc, char * argv[] )
           tftpClient,
           tftpConfiguration,
           tftpOptionsConfiguration,
-          localFile,
+          std::move( file ),
           remoteFile,
           address,
           ioContext );
@@ -242,11 +287,24 @@ int main( const int argc, char * argv[] )
 
     assert( tftpOperation );
 
+    if ( !captureFile.empty() )
+    {
+      Tftp::PacketCapture::instance().start(
+        std::make_shared< std::ofstream >( captureFile, std::ios::binary | std::ios::trunc ) );
+    }
+
     // start request
     tftpOperation->request();
 
     ioContext.run();
 
+    Tftp::PacketCapture::instance().stop();
+
+    if ( digestFile )
+    {
+      std::cout << "Digest:\n" << digestFile->digest() << "\n";
+    }
+
     // Print Packet Statistic
     std::cout
       << "RX:\n" << Tftp::Packets::PacketStatistic::globalReceive() << "\n"
@@ -296,7 +354,7 @@ static Tftp::Clients::OperationPtr readOperation(
   const Tftp::Clients::ClientPtr &tftpClient,
   const Tftp::TftpConfiguration &tftpConfiguration,
   const Tftp::TftpOptionsConfiguration &tftpOptionsConfiguration,
-  const std::filesystem::path &localFile,
+  Tftp::Files::FilePtr file,
   const std::string &remoteFile,
   const boost::asio::ip::address &address,
   boost::asio::io_context &ioContext )
@@ -308,9 +366,10 @@ static Tftp::Clients::OperationPtr readOperation(
     .tftpRetries( tftpConfiguration.tftpRetries )
     .dally( tftpConfiguration.dally )
     .optionsConfiguration( tftpOptionsConfiguration )
+    .socketBufferSizes( tftpConfiguration.socketBufferSizes )
     .optionNegotiationHandler( std::bind_front( &optionNegotiation ) )
     .completionHandler( std::bind_front( &operationCompleted, std::ref( ioContext ) ) )
-    .dataHandler( std::make_shared< Tftp::Files::StreamFile >( Tftp::Files::File::Operation::Receive, localFile ) )
+    .dataHandler( std::move( file ) )
     .filename( remoteFile )
     .mode( Tftp::Packets::TransferMode::OCTET )
     .remote( boost::asio::ip::udp::endpoint{ address,tftpConfiguration.tftpServerPort } );
@@ -322,7 +381,7 @@ static  Tftp::Clients::OperationPtr writeOperation(
   const Tftp::Clients::ClientPtr &tftpClient,
   const Tftp::TftpConfiguration &tftpConfiguration,
   const Tftp::TftpOptionsConfiguration &tftpOptionsConfiguration,
-  const std::filesystem::path &localFile,
+  Tftp::Files::FilePtr file,
   const std::string &remoteFile,
   const boost::asio::ip::address &address,
   boost::asio::io_context &ioContext )
@@ -333,13 +392,10 @@ static  Tftp::Clients::OperationPtr writeOperation(
     ->tftpTimeout( tftpConfiguration.tftpTimeout )
     .tftpRetries( tftpConfiguration.tftpRetries )
     .optionsConfiguration( tftpOptionsConfiguration )
+    .socketBufferSizes( tftpConfiguration.socketBufferSizes )
     .optionNegotiationHandler( std::bind_front( &optionNegotiation ) )
     .completionHandler( std::bind_front( &operationCompleted, std::ref( ioContext ) ) )
-    .dataHandler(
-      std::make_shared< Tftp::Files::StreamFile >(
-        Tftp::Files::File::Operation::Transmit,
-        localFile,
-        std::filesystem::file_size( localFile ) ) )
+    .dataHandler( std::move( file ) )
     .filename( remoteFile )
     .mode( Tftp::Packets::TransferMode::OCTET )
     .remote( boost::asio::ip::udp::endpoint{ address,tftpConfiguration.tftpServerPort } );
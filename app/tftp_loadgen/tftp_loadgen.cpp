@@ -0,0 +1,590 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief TFTP Load Generator CLI Application.
+ **/
+
+#include <tftp/clients/AsyncOperations.hpp>
+#include <tftp/clients/Client.hpp>
+#include <tftp/clients/OperationResult.hpp>
+#include <tftp/clients/ReadOperation.hpp>
+#include <tftp/clients/WriteOperation.hpp>
+
+#include <tftp/files/NullSinkFile.hpp>
+#include <tftp/files/NullSourceFile.hpp>
+
+#include <tftp/packets/PacketStatistic.hpp>
+
+#include <tftp/TftpConfiguration.hpp>
+#include <tftp/TftpException.hpp>
+#include <tftp/TftpOptionsConfiguration.hpp>
+#include <tftp/TransferStatusDescription.hpp>
+#include <tftp/Version.hpp>
+
+#include <helper/BoostAsioProgramOptions.hpp>
+
+#include <boost/asio.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <format>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Application Entry Point.
+ *
+ * @param[in] argc
+ *   Number of arguments.
+ * @param[in] argv
+ *   Arguments
+ *
+ * @return Application exit status.
+ **/
+int main( int argc, char * argv[] );
+
+/**
+ * @brief Schedules the next Session Arrival.
+ **/
+static void scheduleArrival();
+
+/**
+ * @brief Starts a Session or queues it, when the concurrency limit is reached.
+ **/
+static void arrival();
+
+/**
+ * @brief Starts a Session.
+ *
+ * The request type and filename are chosen randomly from the file mix.
+ *
+ * @param[in] arrivalTime
+ *   Arrival time of the session.
+ **/
+static void startSession( std::chrono::steady_clock::time_point arrivalTime );
+
+/**
+ * @brief Session Completed Callback.
+ *
+ * Called by Tftp::Clients::asyncExecute() outside of the finished operation.
+ *
+ * @param[in] arrivalTime
+ *   Arrival time of the session.
+ * @param[in] result
+ *   Operation Result.
+ **/
+static void sessionCompleted(
+  std::chrono::steady_clock::time_point arrivalTime,
+  const Tftp::Clients::OperationResult &result );
+
+/**
+ * @brief Accepts all Options acknowledged by the Server.
+ *
+ * @param[in] serverOptions
+ *   Additional options acknowledged by the server.
+ *
+ * @return if @p serverOptions are empty.
+ **/
+static bool optionNegotiation( const Tftp::Packets::Options &serverOptions );
+
+/**
+ * @brief Prints the Load Generator Report.
+ *
+ * @param[in] duration
+ *   Duration of the load run.
+ **/
+static void printReport( std::chrono::steady_clock::duration duration );
+
+//! Address of the Server
+static boost::asio::ip::address address{ boost::asio::ip::address_v4::loopback() };
+
+//! Total Number of Sessions
+static std::size_t sessions{ 1000U };
+
+//! Arrival Rate [sessions/s] (0: all sessions at once)
+static double arrivalRate{ 100.0 };
+
+//! Poisson Arrivals instead of constant Inter-arrival Times
+static bool poisson{ false };
+
+//! Maximum Number of concurrent Sessions (0: unlimited)
+static std::size_t concurrency{ 0U };
+
+//! Files read by RRQ
+static std::vector< std::string > readFiles{};
+
+//! Files written by WRQ
+static std::vector< std::string > writeFiles{};
+
+//! Size of written Files [bytes]
+static uint64_t writeSize{ 1024U * 1024U };
+
+//! Local Address
+static boost::asio::ip::address localAddress{};
+
+//! First Local Port (0: ephemeral ports)
+static uint16_t localPortFirst{ 0U };
+
+//! Number of Local Ports
+static uint16_t localPortCount{ 0U };
+
+//! Random Seed
+static unsigned int seed{ 0U };
+
+//! TFTP Configuration
+static Tftp::TftpConfiguration tftpConfiguration{};
+
+//! TFTP Options Configuration
+static Tftp::TftpOptionsConfiguration tftpOptionsConfiguration{};
+
+//! I/O Context (the TFTP library requires an I/O context run by a single thread)
+static boost::asio::io_context ioContext{ 1 };
+
+//! Arrival Timer
+static boost::asio::steady_timer arrivalTimer{ ioContext };
+
+//! TFTP Client
+static Tftp::Clients::ClientPtr tftpClient;
+
+//! Random Generator (file mix, arrivals)
+static std::mt19937 generator{};
+
+//! Number of active Sessions (the operations are kept by Tftp::Clients::asyncExecute())
+static std::size_t activeSessions{ 0U };
+
+//! Number of arrived Sessions
+static std::size_t arrivedSessions{ 0U };
+
+//! Number of started Sessions
+static std::size_t startedSessions{ 0U };
+
+//! Arrival Times of the Sessions waiting for the concurrency limit
+static std::deque< std::chrono::steady_clock::time_point > queuedSessions;
+
+//! Maximum Number of concurrent Sessions reached
+static std::size_t peakConcurrency{ 0U };
+
+//! Session Latencies (from the arrival) of successful Sessions
+static std::vector< std::chrono::steady_clock::duration > latencies;
+
+//! Queueing Delays (from the arrival to the start) of started Sessions
+static std::vector< std::chrono::steady_clock::duration > queueingDelays;
+
+//! Number of Sessions by Transfer Status
+static std::map< Tftp::TransferStatus, std::size_t > results;
+
+//! Number of Retransmissions of all Sessions
+static uint64_t retransmissions{ 0U };
+
+int main( const int argc, char * argv[] )
+{
+  try
+  {
+    std::cout << std::format( "TFTP Load Generator - {}\n", Tftp::Version::VersionInformation );
+
+    boost::program_options::options_description optionsDescription{ "TFTP Load Generator Options" };
+
+    optionsDescription.add_options()
+    (
+      "help,h",
+      "Print this help screen."
+    )
+    (
+      "address,a",
+      boost::program_options::value( &address )->default_value( address ),
+      "Address of the TFTP server."
+    )
+    (
+      "sessions,n",
+      boost::program_options::value( &sessions )->default_value( sessions ),
+      "Total number of sessions."
+    )
+    (
+      "rate",
+      boost::program_options::value( &arrivalRate )->default_value( arrivalRate ),
+      "Arrival rate of sessions per second (0: all sessions at once)."
+    )
+    (
+      "poisson",
+      boost::program_options::bool_switch( &poisson ),
+      "Poisson arrivals (exponential inter-arrival times) instead of constant ones."
+    )
+    (
+      "concurrency",
+      boost::program_options::value( &concurrency )->default_value( concurrency ),
+      "Maximum number of concurrent sessions. Further arrivals wait (0: unlimited)."
+    )
+    (
+      "read-file",
+      boost::program_options::value( &readFiles )->composing()->value_name( "filename" ),
+      "File requested by RRQ. Can be given multiple times for a file mix."
+    )
+    (
+      "write-file",
+      boost::program_options::value( &writeFiles )->composing()->value_name( "filename" ),
+      "File written by WRQ. Can be given multiple times for a file mix."
+    )
+    (
+      "write-size",
+      boost::program_options::value( &writeSize )->default_value( writeSize ),
+      "Size of the written files in bytes."
+    )
+    (
+      "local-address",
+      boost::program_options::value( &localAddress ),
+      "Local address of the sessions."
+    )
+    (
+      "local-port-first",
+      boost::program_options::value( &localPortFirst )->default_value( localPortFirst ),
+      "First local port of the sessions (0: ephemeral ports)."
+    )
+    (
+      "local-port-count",
+      boost::program_options::value( &localPortCount )->default_value( localPortCount ),
+      "Number of local ports used round robin."
+    )
+    (
+      "seed",
+      boost::program_options::value( &seed )->default_value( seed ),
+      "Seed of the file mix and Poisson arrivals."
+    );
+
+    // Add TFTP options
+    optionsDescription.add( tftpConfiguration.options() );
+    optionsDescription.add( tftpOptionsConfiguration.options() );
+
+    boost::program_options::variables_map variablesMap;
+    boost::program_options::store(
+      boost::program_options::parse_command_line( argc, argv, optionsDescription ),
+      variablesMap );
+
+    if ( 0U != variablesMap.count( "help" ) )
+    {
+      std::cout
+        << "Generates TFTP client load.\n\n"
+        << optionsDescription << "\n";
+      return EXIT_FAILURE;
+    }
+
+    boost::program_options::notify( variablesMap );
+
+    if ( readFiles.empty() && writeFiles.empty() )
+    {
+      std::cerr << "No --read-file or --write-file given\n";
+      return EXIT_FAILURE;
+    }
+
+    if ( ( 0U != localPortFirst ) && ( 0U == localPortCount ) )
+    {
+      localPortCount = 1U;
+    }
+
+    if ( ( 0U != concurrency ) && ( 0U != localPortCount ) && ( concurrency > localPortCount ) )
+    {
+      std::cout << "Concurrency exceeds the local port range - sessions may fail to bind\n";
+    }
+
+    generator.seed( seed );
+    latencies.reserve( sessions );
+    queueingDelays.reserve( sessions );
+
+    tftpClient = Tftp::Clients::Client::instance( ioContext );
+
+    std::cout << std::format(
+      "{} sessions to {} at {} sessions/s\n",
+      sessions,
+      address.to_string(),
+      arrivalRate );
+
+    const auto start{ std::chrono::steady_clock::now() };
+
+    scheduleArrival();
+
+    ioContext.run();
+
+    printReport( std::chrono::steady_clock::now() - start );
+
+    return EXIT_SUCCESS;
+  }
+  catch ( const boost::program_options::error &e )
+  {
+    std::cerr << std::format(
+      "Error parsing command line: {}\n"
+      "Enter '{} --help' for command line description.\n",
+      e.what(),
+      argv[ 0 ] );
+    return EXIT_FAILURE;
+  }
+  catch ( const boost::exception &e )
+  {
+    std::cerr << std::format( "Error: {}\n", boost::diagnostic_information( e ) );
+    return EXIT_FAILURE;
+  }
+  catch ( const std::exception &e )
+  {
+    std::cerr << std::format( "Error: {}\n", boost::diagnostic_information( e ) );
+    return EXIT_FAILURE;
+  }
+  catch ( ... )
+  {
+    std::cerr << "Unknown exception occurred\n";
+    return EXIT_FAILURE;
+  }
+}
+
+static void scheduleArrival()
+{
+  if ( arrivedSessions == sessions )
+  {
+    return;
+  }
+
+  if ( arrivalRate <= 0.0 )
+  {
+    while ( arrivedSessions < sessions )
+    {
+      arrival();
+    }
+    return;
+  }
+
+  const std::chrono::duration< double > interArrival{
+    poisson ? std::exponential_distribution< double >{ arrivalRate }( generator ) : 1.0 / arrivalRate };
+
+  arrivalTimer.expires_after( std::chrono::duration_cast< std::chrono::steady_clock::duration >( interArrival ) );
+  arrivalTimer.async_wait( []( const boost::system::error_code &errorCode )
+  {
+    if ( errorCode )
+    {
+      return;
+    }
+
+    arrival();
+    scheduleArrival();
+  } );
+}
+
+static void arrival()
+{
+  ++arrivedSessions;
+
+  const auto arrivalTime{ std::chrono::steady_clock::now() };
+
+  if ( ( 0U != concurrency ) && ( activeSessions >= concurrency ) )
+  {
+    queuedSessions.push_back( arrivalTime );
+    return;
+  }
+
+  startSession( arrivalTime );
+}
+
+static void startSession( const std::chrono::steady_clock::time_point arrivalTime )
+{
+  const auto session{ startedSessions++ };
+  queueingDelays.push_back( std::chrono::steady_clock::now() - arrivalTime );
+
+  // choose from the file mix
+  const auto fileIndex{ std::uniform_int_distribution< std::size_t >{
+    0U, readFiles.size() + writeFiles.size() - 1U }( generator ) };
+
+  std::optional< boost::asio::ip::udp::endpoint > local{};
+
+  if ( 0U != localPortCount )
+  {
+    local = boost::asio::ip::udp::endpoint{
+      localAddress,
+      static_cast< uint16_t >( localPortFirst + ( session % localPortCount ) ) };
+  }
+  else if ( !localAddress.is_unspecified() )
+  {
+    local = boost::asio::ip::udp::endpoint{ localAddress, 0U };
+  }
+
+  Tftp::Clients::OperationPtr operation{};
+
+  if ( fileIndex < readFiles.size() )
+  {
+    auto readOperation{ tftpClient->readOperation() };
+
+    readOperation
+      ->tftpTimeout( tftpConfiguration.tftpTimeout )
+      .tftpRetries( tftpConfiguration.tftpRetries )
+      .dally( tftpConfiguration.dally )
+      .optionsConfiguration( tftpOptionsConfiguration )
+      .socketBufferSizes( tftpConfiguration.socketBufferSizes )
+      .optionNegotiationHandler( std::bind_front( &optionNegotiation ) )
+      .dataHandler( std::make_shared< Tftp::Files::NullSinkFile >() )
+      .filename( readFiles[ fileIndex ] )
+      .mode( Tftp::Packets::TransferMode::OCTET )
+      .remote( boost::asio::ip::udp::endpoint{ address, tftpConfiguration.tftpServerPort } );
+
+    if ( local )
+    {
+      readOperation->local( *local );
+    }
+
+    operation = std::move( readOperation );
+  }
+  else
+  {
+    auto writeOperation{ tftpClient->writeOperation() };
+
+    writeOperation
+      ->tftpTimeout( tftpConfiguration.tftpTimeout )
+      .tftpRetries( tftpConfiguration.tftpRetries )
+      .optionsConfiguration( tftpOptionsConfiguration )
+      .socketBufferSizes( tftpConfiguration.socketBufferSizes )
+      .optionNegotiationHandler( std::bind_front( &optionNegotiation ) )
+      .dataHandler( std::make_shared< Tftp::Files::NullSourceFile >( writeSize ) )
+      .filename( writeFiles[ fileIndex - readFiles.size() ] )
+      .mode( Tftp::Packets::TransferMode::OCTET )
+      .remote( boost::asio::ip::udp::endpoint{ address, tftpConfiguration.tftpServerPort } );
+
+    if ( local )
+    {
+      writeOperation->local( *local );
+    }
+
+    operation = std::move( writeOperation );
+  }
+
+  ++activeSessions;
+  peakConcurrency = std::max( peakConcurrency, activeSessions );
+
+  Tftp::Clients::asyncExecute( std::move( operation ), std::bind_front( &sessionCompleted, arrivalTime ) );
+}
+
+static void sessionCompleted(
+  const std::chrono::steady_clock::time_point arrivalTime,
+  const Tftp::Clients::OperationResult &result )
+{
+  --activeSessions;
+  ++results[ result.status ];
+  retransmissions += result.retransmissions;
+
+  // the latency includes the queueing delay, so a saturated server is not hidden by the concurrency limit
+  if ( result )
+  {
+    latencies.push_back( std::chrono::steady_clock::now() - arrivalTime );
+  }
+
+  if ( !queuedSessions.empty() )
+  {
+    const auto nextArrivalTime{ queuedSessions.front() };
+    queuedSessions.pop_front();
+    startSession( nextArrivalTime );
+  }
+
+  if ( ( arrivedSessions == sessions ) && ( 0U == activeSessions ) )
+  {
+    ioContext.stop();
+  }
+}
+
+static bool optionNegotiation( const Tftp::Packets::Options &serverOptions )
+{
+  return serverOptions.empty();
+}
+
+static void printReport( const std::chrono::steady_clock::duration duration )
+{
+  const auto seconds{ std::chrono::duration< double >{ duration }.count() };
+  const auto [ dataPackets, dataBytes ]{ [] -> Tftp::Packets::PacketStatistic::Value
+  {
+    std::size_t packets{ 0U };
+    std::size_t bytes{ 0U };
+
+    // DATA packets in both directions, without the 4 byte header
+    for ( const auto *statistic : {
+      &Tftp::Packets::PacketStatistic::globalReceive(),
+      &Tftp::Packets::PacketStatistic::globalTransmit() } )
+    {
+      const auto data{ statistic->statistic() };
+
+      if ( const auto it{ data.find( Tftp::Packets::PacketType::Data ) }; it != data.end() )
+      {
+        packets += std::get< 0 >( it->second );
+        bytes += std::get< 1 >( it->second ) - ( 4U * std::get< 0 >( it->second ) );
+      }
+    }
+
+    return { packets, bytes };
+  }() };
+
+  std::cout << std::format(
+    "Sessions               : {}\n"
+    "Duration               : {:.3f} s\n"
+    "Achieved Rate          : {:.1f} sessions/s\n"
+    "Peak Concurrency       : {}\n"
+    "DATA Packets           : {} ({:.1f} packets/s)\n"
+    "Throughput             : {:.3f} MiB/s\n"
+    "Retransmissions        : {}\n",
+    startedSessions,
+    seconds,
+    static_cast< double >( startedSessions ) / seconds,
+    peakConcurrency,
+    dataPackets,
+    static_cast< double >( dataPackets ) / seconds,
+    static_cast< double >( dataBytes ) / seconds / ( 1024.0 * 1024.0 ),
+    retransmissions );
+
+  for ( const auto &[ transferStatus, count ] : results )
+  {
+    std::cout << std::format(
+      "{:23}: {}\n",
+      Tftp::TransferStatusDescription::instance().name( transferStatus ),
+      count );
+  }
+
+  // nearest rank percentiles
+  const auto printPercentiles{ [](
+    const std::string_view name,
+    std::vector< std::chrono::steady_clock::duration > &values )
+  {
+    if ( values.empty() )
+    {
+      return;
+    }
+
+    std::ranges::sort( values );
+
+    const auto percentile{ [ &values ]( const double rank )
+    {
+      const auto index{ static_cast< std::size_t >( rank * static_cast< double >( values.size() - 1U ) + 0.5 ) };
+      return std::chrono::duration< double, std::milli >{ values[ index ] }.count();
+    } };
+
+    std::cout << std::format(
+      "{:23}: min {:.2f}, p50 {:.2f}, p90 {:.2f}, p99 {:.2f}, max {:.2f}\n",
+      name,
+      percentile( 0.0 ),
+      percentile( 0.5 ),
+      percentile( 0.9 ),
+      percentile( 0.99 ),
+      percentile( 1.0 ) );
+  } };
+
+  printPercentiles( "Queueing [ms]", queueingDelays );
+  printPercentiles( "Latency [ms]", latencies );
+}
@@ -0,0 +1,575 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief TFTP Replay CLI Application.
+ **/
+
+#include <tftp/PacketCapture.hpp>
+#include <tftp/Tftp.hpp>
+#include <tftp/Version.hpp>
+
+#include <helper/BoostAsioProgramOptions.hpp>
+
+#include <boost/asio.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+//! Replayed Datagram
+struct Datagram
+{
+  //! Offset to the Start of the Replay
+  std::chrono::nanoseconds offset;
+  //! Datagram
+  Helper::RawData packet;
+  //! Number of Datagrams of the other Side captured before this Datagram
+  std::size_t responses;
+};
+
+/**
+ * @brief Application Entry Point.
+ *
+ * @param[in] argc
+ *   Number of arguments.
+ * @param[in] argv
+ *   Arguments
+ *
+ * @return Application exit status.
+ **/
+int main( int argc, char * argv[] );
+
+/**
+ * @brief Prints the captured Sessions.
+ *
+ * @param[in] records
+ *   Captured records.
+ **/
+static void listSessions( std::span< const Tftp::CaptureRecord > records );
+
+/**
+ * @brief Returns the Datagrams of one Side of a Session.
+ *
+ * The offsets are relative to the first record of the session (the request) and scaled by the replay speed.
+ * Each datagram records, how many datagrams of the other side have been captured before it.
+ *
+ * @param[in] records
+ *   Records of the session.
+ * @param[in] sentByClient
+ *   Select datagrams sent by the client or by the server.
+ *
+ * @return Datagrams to replay.
+ **/
+static std::vector< Datagram > datagrams( std::span< const Tftp::CaptureRecord > records, bool sentByClient );
+
+/**
+ * @brief Sends the Datagram @p index at its Offset and the following ones afterwards.
+ *
+ * The replay is closed loop:
+ * A datagram is sent not before the datagrams of the other side, which have been captured before it, are received.
+ * When they are not received within the TFTP receive timeout, the replay is stopped.
+ *
+ * @param[in] index
+ *   Index of the datagram.
+ **/
+static void sendDatagram( std::size_t index );
+
+/**
+ * @brief Returns, if the Datagram @p index can be sent.
+ *
+ * The first datagram can always be sent.
+ * The following ones require the transfer endpoint and the captured number of received datagrams.
+ *
+ * @param[in] index
+ *   Index of the datagram.
+ *
+ * @return If the datagram @p index can be sent.
+ **/
+static bool responsesReceived( std::size_t index );
+
+/**
+ * @brief Sends the Datagram @p index immediately and schedules the following ones.
+ *
+ * @param[in] index
+ *   Index of the datagram.
+ **/
+static void transmitDatagram( std::size_t index );
+
+/**
+ * @brief Receives Datagrams on the Replay Socket until the Replay is finished.
+ **/
+static void receiveDatagram();
+
+/**
+ * @brief Replays the Client Side of a Session against a Server.
+ *
+ * @param[in] records
+ *   Records of the session.
+ **/
+static void replayClient( std::span< const Tftp::CaptureRecord > records );
+
+/**
+ * @brief Replays the Server Side of a Session to a Client.
+ *
+ * Waits for a request and replays the server datagrams to the requesting client.
+ *
+ * @param[in] records
+ *   Records of the session.
+ **/
+static void replayServer( std::span< const Tftp::CaptureRecord > records );
+
+//! Replay Speed (2.0: twice as fast, 0: without delays)
+static double speed{ 1.0 };
+
+//! Address of the Server (client replay) or Listen Address (server replay)
+static boost::asio::ip::address address{ boost::asio::ip::address_v4::loopback() };
+
+//! Server Port (client replay) or Listen Port (server replay)
+static uint16_t port{ Tftp::DefaultTftpPort };
+
+//! I/O Context (the TFTP library requires an I/O context run by a single thread)
+static boost::asio::io_context ioContext{ 1 };
+
+//! Replay Socket
+static boost::asio::ip::udp::socket replaySocket{ ioContext };
+
+//! Send Timer
+static boost::asio::steady_timer sendTimer{ ioContext };
+
+//! Datagrams to replay
+static std::vector< Datagram > replayDatagrams;
+
+//! Start of the Replay
+static std::chrono::steady_clock::time_point replayStart;
+
+//! Destination of the first Datagram (request in client replay)
+static boost::asio::ip::udp::endpoint requestEndpoint;
+
+//! Destination of the following Datagrams (learned from the first received datagram in client replay)
+static std::optional< boost::asio::ip::udp::endpoint > transferEndpoint;
+
+//! Receive Buffer
+static std::array< std::byte, 65536U > receiveBuffer{};
+
+//! Source of the received Datagram
+static boost::asio::ip::udp::endpoint receiveEndpoint;
+
+//! Number of sent Datagrams
+static std::size_t sentDatagrams{ 0U };
+
+//! Number of received Datagrams
+static std::size_t receivedDatagrams{ 0U };
+
+//! Datagram waiting for the Responses of the other Side
+static std::optional< std::size_t > pendingDatagram;
+
+int main( const int argc, char * argv[] )
+{
+  try
+  {
+    std::cout << std::format( "TFTP Replay - {}\n", Tftp::Version::VersionInformation );
+
+    std::filesystem::path captureFile;
+    std::optional< uint32_t > session;
+    std::string replay{ "client" };
+
+    boost::program_options::options_description optionsDescription{ "TFTP Replay Options" };
+
+    optionsDescription.add_options()
+    (
+      "help,h",
+      "Print this help screen."
+    )
+    (
+      "capture-file,f",
+      boost::program_options::value( &captureFile )
+        ->required()
+        ->value_name( "filename" ),
+      "Capture file of the TFTP server or client."
+    )
+    (
+      "session,s",
+      boost::program_options::value< uint32_t >()
+        ->notifier( [ &session ]( const uint32_t value ){ session = value; } )
+        ->value_name( "session" ),
+      "Session to replay. When not given, the captured sessions are listed."
+    )
+    (
+      "replay,r",
+      boost::program_options::value( &replay )
+        ->default_value( replay )
+        ->value_name( "client|server" ),
+      "Replays the client side against a server or the server side to a client."
+    )
+    (
+      "address,a",
+      boost::program_options::value( &address )->default_value( address ),
+      "Address of the server (client replay) or listen address (server replay)."
+    )
+    (
+      "port,p",
+      boost::program_options::value( &port )->default_value( port ),
+      "Port of the server (client replay) or listen port (server replay)."
+    )
+    (
+      "speed",
+      boost::program_options::value( &speed )->default_value( speed ),
+      "Replay speed factor (1: original timing, 2: twice as fast, 0: without delays)."
+    );
+
+    boost::program_options::variables_map variablesMap;
+    boost::program_options::store(
+      boost::program_options::parse_command_line( argc, argv, optionsDescription ),
+      variablesMap );
+
+    if ( 0U != variablesMap.count( "help" ) )
+    {
+      std::cout
+        << "Replays captured TFTP sessions.\n\n"
+        << optionsDescription << "\n";
+      return EXIT_FAILURE;
+    }
+
+    boost::program_options::notify( variablesMap );
+
+    if ( ( replay != "client" ) && ( replay != "server" ) )
+    {
+      std::cerr << std::format( "Invalid replay side '{}'\n", replay );
+      return EXIT_FAILURE;
+    }
+
+    std::ifstream captureStream{ captureFile, std::ios::binary };
+
+    if ( !captureStream )
+    {
+      std::cerr << std::format( "Error opening {}\n", captureFile.string() );
+      return EXIT_FAILURE;
+    }
+
+    const auto records{ Tftp::PacketCapture::read( captureStream ) };
+
+    if ( !session )
+    {
+      listSessions( records );
+      return EXIT_SUCCESS;
+    }
+
+    const auto sessionRecords{ Tftp::PacketCapture::sessionRecords( records, *session ) };
+
+    if ( sessionRecords.empty() )
+    {
+      std::cerr << std::format( "Session {} not captured\n", *session );
+      return EXIT_FAILURE;
+    }
+
+    if ( replay == "client" )
+    {
+      replayClient( sessionRecords );
+    }
+    else
+    {
+      replayServer( sessionRecords );
+    }
+
+    ioContext.run();
+
+    const auto elapsed{ std::chrono::duration< double >{ std::chrono::steady_clock::now() - replayStart } };
+    const auto captured{ std::chrono::duration< double >{
+      std::chrono::nanoseconds{ sessionRecords.back().timestamp - sessionRecords.front().timestamp } } };
+
+    std::cout << std::format(
+      "Replayed {} of {} datagrams in {:.3f} s (captured: {:.3f} s)\n"
+      "Received {} datagrams (captured: {})\n",
+      sentDatagrams,
+      replayDatagrams.size(),
+      elapsed.count(),
+      captured.count(),
+      receivedDatagrams,
+      sessionRecords.size() - replayDatagrams.size() );
+
+    return EXIT_SUCCESS;
+  }
+  catch ( const boost::program_options::error &e )
+  {
+    std::cerr << std::format(
+      "Error parsing command line: {}\n"
+      "Enter '{} --help' for command line description.\n",
+      e.what(),
+      argv[ 0 ] );
+    return EXIT_FAILURE;
+  }
+  catch ( const boost::exception &e )
+  {
+    std::cerr << std::format( "Error: {}\n", boost::diagnostic_information( e ) );
+    return EXIT_FAILURE;
+  }
+  catch ( const std::exception &e )
+  {
+    std::cerr << std::format( "Error: {}\n", boost::diagnostic_information( e ) );
+    return EXIT_FAILURE;
+  }
+  catch ( ... )
+  {
+    std::cerr << "Unknown exception occurred\n";
+    return EXIT_FAILURE;
+  }
+}
+
+static void listSessions( const std::span< const Tftp::CaptureRecord > records )
+{
+  //! Summary of a Session
+  struct Summary
+  {
+    Tftp::CaptureRecord::Role role;
+    boost::asio::ip::udp::endpoint remote;
+    std::size_t datagrams;
+    uint64_t first;
+    uint64_t last;
+  };
+
+  std::map< uint32_t, Summary > sessions;
+
+  for ( const auto &record : records )
+  {
+    // requests are replayed together with their session
+    if ( 0U == record.session )
+    {
+      continue;
+    }
+
+    auto [ summary, inserted ]{ sessions.try_emplace(
+      record.session,
+      Summary{ record.role, record.remote, 0U, record.timestamp, record.timestamp } ) };
+    ++summary->second.datagrams;
+    summary->second.last = record.timestamp;
+  }
+
+  std::cout << std::format( "{:>8} {:6} {:>8} {:>10} {}\n", "Session", "Side", "Packets", "Time [s]", "Remote" );
+
+  for ( const auto &[ session, summary ] : sessions )
+  {
+    std::cout << std::format(
+      "{:>8} {:6} {:>8} {:>10.3f} {}\n",
+      session,
+      Tftp::CaptureRecord::Role::Server == summary.role ? "server" : "client",
+      summary.datagrams,
+      std::chrono::duration< double >{ std::chrono::nanoseconds{ summary.last - summary.first } }.count(),
+      summary.remote.address().to_string() + ":" + std::to_string( summary.remote.port() ) );
+  }
+}
+
+static std::vector< Datagram > datagrams(
+  const std::span< const Tftp::CaptureRecord > records,
+  const bool sentByClient )
+{
+  std::vector< Datagram > result;
+  std::size_t responses{ 0U };
+
+  for ( const auto &record : records )
+  {
+    if ( record.sentByClient() != sentByClient )
+    {
+      ++responses;
+      continue;
+    }
+
+    const std::chrono::nanoseconds offset{ record.timestamp - records.front().timestamp };
+
+    result.emplace_back(
+      speed > 0.0 ?
+        std::chrono::duration_cast< std::chrono::nanoseconds >( offset / speed ) :
+        std::chrono::nanoseconds{},
+      record.packet,
+      responses );
+  }
+
+  return result;
+}
+
+static void sendDatagram( const std::size_t index )
+{
+  if ( index == replayDatagrams.size() )
+  {
+    // wait for the last responses
+    sendTimer.expires_after( Tftp::DefaultTftpReceiveTimeout );
+    sendTimer.async_wait( []( const boost::system::error_code &errorCode )
+    {
+      if ( !errorCode )
+      {
+        replaySocket.close();
+      }
+    } );
+    return;
+  }
+
+  sendTimer.expires_at( replayStart + replayDatagrams[ index ].offset );
+  sendTimer.async_wait( [ index ]( const boost::system::error_code &errorCode )
+  {
+    if ( errorCode )
+    {
+      return;
+    }
+
+    if ( responsesReceived( index ) )
+    {
+      transmitDatagram( index );
+      return;
+    }
+
+    // wait for the responses - sent by receiveDatagram()
+    pendingDatagram = index;
+
+    sendTimer.expires_after( Tftp::DefaultTftpReceiveTimeout );
+    sendTimer.async_wait( []( const boost::system::error_code &timeoutErrorCode )
+    {
+      if ( timeoutErrorCode )
+      {
+        return;
+      }
+
+      std::cerr << std::format( "No response before datagram {} - replay stopped\n", *pendingDatagram );
+      pendingDatagram.reset();
+      replaySocket.close();
+    } );
+  } );
+}
+
+static bool responsesReceived( const std::size_t index )
+{
+  return ( 0U == index )
+    || ( transferEndpoint && ( receivedDatagrams >= replayDatagrams[ index ].responses ) );
+}
+
+static void transmitDatagram( const std::size_t index )
+{
+  replaySocket.send_to(
+    boost::asio::buffer( replayDatagrams[ index ].packet ),
+    ( 0U == index ) ? requestEndpoint : *transferEndpoint );
+  ++sentDatagrams;
+
+  sendDatagram( index + 1U );
+}
+
+static void receiveDatagram()
+{
+  replaySocket.async_receive_from(
+    boost::asio::buffer( receiveBuffer ),
+    receiveEndpoint,
+    []( const boost::system::error_code &errorCode, [[maybe_unused]] const std::size_t bytesTransferred )
+    {
+      if ( errorCode )
+      {
+        return;
+      }
+
+      // the server answers from its transfer port
+      if ( !transferEndpoint )
+      {
+        transferEndpoint = receiveEndpoint;
+      }
+
+      ++receivedDatagrams;
+
+      if ( pendingDatagram && responsesReceived( *pendingDatagram ) )
+      {
+        const auto index{ *pendingDatagram };
+        pendingDatagram.reset();
+        transmitDatagram( index );
+      }
+
+      receiveDatagram();
+    } );
+}
+
+static void replayClient( const std::span< const Tftp::CaptureRecord > records )
+{
+  replayDatagrams = datagrams( records, true );
+
+  if ( replayDatagrams.empty() )
+  {
+    std::cerr << "No client datagrams captured\n";
+    return;
+  }
+
+  requestEndpoint = boost::asio::ip::udp::endpoint{ address, port };
+
+  std::cout << std::format(
+    "Replaying {} client datagrams to {}:{}\n",
+    replayDatagrams.size(),
+    address.to_string(),
+    port );
+
+  replaySocket.open( requestEndpoint.protocol() );
+  replayStart = std::chrono::steady_clock::now();
+
+  receiveDatagram();
+  sendDatagram( 0U );
+}
+
+static void replayServer( const std::span< const Tftp::CaptureRecord > records )
+{
+  replayDatagrams = datagrams( records, false );
+
+  if ( replayDatagrams.empty() )
+  {
+    std::cerr << "No server datagrams captured\n";
+    return;
+  }
+
+  // the listen socket receives the request only, the transfer uses the replay socket
+  static boost::asio::ip::udp::socket listenSocket{ ioContext, boost::asio::ip::udp::endpoint{ address, port } };
+
+  std::cout << std::format(
+    "Waiting for request on {}:{} to replay {} server datagrams\n",
+    address.to_string(),
+    port,
+    replayDatagrams.size() );
+
+  listenSocket.async_receive_from(
+    boost::asio::buffer( receiveBuffer ),
+    receiveEndpoint,
+    []( const boost::system::error_code &errorCode, [[maybe_unused]] const std::size_t bytesTransferred )
+    {
+      if ( errorCode )
+      {
+        return;
+      }
+
+      listenSocket.close();
+
+      // the request is the first captured client datagram
+      ++receivedDatagrams;
+      requestEndpoint = receiveEndpoint;
+      transferEndpoint = receiveEndpoint;
+
+      std::cout << std::format(
+        "Request from {}:{}\n",
+        receiveEndpoint.address().to_string(),
+        receiveEndpoint.port() );
+
+      replaySocket.open( receiveEndpoint.protocol() );
+      replayStart = std::chrono::steady_clock::now();
+
+      receiveDatagram();
+      sendDatagram( 0U );
+    } );
+}
@@ -10,19 +10,29 @@
  * @brief TFTP Server CLI Application.
  **/
 
+#include <tftp/servers/AdmissionConfiguration.hpp>
+#include <tftp/servers/FileResolver.hpp>
 #include <tftp/servers/Operation.hpp>
 #include <tftp/servers/ReadOperation.hpp>
 #include <tftp/servers/Server.hpp>
+#include <tftp/servers/ShapingConfiguration.hpp>
+#include <tftp/servers/TuningConfiguration.hpp>
 #include <tftp/servers/WriteOperation.hpp>
 
-#include <tftp/files/StreamFile.hpp>
+#include <tftp/files/ChunkStore.hpp>
+#include <tftp/files/DeduplicatingFile.hpp>
+#include <tftp/files/DigestFile.hpp>
+#include <tftp/files/File.hpp>
+#include <tftp/files/NetasciiFile.hpp>
 
 #include <tftp/packets/PacketStatistic.hpp>
 #include <tftp/packets/TftpOptions.hpp>
 
+#include <tftp/PacketCapture.hpp>
 #include <tftp/TftpConfiguration.hpp>
 #include <tftp/TftpException.hpp>
 #include <tftp/TftpOptionsConfiguration.hpp>
+#include <tftp/TraceRing.hpp>
 #include <tftp/TransferStatusDescription.hpp>
 #include <tftp/Version.hpp>
 
@@ -32,10 +42,14 @@
 
 #include <boost/program_options.hpp>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
 
 /**
  * @brief Application Entry Point.
@@ -80,12 +94,15 @@ static void receivedRequest(
  *   Remote address.
  * @param[in] filename
  *   Requested filename.
+ * @param[in] file
+ *   Opened file.
  * @param[in] clientOptions
  *   Received Options.
  **/
 static void transmitFile(
   const boost::asio::ip::udp::endpoint &remote,
-  const std::filesystem::path &filename,
+  std::string_view filename,
+  Tftp::Files::FilePtr file,
   const Tftp::Packets::TftpOptions &clientOptions );
 
 /**
@@ -95,36 +112,110 @@ static void transmitFile(
  *   Remote address.
  * @param[in] filename
  *   Requested filename.
+ * @param[in] file
+ *   Opened file.
  * @param[in] clientOptions
  *   Received Options.
  **/
 static void receiveFile(
   const boost::asio::ip::udp::endpoint &remote,
-  const std::filesystem::path &filename,
+  std::string_view filename,
+  Tftp::Files::FilePtr file,
   const Tftp::Packets::TftpOptions &clientOptions );
 
+/**
+ * @brief Wraps @p file into a Digest File, when digests are requested.
+ *
+ * @param[in] session
+ *   Session number.
+ * @param[in,out] file
+ *   Opened file. Replaced by the Digest File.
+ *
+ * @return Operation Completed Handler, which prints the digests before calling operationCompleted().
+ **/
+static Tftp::Servers::OperationCompletedHandler digestHandler( std::size_t session, Tftp::Files::FilePtr &file );
+
 /**
  * @brief Operation Completed callback
  *
+ * @param[in] session
+ *   Session number.
  * @param[in] transferStatus
  *   Transfer Status.
  **/
-static void operationCompleted( Tftp::TransferStatus transferStatus );
+static void operationCompleted( std::size_t session, Tftp::TransferStatus transferStatus );
 
 //! TFTP Server Base Directory
 static std::filesystem::path baseDir{};
 
+//! Resolves the requested Files beneath the Base Directory
+static std::unique_ptr< Tftp::Servers::FileResolver > fileResolver;
+
+//! Time, how long not existing Files are remembered [ms]
+static std::uint32_t negativeCacheTimeToLive{ 5000U };
+
+//! Maximum number of remembered not existing Files
+static std::size_t negativeCacheSize{ 0U };
+
+//! Time, how long opened Files are reused [ms]
+static std::uint32_t metadataCacheTimeToLive{ 60000U };
+
+//! Maximum number of reused opened Files
+static std::size_t metadataCacheSize{ 0U };
+
+//! Serve pre-compressed Files (`.zst`, `.gz`)
+static bool precompressed{ false };
+
+//! Maximum size of decompressed Files kept in memory [bytes]
+static std::uint64_t memoizeLimit{ 0U };
+
+//! Directory of the Chunk Store (empty: files are not deduplicated)
+static std::filesystem::path chunkStoreDir{};
+
+//! Stores the Chunks of deduplicated Files
+static std::shared_ptr< Tftp::Files::ChunkStore > chunkStore;
+
+//! Print the Digests of each transferred File
+static bool digest{ false };
+
+//! File, where the Packets are captured (empty: packets are not captured)
+static std::filesystem::path captureFile{};
+
+//! File, where the Packet Trace is saved on Exit (empty: trace is not saved)
+static std::filesystem::path traceFile{};
+
+//! Number of Sockets shared by the Transfers
+static std::size_t sharedSockets{ 0U };
+
+//! Number of idle Operations held per Operation Pool
+static std::size_t operationPoolSize{ 0U };
+
 //! TFTP Server Configuration
 static Tftp::TftpConfiguration tftpConfiguration{};
 
 //! TFTP Server Options Configuration
 static Tftp::TftpOptionsConfiguration tftpOptionsConfiguration{};
 
+//! TFTP Server Admission Control Configuration
+static Tftp::Servers::AdmissionConfiguration admissionConfiguration{};
+
+//! TFTP Server Transmit Shaping Configuration
+static Tftp::Servers::ShapingConfiguration shapingConfiguration{};
+
+//! TFTP Server Tuning Configuration
+static Tftp::Servers::TuningConfiguration tuningConfiguration{};
+
+//! I/O Context (the TFTP library requires an I/O context run by a single thread)
+static boost::asio::io_context ioContext{ 1 };
+
 //! TFTP Server Instance
 static Tftp::Servers::ServerPtr server;
 
-//! TFTP Server Operation
-static Tftp::Servers::OperationPtr serverOperation;
+//! Active TFTP Server Operations (by session number)
+static std::map< std::size_t, Tftp::Servers::OperationPtr > serverOperations;
+
+//! Number of started Sessions
+static std::size_t startedSessions{ 0U };
 
 int main( const int argc, char * argv[] )
 {
@@ -143,13 +234,75 @@ int main( const int argc, char * argv[] )
       "server-root,r",
       boost::program_options::value( &baseDir )->default_value( std::filesystem::current_path() ),
       "Directory path, where the server shall have its root."
+    )
+    (
+      "shared-sockets",
+      boost::program_options::value( &sharedSockets )->default_value( sharedSockets ),
+      "Number of sockets shared by all transfers (0: every transfer uses its own socket)."
+    )
+    (
+      "operation-pool-size",
+      boost::program_options::value( &operationPoolSize )->default_value( operationPoolSize ),
+      "Number of idle transfers kept for reuse per transfer type (0: no pooling)."
+    )
+    (
+      "negative-cache-size",
+      boost::program_options::value( &negativeCacheSize )->default_value( negativeCacheSize ),
+      "Number of not existing files remembered for read requests (0: no negative cache)."
+    )
+    (
+      "negative-cache-ttl",
+      boost::program_options::value( &negativeCacheTimeToLive )->default_value( negativeCacheTimeToLive ),
+      "Time in milliseconds, how long not existing files are remembered."
+    )
+    (
+      "metadata-cache-size",
+      boost::program_options::value( &metadataCacheSize )->default_value( metadataCacheSize ),
+      "Number of opened files reused for read requests (0: no metadata cache)."
+    )
+    (
+      "metadata-cache-ttl",
+      boost::program_options::value( &metadataCacheTimeToLive )->default_value( metadataCacheTimeToLive ),
+      "Time in milliseconds, how long opened files are reused at most."
+    )
+    (
+      "precompressed",
+      boost::program_options::bool_switch( &precompressed ),
+      "Serve <file>.zst or <file>.gz decompressed, when <file> does not exist."
+    )
+    (
+      "memoize-limit",
+      boost::program_options::value( &memoizeLimit )->default_value( memoizeLimit ),
+      "Maximum size in bytes of pre-compressed files kept decompressed in the metadata cache (0: none)."
+    )
+    (
+      "chunk-store",
+      boost::program_options::value( &chunkStoreDir ),
+      "Directory, where uploaded files are stored deduplicated. The files get a manifest of their chunks."
+    )
+    (
+      "digest",
+      boost::program_options::bool_switch( &digest ),
+      "Print CRC32C and SHA-256 of each transferred file."
+    )
+    (
+      "trace-file",
+      boost::program_options::value( &traceFile ),
+      "File, where the binary packet trace is saved on exit. Decode it with tftp_trace."
+    )
+    (
+      "capture-file",
+      boost::program_options::value( &captureFile ),
+      "File, where all packets are captured. Replay the sessions with tftp_replay."
     );
 
     // Add TFTP options
     optionsDescription.add( tftpConfiguration.options() );
     optionsDescription.add( tftpOptionsConfiguration.options() );
+    optionsDescription.add( admissionConfiguration.options() );
+    optionsDescription.add( shapingConfiguration.options() );
+    optionsDescription.add( tuningConfiguration.options() );
 
-    boost::asio::io_context ioContext;
     boost::asio::signal_set signals{ ioContext, SIGINT, SIGTERM };
 
     boost::program_options::variables_map variablesMap;
@@ -170,6 +323,17 @@ int main( const int argc, char * argv[] )
     // make an absolute path
     baseDir = std::filesystem::canonical( baseDir );
 
+    // open the base directory once
+    fileResolver = std::make_unique< Tftp::Servers::FileResolver >( baseDir );
+    fileResolver->negativeCache( std::chrono::milliseconds{ negativeCacheTimeToLive }, negativeCacheSize );
+    fileResolver->metadataCache( std::chrono::milliseconds{ metadataCacheTimeToLive }, metadataCacheSize );
+    fileResolver->precompressed( precompressed, memoizeLimit );
+
+    if ( !chunkStoreDir.empty() )
+    {
+      chunkStore = std::make_shared< Tftp::Files::ChunkStore >( chunkStoreDir );
+    }
+
     std::cout
       << "Starting TFTP server in " << baseDir.string() << "\n";
 
@@ -180,9 +344,25 @@ int main( const int argc, char * argv[] )
     // configure
     server
       ->requestHandler( std::bind_front( &receivedRequest ) )
+      .admissionConfiguration( admissionConfiguration )
+      .shapingConfiguration( shapingConfiguration )
+      .tuningConfiguration( tuningConfiguration )
+      .tftpTimeoutDefault( tftpConfiguration.tftpTimeout )
+      .tftpRetriesDefault( tftpConfiguration.tftpRetries )
+      .dallyDefault( tftpConfiguration.dally )
+      .optionsConfigurationDefault( tftpOptionsConfiguration )
+      .sharedSockets( sharedSockets )
+      .socketBufferSizes( tftpConfiguration.socketBufferSizes )
+      .operationPoolSize( operationPoolSize )
       .serverAddress(
         boost::asio::ip::udp::endpoint{ boost::asio::ip::address_v4::any(), tftpConfiguration.tftpServerPort } );
 
+    if ( !captureFile.empty() )
+    {
+      Tftp::PacketCapture::instance().start(
+        std::make_shared< std::ofstream >( captureFile, std::ios::binary | std::ios::trunc ) );
+    }
+
     server->start();
 
     std::cout
@@ -195,14 +375,42 @@ int main( const int argc, char * argv[] )
     {
       std::cout << "Termination request\n";
       server->stop();
+
+      // the operations are released by their completion handlers
+      for ( const auto &[ session, operation ] : serverOperations )
+      {
+        operation->abort();
+      }
     } );
 
     ioContext.run();
 
+    Tftp::PacketCapture::instance().stop();
+
     // Print Packet Statistic
     std::cout
       << "RX:\n" << Tftp::Packets::PacketStatistic::globalReceive() << "\n"
-      << "TX:\n" << Tftp::Packets::PacketStatistic::globalTransmit() << "\n";
+      << "TX:\n" << Tftp::Packets::PacketStatistic::globalTransmit() << "\n"
+      << "Admission:\n" << server->admissionStatistic() << "\n"
+      << "Shaping:\n" << server->shapingStatistic() << "\n"
+      << "Operation Pool:\n" << server->operationPoolStatistic() << "\n"
+      << "File Resolver:\n" << fileResolver->statistic() << "\n";
+
+    if ( chunkStore )
+    {
+      std::cout << "Chunk Store:\n" << chunkStore->statistic() << "\n";
+    }
+
+    if ( !traceFile.empty() )
+    {
+      std::ofstream traceStream{ traceFile, std::ios::binary | std::ios::trunc };
+      Tftp::TraceRing::write( traceStream, Tftp::TraceRing::instance().snapshot() );
+
+      if ( !traceStream )
+      {
+        std::cerr << std::format( "Error saving trace to {}\n", traceFile.string() );
+      }
+    }
 
     return EXIT_SUCCESS;
   }
@@ -241,7 +449,7 @@ static void receivedRequest(
   const Tftp::Packets::Options &additionalClientOptions )
 {
   // Check transfer mode
-  if ( mode != Tftp::Packets::TransferMode::OCTET )
+  if ( ( mode != Tftp::Packets::TransferMode::OCTET ) && ( mode != Tftp::Packets::TransferMode::NETASCII ) )
   {
     std::cerr << "Wrong transfer mode\n";
 
@@ -250,17 +458,34 @@ static void receivedRequest(
     return;
   }
 
-  // check and generate file path
-  const auto filePath{ Tftp::Servers::checkFilename( baseDir, filename, Tftp::RequestType::Read == requestType ) };
-  if ( !filePath )
+  // open the file beneath the base directory (with a chunk store, NETASCII is translated on top of deduplication)
+  auto file{ fileResolver->open( filename, requestType, chunkStore ? Tftp::Packets::TransferMode::OCTET : mode ) };
+  if ( !file )
   {
-    std::cerr << "Error filename check\n";
+    std::cerr << "Error opening file\n";
 
-    server->errorOperation( remote, Tftp::Packets::ErrorCode::AccessViolation, "Illegal filename" );
+    server->errorOperation( remote, file.error() );
 
     return;
   }
 
+  // deduplicate the file within the chunk store
+  if ( chunkStore )
+  {
+    const auto operation{
+      Tftp::RequestType::Read == requestType ?
+        Tftp::Files::File::Operation::Transmit :
+        Tftp::Files::File::Operation::Receive };
+
+    *file = std::make_shared< Tftp::Files::DeduplicatingFile >( operation, chunkStore, std::move( *file ) );
+
+    // the NETASCII size of the content is not known in advance
+    if ( mode == Tftp::Packets::TransferMode::NETASCII )
+    {
+      *file = std::make_shared< Tftp::Files::NetasciiFile >( operation, std::move( *file ) );
+    }
+  }
+
   if ( !additionalClientOptions.empty() )
   {
     std::cout << "Unknown options ";
@@ -275,12 +500,12 @@ static void receivedRequest(
   {
     case Tftp::RequestType::Read:
       // we are on server side and transmit the data on RRQ
-      transmitFile( remote, baseDir / filename, clientOptions );
+      transmitFile( remote, filename, std::move( *file ), clientOptions );
       break;
 
     case Tftp::RequestType::Write:
       // we are on server side and receive the data on WRQ
-      receiveFile( remote, baseDir / filename, clientOptions );
+      receiveFile( remote, filename, std::move( *file ), clientOptions );
       break;
 
     default:
@@ -290,88 +515,79 @@ static void receivedRequest(
 
 static void transmitFile(
   const boost::asio::ip::udp::endpoint &remote,
-  const std::filesystem::path &filename,
+  const std::string_view filename,
+  Tftp::Files::FilePtr file,
   const Tftp::Packets::TftpOptions &clientOptions )
 {
   std::cout
     << "RRQ: " << filename << " from: " << remote.address().to_string() << "\n";
 
-  // open requested file
-  std::fstream fileStream{ filename.c_str(), std::fstream::in };
-
-  // check that file was opened successfully
-  if ( !fileStream.good() )
-  {
-    std::cerr << "Error opening file\n";
-
-    server->errorOperation( remote, Tftp::Packets::ErrorCode::FileNotFound, "file not found" );
-
-    return;
-  }
-
   // initiate TFTP operation
-  const auto readOperation{ server->readOperation() };
+  const auto session{ startedSessions++ };
+  auto completionHandler{ digestHandler( session, file ) };
+  const auto readOperation{ server->readOperation( remote.address(), filename ) };
 
+  // timeout, retries, and options configuration are set by the server (tuning profiles)
   readOperation
-    ->tftpTimeout( tftpConfiguration.tftpTimeout )
-    .tftpRetries( tftpConfiguration.tftpRetries )
-    .optionsConfiguration( tftpOptionsConfiguration )
-    .completionHandler( std::bind_front( &operationCompleted ) )
-    .dataHandler(
-      std::make_shared< Tftp::Files::StreamFile >(
-        Tftp::Files::File::Operation::Transmit,
-        filename,
-        std::filesystem::file_size( filename ) ) )
+    ->completionHandler( std::move( completionHandler ) )
+    .dataHandler( std::move( file ) )
     .remote( remote)
     .clientOptions( clientOptions );
 
-  serverOperation = readOperation;
-  serverOperation->start();
+  serverOperations.emplace( session, readOperation );
+  readOperation->start();
 }
 
 static void receiveFile(
   const boost::asio::ip::udp::endpoint &remote,
-  const std::filesystem::path &filename,
+  const std::string_view filename,
+  Tftp::Files::FilePtr file,
   const Tftp::Packets::TftpOptions &clientOptions )
 {
   std::cout
     << "WRQ: " << filename << " from: " << remote.address().to_string() << "\n";
 
-  // open the requested file
-  std::fstream fileStream{ filename.c_str(), std::fstream::out | std::fstream::trunc };
-
-  // check that file was opened successfully
-  if ( !fileStream.good() )
-  {
-    std::cerr << "Error opening file\n";
-
-    server->errorOperation( remote, Tftp::Packets::ErrorCode::AccessViolation );
-
-    return;
-  }
-
   // initiate TFTP operation
-  const auto writeOperation{ server->writeOperation() };
+  const auto session{ startedSessions++ };
+  auto completionHandler{ digestHandler( session, file ) };
+  const auto writeOperation{ server->writeOperation( remote.address(), filename ) };
 
+  // timeout, retries, dally, and options configuration are set by the server (tuning profiles)
   writeOperation
-    ->tftpTimeout( tftpConfiguration.tftpTimeout )
-    .tftpRetries( tftpConfiguration.tftpRetries )
-    .dally( tftpConfiguration.dally )
-    .optionsConfiguration( tftpOptionsConfiguration )
-    .completionHandler( std::bind_front( &operationCompleted ) )
-    .dataHandler( std::make_shared< Tftp::Files::StreamFile >( Tftp::Files::File::Operation::Receive, filename ) )
+    ->completionHandler( std::move( completionHandler ) )
+    .dataHandler( std::move( file ) )
     .remote( remote )
     .clientOptions( clientOptions );
 
-  serverOperation = writeOperation;
-  serverOperation->start();
+  serverOperations.emplace( session, writeOperation );
+  writeOperation->start();
+}
+
+static Tftp::Servers::OperationCompletedHandler digestHandler(
+  const std::size_t session,
+  Tftp::Files::FilePtr &file )
+{
+  if ( !digest )
+  {
+    return std::bind_front( &operationCompleted, session );
+  }
+
+  auto digestFile{ std::make_shared< Tftp::Files::DigestFile >( std::move( file ) ) };
+  file = digestFile;
+
+  return [ session, digestFile ]( const Tftp::TransferStatus transferStatus )
+  {
+    std::cout << "Digest:\n" << digestFile->digest();
+    operationCompleted( session, transferStatus );
+  };
 }
 
-static void operationCompleted( const Tftp::TransferStatus transferStatus )
+static void operationCompleted( const std::size_t session, const Tftp::TransferStatus transferStatus )
 {
   std::cout << "Transfer Completed: " << transferStatus << "\n";
 
-  serverOperation.reset();
+  // the operation is released outside its own completion handler
+  boost::asio::post( ioContext, [ session ]{ serverOperations.erase( session ); } );
 
   /* TODO
    * RX statistic maybe incomplete, because this completion handler maybe called
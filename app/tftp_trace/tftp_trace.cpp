@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief TFTP Trace Decoder CLI Application.
+ **/
+
+#include <tftp/TraceRing.hpp>
+#include <tftp/Version.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+
+/**
+ * @brief Application Entry Point.
+ *
+ * @param[in] argc
+ *   Number of arguments.
+ * @param[in] argv
+ *   Arguments
+ *
+ * @return Application exit status.
+ **/
+int main( int argc, char * argv[] );
+
+int main( const int argc, char * argv[] )
+{
+  try
+  {
+    std::cout << std::format( "TFTP Trace Decoder - {}\n", Tftp::Version::VersionInformation );
+
+    std::filesystem::path traceFile;
+    std::optional< uint32_t > session;
+
+    boost::program_options::options_description optionsDescription{ "TFTP Trace Decoder Options" };
+
+    optionsDescription.add_options()
+    (
+      "help,h",
+      "Print this help screen."
+    )
+    (
+      "trace-file,f",
+      boost::program_options::value( &traceFile )
+        ->required()
+        ->value_name( "file" ),
+      "Trace file saved by the TFTP server."
+    )
+    (
+      "session,s",
+      boost::program_options::value< uint32_t >()
+        ->notifier( [ &session ]( const uint32_t value ){ session = value; } )
+        ->value_name( "session" ),
+      "Print the records of this session only (0: requests)."
+    );
+
+    boost::program_options::variables_map variablesMap;
+    boost::program_options::store(
+      boost::program_options::parse_command_line( argc, argv, optionsDescription ),
+      variablesMap );
+
+    if ( 0U != variablesMap.count( "help" ) )
+    {
+      std::cout
+        << "Decodes a binary TFTP packet trace.\n\n"
+        << optionsDescription << "\n";
+      return EXIT_FAILURE;
+    }
+
+    boost::program_options::notify( variablesMap );
+
+    std::ifstream traceStream{ traceFile, std::ios::binary };
+
+    if ( !traceStream )
+    {
+      std::cerr << std::format( "Error opening {}\n", traceFile.string() );
+      return EXIT_FAILURE;
+    }
+
+    const auto records{ Tftp::TraceRing::read( traceStream ) };
+
+    if ( records.empty() )
+    {
+      return EXIT_SUCCESS;
+    }
+
+    // print times relative to the first record
+    const auto start{ records.front().timestamp };
+
+    for ( const auto &record : records )
+    {
+      if ( session && ( *session != record.session ) )
+      {
+        continue;
+      }
+
+      std::cout << record.toString( start ) << "\n";
+    }
+
+    return EXIT_SUCCESS;
+  }
+  catch ( const boost::program_options::error &e )
+  {
+    std::cerr << std::format(
+      "Error parsing command line: {}\n"
+      "Enter '{} --help' for command line description.\n",
+      e.what(),
+      argv[ 0 ] );
+    return EXIT_FAILURE;
+  }
+  catch ( const boost::exception &e )
+  {
+    std::cerr << std::format( "Error: {}\n", boost::diagnostic_information( e ) );
+    return EXIT_FAILURE;
+  }
+  catch ( const std::exception &e )
+  {
+    std::cerr << std::format( "Error: {}\n", boost::diagnostic_information( e ) );
+    return EXIT_FAILURE;
+  }
+  catch ( ... )
+  {
+    std::cerr << "Unknown exception occurred\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Crc32c.
+ **/
+
+#include "Crc32c.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined( __x86_64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define TFTP_CRC32C_SSE42
+#include <nmmintrin.h>
+#endif
+
+namespace Tftp {
+
+namespace {
+
+//! CRC-32C Polynomial (reversed)
+constexpr uint32_t Polynomial{ 0x82F6'3B78U };
+
+//! Byte-wise Lookup Table
+constexpr auto Table{ []
+{
+  std::array< uint32_t, 256U > table{};
+
+  for ( uint32_t index{ 0U }; index < table.size(); ++index )
+  {
+    uint32_t crc{ index };
+
+    for ( int bit{ 0 }; bit < 8; ++bit )
+    {
+      crc = ( 0U != ( crc & 1U ) ) ? ( ( crc >> 1U ) ^ Polynomial ) : ( crc >> 1U );
+    }
+
+    table[ index ] = crc;
+  }
+
+  return table;
+}() };
+
+/**
+ * @brief Table driven Implementation.
+ *
+ * @param[in] crc
+ *   CRC register.
+ * @param[in] data
+ *   Data.
+ *
+ * @return Updated CRC register.
+ **/
+uint32_t updateSoftware( uint32_t crc, const Helper::ConstRawDataSpan data ) noexcept
+{
+  for ( const auto byte : data )
+  {
+    crc = Table[ ( crc ^ std::to_integer< uint32_t >( byte ) ) & 0xFFU ] ^ ( crc >> 8U );
+  }
+
+  return crc;
+}
+
+#if defined( TFTP_CRC32C_SSE42 )
+/**
+ * @brief SSE 4.2 Implementation.
+ *
+ * @param[in] crc
+ *   CRC register.
+ * @param[in] data
+ *   Data.
+ *
+ * @return Updated CRC register.
+ **/
+__attribute__(( target( "sse4.2" ) ))
+uint32_t updateHardware( uint32_t crc, Helper::ConstRawDataSpan data ) noexcept
+{
+  uint64_t crc64{ crc };
+
+  while ( data.size() >= sizeof( uint64_t ) )
+  {
+    uint64_t word{};
+    std::memcpy( &word, data.data(), sizeof( word ) );
+    crc64 = _mm_crc32_u64( crc64, word );
+    data = data.subspan( sizeof( word ) );
+  }
+
+  crc = static_cast< uint32_t >( crc64 );
+
+  for ( const auto byte : data )
+  {
+    crc = _mm_crc32_u8( crc, std::to_integer< uint8_t >( byte ) );
+  }
+
+  return crc;
+}
+
+//! SSE 4.2 is supported by the CPU
+const bool HardwareSupport{ 0 != __builtin_cpu_supports( "sse4.2" ) };
+#endif
+
+}
+
+bool Crc32c::hardwareAccelerated() noexcept
+{
+#if defined( TFTP_CRC32C_SSE42 )
+  return HardwareSupport;
+#else
+  return false;
+#endif
+}
+
+void Crc32c::update( const Helper::ConstRawDataSpan data ) noexcept
+{
+#if defined( TFTP_CRC32C_SSE42 )
+  if ( HardwareSupport )
+  {
+    crcV = updateHardware( crcV, data );
+    return;
+  }
+#endif
+
+  crcV = updateSoftware( crcV, data );
+}
+
+uint32_t Crc32c::value() const noexcept
+{
+  return crcV ^ Initial;
+}
+
+void Crc32c::reset() noexcept
+{
+  crcV = Initial;
+}
+
+}
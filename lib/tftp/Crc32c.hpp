@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Crc32c.
+ **/
+
+#ifndef TFTP_CRC32C_HPP
+#define TFTP_CRC32C_HPP
+
+#include <tftp/Tftp.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <cstdint>
+
+namespace Tftp {
+
+/**
+ * @brief Incremental CRC-32C (Castagnoli) Calculation.
+ *
+ * On x86-64 CPUs with SSE 4.2, the CRC32 instruction is used (detected at runtime).
+ * Otherwise, a table driven implementation is used.
+ **/
+class TFTP_EXPORT Crc32c final
+{
+  public:
+    /**
+     * @brief Returns if the Hardware Implementation is used.
+     *
+     * @return If the CRC32 instruction is used.
+     **/
+    [[nodiscard]] static bool hardwareAccelerated() noexcept;
+
+    /**
+     * @brief Adds @p data to the Checksum.
+     *
+     * @param[in] data
+     *   Data.
+     **/
+    void update( Helper::ConstRawDataSpan data ) noexcept;
+
+    /**
+     * @brief Returns the Checksum of the Data added so far.
+     *
+     * @return CRC-32C
+     **/
+    [[nodiscard]] uint32_t value() const noexcept;
+
+    //! Restarts the Calculation.
+    void reset() noexcept;
+
+  private:
+    //! Initial Value and final XOR Value
+    static constexpr uint32_t Initial{ 0xFFFF'FFFFU };
+
+    //! Current CRC Register
+    uint32_t crcV{ Initial };
+};
+
+}
+
+#endif
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::PacketCapture.
+ **/
+
+#include "PacketCapture.hpp"
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/exception/all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <exception>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+namespace Tftp {
+
+namespace {
+
+//! Size of the Record Header
+constexpr std::size_t RecordHeaderSize{ 8U + 4U + 1U + 1U + 2U + 16U + 2U };
+
+}
+
+bool CaptureRecord::sentByClient() const noexcept
+{
+  return ( Role::Client == role ) == ( Direction::Transmit == direction );
+}
+
+PacketCapture& PacketCapture::instance() noexcept
+{
+  static PacketCapture packetCapture;
+  return packetCapture;
+}
+
+std::vector< CaptureRecord > PacketCapture::read( std::istream &stream )
+{
+  std::array< char, FileMagic.size() > magic{};
+
+  if ( !stream.read( magic.data(), magic.size() )
+    || ( std::string_view{ magic.data(), magic.size() } != FileMagic ) )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Invalid capture file header" } );
+  }
+
+  std::vector< CaptureRecord > records;
+
+  for ( ;; )
+  {
+    std::array< std::byte, RecordHeaderSize > header{};
+    stream.read( reinterpret_cast< char * >( header.data() ), header.size() );
+
+    if ( 0 == stream.gcount() )
+    {
+      break;
+    }
+
+    if ( static_cast< std::size_t >( stream.gcount() ) != header.size() )
+    {
+      BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Capture file truncated" } );
+    }
+
+    CaptureRecord record;
+    Helper::ConstRawDataSpan headerSpan{ header };
+    uint16_t port{};
+    uint16_t length{};
+
+    std::tie( headerSpan, record.timestamp ) = Helper::RawData_getInt< uint64_t >( headerSpan );
+    std::tie( headerSpan, record.session ) = Helper::RawData_getInt< uint32_t >( headerSpan );
+    record.role = static_cast< CaptureRecord::Role >( headerSpan[ 0U ] );
+    record.direction = static_cast< CaptureRecord::Direction >( headerSpan[ 1U ] );
+    std::tie( headerSpan, port ) = Helper::RawData_getInt< uint16_t >( headerSpan.subspan( 2U ) );
+
+    boost::asio::ip::address_v6::bytes_type addressBytes{};
+    std::ranges::transform(
+      headerSpan.first( addressBytes.size() ),
+      addressBytes.begin(),
+      []( const std::byte value ){ return std::to_integer< unsigned char >( value ); } );
+    std::tie( headerSpan, length ) = Helper::RawData_getInt< uint16_t >( headerSpan.subspan( addressBytes.size() ) );
+
+    const boost::asio::ip::address_v6 address{ addressBytes };
+    record.remote = boost::asio::ip::udp::endpoint{
+      address.is_v4_mapped() ?
+        boost::asio::ip::address{ boost::asio::ip::make_address_v4( boost::asio::ip::v4_mapped, address ) } :
+        boost::asio::ip::address{ address },
+      port };
+
+    record.packet.resize( length );
+
+    if ( !stream.read( reinterpret_cast< char * >( record.packet.data() ), length ) )
+    {
+      BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Capture file truncated" } );
+    }
+
+    records.push_back( std::move( record ) );
+  }
+
+  return records;
+}
+
+std::vector< CaptureRecord > PacketCapture::sessionRecords(
+  const std::span< const CaptureRecord > records,
+  const uint32_t session )
+{
+  std::vector< CaptureRecord > result;
+  std::ranges::copy_if(
+    records,
+    std::back_inserter( result ),
+    [ session ]( const CaptureRecord &record ){ return record.session == session; } );
+
+  if ( result.empty() || ( CaptureRecord::Role::Server != result.front().role ) )
+  {
+    return result;
+  }
+
+  // the request is the last one received from the client before the session has been started
+  const auto &first{ result.front() };
+  const auto request{ std::ranges::find_if(
+    records.rbegin(),
+    records.rend(),
+    [ &first ]( const CaptureRecord &record )
+    {
+      return ( 0U == record.session )
+        && ( CaptureRecord::Role::Server == record.role )
+        && ( CaptureRecord::Direction::Receive == record.direction )
+        && ( record.remote == first.remote )
+        && ( record.timestamp <= first.timestamp );
+    } ) };
+
+  if ( request != records.rend() )
+  {
+    result.insert( result.begin(), *request );
+  }
+
+  return result;
+}
+
+void PacketCapture::start( std::shared_ptr< std::ostream > stream )
+{
+  if ( !stream )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Stream not provided" } );
+  }
+
+  const std::lock_guard lock{ mutexV };
+
+  streamV = std::move( stream );
+  streamV->write( FileMagic.data(), static_cast< std::streamsize >( FileMagic.size() ) );
+  enabledV = true;
+}
+
+void PacketCapture::stop()
+{
+  const std::lock_guard lock{ mutexV };
+
+  enabledV = false;
+
+  if ( streamV )
+  {
+    streamV->flush();
+    streamV.reset();
+  }
+}
+
+bool PacketCapture::enabled() const noexcept
+{
+  return enabledV.load( std::memory_order_relaxed );
+}
+
+void PacketCapture::record(
+  const CaptureRecord::Role role,
+  const CaptureRecord::Direction direction,
+  const uint32_t session,
+  const boost::asio::ip::udp::endpoint &remote,
+  Helper::ConstRawDataSpan packet ) noexcept
+{
+  if ( !enabled() )
+  {
+    return;
+  }
+
+  packet = packet.first( std::min< std::size_t >( packet.size(), std::numeric_limits< uint16_t >::max() ) );
+
+  const auto address{ remote.address().is_v4() ?
+    boost::asio::ip::make_address_v6( boost::asio::ip::v4_mapped, remote.address().to_v4() ) :
+    remote.address().to_v6() };
+  const auto addressBytes{ address.to_bytes() };
+
+  try
+  {
+    const std::lock_guard lock{ mutexV };
+
+    if ( !streamV )
+    {
+      return;
+    }
+
+    // time stamp taken within the lock, so the records are ordered
+    const auto timestamp{ std::chrono::duration_cast< std::chrono::nanoseconds >(
+      std::chrono::steady_clock::now().time_since_epoch() ).count() };
+
+    std::array< std::byte, RecordHeaderSize > header{};
+    Helper::RawDataSpan headerSpan{ header };
+    headerSpan = Helper::RawData_setInt( headerSpan, static_cast< uint64_t >( timestamp ) );
+    headerSpan = Helper::RawData_setInt( headerSpan, session );
+    headerSpan[ 0U ] = static_cast< std::byte >( role );
+    headerSpan[ 1U ] = static_cast< std::byte >( direction );
+    headerSpan = Helper::RawData_setInt( headerSpan.subspan( 2U ), remote.port() );
+    std::ranges::transform(
+      addressBytes,
+      headerSpan.begin(),
+      []( const unsigned char value ){ return static_cast< std::byte >( value ); } );
+    headerSpan = headerSpan.subspan( addressBytes.size() );
+    Helper::RawData_setInt( headerSpan, static_cast< uint16_t >( packet.size() ) );
+
+    streamV->write( reinterpret_cast< const char * >( header.data() ), header.size() );
+    streamV->write( reinterpret_cast< const char * >( packet.data() ), static_cast< std::streamsize >( packet.size() ) );
+
+    if ( !*streamV )
+    {
+      SPDLOG_ERROR( "Error writing packet capture - capture stopped" );
+      enabledV = false;
+      streamV.reset();
+    }
+  }
+  catch ( const std::exception &e )
+  {
+    SPDLOG_ERROR( "Error writing packet capture: {}", e.what() );
+  }
+}
+
+}
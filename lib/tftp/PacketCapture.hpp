@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::PacketCapture.
+ **/
+
+#ifndef TFTP_PACKETCAPTURE_HPP
+#define TFTP_PACKETCAPTURE_HPP
+
+#include <tftp/Tftp.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/asio/ip/udp.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Tftp {
+
+//! Captured Datagram
+struct TFTP_EXPORT CaptureRecord
+{
+  //! Role of the capturing Side
+  enum class Role : uint8_t
+  {
+    Client = 0U, //!< Captured by a client operation
+    Server = 1U  //!< Captured by the server or a server operation
+  };
+
+  //! Direction of the Datagram
+  enum class Direction : uint8_t
+  {
+    Transmit = 0U, //!< Sent by the capturing side
+    Receive  = 1U  //!< Received by the capturing side
+  };
+
+  //! Time Stamp (`std::chrono::steady_clock`) [ns]
+  uint64_t timestamp{ 0U };
+  //! Session Identifier (0: request received by the server)
+  uint32_t session{ 0U };
+  //! Role
+  Role role{ Role::Client };
+  //! Direction
+  Direction direction{ Direction::Transmit };
+  //! Remote Endpoint
+  boost::asio::ip::udp::endpoint remote;
+  //! Datagram
+  Helper::RawData packet;
+
+  /**
+   * @brief Returns, if the Datagram has been sent by the Client.
+   *
+   * @return If the datagram has been sent by the client.
+   **/
+  [[nodiscard]] bool sentByClient() const noexcept;
+};
+
+/**
+ * @brief Packet Capture.
+ *
+ * Records every datagram transmitted and received by the client and server operations together with a time stamp
+ * and the session identifier of the operation (see TraceRing::session()).
+ * Requests received by the server are recorded with session 0, as the operation does not exist yet.
+ *
+ * The capture is disabled by default.
+ * When it is disabled, recording costs a single atomic load.
+ * The records are written immediately to the stream given on start().
+ *
+ * The captured sessions can be replayed by `tftp_replay`.
+ *
+ * File format (integers in network byte order):
+ * - Header: @ref FileMagic
+ * - Records: time stamp (8 bytes), session (4 bytes), role (1 byte), direction (1 byte), remote port (2 bytes),
+ *   remote address (IPv6 or IPv4-mapped, 16 bytes), datagram length (2 bytes), datagram.
+ **/
+class TFTP_EXPORT PacketCapture final
+{
+  public:
+    //! File Magic of Captures
+    static constexpr std::string_view FileMagic{ "TFTPCAP1" };
+
+    /**
+     * @brief Returns the Process-wide Packet Capture.
+     *
+     * @return Packet Capture.
+     **/
+    [[nodiscard]] static PacketCapture& instance() noexcept;
+
+    /**
+     * @brief Loads a Capture.
+     *
+     * @param[in,out] stream
+     *   Binary input stream.
+     *
+     * @return Records.
+     *
+     * @throw TftpException
+     *   When the stream does not contain a valid capture.
+     **/
+    [[nodiscard]] static std::vector< CaptureRecord > read( std::istream &stream );
+
+    /**
+     * @brief Selects the Records of a Session.
+     *
+     * When the session has been captured by the server, the request preceding the session from the same client is
+     * added.
+     *
+     * @param[in] records
+     *   Records.
+     * @param[in] session
+     *   Session identifier.
+     *
+     * @return Records of the session (oldest first).
+     **/
+    [[nodiscard]] static std::vector< CaptureRecord > sessionRecords(
+      std::span< const CaptureRecord > records,
+      uint32_t session );
+
+    /**
+     * @brief Starts the Capture.
+     *
+     * @param[in] stream
+     *   Binary output stream.
+     *
+     * @throw TftpException
+     *   When @p stream is not provided.
+     **/
+    void start( std::shared_ptr< std::ostream > stream );
+
+    /**
+     * @brief Stops the Capture and flushes the Stream.
+     **/
+    void stop();
+
+    /**
+     * @brief Returns, if the Capture is active.
+     *
+     * @return If the capture is active.
+     **/
+    [[nodiscard]] bool enabled() const noexcept;
+
+    /**
+     * @brief Records a Datagram.
+     *
+     * Write errors stop the capture.
+     *
+     * @param[in] role
+     *   Role of the capturing side.
+     * @param[in] direction
+     *   Direction.
+     * @param[in] session
+     *   Session identifier.
+     * @param[in] remote
+     *   Remote endpoint.
+     * @param[in] packet
+     *   Datagram.
+     **/
+    void record(
+      CaptureRecord::Role role,
+      CaptureRecord::Direction direction,
+      uint32_t session,
+      const boost::asio::ip::udp::endpoint &remote,
+      Helper::ConstRawDataSpan packet ) noexcept;
+
+  private:
+    //! Capture is active
+    std::atomic< bool > enabledV{ false };
+    //! Protects the Stream
+    std::mutex mutexV;
+    //! Output Stream
+    std::shared_ptr< std::ostream > streamV;
+};
+
+}
+
+#endif
@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::PathMtu.
+ **/
+
+#include "PathMtu.hpp"
+
+#include <tftp/packets/Packets.hpp>
+
+#include <spdlog/spdlog.h>
+
+#if defined( __linux__ )
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+namespace Tftp {
+
+namespace {
+
+/**
+ * @brief Returns, if the Address is an IPv6 Address (IPv4-mapped addresses are IPv4).
+ *
+ * @param[in] address
+ *   Address.
+ *
+ * @return If @p address is an IPv6 address.
+ **/
+bool isIpv6( const boost::asio::ip::address &address )
+{
+  return address.is_v6() && !address.to_v6().is_v4_mapped();
+}
+
+}
+
+PathMtu& PathMtu::instance() noexcept
+{
+  static PathMtu pathMtu;
+  return pathMtu;
+}
+
+std::optional< uint16_t > PathMtu::query( const boost::asio::ip::udp::endpoint &remote ) noexcept
+{
+#if defined( __linux__ )
+  const auto ipv6{ remote.address().is_v6() };
+  const int fd{ ::socket( ipv6 ? AF_INET6 : AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0 ) };
+
+  if ( fd < 0 )
+  {
+    return {};
+  }
+
+  // don't fragment locally - the MTU reflects the discovered path MTU
+  const int discover{ ipv6 ? IPV6_PMTUDISC_DO : IP_PMTUDISC_DO };
+  int mtu{ 0 };
+  socklen_t mtuSize{ sizeof( mtu ) };
+
+  const auto result{
+    ( 0 == ::setsockopt(
+      fd,
+      ipv6 ? IPPROTO_IPV6 : IPPROTO_IP,
+      ipv6 ? IPV6_MTU_DISCOVER : IP_MTU_DISCOVER,
+      &discover,
+      sizeof( discover ) ) )
+    && ( 0 == ::connect( fd, remote.data(), static_cast< socklen_t >( remote.size() ) ) )
+    && ( 0 == ::getsockopt( fd, ipv6 ? IPPROTO_IPV6 : IPPROTO_IP, ipv6 ? IPV6_MTU : IP_MTU, &mtu, &mtuSize ) ) };
+
+  ::close( fd );
+
+  if ( !result || ( mtu <= 0 ) )
+  {
+    SPDLOG_DEBUG( "Path MTU query to {} failed", remote.address().to_string() );
+    return {};
+  }
+
+  return static_cast< uint16_t >( std::min( mtu, static_cast< int >( std::numeric_limits< uint16_t >::max() ) ) );
+#else
+  static_cast< void >( remote );
+  return {};
+#endif
+}
+
+uint16_t PathMtu::blockSize( const uint16_t mtu, const bool ipv6 ) noexcept
+{
+  const int overhead{
+    ( ipv6 ? Ipv6HeaderSize : Ipv4HeaderSize ) + UdpHeaderSize + Packets::DefaultTftpDataPacketHeaderSize };
+
+  return static_cast< uint16_t >( std::clamp(
+    static_cast< int >( mtu ) - overhead,
+    static_cast< int >( Packets::BlockSizeOptionMin ),
+    static_cast< int >( Packets::BlockSizeOptionMax ) ) );
+}
+
+std::optional< uint16_t > PathMtu::mtu( const boost::asio::ip::udp::endpoint &remote )
+{
+  return mtu( remote, Clock::now() );
+}
+
+std::optional< uint16_t > PathMtu::mtu( const boost::asio::ip::udp::endpoint &remote, const Clock::time_point now )
+{
+  std::unique_lock lock{ mutexV };
+
+  auto query{ queriesV.find( remote.address() ) };
+
+  if ( ( query == queriesV.end() ) || ( query->second.expiry <= now ) )
+  {
+    // query without holding the lock
+    lock.unlock();
+    const auto queried{ PathMtu::query( remote ) };
+    lock.lock();
+
+    if ( !queriesV.contains( remote.address() ) )
+    {
+      makeRoom( queriesV, now );
+    }
+
+    query = queriesV.insert_or_assign( remote.address(), Entry{ queried, now + QueryTtl } ).first;
+  }
+
+  auto mtu{ query->second.mtu };
+
+  if ( const auto fallback{ fallbacksV.find( remote.address() ) }; fallback != fallbacksV.end() )
+  {
+    if ( fallback->second.expiry <= now )
+    {
+      fallbacksV.erase( fallback );
+    }
+    else
+    {
+      mtu = std::min( mtu.value_or( *fallback->second.mtu ), *fallback->second.mtu );
+    }
+  }
+
+  return mtu;
+}
+
+std::optional< uint16_t > PathMtu::blockSize( const boost::asio::ip::udp::endpoint &remote )
+{
+  const auto pathMtu{ mtu( remote ) };
+
+  if ( !pathMtu )
+  {
+    return {};
+  }
+
+  return blockSize( *pathMtu, isIpv6( remote.address() ) );
+}
+
+void PathMtu::timeout( const boost::asio::ip::address &remote, const uint16_t blockSize )
+{
+  timeout( remote, blockSize, Clock::now() );
+}
+
+void PathMtu::timeout(
+  const boost::asio::ip::address &remote,
+  const uint16_t blockSize,
+  const Clock::time_point now )
+{
+  const auto ipv6{ isIpv6( remote ) };
+  const auto failedMtu{
+    static_cast< int >( blockSize )
+    + ( ipv6 ? Ipv6HeaderSize : Ipv4HeaderSize ) + UdpHeaderSize + Packets::DefaultTftpDataPacketHeaderSize };
+  const auto minimumMtu{ ipv6 ? Ipv6MinimumMtu : MtuPlateaus.back() };
+
+  // next plateau below the failed MTU
+  const auto plateau{ std::ranges::find_if(
+    MtuPlateaus,
+    [ failedMtu ]( const auto mtu ){ return static_cast< int >( mtu ) < failedMtu; } ) };
+
+  if ( ( plateau == MtuPlateaus.end() ) || ( *plateau < minimumMtu ) )
+  {
+    // block sizes below the minimum MTU are not reduced
+    return;
+  }
+
+  SPDLOG_INFO( "Path MTU of {} lowered to {}", remote.to_string(), *plateau );
+
+  std::lock_guard lock{ mutexV };
+
+  auto fallback{ fallbacksV.find( remote ) };
+
+  if ( ( fallback == fallbacksV.end() ) || ( fallback->second.expiry <= now ) )
+  {
+    if ( fallback == fallbacksV.end() )
+    {
+      makeRoom( fallbacksV, now );
+    }
+
+    fallbacksV.insert_or_assign( remote, Entry{ *plateau, now + FallbackTtl } );
+    return;
+  }
+
+  // a later timeout with a larger block size does not raise the fall-back
+  fallback->second.mtu = std::min( *fallback->second.mtu, *plateau );
+  fallback->second.expiry = now + FallbackTtl;
+}
+
+void PathMtu::reset()
+{
+  std::lock_guard lock{ mutexV };
+  queriesV.clear();
+  fallbacksV.clear();
+}
+
+void PathMtu::makeRoom( Entries &entries, const Clock::time_point now )
+{
+  if ( entries.size() < MaxRemotes )
+  {
+    return;
+  }
+
+  std::erase_if( entries, [ now ]( const auto &entry ){ return entry.second.expiry <= now; } );
+
+  if ( entries.size() >= MaxRemotes )
+  {
+    entries.clear();
+  }
+}
+
+}
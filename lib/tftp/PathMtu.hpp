@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::PathMtu.
+ **/
+
+#ifndef TFTP_PATHMTU_HPP
+#define TFTP_PATHMTU_HPP
+
+#include <tftp/Tftp.hpp>
+
+#include <boost/asio/ip/udp.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace Tftp {
+
+/**
+ * @brief Path MTU based Block Size Selection.
+ *
+ * Selects the largest TFTP block size, which DATA packets fit into one IP frame to the remote, so they are not
+ * fragmented.
+ * Fragmented DATA packets are lost completely, when one of their fragments is lost, which amplifies packet loss.
+ *
+ * The path MTU is queried from the IP stack (`IP_MTU` resp. `IPV6_MTU` of a connected socket with path MTU discovery
+ * enabled), which reports the MTU of the route or the discovered path MTU.
+ * Where the query is not supported, the path MTU is unknown.
+ * The queried path MTU is cached per remote for @ref QueryTtl, so not every transfer opens a probe socket.
+ *
+ * Paths, which drop large packets without reporting it (e.g. tunnels with filtered ICMP), are detected by
+ * timeouts:
+ * When a transfer with an automatically selected block size fails by timeout after the DATA phase has started,
+ * timeout() lowers the path MTU of the remote to the next smaller common MTU (plateau) for the following
+ * transfers.
+ * The lowered path MTU expires after @ref FallbackTtl, so a repaired path is used at full size again.
+ **/
+class TFTP_EXPORT PathMtu final
+{
+  public:
+    //! IPv4 Header Size (without options)
+    static constexpr uint16_t Ipv4HeaderSize{ 20U };
+    //! IPv6 Header Size (without extension headers)
+    static constexpr uint16_t Ipv6HeaderSize{ 40U };
+    //! UDP Header Size
+    static constexpr uint16_t UdpHeaderSize{ 8U };
+    //! Minimum IPv6 MTU
+    static constexpr uint16_t Ipv6MinimumMtu{ 1280U };
+    //! Common MTUs used as Fall-back (descending, RFC 1191 plateaus and common link MTUs)
+    static constexpr std::array< uint16_t, 9U > MtuPlateaus{
+      9000U, 8166U, 4352U, 2002U, 1500U, 1492U, 1280U, 1006U, 576U };
+    //! Maximum Number of remembered Remotes (the expired entries are removed, when exceeded)
+    static constexpr std::size_t MaxRemotes{ 4096U };
+    //! Clock used for the Expiry of the cached Path MTUs
+    using Clock = std::chrono::steady_clock;
+    //! Time to Live of a queried Path MTU
+    static constexpr std::chrono::seconds QueryTtl{ 60 };
+    //! Time to Live of a lowered Path MTU (like the path MTU expiry of the Linux IP stack)
+    static constexpr std::chrono::seconds FallbackTtl{ 600 };
+
+    /**
+     * @brief Returns the Process-wide Path MTU Cache.
+     *
+     * @return Path MTU Cache.
+     **/
+    [[nodiscard]] static PathMtu& instance() noexcept;
+
+    /**
+     * @brief Queries the Path MTU from the IP Stack.
+     *
+     * @param[in] remote
+     *   Remote endpoint.
+     *
+     * @return Path MTU.
+     * @retval {}
+     *   If the query is not supported or failed.
+     **/
+    [[nodiscard]] static std::optional< uint16_t > query( const boost::asio::ip::udp::endpoint &remote ) noexcept;
+
+    /**
+     * @brief Returns the largest Block Size, which DATA packets fit into the MTU.
+     *
+     * @param[in] mtu
+     *   MTU.
+     * @param[in] ipv6
+     *   If the path is IPv6.
+     *
+     * @return Block size limited to the valid block size option range.
+     **/
+    [[nodiscard]] static uint16_t blockSize( uint16_t mtu, bool ipv6 ) noexcept;
+
+    /**
+     * @brief Returns the Path MTU to the Remote.
+     *
+     * The queried MTU is limited by the fall-back of the remote.
+     *
+     * @param[in] remote
+     *   Remote endpoint.
+     *
+     * @return Path MTU.
+     * @retval {}
+     *   If the path MTU is unknown.
+     **/
+    [[nodiscard]] std::optional< uint16_t > mtu( const boost::asio::ip::udp::endpoint &remote );
+
+    /**
+     * @copydoc mtu(const boost::asio::ip::udp::endpoint&)
+     *
+     * @param[in] now
+     *   Current time point.
+     **/
+    [[nodiscard]] std::optional< uint16_t > mtu( const boost::asio::ip::udp::endpoint &remote, Clock::time_point now );
+
+    /**
+     * @brief Returns the largest Block Size for the Remote.
+     *
+     * @param[in] remote
+     *   Remote endpoint.
+     *
+     * @return Block size.
+     * @retval {}
+     *   If the path MTU is unknown.
+     **/
+    [[nodiscard]] std::optional< uint16_t > blockSize( const boost::asio::ip::udp::endpoint &remote );
+
+    /**
+     * @brief Informs about a Transfer, which failed by Timeout.
+     *
+     * Lowers the path MTU of the remote to the next plateau below the MTU, which corresponds to @p blockSize.
+     *
+     * @param[in] remote
+     *   Remote address.
+     * @param[in] blockSize
+     *   Block size of the failed transfer.
+     **/
+    void timeout( const boost::asio::ip::address &remote, uint16_t blockSize );
+
+    /**
+     * @copydoc timeout(const boost::asio::ip::address&,uint16_t)
+     *
+     * @param[in] now
+     *   Current time point.
+     **/
+    void timeout( const boost::asio::ip::address &remote, uint16_t blockSize, Clock::time_point now );
+
+    /**
+     * @brief Forgets all cached Path MTUs and Fall-backs.
+     **/
+    void reset();
+
+  private:
+    //! Cached Path MTU
+    struct Entry
+    {
+      //! Path MTU (unknown, if not set)
+      std::optional< uint16_t > mtu;
+      //! Time point, when the entry expires
+      Clock::time_point expiry;
+    };
+
+    //! Cached Path MTUs per Remote
+    using Entries = std::map< boost::asio::ip::address, Entry >;
+
+    /**
+     * @brief Makes Room for a new Entry.
+     *
+     * When the map is full, the expired entries are removed.
+     * When no entry is expired, all entries are removed.
+     *
+     * @param[in,out] entries
+     *   Cached Path MTUs.
+     * @param[in] now
+     *   Current time point.
+     **/
+    static void makeRoom( Entries &entries, Clock::time_point now );
+
+    //! Protects the cached Path MTUs
+    std::mutex mutexV;
+    //! Queried Path MTU per Remote
+    Entries queriesV;
+    //! Lowered Path MTU per Remote
+    Entries fallbacksV;
+};
+
+}
+
+#endif
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::ReceiveBuffer.
+ **/
+
+#ifndef TFTP_RECEIVEBUFFER_HPP
+#define TFTP_RECEIVEBUFFER_HPP
+
+#include <tftp/Tftp.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <cstddef>
+
+namespace Tftp {
+
+/**
+ * @brief Per-Thread Receive Buffer.
+ *
+ * TFTP operations do not hold their own receive buffer.
+ * Instead, they wait for the readability of their socket (`async_wait`) and read the datagram synchronously into the
+ * buffer of the current thread.
+ * The received packet is handed to the operation as span and must be decoded before the next receive on this thread.
+ *
+ * Thus, the memory of an idle operation does not depend on the negotiated block size and the receive size does not
+ * need to follow the option negotiation.
+ **/
+class TFTP_EXPORT ReceiveBuffer final
+{
+  public:
+    //! Size of the Receive Buffer (maximum UDP payload)
+    static constexpr std::size_t Size{ 65535U };
+
+    /**
+     * @brief Returns the Receive Buffer of the current Thread.
+     *
+     * The buffer always covers the maximum UDP payload, so datagrams are never truncated, regardless of the negotiated
+     * block size or the size of the option list.
+     * Oversized packets are rejected by the decoding operation instead.
+     *
+     * @return Receive Buffer of @ref Size bytes.
+     **/
+    [[nodiscard]] static Helper::RawDataSpan instance();
+};
+
+}
+
+#endif
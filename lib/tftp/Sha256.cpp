@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Sha256.
+ **/
+
+#include "Sha256.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined( __x86_64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define TFTP_SHA256_SHANI
+#include <immintrin.h>
+#endif
+
+namespace Tftp {
+
+namespace {
+
+//! Round Constants
+constexpr std::array< uint32_t, 64U > RoundConstants{
+  0x428A'2F98U, 0x7137'4491U, 0xB5C0'FBCFU, 0xE9B5'DBA5U, 0x3956'C25BU, 0x59F1'11F1U, 0x923F'82A4U, 0xAB1C'5ED5U,
+  0xD807'AA98U, 0x1283'5B01U, 0x2431'85BEU, 0x550C'7DC3U, 0x72BE'5D74U, 0x80DE'B1FEU, 0x9BDC'06A7U, 0xC19B'F174U,
+  0xE49B'69C1U, 0xEFBE'4786U, 0x0FC1'9DC6U, 0x240C'A1CCU, 0x2DE9'2C6FU, 0x4A74'84AAU, 0x5CB0'A9DCU, 0x76F9'88DAU,
+  0x983E'5152U, 0xA831'C66DU, 0xB003'27C8U, 0xBF59'7FC7U, 0xC6E0'0BF3U, 0xD5A7'9147U, 0x06CA'6351U, 0x1429'2967U,
+  0x27B7'0A85U, 0x2E1B'2138U, 0x4D2C'6DFCU, 0x5338'0D13U, 0x650A'7354U, 0x766A'0ABBU, 0x81C2'C92EU, 0x9272'2C85U,
+  0xA2BF'E8A1U, 0xA81A'664BU, 0xC24B'8B70U, 0xC76C'51A3U, 0xD192'E819U, 0xD699'0624U, 0xF40E'3585U, 0x106A'A070U,
+  0x19A4'C116U, 0x1E37'6C08U, 0x2748'774CU, 0x34B0'BCB5U, 0x391C'0CB3U, 0x4ED8'AA4AU, 0x5B9C'CA4FU, 0x682E'6FF3U,
+  0x748F'82EEU, 0x78A5'636FU, 0x84C8'7814U, 0x8CC7'0208U, 0x90BE'FFFAU, 0xA450'6CEBU, 0xBEF9'A3F7U, 0xC671'78F2U };
+
+/**
+ * @brief Loads a big endian Word.
+ *
+ * @param[in] data
+ *   Data (4 bytes).
+ *
+ * @return Word
+ **/
+constexpr uint32_t loadBigEndian( const std::byte * const data ) noexcept
+{
+  return ( std::to_integer< uint32_t >( data[ 0 ] ) << 24U )
+    | ( std::to_integer< uint32_t >( data[ 1 ] ) << 16U )
+    | ( std::to_integer< uint32_t >( data[ 2 ] ) << 8U )
+    | std::to_integer< uint32_t >( data[ 3 ] );
+}
+
+/**
+ * @brief Portable Implementation.
+ *
+ * @param[in,out] state
+ *   Hash state.
+ * @param[in] block
+ *   Data block of 64 bytes.
+ **/
+void transformSoftware( std::array< uint32_t, 8U > &state, const std::byte * const block ) noexcept
+{
+  std::array< uint32_t, 64U > schedule{};
+
+  for ( std::size_t index{ 0U }; index < 16U; ++index )
+  {
+    schedule[ index ] = loadBigEndian( block + 4U * index );
+  }
+
+  for ( std::size_t index{ 16U }; index < schedule.size(); ++index )
+  {
+    const auto w15{ schedule[ index - 15U ] };
+    const auto w2{ schedule[ index - 2U ] };
+    const auto s0{ std::rotr( w15, 7 ) ^ std::rotr( w15, 18 ) ^ ( w15 >> 3U ) };
+    const auto s1{ std::rotr( w2, 17 ) ^ std::rotr( w2, 19 ) ^ ( w2 >> 10U ) };
+    schedule[ index ] = schedule[ index - 16U ] + s0 + schedule[ index - 7U ] + s1;
+  }
+
+  auto [ a, b, c, d, e, f, g, h ]{ state };
+
+  for ( std::size_t index{ 0U }; index < schedule.size(); ++index )
+  {
+    const auto s1{ std::rotr( e, 6 ) ^ std::rotr( e, 11 ) ^ std::rotr( e, 25 ) };
+    const auto choice{ ( e & f ) ^ ( ~e & g ) };
+    const auto temp1{ h + s1 + choice + RoundConstants[ index ] + schedule[ index ] };
+    const auto s0{ std::rotr( a, 2 ) ^ std::rotr( a, 13 ) ^ std::rotr( a, 22 ) };
+    const auto majority{ ( a & b ) ^ ( a & c ) ^ ( b & c ) };
+    const auto temp2{ s0 + majority };
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+
+  state[ 0 ] += a;
+  state[ 1 ] += b;
+  state[ 2 ] += c;
+  state[ 3 ] += d;
+  state[ 4 ] += e;
+  state[ 5 ] += f;
+  state[ 6 ] += g;
+  state[ 7 ] += h;
+}
+
+#if defined( TFTP_SHA256_SHANI )
+/**
+ * @brief SHA-NI Implementation.
+ *
+ * @param[in,out] state
+ *   Hash state.
+ * @param[in] block
+ *   Data block of 64 bytes.
+ **/
+__attribute__(( target( "sha,sse4.1" ) ))
+void transformHardware( std::array< uint32_t, 8U > &state, const std::byte * const block ) noexcept
+{
+  // NOLINTBEGIN( cppcoreguidelines-pro-type-reinterpret-cast ): unaligned SIMD loads and stores
+  const auto byteSwap{ _mm_set_epi64x( 0x0C0D'0E0F'0809'0A0BLL, 0x0405'0607'0001'0203LL ) };
+
+  // the instructions use the state as ABEF and CDGH
+  const auto dcba{ _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast< const __m128i * >( &state[ 0 ] ) ), 0xB1 ) };
+  const auto efgh{ _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast< const __m128i * >( &state[ 4 ] ) ), 0x1B ) };
+  auto abef{ _mm_alignr_epi8( dcba, efgh, 8 ) };
+  auto cdgh{ _mm_blend_epi16( efgh, dcba, 0xF0 ) };
+  const auto previousAbef{ abef };
+  const auto previousCdgh{ cdgh };
+
+  // std::array would drop the alignment attribute of the vector type
+  __m128i messages[ 4U ]; // NOLINT( *-avoid-c-arrays )
+
+  for ( std::size_t index{ 0U }; index < std::size( messages ); ++index )
+  {
+    messages[ index ] = _mm_shuffle_epi8(
+      _mm_loadu_si128( reinterpret_cast< const __m128i * >( block + 16U * index ) ),
+      byteSwap );
+  }
+
+  // four rounds per group
+  for ( std::size_t group{ 0U }; group < 16U; ++group )
+  {
+    auto &message{ messages[ group % 4U ] };
+
+    // schedule W[t..t+3] from W[t-16..t-1]
+    if ( group >= 4U )
+    {
+      const auto &message12{ messages[ ( group + 1U ) % 4U ] };
+      const auto &message8{ messages[ ( group + 2U ) % 4U ] };
+      const auto &message4{ messages[ ( group + 3U ) % 4U ] };
+      message = _mm_sha256msg2_epu32(
+        _mm_add_epi32( _mm_sha256msg1_epu32( message, message12 ), _mm_alignr_epi8( message4, message8, 4 ) ),
+        message4 );
+    }
+
+    const auto value{ _mm_add_epi32(
+      message,
+      _mm_loadu_si128( reinterpret_cast< const __m128i * >( &RoundConstants[ 4U * group ] ) ) ) };
+    cdgh = _mm_sha256rnds2_epu32( cdgh, abef, value );
+    abef = _mm_sha256rnds2_epu32( abef, cdgh, _mm_shuffle_epi32( value, 0x0E ) );
+  }
+
+  abef = _mm_add_epi32( abef, previousAbef );
+  cdgh = _mm_add_epi32( cdgh, previousCdgh );
+
+  const auto feba{ _mm_shuffle_epi32( abef, 0x1B ) };
+  const auto dchg{ _mm_shuffle_epi32( cdgh, 0xB1 ) };
+  _mm_storeu_si128( reinterpret_cast< __m128i * >( &state[ 0 ] ), _mm_blend_epi16( feba, dchg, 0xF0 ) );
+  _mm_storeu_si128( reinterpret_cast< __m128i * >( &state[ 4 ] ), _mm_alignr_epi8( dchg, feba, 8 ) );
+  // NOLINTEND( cppcoreguidelines-pro-type-reinterpret-cast )
+}
+
+//! SHA extensions and SSE 4.1 are supported by the CPU
+const bool HardwareSupport{
+  ( 0 != __builtin_cpu_supports( "sha" ) ) && ( 0 != __builtin_cpu_supports( "sse4.1" ) ) };
+#endif
+
+}
+
+bool Sha256::hardwareAccelerated() noexcept
+{
+#if defined( TFTP_SHA256_SHANI )
+  return HardwareSupport;
+#else
+  return false;
+#endif
+}
+
+void Sha256::update( Helper::ConstRawDataSpan data ) noexcept
+{
+  sizeV += data.size();
+
+  // complete the partial block
+  if ( 0U != blockSizeV )
+  {
+    const auto size{ std::min( BlockSize - blockSizeV, data.size() ) };
+    std::ranges::copy( data.first( size ), blockV.begin() + static_cast< std::ptrdiff_t >( blockSizeV ) );
+    blockSizeV += size;
+    data = data.subspan( size );
+
+    if ( BlockSize != blockSizeV )
+    {
+      return;
+    }
+
+    transform( blockV.data() );
+    blockSizeV = 0U;
+  }
+
+  // complete blocks are processed in place
+  while ( data.size() >= BlockSize )
+  {
+    transform( data.data() );
+    data = data.subspan( BlockSize );
+  }
+
+  std::ranges::copy( data, blockV.begin() );
+  blockSizeV = data.size();
+}
+
+Sha256::Digest Sha256::value() const noexcept
+{
+  auto sha256{ *this };
+
+  // padding: 0x80, zeros, and the message length in bits (big endian)
+  const auto bitSize{ sizeV * 8U };
+  sha256.blockV[ sha256.blockSizeV++ ] = std::byte{ 0x80U };
+
+  if ( sha256.blockSizeV > BlockSize - sizeof( uint64_t ) )
+  {
+    std::fill(
+      sha256.blockV.begin() + static_cast< std::ptrdiff_t >( sha256.blockSizeV ),
+      sha256.blockV.end(),
+      std::byte{} );
+    sha256.transform( sha256.blockV.data() );
+    sha256.blockSizeV = 0U;
+  }
+
+  std::fill(
+    sha256.blockV.begin() + static_cast< std::ptrdiff_t >( sha256.blockSizeV ),
+    sha256.blockV.end() - sizeof( uint64_t ),
+    std::byte{} );
+
+  for ( std::size_t index{ 0U }; index < sizeof( uint64_t ); ++index )
+  {
+    sha256.blockV[ BlockSize - 1U - index ] = static_cast< std::byte >( bitSize >> ( 8U * index ) );
+  }
+
+  sha256.transform( sha256.blockV.data() );
+
+  Digest digest{};
+
+  for ( std::size_t index{ 0U }; index < digest.size(); ++index )
+  {
+    digest[ index ] = static_cast< std::byte >( sha256.stateV[ index / 4U ] >> ( 24U - 8U * ( index % 4U ) ) );
+  }
+
+  return digest;
+}
+
+void Sha256::reset() noexcept
+{
+  stateV = InitialState;
+  blockSizeV = 0U;
+  sizeV = 0U;
+}
+
+void Sha256::transform( const std::byte * const block ) noexcept
+{
+#if defined( TFTP_SHA256_SHANI )
+  if ( HardwareSupport )
+  {
+    transformHardware( stateV, block );
+    return;
+  }
+#endif
+
+  transformSoftware( stateV, block );
+}
+
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Sha256.
+ **/
+
+#ifndef TFTP_SHA256_HPP
+#define TFTP_SHA256_HPP
+
+#include <tftp/Tftp.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Tftp {
+
+/**
+ * @brief Incremental SHA-256 Calculation (FIPS 180-4).
+ *
+ * On x86-64, the SHA extensions are used, when supported by the CPU.
+ **/
+class TFTP_EXPORT Sha256 final
+{
+  public:
+    //! Digest Size in Bytes
+    static constexpr std::size_t DigestSize{ 32U };
+
+    //! SHA-256 Digest
+    using Digest = std::array< std::byte, DigestSize >;
+
+    /**
+     * @brief Returns if the Hardware Implementation is used.
+     *
+     * @return If the SHA extensions are used.
+     **/
+    [[nodiscard]] static bool hardwareAccelerated() noexcept;
+
+    /**
+     * @brief Adds @p data to the Digest.
+     *
+     * @param[in] data
+     *   Data.
+     **/
+    void update( Helper::ConstRawDataSpan data ) noexcept;
+
+    /**
+     * @brief Returns the Digest of the Data added so far.
+     *
+     * The calculation can be continued afterwards.
+     *
+     * @return SHA-256 Digest.
+     **/
+    [[nodiscard]] Digest value() const noexcept;
+
+    //! Restarts the Calculation.
+    void reset() noexcept;
+
+  private:
+    //! Block Size in Bytes
+    static constexpr std::size_t BlockSize{ 64U };
+
+    //! Initial Hash Value
+    static constexpr std::array< uint32_t, 8U > InitialState{
+      0x6A09'E667U, 0xBB67'AE85U, 0x3C6E'F372U, 0xA54F'F53AU, 0x510E'527FU, 0x9B05'688CU, 0x1F83'D9ABU, 0x5BE0'CD19U };
+
+    /**
+     * @brief Processes a complete Block.
+     *
+     * @param[in] block
+     *   Data block of BlockSize bytes.
+     **/
+    void transform( const std::byte * block ) noexcept;
+
+    //! Hash State
+    std::array< uint32_t, 8U > stateV{ InitialState };
+    //! Partial Block
+    std::array< std::byte, BlockSize > blockV{};
+    //! Number of Bytes within the partial Block
+    std::size_t blockSizeV{ 0U };
+    //! Total Number of processed Bytes
+    uint64_t sizeV{ 0U };
+};
+
+}
+
+#endif
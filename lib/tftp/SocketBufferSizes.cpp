@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::SocketBufferSizes.
+ **/
+
+#include "SocketBufferSizes.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <string_view>
+
+namespace Tftp {
+
+namespace {
+
+/**
+ * @brief Sets a Socket Buffer Size Option and checks the effective Size.
+ *
+ * The sizes are applied to the socket of every operation.
+ * Therefore, a problem is only warned once per option and requested size - further occurrences are logged at debug
+ * level.
+ *
+ * @tparam Option
+ *   Socket option type (`receive_buffer_size` or `send_buffer_size`).
+ * @param[in,out] socket
+ *   Opened socket.
+ * @param[in] name
+ *   Name of the option (for logging).
+ * @param[in] size
+ *   Requested size in bytes.
+ **/
+template< typename Option >
+void applyBufferSize(
+  boost::asio::ip::udp::socket &socket,
+  const std::string_view name,
+  const int size ) noexcept
+{
+  // requested size, which has already been warned
+  static std::atomic< int > warnedSize{ 0 };
+
+  boost::system::error_code errorCode;
+
+  socket.set_option( Option{ size }, errorCode );
+
+  if ( errorCode )
+  {
+    if ( warnedSize.exchange( size ) != size )
+    {
+      SPDLOG_WARN( "Setting {} to {} failed: {}", name, size, errorCode.message() );
+    }
+    else
+    {
+      SPDLOG_DEBUG( "Setting {} to {} failed: {}", name, size, errorCode.message() );
+    }
+
+    return;
+  }
+
+  Option option{};
+  socket.get_option( option, errorCode );
+
+  // Linux reports the doubled size (including bookkeeping overhead)
+  if ( !errorCode && ( option.value() < size ) )
+  {
+    if ( warnedSize.exchange( size ) != size )
+    {
+      SPDLOG_WARN( "{} limited by the IP stack to {} (requested {})", name, option.value(), size );
+    }
+    else
+    {
+      SPDLOG_DEBUG( "{} limited by the IP stack to {} (requested {})", name, option.value(), size );
+    }
+  }
+}
+
+}
+
+void SocketBufferSizes::apply( boost::asio::ip::udp::socket &socket ) const noexcept
+{
+  if ( receive )
+  {
+    applyBufferSize< boost::asio::socket_base::receive_buffer_size >( socket, "SO_RCVBUF", *receive );
+  }
+
+  if ( send )
+  {
+    applyBufferSize< boost::asio::socket_base::send_buffer_size >( socket, "SO_SNDBUF", *send );
+  }
+}
+
+}
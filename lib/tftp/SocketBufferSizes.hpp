@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::SocketBufferSizes.
+ **/
+
+#ifndef TFTP_SOCKETBUFFERSIZES_HPP
+#define TFTP_SOCKETBUFFERSIZES_HPP
+
+#include <tftp/Tftp.hpp>
+
+#include <boost/asio/ip/udp.hpp>
+
+#include <optional>
+
+namespace Tftp {
+
+/**
+ * @brief Kernel Socket Buffer Sizes (`SO_RCVBUF`, `SO_SNDBUF`).
+ *
+ * Large block sizes and bursts of DATA packets can exceed the default kernel receive buffer, which drops the
+ * datagrams before they are read.
+ * Unset sizes keep the default of the IP stack.
+ **/
+struct TFTP_EXPORT SocketBufferSizes
+{
+  //! Receive Buffer Size in Bytes (`SO_RCVBUF`)
+  std::optional< int > receive;
+  //! Send Buffer Size in Bytes (`SO_SNDBUF`)
+  std::optional< int > send;
+
+  /**
+   * @brief Applies the Buffer Sizes to the Socket.
+   *
+   * Failures are logged and ignored, as the socket is still usable with the default sizes.
+   * When the IP stack limits a buffer to a smaller size (e.g. `net.core.rmem_max`), a warning is logged once per
+   * requested size.
+   *
+   * @param[in,out] socket
+   *   Opened socket.
+   **/
+  void apply( boost::asio::ip::udp::socket &socket ) const noexcept;
+};
+
+}
+
+#endif
@@ -118,6 +118,7 @@ constexpr uint16_t DefaultTftpRetries{ 1U };
 // Forward declarations
 class TftpConfiguration;
 class TftpOptionsConfiguration;
+struct SocketBufferSizes;
 
 class DataHandler;
 class ReceiveDataHandler;
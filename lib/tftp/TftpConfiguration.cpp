@@ -37,6 +37,7 @@ TftpConfiguration& TftpConfiguration::operator=( const TftpConfiguration &other
   tftpRetries = other.tftpRetries;
   tftpServerPort = other.tftpServerPort;
   dally = other.dally;
+  socketBufferSizes = other.socketBufferSizes;
 
   return *this;
 }
@@ -47,6 +48,7 @@ TftpConfiguration& TftpConfiguration::operator=( TftpConfiguration &&other ) noe
   tftpRetries = other.tftpRetries;
   tftpServerPort = other.tftpServerPort;
   dally = other.dally;
+  socketBufferSizes = other.socketBufferSizes;
 
   return *this;
 }
@@ -64,6 +66,16 @@ void TftpConfiguration::fromProperties( const boost::property_tree::ptree &prope
   tftpRetries = properties.get( "retries", tftpRetries ) ;
   tftpServerPort = properties.get( "port", defaultTftpPort );
   dally = properties.get( "dally", dally ) ;
+
+  if ( const auto receiveBufferSize{ properties.get_optional< int >( "receive_buffer_size" ) }; receiveBufferSize )
+  {
+    socketBufferSizes.receive = *receiveBufferSize;
+  }
+
+  if ( const auto sendBufferSize{ properties.get_optional< int >( "send_buffer_size" ) }; sendBufferSize )
+  {
+    socketBufferSizes.send = *sendBufferSize;
+  }
 }
 
 boost::property_tree::ptree TftpConfiguration::toProperties( const bool full ) const
@@ -90,6 +102,16 @@ boost::property_tree::ptree TftpConfiguration::toProperties( const bool full ) c
     properties.add( "dally", dally );
   }
 
+  if ( socketBufferSizes.receive )
+  {
+    properties.add( "receive_buffer_size", *socketBufferSizes.receive );
+  }
+
+  if ( socketBufferSizes.send )
+  {
+    properties.add( "send_buffer_size", *socketBufferSizes.send );
+  }
+
   return properties;
 }
 
@@ -122,6 +144,29 @@ boost::program_options::options_description TftpConfiguration::options()
       ->value_name( "true|false" ),
     "TFTP dally option.\n"
     "Wait when last ACK has been sent to prevent aborts on last ACK miss."
+  )
+  (
+    "receive-buffer-size",
+    boost::program_options::value< int >()
+      ->value_name( "bytes" )
+      ->notifier(
+        [ this ]( const auto size )
+        {
+          socketBufferSizes.receive = size;
+        } ),
+    "Kernel socket receive buffer size (SO_RCVBUF) in bytes.\n"
+    "Increase for large block sizes to prevent packet drops."
+  )
+  (
+    "send-buffer-size",
+    boost::program_options::value< int >()
+      ->value_name( "bytes" )
+      ->notifier(
+        [ this ]( const auto size )
+        {
+          socketBufferSizes.send = size;
+        } ),
+    "Kernel socket send buffer size (SO_SNDBUF) in bytes."
   );
 
   return options;
@@ -14,6 +14,7 @@
 #define TFTP_TFTPCONFIGURATION_HPP
 
 #include <tftp/Tftp.hpp>
+#include <tftp/SocketBufferSizes.hpp>
 
 #include <boost/property_tree/ptree_fwd.hpp>
 
@@ -103,6 +104,9 @@ class TFTP_EXPORT TftpConfiguration
     //! Dally Option
     bool dally{ false };
 
+    //! Socket Buffer Sizes (`SO_RCVBUF`, `SO_SNDBUF`)
+    SocketBufferSizes socketBufferSizes;
+
   private:
     /**
      * @brief Default TFTP Port (can be overridden by configuration).
@@ -27,6 +27,7 @@ void TftpOptionsConfiguration::fromProperties( const boost::property_tree::ptree
 {
   handleTransferSizeOption = properties.get( "transfer_size", handleTransferSizeOption );
   blockSizeOption = properties.get_optional< uint16_t>( "block_size" );
+  blockSizeAutomatic = properties.get( "block_size_automatic", blockSizeAutomatic );
   // convert to std::chrono (is similar to std::optional::transform)
   timeoutOption =
     properties.get_optional< std::chrono::seconds::rep >( "timeout" )
@@ -51,6 +52,11 @@ boost::property_tree::ptree TftpOptionsConfiguration::toProperties( const bool f
     properties.add( "block_size", blockSizeOption );
   }
 
+  if ( full || blockSizeAutomatic )
+  {
+    properties.add( "block_size_automatic", blockSizeAutomatic );
+  }
+
   if ( full || timeoutOption )
   {
     // like std::optional::transform
@@ -78,6 +84,13 @@ boost::program_options::options_description TftpOptionsConfiguration::options()
       ->implicit_value( Packets::BlockSizeOptionDefault ),
     "Negotiates the TFTP block size for transfers."
   )
+  (
+    "block-size-automatic",
+    boost::program_options::value( &blockSizeAutomatic )
+      ->implicit_value( true, "true" )
+      ->value_name( "true|false" ),
+    "Negotiates the largest TFTP block size, which fits into the path MTU (limited by the block size option)."
+  )
   (
     "timeout-option,i",
     boost::program_options::value< std::chrono::seconds::rep >()
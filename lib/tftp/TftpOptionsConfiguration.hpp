@@ -36,6 +36,8 @@ namespace Tftp {
  * - timeout option (RFC 2349)
  * - transfer size option (RFC 2349)
  *
+ * The block size can be selected automatically by the path MTU to the remote (see PathMtu).
+ *
  * @sa TftpConfiguration
  **/
 class TFTP_EXPORT TftpOptionsConfiguration
@@ -85,6 +87,15 @@ class TFTP_EXPORT TftpOptionsConfiguration
     //! If set, this value is used for option negotiation
     boost::optional< uint16_t > blockSizeOption;
 
+    /**
+     * @brief If set, the block size option is selected by the path MTU.
+     *
+     * The largest block size, which DATA packets fit into one frame to the remote, is negotiated.
+     * When @ref blockSizeOption is set, it limits the selected block size.
+     * When the path MTU is unknown, @ref blockSizeOption is used.
+     **/
+    bool blockSizeAutomatic{ false };
+
     //! If set, this value is used for option negotiation
     boost::optional< std::chrono::seconds > timeoutOption;
 };
@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::TimerWheel.
+ **/
+
+#include "TimerWheel.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace Tftp {
+
+/**
+ * @brief I/O context Service, which owns the Timer Wheel.
+ *
+ * The timer wheel is destroyed together with the I/O context.
+ **/
+class TimerWheel::Service final : public boost::asio::execution_context::service
+{
+  public:
+    //! Service Identification
+    static boost::asio::execution_context::id id;
+
+    /**
+     * @brief Creates the Service.
+     *
+     * @param[in] ioContext
+     *   I/O context owning the service.
+     **/
+    explicit Service( boost::asio::io_context &ioContext ) :
+      boost::asio::execution_context::service{ ioContext },
+      timerWheelV{ ioContext }
+    {
+    }
+
+    /**
+     * @brief Returns the Timer Wheel.
+     *
+     * @return Timer Wheel.
+     **/
+    TimerWheel& timerWheel() noexcept
+    {
+      return timerWheelV;
+    }
+
+  private:
+    //! Stops the Timer Wheel
+    void shutdown() override
+    {
+      timerWheelV.timerV.cancel();
+    }
+
+    //! Timer Wheel
+    TimerWheel timerWheelV;
+};
+
+boost::asio::execution_context::id TimerWheel::Service::id;
+
+TimerWheel::Timer::Timer( TimerWheel &timerWheel ) noexcept :
+  timerWheelV{ timerWheel }
+{
+}
+
+TimerWheel::Timer::Timer( boost::asio::io_context &ioContext ) :
+  timerWheelV{ TimerWheel::instance( ioContext ) }
+{
+}
+
+TimerWheel::Timer::~Timer() noexcept
+{
+  cancel();
+}
+
+void TimerWheel::Timer::expiresAfter( const Clock::duration duration, Handler handler )
+{
+  timerWheelV.checkThread();
+
+  cancel();
+
+  handlerV = std::move( handler );
+
+  const auto now{ Clock::now() };
+
+  // an empty wheel has nothing to process - skip idle ticks
+  if ( 0U == timerWheelV.sizeV )
+  {
+    timerWheelV.currentTickV = std::max(
+      timerWheelV.currentTickV,
+      static_cast< uint64_t >( ( now - timerWheelV.originV ) / Resolution ) );
+  }
+
+  expiryTickV = std::max( timerWheelV.tick( now + duration ), timerWheelV.currentTickV + 1U );
+
+  timerWheelV.link( *this );
+  ++timerWheelV.sizeV;
+
+  // wake up earlier, if required
+  if ( !timerWheelV.waitTickV || ( expiryTickV < *timerWheelV.waitTickV ) )
+  {
+    timerWheelV.wait();
+  }
+}
+
+void TimerWheel::Timer::cancel() noexcept
+{
+  if ( nullptr == slotV )
+  {
+    return;
+  }
+
+  timerWheelV.checkThread();
+
+  TimerWheel::unlink( *this );
+  --timerWheelV.sizeV;
+  handlerV = {};
+}
+
+bool TimerWheel::Timer::armed() const noexcept
+{
+  return nullptr != slotV;
+}
+
+TimerWheel& TimerWheel::instance( boost::asio::io_context &ioContext )
+{
+  return boost::asio::use_service< Service >( ioContext ).timerWheel();
+}
+
+TimerWheel::TimerWheel( boost::asio::io_context &ioContext ) :
+  ioContextV{ ioContext },
+  timerV{ ioContext },
+  originV{ Clock::now() }
+{
+}
+
+TimerWheel::~TimerWheel() noexcept
+{
+  // detach remaining timers - they are not called anymore
+  for ( auto * const level : { level0V.data(), level1V.data(), level2V.data() } )
+  {
+    const auto slots{ ( level == level0V.data() ) ? Level0Slots : LevelSlots };
+
+    for ( std::size_t slot{ 0U }; slot < slots; ++slot )
+    {
+      while ( nullptr != level[ slot ] )
+      {
+        unlink( *level[ slot ] );
+      }
+    }
+  }
+}
+
+std::size_t TimerWheel::size() const noexcept
+{
+  return sizeV;
+}
+
+void TimerWheel::checkThread() noexcept
+{
+  if ( !ioContextV.get_executor().running_in_this_thread() )
+  {
+    return;
+  }
+
+  const auto thisThread{ std::this_thread::get_id() };
+  auto runThread{ std::thread::id{} };
+
+  // the first thread running a handler becomes the owner
+  if ( !runThreadV.compare_exchange_strong( runThread, thisThread ) )
+  {
+    assert( ( runThread == thisThread ) && "The I/O context of a timer wheel must be run by a single thread" );
+  }
+}
+
+uint64_t TimerWheel::tick( const Clock::time_point timePoint ) const noexcept
+{
+  const auto elapsed{ std::max( timePoint - originV, Clock::duration::zero() ) };
+  const auto resolution{ std::chrono::duration_cast< Clock::duration >( Resolution ) };
+
+  return static_cast< uint64_t >( ( elapsed + resolution - Clock::duration{ 1 } ) / resolution );
+}
+
+void TimerWheel::link( Timer &timer ) noexcept
+{
+  constexpr uint64_t Level0Range{ Level0Slots };
+  constexpr uint64_t Level1Range{ Level0Range * LevelSlots };
+  constexpr uint64_t Level2Range{ Level1Range * LevelSlots };
+
+  const auto delta{
+    ( timer.expiryTickV > currentTickV ) ? ( timer.expiryTickV - currentTickV ) : uint64_t{ 0U } };
+
+  Timer ** slot{ nullptr };
+
+  if ( delta < Level0Range )
+  {
+    slot = &level0V[ timer.expiryTickV % Level0Slots ];
+  }
+  else if ( delta < Level1Range )
+  {
+    slot = &level1V[ ( timer.expiryTickV / Level0Range ) % LevelSlots ];
+  }
+  else if ( delta < Level2Range )
+  {
+    slot = &level2V[ ( timer.expiryTickV / Level1Range ) % LevelSlots ];
+  }
+  else
+  {
+    // beyond range: park in the farthest level 2 slot and re-link, when it is cascaded
+    slot = &level2V[ ( ( currentTickV + Level2Range - 1U ) / Level1Range ) % LevelSlots ];
+  }
+
+  timer.slotV = slot;
+  timer.previousV = nullptr;
+  timer.nextV = *slot;
+
+  if ( nullptr != *slot )
+  {
+    ( *slot )->previousV = &timer;
+  }
+
+  *slot = &timer;
+}
+
+void TimerWheel::unlink( Timer &timer ) noexcept
+{
+  if ( nullptr != timer.previousV )
+  {
+    timer.previousV->nextV = timer.nextV;
+  }
+  else
+  {
+    *timer.slotV = timer.nextV;
+  }
+
+  if ( nullptr != timer.nextV )
+  {
+    timer.nextV->previousV = timer.previousV;
+  }
+
+  timer.slotV = nullptr;
+  timer.previousV = nullptr;
+  timer.nextV = nullptr;
+}
+
+void TimerWheel::cascade( Timer * &slot ) noexcept
+{
+  auto * timer{ slot };
+  slot = nullptr;
+
+  while ( nullptr != timer )
+  {
+    auto * const next{ timer->nextV };
+    link( *timer );
+    timer = next;
+  }
+}
+
+void TimerWheel::wait()
+{
+  if ( 0U == sizeV )
+  {
+    waitTickV.reset();
+    timerV.cancel();
+    return;
+  }
+
+  // next non-empty level 0 slot, or the next cascade
+  auto nextTick{ ( currentTickV / Level0Slots + 1U ) * Level0Slots };
+
+  for ( auto waitTick{ currentTickV + 1U }; waitTick < nextTick; ++waitTick )
+  {
+    if ( nullptr != level0V[ waitTick % Level0Slots ] )
+    {
+      nextTick = waitTick;
+      break;
+    }
+  }
+
+  waitTickV = nextTick;
+  timerV.expires_at( originV + nextTick * std::chrono::duration_cast< Clock::duration >( Resolution ) );
+  timerV.async_wait( std::bind_front( &TimerWheel::expired, this ) );
+}
+
+void TimerWheel::expired( const boost::system::error_code &errorCode )
+{
+  // wait aborted (re-armed or shutdown)
+  if ( boost::asio::error::operation_aborted == errorCode )
+  {
+    return;
+  }
+
+  checkThread();
+
+  waitTickV.reset();
+
+  if ( errorCode )
+  {
+    SPDLOG_ERROR( "Timer wheel error: {}", errorCode.message() );
+  }
+
+  const auto nowTick{ static_cast< uint64_t >( ( Clock::now() - originV ) / Resolution ) };
+
+  while ( currentTickV < nowTick )
+  {
+    // nothing to process - skip idle ticks
+    if ( 0U == sizeV )
+    {
+      currentTickV = nowTick;
+      break;
+    }
+
+    ++currentTickV;
+
+    if ( 0U == ( currentTickV % Level0Slots ) )
+    {
+      if ( 0U == ( ( currentTickV / Level0Slots ) % LevelSlots ) )
+      {
+        cascade( level2V[ ( currentTickV / ( Level0Slots * LevelSlots ) ) % LevelSlots ] );
+      }
+
+      cascade( level1V[ ( currentTickV / Level0Slots ) % LevelSlots ] );
+    }
+
+    // expire all timers of the current slot - handlers may re-arm or cancel other timers
+    auto * &slot{ level0V[ currentTickV % Level0Slots ] };
+
+    while ( nullptr != slot )
+    {
+      auto &timer{ *slot };
+      unlink( timer );
+      --sizeV;
+
+      // the handler may re-arm or destroy the timer
+      const auto handler{ std::move( timer.handlerV ) };
+      timer.handlerV = {};
+
+      if ( handler )
+      {
+        handler();
+      }
+    }
+  }
+
+  if ( !waitTickV )
+  {
+    wait();
+  }
+}
+
+}
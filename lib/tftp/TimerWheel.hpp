@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::TimerWheel.
+ **/
+
+#ifndef TFTP_TIMERWHEEL_HPP
+#define TFTP_TIMERWHEEL_HPP
+
+#include <tftp/Tftp.hpp>
+
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <thread>
+
+namespace Tftp {
+
+/**
+ * @brief Hierarchical Timer Wheel.
+ *
+ * Manages the retransmission and dally deadlines of TFTP operations.
+ * In contrast to one `boost::asio::system_timer` per operation, arming, re-arming, and cancelling a @ref Timer is
+ * O(1) and does not touch the I/O context.
+ * A single `boost::asio::steady_timer` drives the whole wheel.
+ *
+ * The wheel consists of three levels:
+ * - level 0 with @ref Level0Slots slots of @ref Resolution,
+ * - level 1 with @ref LevelSlots slots covering one level 0 revolution each,
+ * - level 2 with @ref LevelSlots slots covering one level 1 revolution each.
+ * Timers are cascaded to the next lower level, when the lower level wraps around.
+ * Deadlines beyond the range of level 2 are re-inserted, when reached.
+ *
+ * There is one timer wheel per I/O context, which is obtained by @ref instance().
+ * The timer wheel is not thread-safe.
+ * Like the TFTP clients and servers using it, it requires an I/O context, which is run by a single thread.
+ * To use several threads, run one I/O context (with its own clients and servers) per thread.
+ * Timers may be armed and cancelled outside of `run()`, e.g. before the I/O context is started.
+ * Using the wheel from handlers on different threads is detected by an assertion.
+ *
+ * Handlers are called from within the I/O context and may re-arm or cancel any timer of the wheel.
+ **/
+class TFTP_EXPORT TimerWheel
+{
+  public:
+    //! Monotonic Clock used by the Timer Wheel
+    using Clock = std::chrono::steady_clock;
+    //! Timer Expiry Handler
+    using Handler = std::function< void() >;
+
+    //! Resolution of the Timer Wheel
+    static constexpr std::chrono::milliseconds Resolution{ 10 };
+    //! Number of Slots of Level 0
+    static constexpr std::size_t Level0Slots{ 256U };
+    //! Number of Slots of Level 1 and 2
+    static constexpr std::size_t LevelSlots{ 64U };
+
+    /**
+     * @brief Timer registered with a Timer Wheel.
+     *
+     * The timer is cancelled on destruction.
+     * The timer is neither copyable nor movable, as it is linked into the wheel.
+     **/
+    class TFTP_EXPORT Timer
+    {
+      public:
+        /**
+         * @brief Creates a Timer, which is not armed.
+         *
+         * @param[in] timerWheel
+         *   Timer Wheel, which handles this timer. Must outlive the timer.
+         **/
+        explicit Timer( TimerWheel &timerWheel ) noexcept;
+
+        /**
+         * @brief Creates a Timer using the Timer Wheel of the I/O context.
+         *
+         * @param[in] ioContext
+         *   I/O context driving the timer wheel.
+         **/
+        explicit Timer( boost::asio::io_context &ioContext );
+
+        //! Cancels the Timer.
+        ~Timer() noexcept;
+
+        Timer( const Timer & ) = delete;
+        Timer& operator=( const Timer & ) = delete;
+
+        /**
+         * @brief Arms or re-arms the Timer.
+         *
+         * A pending expiry is replaced without calling its handler.
+         *
+         * @param[in] duration
+         *   Expiry relative to now.
+         *   The timer expires not before the given duration, rounded up to the wheel resolution.
+         * @param[in] handler
+         *   Handler called on expiry.
+         **/
+        void expiresAfter( Clock::duration duration, Handler handler );
+
+        /**
+         * @brief Cancels the Timer.
+         *
+         * The handler is not called.
+         * Cancelling a timer, which is not armed, has no effect.
+         **/
+        void cancel() noexcept;
+
+        /**
+         * @brief Returns if the Timer is armed.
+         *
+         * @return If the timer is armed.
+         **/
+        [[nodiscard]] bool armed() const noexcept;
+
+      private:
+        friend class TimerWheel;
+
+        //! Timer Wheel
+        TimerWheel &timerWheelV;
+        //! Expiry Handler
+        Handler handlerV;
+        //! Expiry Tick
+        uint64_t expiryTickV{ 0U };
+        //! Slot List Head, the timer is linked into (nullptr if not armed)
+        Timer ** slotV{ nullptr };
+        //! Previous Timer in Slot
+        Timer * previousV{ nullptr };
+        //! Next Timer in Slot
+        Timer * nextV{ nullptr };
+    };
+
+    /**
+     * @brief Returns the Timer Wheel of the given I/O context.
+     *
+     * The timer wheel is owned by the I/O context and destroyed together with it.
+     *
+     * @param[in] ioContext
+     *   I/O context.
+     *
+     * @return Timer Wheel
+     **/
+    [[nodiscard]] static TimerWheel& instance( boost::asio::io_context &ioContext );
+
+    /**
+     * @brief Creates a Timer Wheel.
+     *
+     * @param[in] ioContext
+     *   I/O context driving the timer wheel.
+     **/
+    explicit TimerWheel( boost::asio::io_context &ioContext );
+
+    //! Destructor
+    ~TimerWheel() noexcept;
+
+    TimerWheel( const TimerWheel & ) = delete;
+    TimerWheel& operator=( const TimerWheel & ) = delete;
+
+    /**
+     * @brief Returns the Number of armed Timers.
+     *
+     * @return Number of armed timers.
+     **/
+    [[nodiscard]] std::size_t size() const noexcept;
+
+  private:
+    //! I/O context Service, which owns the Timer Wheel.
+    class Service;
+
+    /**
+     * @brief Checks, that the Wheel is only used by the Thread running the I/O context.
+     *
+     * Calls outside of `run()` are not checked.
+     **/
+    void checkThread() noexcept;
+
+    //! Slot List Heads
+    template< std::size_t Slots >
+    using Level = std::array< Timer *, Slots >;
+
+    /**
+     * @brief Converts the Time Point to the Wheel Tick (rounded up).
+     *
+     * @param[in] timePoint
+     *   Time Point.
+     *
+     * @return Tick.
+     **/
+    [[nodiscard]] uint64_t tick( Clock::time_point timePoint ) const noexcept;
+
+    /**
+     * @brief Links the Timer into the Slot of its Expiry Tick.
+     *
+     * @param[in,out] timer
+     *   Timer, which is not linked.
+     **/
+    void link( Timer &timer ) noexcept;
+
+    /**
+     * @brief Unlinks the Timer from its Slot.
+     *
+     * @param[in,out] timer
+     *   Linked Timer.
+     **/
+    static void unlink( Timer &timer ) noexcept;
+
+    /**
+     * @brief Re-Links all Timers of the given Slot.
+     *
+     * @param[in,out] slot
+     *   Slot List Head.
+     **/
+    void cascade( Timer * &slot ) noexcept;
+
+    /**
+     * @brief Starts the Steady Timer for the next non-empty Tick.
+     **/
+    void wait();
+
+    /**
+     * @brief Steady Timer Handler - advances the Wheel and calls the Handlers of expired Timers.
+     *
+     * @param[in] errorCode
+     *   error status of operation.
+     **/
+    void expired( const boost::system::error_code &errorCode );
+
+    //! I/O context driving the Wheel
+    boost::asio::io_context &ioContextV;
+    //! Thread running the I/O context (set on first use within `run()`)
+    std::atomic< std::thread::id > runThreadV{};
+    //! Steady Timer driving the Wheel
+    boost::asio::steady_timer timerV;
+    //! Origin of the Ticks
+    Clock::time_point originV;
+    //! Current (processed) Tick
+    uint64_t currentTickV{ 0U };
+    //! Tick, the steady timer is waiting for
+    std::optional< uint64_t > waitTickV;
+    //! Number of armed Timers
+    std::size_t sizeV{ 0U };
+    //! Level 0
+    Level< Level0Slots > level0V{};
+    //! Level 1
+    Level< LevelSlots > level1V{};
+    //! Level 2
+    Level< LevelSlots > level2V{};
+};
+
+}
+
+#endif
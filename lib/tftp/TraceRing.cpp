@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::TraceRing.
+ **/
+
+#include "TraceRing.hpp"
+
+#include <tftp/packets/Packets.hpp>
+#include <tftp/packets/PacketTypeDescription.hpp>
+
+#include <tftp/TftpException.hpp>
+#include <tftp/TransferStatusDescription.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <istream>
+#include <ostream>
+
+namespace Tftp {
+
+namespace {
+
+//! Mask of the Slot Index
+constexpr uint64_t SlotMask{ TraceRing::Capacity - 1U };
+
+static_assert( 0U == ( TraceRing::Capacity & SlotMask ), "Capacity must be a power of 2" );
+
+/**
+ * @brief Writes @p value little endian into @p data.
+ *
+ * @param[out] data
+ *   Output buffer (at least @p Size bytes).
+ * @param[in] value
+ *   Value.
+ **/
+template< std::size_t Size >
+void putLittleEndian( char * const data, const uint64_t value ) noexcept
+{
+  for ( std::size_t index{ 0U }; index < Size; ++index )
+  {
+    data[ index ] = static_cast< char >( ( value >> ( 8U * index ) ) & 0xFFU );
+  }
+}
+
+/**
+ * @brief Reads @p Size bytes little endian from @p data.
+ *
+ * @param[in] data
+ *   Input buffer (at least @p Size bytes).
+ *
+ * @return Value.
+ **/
+template< std::size_t Size >
+uint64_t getLittleEndian( const char * const data ) noexcept
+{
+  uint64_t value{ 0U };
+
+  for ( std::size_t index{ 0U }; index < Size; ++index )
+  {
+    value |= static_cast< uint64_t >( static_cast< unsigned char >( data[ index ] ) ) << ( 8U * index );
+  }
+
+  return value;
+}
+
+}
+
+std::string_view TraceEvent_name( const TraceEvent event ) noexcept
+{
+  switch ( event )
+  {
+    case TraceEvent::Started:
+      return "Started";
+
+    case TraceEvent::Transmit:
+      return "TX";
+
+    case TraceEvent::Retransmit:
+      return "Re-TX";
+
+    case TraceEvent::Receive:
+      return "RX";
+
+    case TraceEvent::Timeout:
+      return "Timeout";
+
+    case TraceEvent::Finished:
+      return "Finished";
+
+    case TraceEvent::Request:
+      return "Request";
+
+    default:
+      return "Invalid";
+  }
+}
+
+std::string TraceRecord::toString( const uint64_t start ) const
+{
+  auto result{ std::format(
+    "{:+14.6f} #{:<6} {:8}",
+    static_cast< double >( static_cast< int64_t >( timestamp - start ) ) / 1.0E9,
+    session,
+    TraceEvent_name( event ) ) };
+
+  if ( 0U != packetType )
+  {
+    result += std::format(
+      " {:4} {}",
+      Packets::PacketTypeDescription::instance().name( static_cast< Packets::PacketType >( packetType ) ),
+      value );
+  }
+  else if ( TraceEvent::Finished == event )
+  {
+    result += std::format(
+      " {}",
+      TransferStatusDescription::instance().name( static_cast< TransferStatus >( value ) ) );
+  }
+
+  return result;
+}
+
+TraceRing& TraceRing::instance() noexcept
+{
+  static TraceRing traceRing;
+  return traceRing;
+}
+
+uint32_t TraceRing::session() noexcept
+{
+  static std::atomic< uint32_t > nextSession{ 0U };
+
+  // skip 0 on wrap around
+  uint32_t session;
+  do
+  {
+    session = ++nextSession;
+  } while ( 0U == session );
+
+  return session;
+}
+
+void TraceRing::write( std::ostream &stream, const std::span< const TraceRecord > records )
+{
+  std::array< char, 16U > header{};
+  FileMagic.copy( header.data(), FileMagic.size() );
+  putLittleEndian< 4U >( header.data() + 8U, records.size() );
+  putLittleEndian< 4U >( header.data() + 12U, TraceRecord::EncodedSize );
+  stream.write( header.data(), header.size() );
+
+  for ( const auto &record : records )
+  {
+    std::array< char, TraceRecord::EncodedSize > data{};
+    putLittleEndian< 8U >( data.data(), record.timestamp );
+    putLittleEndian< 4U >( data.data() + 8U, record.session );
+    putLittleEndian< 2U >( data.data() + 12U, record.value );
+    data[ 14U ] = static_cast< char >( record.event );
+    data[ 15U ] = static_cast< char >( record.packetType );
+    stream.write( data.data(), data.size() );
+  }
+}
+
+std::vector< TraceRecord > TraceRing::read( std::istream &stream )
+{
+  std::array< char, 16U > header{};
+  stream.read( header.data(), header.size() );
+
+  if ( !stream
+    || ( std::string_view{ header.data(), FileMagic.size() } != FileMagic )
+    || ( getLittleEndian< 4U >( header.data() + 12U ) != TraceRecord::EncodedSize ) )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Invalid trace file header" } );
+  }
+
+  const auto count{ getLittleEndian< 4U >( header.data() + 8U ) };
+
+  std::vector< TraceRecord > records;
+  records.reserve( std::min< uint64_t >( count, Capacity ) );
+
+  for ( uint64_t index{ 0U }; index < count; ++index )
+  {
+    std::array< char, TraceRecord::EncodedSize > data{};
+
+    if ( !stream.read( data.data(), data.size() ) )
+    {
+      BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Trace file truncated" } );
+    }
+
+    records.push_back( TraceRecord{
+      getLittleEndian< 8U >( data.data() ),
+      static_cast< uint32_t >( getLittleEndian< 4U >( data.data() + 8U ) ),
+      static_cast< uint16_t >( getLittleEndian< 2U >( data.data() + 12U ) ),
+      static_cast< TraceEvent >( data[ 14U ] ),
+      static_cast< uint8_t >( data[ 15U ] ) } );
+  }
+
+  return records;
+}
+
+void TraceRing::record(
+  const TraceEvent event,
+  const uint32_t session,
+  const uint16_t value,
+  const uint8_t packetType ) noexcept
+{
+  const auto index{ headV.fetch_add( 1U, std::memory_order_relaxed ) };
+  auto &slot{ slotsV[ index & SlotMask ] };
+
+  const auto timestamp{ std::chrono::duration_cast< std::chrono::nanoseconds >(
+    std::chrono::steady_clock::now().time_since_epoch() ).count() };
+
+  slot.sequence.store( ( 2U * index ) + 1U, std::memory_order_relaxed );
+  std::atomic_thread_fence( std::memory_order_release );
+
+  slot.timestamp.store( static_cast< uint64_t >( timestamp ), std::memory_order_relaxed );
+  slot.data.store(
+    ( static_cast< uint64_t >( session ) << 32U )
+      | ( static_cast< uint64_t >( value ) << 16U )
+      | ( static_cast< uint64_t >( event ) << 8U )
+      | packetType,
+    std::memory_order_relaxed );
+
+  slot.sequence.store( ( 2U * index ) + 2U, std::memory_order_release );
+}
+
+void TraceRing::record(
+  const TraceEvent event,
+  const uint32_t session,
+  const Helper::ConstRawDataSpan rawPacket ) noexcept
+{
+  if ( rawPacket.size() < 2U )
+  {
+    record( event, session, 0U, static_cast< uint8_t >( Packets::PacketType::Invalid ) );
+    return;
+  }
+
+  const auto opcode{ std::to_integer< uint8_t >( rawPacket[ 1U ] ) };
+  uint16_t value{ 0U };
+
+  // DATA, ACK, and ERROR carry the block number resp. error code after the opcode
+  if ( ( rawPacket.size() >= 4U )
+    && ( ( static_cast< uint8_t >( Packets::PacketType::Data ) == opcode )
+      || ( static_cast< uint8_t >( Packets::PacketType::Acknowledgement ) == opcode )
+      || ( static_cast< uint8_t >( Packets::PacketType::Error ) == opcode ) ) )
+  {
+    value = static_cast< uint16_t >(
+      ( std::to_integer< uint16_t >( rawPacket[ 2U ] ) << 8U ) | std::to_integer< uint16_t >( rawPacket[ 3U ] ) );
+  }
+
+  record(
+    event,
+    session,
+    value,
+    ( 0U == std::to_integer< uint8_t >( rawPacket[ 0U ] ) ) ?
+      opcode :
+      static_cast< uint8_t >( Packets::PacketType::Invalid ) );
+}
+
+std::vector< TraceRecord > TraceRing::snapshot() const
+{
+  const auto head{ headV.load( std::memory_order_acquire ) };
+  const auto first{ ( head > Capacity ) ? ( head - Capacity ) : 0U };
+
+  std::vector< TraceRecord > records;
+  records.reserve( head - first );
+
+  for ( auto index{ first }; index < head; ++index )
+  {
+    const auto &slot{ slotsV[ index & SlotMask ] };
+    const auto sequence{ slot.sequence.load( std::memory_order_acquire ) };
+
+    // being written or already overwritten
+    if ( sequence != ( 2U * index ) + 2U )
+    {
+      continue;
+    }
+
+    const auto timestamp{ slot.timestamp.load( std::memory_order_relaxed ) };
+    const auto data{ slot.data.load( std::memory_order_relaxed ) };
+
+    std::atomic_thread_fence( std::memory_order_acquire );
+
+    if ( slot.sequence.load( std::memory_order_relaxed ) != sequence )
+    {
+      continue;
+    }
+
+    records.push_back( TraceRecord{
+      timestamp,
+      static_cast< uint32_t >( data >> 32U ),
+      static_cast< uint16_t >( data >> 16U ),
+      static_cast< TraceEvent >( ( data >> 8U ) & 0xFFU ),
+      static_cast< uint8_t >( data & 0xFFU ) } );
+  }
+
+  return records;
+}
+
+}
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::TraceRing.
+ **/
+
+#ifndef TFTP_TRACERING_HPP
+#define TFTP_TRACERING_HPP
+
+#include <tftp/Tftp.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Tftp {
+
+//! Trace Event
+enum class TraceEvent : uint8_t
+{
+  Started    = 1U, //!< Operation started (value: 0)
+  Transmit   = 2U, //!< Packet transmitted (value: block number or error code)
+  Retransmit = 3U, //!< Packet retransmitted on timeout (value: block number or error code)
+  Receive    = 4U, //!< Packet received (value: block number or error code)
+  Timeout    = 5U, //!< Retry counter exceeded (value: 0)
+  Finished   = 6U, //!< Operation finished (value: TransferStatus)
+  Request    = 7U, //!< Request received by the server (value: 0)
+
+  Invalid    = 0xFFU //!< Invalid value
+};
+
+/**
+ * @brief Returns the Name of the Trace Event.
+ *
+ * @param[in] event
+ *   Trace Event.
+ *
+ * @return Event name.
+ **/
+[[nodiscard]] TFTP_EXPORT std::string_view TraceEvent_name( TraceEvent event ) noexcept;
+
+//! Trace Record
+struct TFTP_EXPORT TraceRecord
+{
+  //! Size of the encoded Record
+  static constexpr std::size_t EncodedSize{ 16U };
+
+  //! Time Stamp (`std::chrono::steady_clock`) [ns]
+  uint64_t timestamp{ 0U };
+  //! Session Identifier (0: no operation)
+  uint32_t session{ 0U };
+  //! Block Number, Error Code, or Transfer Status (depends on event)
+  uint16_t value{ 0U };
+  //! Event
+  TraceEvent event{ TraceEvent::Invalid };
+  //! Packet Type (Packets::PacketType, 0: no packet)
+  uint8_t packetType{ 0U };
+
+  /**
+   * @brief Returns the Record as printable String.
+   *
+   * @param[in] start
+   *   Time stamp, the time is printed relative to.
+   *
+   * @return Record as string representation.
+   **/
+  [[nodiscard]] std::string toString( uint64_t start = 0U ) const;
+};
+
+/**
+ * @brief Binary Trace Ring.
+ *
+ * Fixed-size ring of the last @ref Capacity trace records of all operations.
+ * The ring is always active and replaces text logging on the data path, which is compiled out in release builds.
+ *
+ * Recording is lock-free and wait-free:
+ * A slot is reserved by an atomic increment of the head, and each slot carries a sequence number, so readers skip
+ * slots, which are written concurrently.
+ * When the ring is full, the oldest records are overwritten.
+ *
+ * The records are taken by snapshot() and can be saved by write() for offline decoding (`tftp_trace`).
+ **/
+class TFTP_EXPORT TraceRing final
+{
+  public:
+    //! Number of Records (power of 2)
+    static constexpr std::size_t Capacity{ 65536U };
+    //! File Magic of saved Traces
+    static constexpr std::string_view FileMagic{ "TFTPTRC1" };
+
+    /**
+     * @brief Returns the Process-wide Trace Ring.
+     *
+     * @return Trace Ring.
+     **/
+    [[nodiscard]] static TraceRing& instance() noexcept;
+
+    /**
+     * @brief Returns a new Session Identifier.
+     *
+     * @return Session identifier (never 0).
+     **/
+    [[nodiscard]] static uint32_t session() noexcept;
+
+    /**
+     * @brief Saves the Records.
+     *
+     * @param[in,out] stream
+     *   Binary output stream.
+     * @param[in] records
+     *   Records.
+     **/
+    static void write( std::ostream &stream, std::span< const TraceRecord > records );
+
+    /**
+     * @brief Loads saved Records.
+     *
+     * @param[in,out] stream
+     *   Binary input stream.
+     *
+     * @return Records.
+     *
+     * @throw TftpException
+     *   When the stream does not contain a valid trace.
+     **/
+    [[nodiscard]] static std::vector< TraceRecord > read( std::istream &stream );
+
+    /**
+     * @brief Records an Event.
+     *
+     * @param[in] event
+     *   Event.
+     * @param[in] session
+     *   Session identifier.
+     * @param[in] value
+     *   Event value.
+     * @param[in] packetType
+     *   Packet type (0: no packet).
+     **/
+    void record( TraceEvent event, uint32_t session, uint16_t value = 0U, uint8_t packetType = 0U ) noexcept;
+
+    /**
+     * @brief Records a Packet Event.
+     *
+     * Packet type and block number (DATA, ACK) resp. error code (ERROR) are taken from the header of @p rawPacket.
+     *
+     * @param[in] event
+     *   Event.
+     * @param[in] session
+     *   Session identifier.
+     * @param[in] rawPacket
+     *   Raw packet.
+     **/
+    void record( TraceEvent event, uint32_t session, Helper::ConstRawDataSpan rawPacket ) noexcept;
+
+    /**
+     * @brief Returns the recorded Records.
+     *
+     * Records, which are written concurrently, are skipped.
+     *
+     * @return Records (oldest first).
+     **/
+    [[nodiscard]] std::vector< TraceRecord > snapshot() const;
+
+  private:
+    //! Record Slot
+    struct Slot
+    {
+      //! Sequence (odd: being written, even: 2 * (index + 1) of the written record)
+      std::atomic< uint64_t > sequence;
+      //! Time Stamp
+      std::atomic< uint64_t > timestamp;
+      //! Session, Value, Event, and Packet Type
+      std::atomic< uint64_t > data;
+    };
+
+    //! Index of the next Record
+    std::atomic< uint64_t > headV{ 0U };
+    //! Record Slots
+    std::array< Slot, Capacity > slotsV{};
+};
+
+}
+
+#endif
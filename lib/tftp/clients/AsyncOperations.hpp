@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration and Definition of the Asynchronous TFTP %Client Operations.
+ *
+ * The asynchronous operations support any Boost.Asio completion token, e.g. `boost::asio::use_awaitable`,
+ * `boost::asio::use_future`, `boost::asio::deferred`, or a plain callback.
+ **/
+
+#ifndef TFTP_CLIENTS_ASYNCOPERATIONS_HPP
+#define TFTP_CLIENTS_ASYNCOPERATIONS_HPP
+
+#include <tftp/clients/Clients.hpp>
+#include <tftp/clients/Client.hpp>
+#include <tftp/clients/OperationResult.hpp>
+#include <tftp/clients/ReadOperation.hpp>
+#include <tftp/clients/WriteOperation.hpp>
+
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/cancellation_type.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/post.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace Tftp::Clients {
+
+/**
+ * @brief Executes the configured TFTP %Client %Operation asynchronously.
+ *
+ * Sets the completion handler of @p operation, sends the request and completes with the OperationResult, when the
+ * operation is finished.
+ * The operation is kept alive until completion.
+ * Therefore, the caller does not need to hold the operation.
+ *
+ * The completion handler is invoked through its associated executor and never from within this call.
+ *
+ * Per-operation cancellation is supported:
+ * When cancellation is emitted on the cancellation slot associated with the completion handler, the operation is
+ * aborted and completes with TransferStatus::Aborted.
+ *
+ * @tparam CompletionToken
+ *   Completion Token Type with the signature `void( OperationResult )`.
+ * @param[in] operation
+ *   Configured Operation (filename, mode, remote, and data handler must be set).
+ * @param[in] token
+ *   Completion Token.
+ *
+ * @return Depends on @p token.
+ *
+ * @throw TftpException
+ *   When the operation is not configured correctly.
+ **/
+template< typename CompletionToken >
+auto asyncExecute( OperationPtr operation, CompletionToken &&token )
+{
+  return boost::asio::async_initiate< CompletionToken, void( OperationResult ) >(
+    []( auto handler, OperationPtr operation )
+    {
+      using Handler = std::decay_t< decltype( handler ) >;
+      using Executor = boost::asio::associated_executor_t< Handler >;
+
+      // state shared by the completion and cancellation handlers (operation completion handler must be copyable)
+      struct State
+      {
+        Handler handler;
+        boost::asio::executor_work_guard< Executor > work;
+        OperationPtr operation;
+        std::chrono::steady_clock::time_point start;
+        bool completed;
+      };
+
+      const auto executor{ boost::asio::get_associated_executor( handler ) };
+      auto state{ std::make_shared< State >( State{
+        std::move( handler ),
+        boost::asio::make_work_guard( executor ),
+        operation,
+        std::chrono::steady_clock::now(),
+        false } ) };
+
+      operation->completionHandler( [ state ]( const TransferStatus status )
+      {
+        state->completed = true;
+        boost::asio::get_associated_cancellation_slot( state->handler ).clear();
+
+        OperationResult result{
+          status,
+          state->operation->errorInformation(),
+          std::chrono::steady_clock::now() - state->start,
+          state->operation->transferredBytes(),
+          state->operation->retransmissions() };
+
+        // complete outside the operation, which is released before the handler is called
+        const auto executor{ boost::asio::get_associated_executor( state->handler ) };
+        boost::asio::post( executor, [ state, result = std::move( result ) ]() mutable
+        {
+          auto completionHandler{ std::move( state->handler ) };
+          state->operation.reset();
+          state->work.reset();
+          std::move( completionHandler )( std::move( result ) );
+        } );
+      } );
+
+      try
+      {
+        operation->request();
+      }
+      catch ( ... )
+      {
+        operation->completionHandler( {} );
+        throw;
+      }
+
+      // the request may have been finished immediately
+      if ( auto slot{ boost::asio::get_associated_cancellation_slot( state->handler ) };
+        !state->completed && slot.is_connected() )
+      {
+        slot.assign( [ weakState = std::weak_ptr< State >{ state } ]( boost::asio::cancellation_type )
+        {
+          if ( const auto state{ weakState.lock() }; state && !state->completed )
+          {
+            state->operation->abort();
+          }
+        } );
+      }
+    },
+    token,
+    std::move( operation ) );
+}
+
+/**
+ * @brief Reads a File from a TFTP %Server asynchronously.
+ *
+ * Creates a read operation (RRQ) with the defaults of @p client in OCTET mode and executes it by asyncExecute().
+ *
+ * @code
+ * const auto result{ co_await asyncRead( *client, remote, "file.bin", sink, boost::asio::use_awaitable ) };
+ * @endcode
+ *
+ * @tparam CompletionToken
+ *   Completion Token Type with the signature `void( OperationResult )`.
+ * @param[in] client
+ *   TFTP %Client, which creates the operation.
+ * @param[in] remote
+ *   TFTP %Server Endpoint.
+ * @param[in] filename
+ *   Filename to request.
+ * @param[in] dataHandler
+ *   Handler for the received data.
+ * @param[in] token
+ *   Completion Token.
+ *
+ * @return Depends on @p token.
+ **/
+template< typename CompletionToken >
+auto asyncRead(
+  Client &client,
+  boost::asio::ip::udp::endpoint remote,
+  std::string filename,
+  ReceiveDataHandlerPtr dataHandler,
+  CompletionToken &&token )
+{
+  auto operation{ client.readOperation() };
+  operation->dataHandler( std::move( dataHandler ) );
+  operation
+    ->filename( std::move( filename ) )
+    .mode( Packets::TransferMode::OCTET )
+    .remote( std::move( remote ) );
+
+  return asyncExecute( std::move( operation ), std::forward< CompletionToken >( token ) );
+}
+
+/**
+ * @brief Writes a File to a TFTP %Server asynchronously.
+ *
+ * Creates a write operation (WRQ) with the defaults of @p client in OCTET mode and executes it by asyncExecute().
+ *
+ * @tparam CompletionToken
+ *   Completion Token Type with the signature `void( OperationResult )`.
+ * @param[in] client
+ *   TFTP %Client, which creates the operation.
+ * @param[in] remote
+ *   TFTP %Server Endpoint.
+ * @param[in] filename
+ *   Filename to write.
+ * @param[in] dataHandler
+ *   Handler for the transmitted data.
+ * @param[in] token
+ *   Completion Token.
+ *
+ * @return Depends on @p token.
+ **/
+template< typename CompletionToken >
+auto asyncWrite(
+  Client &client,
+  boost::asio::ip::udp::endpoint remote,
+  std::string filename,
+  TransmitDataHandlerPtr dataHandler,
+  CompletionToken &&token )
+{
+  auto operation{ client.writeOperation() };
+  operation->dataHandler( std::move( dataHandler ) );
+  operation
+    ->filename( std::move( filename ) )
+    .mode( Packets::TransferMode::OCTET )
+    .remote( std::move( remote ) );
+
+  return asyncExecute( std::move( operation ), std::forward< CompletionToken >( token ) );
+}
+
+}
+
+#endif
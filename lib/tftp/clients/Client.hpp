@@ -26,6 +26,9 @@ namespace Tftp::Clients {
  * This class acts as factory for creating client operations, like read requests or write requests.
  *
  * An instance is created by calling @ref Client::instance().
+ *
+ * The client and its operations are not thread-safe.
+ * The I/O context must be run by a single thread.
  **/
 class TFTP_EXPORT Client
 {
@@ -136,6 +139,18 @@ class TFTP_EXPORT Client
      **/
     virtual Client& localDefault( boost::asio::ip::address local ) = 0;
 
+    /**
+     * @brief Updates the Socket Buffer Sizes.
+     *
+     * If this option is set, every created operation will be initialised with the value.
+     *
+     * @param[in] socketBufferSizes
+     *   Socket buffer sizes (`SO_RCVBUF`, `SO_SNDBUF`).
+     *
+     * @return @p *this for chaining.
+     **/
+    virtual Client& socketBufferSizesDefault( SocketBufferSizes socketBufferSizes ) = 0;
+
     /** @} **/
 
     /**
@@ -19,6 +19,7 @@
 
 #include <boost/asio/ip/udp.hpp>
 
+#include <cstdint>
 #include <string>
 
 namespace Tftp::Clients {
@@ -160,6 +161,7 @@ class TFTP_EXPORT Operation
      * @brief Updates the local address to use as source.
      *
      * To set a fixed IP-address and leave the UDP port up to the IP-Stack, set the port to `0`.
+     * To set a fixed UDP port on all addresses, set the unspecified address.
      *
      * @param[in] local
      *   Parameter to define the communication source
@@ -168,6 +170,19 @@ class TFTP_EXPORT Operation
      **/
     virtual Operation& local( boost::asio::ip::udp::endpoint local ) = 0;
 
+    /**
+     * @brief Updates the Socket Buffer Sizes.
+     *
+     * Applied to the socket of the operation, when it is opened.
+     * Larger receive buffers prevent packet drops by the IP stack with large block sizes.
+     *
+     * @param[in] socketBufferSizes
+     *   Socket buffer sizes.
+     *
+     * @return @p *this for chaining.
+     **/
+    virtual Operation& socketBufferSizes( SocketBufferSizes socketBufferSizes ) = 0;
+
     /** @} **/
 
     /**
@@ -206,6 +221,25 @@ class TFTP_EXPORT Operation
      *   If no error occurred.
      **/
     [[nodiscard]] virtual const Packets::ErrorInformation& errorInformation() const = 0;
+
+    /**
+     * @brief Returns the Number of transferred Data Bytes.
+     *
+     * Payload of the DATA packets received (read operation) or transmitted (write operation) without
+     * retransmissions.
+     *
+     * @return Number of transferred data bytes of the current or last request.
+     **/
+    [[nodiscard]] virtual uint64_t transferredBytes() const = 0;
+
+    /**
+     * @brief Returns the Number of Retransmissions.
+     *
+     * Packets, which have been transmitted again after a timeout.
+     *
+     * @return Number of retransmissions of the current or last request.
+     **/
+    [[nodiscard]] virtual unsigned int retransmissions() const = 0;
 };
 
 }
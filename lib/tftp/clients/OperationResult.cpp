@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Struct Tftp::Clients::OperationResult.
+ **/
+
+#include "OperationResult.hpp"
+
+#include <tftp/packets/ErrorCodeDescription.hpp>
+
+#include <tftp/TransferStatusDescription.hpp>
+
+#include <format>
+#include <ostream>
+
+namespace Tftp::Clients {
+
+OperationResult::operator bool() const noexcept
+{
+  return TransferStatus::Successful == status;
+}
+
+std::string OperationResult::toString() const
+{
+  std::string result{ std::format(
+    "{:22}: {}\n"
+    "{:22}: {} ms\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n",
+    "Status", TransferStatusDescription::instance().name( status ),
+    "Duration", std::chrono::duration_cast< std::chrono::milliseconds >( duration ).count(),
+    "Transferred Bytes", transferredBytes,
+    "Retransmissions", retransmissions ) };
+
+  if ( errorInformation )
+  {
+    const auto &[ errorCode, errorMessage ]{ *errorInformation };
+
+    result += std::format(
+      "{:22}: {} '{}'\n",
+      "Error",
+      Packets::ErrorCodeDescription::instance().name( errorCode ),
+      errorMessage );
+  }
+
+  return result;
+}
+
+std::ostream& operator<<( std::ostream &stream, const OperationResult &result )
+{
+  return ( stream << result.toString() );
+}
+
+}
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Struct Tftp::Clients::OperationResult.
+ **/
+
+#ifndef TFTP_CLIENTS_OPERATIONRESULT_HPP
+#define TFTP_CLIENTS_OPERATIONRESULT_HPP
+
+#include <tftp/clients/Clients.hpp>
+
+#include <tftp/packets/Packets.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace Tftp::Clients {
+
+/**
+ * @brief Result of a TFTP %Client %Operation.
+ *
+ * Completion value of the asynchronous operations asyncExecute(), asyncRead(), and asyncWrite().
+ **/
+struct TFTP_EXPORT OperationResult
+{
+  //! Transfer Status
+  TransferStatus status{ TransferStatus::CommunicationError };
+  //! Error Information (set, when an error packet has been received or transmitted)
+  Packets::ErrorInformation errorInformation;
+  //! Duration from the request until completion
+  std::chrono::steady_clock::duration duration{};
+  //! Transferred Data Bytes (see Operation::transferredBytes())
+  uint64_t transferredBytes{ 0U };
+  //! Number of Retransmissions (see Operation::retransmissions())
+  unsigned int retransmissions{ 0U };
+
+  /**
+   * @brief Returns if the Transfer has been successful.
+   *
+   * @return If @p status is TransferStatus::Successful.
+   **/
+  [[nodiscard]] explicit operator bool() const noexcept;
+
+  /**
+   * @brief Gives the result as printable string.
+   *
+   * @return Result as string representation
+   **/
+  [[nodiscard]] std::string toString() const;
+};
+
+/**
+ * @brief Stream output operator of @p OperationResult.
+ *
+ * @param[in,out] stream
+ *   Output Stream
+ * @param[in] result
+ *   Operation Result
+ *
+ * @return @p stream for chaining.
+ **/
+TFTP_EXPORT std::ostream& operator<<( std::ostream &stream, const OperationResult &result );
+
+}
+
+#endif
@@ -60,6 +60,12 @@ Client& ClientImpl::localDefault( const boost::asio::ip::address local )
   return *this;
 }
 
+Client& ClientImpl::socketBufferSizesDefault( SocketBufferSizes socketBufferSizes )
+{
+  socketBufferSizesDefaultV = std::move( socketBufferSizes );
+  return *this;
+}
+
 ReadOperationPtr ClientImpl::readOperation()
 {
   auto operation{ std::make_shared< ReadOperationImpl >( ioContextV ) };
@@ -94,6 +100,8 @@ ReadOperationPtr ClientImpl::readOperation()
     operation->local( { localV, 0 } );
   }
 
+  operation->socketBufferSizes( socketBufferSizesDefaultV );
+
   return operation;
 }
 
@@ -126,6 +134,8 @@ WriteOperationPtr ClientImpl::writeOperation()
     operation->local( { localV, 0 } );
   }
 
+  operation->socketBufferSizes( socketBufferSizesDefaultV );
+
   return operation;
 }
 
@@ -16,6 +16,7 @@
 #include <tftp/clients/Clients.hpp>
 #include <tftp/clients/Client.hpp>
 
+#include <tftp/SocketBufferSizes.hpp>
 #include <tftp/TftpOptionsConfiguration.hpp>
 
 #include <boost/asio/io_context.hpp>
@@ -63,6 +64,9 @@ class ClientImpl final : public Client
     //! @copydoc Client::localDefault()
     Client& localDefault( boost::asio::ip::address local ) override;
 
+    //! @copydoc Client::socketBufferSizesDefault()
+    Client& socketBufferSizesDefault( SocketBufferSizes socketBufferSizes ) override;
+
     //! @copydoc Client::readOperation()
     ReadOperationPtr readOperation() override;
 
@@ -84,6 +88,8 @@ class ClientImpl final : public Client
     Packets::Options additionalOptionsV;
     //! Default local IP address
     boost::asio::ip::address localV;
+    //! Default socket buffer sizes
+    SocketBufferSizes socketBufferSizesDefaultV;
 };
 
 }
@@ -18,7 +18,11 @@
 #include <tftp/packets/ReadRequestPacket.hpp>
 #include <tftp/packets/WriteRequestPacket.hpp>
 
+#include <tftp/PacketCapture.hpp>
+#include <tftp/PathMtu.hpp>
+#include <tftp/ReceiveBuffer.hpp>
 #include <tftp/TftpException.hpp>
+#include <tftp/TraceRing.hpp>
 
 #include <helper/Exception.hpp>
 
@@ -32,8 +36,7 @@ namespace Tftp::Clients {
 
 OperationImpl::OperationImpl( boost::asio::io_context &ioContext ) :
   socketV{ ioContext },
-  timerV{ ioContext },
-  receivePacketV( Packets::DefaultMaxPacketSize )
+  timerV{ ioContext }
 {
 }
 
@@ -41,6 +44,13 @@ OperationImpl::~OperationImpl() = default;
 
 void OperationImpl::initialise()
 {
+  traceSessionV = TraceRing::session();
+  TraceRing::instance().record( TraceEvent::Started, traceSessionV );
+
+  automaticBlockSizeV.reset();
+  transferredBytesV = 0U;
+  retransmissionsV = 0U;
+
   try
   {
     // reset remembered connected endpoint
@@ -48,12 +58,18 @@ void OperationImpl::initialise()
 
     // Open the socket
     socketV.open( remoteV.protocol() );
+    socketBufferSizesV.apply( socketV );
 
     // Bind socket to source address (from)
     if ( !localV.address().is_unspecified() )
     {
       socketV.bind( localV );
     }
+    else if ( 0U != localV.port() )
+    {
+      // only the port is given - bind to the unspecified address of the remote protocol
+      socketV.bind( boost::asio::ip::udp::endpoint{ remoteV.protocol(), localV.port() } );
+    }
   }
   catch ( const boost::system::system_error &err )
   {
@@ -62,11 +78,14 @@ void OperationImpl::initialise()
     // On error and if socket is opened - close it.
     if ( socketV.is_open() )
     {
-      socketV.close();
+      boost::system::error_code errorCode;
+      socketV.close( errorCode );
     }
 
-    // Operation finished
-    finished( TransferStatus::CommunicationError );
+    // the caller finishes the operation - no request is sent
+    BOOST_THROW_EXCEPTION( CommunicationException{}
+      << Helper::AdditionalInfo{ err.what() }
+      << TransferPhaseInfo{ TransferPhase::Initialisation } );
   }
 }
 
@@ -102,6 +121,16 @@ const Packets::ErrorInformation& OperationImpl::errorInformation() const
   return errorInformationV;
 }
 
+uint64_t OperationImpl::transferredBytes() const noexcept
+{
+  return transferredBytesV;
+}
+
+unsigned int OperationImpl::retransmissions() const noexcept
+{
+  return retransmissionsV;
+}
+
 void OperationImpl::tftpTimeout( const std::chrono::seconds timeout )
 {
   receiveTimeoutV = timeout;
@@ -122,14 +151,14 @@ void OperationImpl::local( boost::asio::ip::udp::endpoint local )
   localV = std::move( local );
 }
 
-void OperationImpl::completionHandler( OperationCompletedHandler handler )
+void OperationImpl::socketBufferSizes( SocketBufferSizes socketBufferSizes )
 {
-  completionHandlerV = std::move( handler );
+  socketBufferSizesV = std::move( socketBufferSizes );
 }
 
-void OperationImpl::maxReceivePacketSize( const uint16_t maxReceivePacketSize )
+void OperationImpl::completionHandler( OperationCompletedHandler handler )
 {
-  receivePacketV.resize( maxReceivePacketSize );
+  completionHandlerV = std::move( handler );
 }
 
 void OperationImpl::receiveTimeout( const std::chrono::seconds receiveTimeout ) noexcept
@@ -137,6 +166,34 @@ void OperationImpl::receiveTimeout( const std::chrono::seconds receiveTimeout )
   receiveTimeoutV = receiveTimeout;
 }
 
+boost::optional< uint16_t > OperationImpl::requestBlockSize(
+  const TftpOptionsConfiguration &optionsConfiguration ) const
+{
+  if ( !optionsConfiguration.blockSizeAutomatic )
+  {
+    return optionsConfiguration.blockSizeOption;
+  }
+
+  const auto blockSize{ PathMtu::instance().blockSize( remoteV ) };
+
+  if ( !blockSize )
+  {
+    return optionsConfiguration.blockSizeOption;
+  }
+
+  return std::min( *blockSize, optionsConfiguration.blockSizeOption.get_value_or( *blockSize ) );
+}
+
+void OperationImpl::automaticBlockSize( const uint16_t blockSize ) noexcept
+{
+  automaticBlockSizeV = blockSize;
+}
+
+void OperationImpl::dataTransferred( const std::size_t bytes ) noexcept
+{
+  transferredBytesV += bytes;
+}
+
 void OperationImpl::sendFirst( const Packets::Packet &packet )
 {
   SPDLOG_TRACE( "TX: {}", static_cast< std::string>( packet ) );
@@ -149,9 +206,18 @@ void OperationImpl::sendFirst( const Packets::Packet &packet )
     // Encode the raw packet
     transmitPacketV = static_cast< Helper::RawData >( packet );
 
+    TraceRing::instance().record( TraceEvent::Transmit, traceSessionV, transmitPacketV );
+
     // Update statistic
     Packets::PacketStatistic::globalTransmit().packet( packet.packetType(), transmitPacketV.size() );
 
+    PacketCapture::instance().record(
+      CaptureRecord::Role::Client,
+      CaptureRecord::Direction::Transmit,
+      traceSessionV,
+      remoteV,
+      transmitPacketV );
+
     // Send the packet to the remote server
     socketV.send_to( boost::asio::buffer( transmitPacketV ), remoteV );
   }
@@ -176,9 +242,18 @@ void OperationImpl::send( const Packets::Packet &packet )
     // Encode the raw packet
     transmitPacketV = static_cast< Helper::RawData >( packet );
 
+    TraceRing::instance().record( TraceEvent::Transmit, traceSessionV, transmitPacketV );
+
     // Update statistic
     Packets::PacketStatistic::globalTransmit().packet( packet.packetType(), transmitPacketV.size() );
 
+    PacketCapture::instance().record(
+      CaptureRecord::Role::Client,
+      CaptureRecord::Direction::Transmit,
+      traceSessionV,
+      receiveEndpointV,
+      transmitPacketV );
+
     // Send the packet to the remote server
     socketV.send( boost::asio::buffer( transmitPacketV ) );
   }
@@ -195,17 +270,13 @@ void OperationImpl::receiveFirst()
   try
   {
     // the first time, we make receive_from (answer is not sent from destination)
-    // Start the reception operation
-    socketV.async_receive_from(
-      boost::asio::buffer( receivePacketV ),
-      receiveEndpointV,
+    // Wait for the reception
+    socketV.async_wait(
+      boost::asio::socket_base::wait_read,
       std::bind_front( &OperationImpl::receiveFirstHandler, this ) );
 
     // Set receive timeout
-    timerV.expires_after( receiveTimeoutV );
-
-    // start waiting for receive timeout
-    timerV.async_wait( std::bind_front( &OperationImpl::timeoutFirstHandler, this ) );
+    timerV.expiresAfter( receiveTimeoutV, [ this ]{ timeoutFirstHandler(); } );
   }
   catch ( const boost::system::system_error &err )
   {
@@ -220,15 +291,12 @@ void OperationImpl::receive()
   try
   {
     // start the receive operation
-    socketV.async_receive(
-      boost::asio::buffer( receivePacketV ),
+    socketV.async_wait(
+      boost::asio::socket_base::wait_read,
       std::bind_front( &OperationImpl::receiveHandler, this ) );
 
     // set receive timeout
-    timerV.expires_after( receiveTimeoutV );
-
-    // start waiting for receive timeout
-    timerV.async_wait( std::bind_front( &OperationImpl::timeoutHandler, this ) );
+    timerV.expiresAfter( receiveTimeoutV, [ this ]{ timeoutHandler(); } );
   }
   catch ( const boost::system::system_error &err )
   {
@@ -243,15 +311,12 @@ void OperationImpl::receiveDally()
   try
   {
     // start the receive operation
-    socketV.async_receive(
-      boost::asio::buffer( receivePacketV ),
+    socketV.async_wait(
+      boost::asio::socket_base::wait_read,
       std::bind_front( &OperationImpl::receiveHandler, this ) );
 
     // set receive timeout
-    timerV.expires_after( 2U * receiveTimeoutV );
-
-    // start waiting for receive timeout
-    timerV.async_wait( std::bind_front( &OperationImpl::timeoutDallyHandler, this ) );
+    timerV.expiresAfter( 2U * receiveTimeoutV, [ this ]{ timeoutDallyHandler(); } );
   }
   catch ( const boost::system::system_error &err )
   {
@@ -265,11 +330,16 @@ void OperationImpl::finished( const TransferStatus status, Packets::ErrorInforma
 {
   SPDLOG_INFO( "TFTP Client Operation finished" );
 
+  TraceRing::instance().record( TraceEvent::Finished, traceSessionV, static_cast< uint16_t >( status ) );
+
   errorInformationV = std::move( errorInformation );
 
   timerV.cancel();
-  socketV.cancel();
-  socketV.close();
+
+  // the socket may be closed already (failed initialisation)
+  boost::system::error_code errorCode;
+  socketV.cancel( errorCode );
+  socketV.close( errorCode );
 
   if ( completionHandlerV )
   {
@@ -354,9 +424,7 @@ void OperationImpl::invalidPacket(
   finished( TransferStatus::TransferError, errorPacket.errorInformation() );
 }
 
-void OperationImpl::receiveFirstHandler(
-  const boost::system::error_code &errorCode,
-  const std::size_t bytesTransferred )
+void OperationImpl::receiveFirstHandler( const boost::system::error_code &errorCode )
 {
   // operation has been aborted (maybe timeout)
   if ( boost::asio::error::operation_aborted == errorCode )
@@ -373,6 +441,24 @@ void OperationImpl::receiveFirstHandler(
     return;
   }
 
+  // the socket is readable - receive into the buffer of this thread
+  const auto receiveBuffer{ ReceiveBuffer::instance() };
+  boost::system::error_code receiveErrorCode;
+  const auto bytesTransferred{ socketV.receive_from(
+    boost::asio::buffer( receiveBuffer.data(), receiveBuffer.size() ),
+    receiveEndpointV,
+    0,
+    receiveErrorCode ) };
+
+  // (internal) receive error occurred
+  if ( receiveErrorCode )
+  {
+    SPDLOG_ERROR( "Error when receiving message: {}", receiveErrorCode.message() );
+
+    finished( TransferStatus::CommunicationError );
+    return;
+  }
+
   // check if the packet has been received from a not expected source
   // send an error packet and ignore it.
   if ( remoteV.address() != receiveEndpointV.address() )
@@ -401,9 +487,8 @@ void OperationImpl::receiveFirstHandler(
     // restart receive operation
     try
     {
-      socketV.async_receive_from(
-        boost::asio::buffer( receivePacketV ),
-        receiveEndpointV,
+      socketV.async_wait(
+        boost::asio::socket_base::wait_read,
         std::bind_front( &OperationImpl::receiveFirstHandler, this ) );
 
       return;
@@ -430,10 +515,19 @@ void OperationImpl::receiveFirstHandler(
     return;
   }
 
-  packet( receiveEndpointV, Helper::ConstRawDataSpan{ receivePacketV.begin(), bytesTransferred } );
+  const Helper::ConstRawDataSpan rawPacket{ receiveBuffer.first( bytesTransferred ) };
+  TraceRing::instance().record( TraceEvent::Receive, traceSessionV, rawPacket );
+  PacketCapture::instance().record(
+    CaptureRecord::Role::Client,
+    CaptureRecord::Direction::Receive,
+    traceSessionV,
+    receiveEndpointV,
+    rawPacket );
+
+  packet( receiveEndpointV, rawPacket );
 }
 
-void OperationImpl::receiveHandler( const boost::system::error_code &errorCode, const std::size_t bytesTransferred )
+void OperationImpl::receiveHandler( const boost::system::error_code &errorCode )
 {
   // operation has been aborted (maybe timeout)
   // error is not handled here.
@@ -442,7 +536,7 @@ void OperationImpl::receiveHandler( const boost::system::error_code &errorCode,
     return;
   }
 
-  // (internal) receive error occurred
+  // (internal) wait error occurred
   if ( errorCode )
   {
     SPDLOG_ERROR( "Error when receiving message: {}", errorCode.message() );
@@ -451,56 +545,78 @@ void OperationImpl::receiveHandler( const boost::system::error_code &errorCode,
     return;
   }
 
-  // handle the received packet
-  packet( receiveEndpointV, Helper::ConstRawDataSpan{ receivePacketV.begin(), bytesTransferred } );
-}
+  // the socket is readable - receive into the buffer of this thread
+  const auto receiveBuffer{ ReceiveBuffer::instance() };
+  boost::system::error_code receiveErrorCode;
+  const auto bytesTransferred{ socketV.receive(
+    boost::asio::buffer( receiveBuffer.data(), receiveBuffer.size() ),
+    0,
+    receiveErrorCode ) };
 
-void OperationImpl::timeoutFirstHandler( const boost::system::error_code &errorCode )
-{
-  // wait aborted (a packet has been received)
-  if ( boost::asio::error::operation_aborted == errorCode )
-  {
-    return;
-  }
-
-  // internal (timer) error occurred
-  if ( errorCode )
+  // (internal) receive error occurred
+  if ( receiveErrorCode )
   {
-    SPDLOG_ERROR( "Timer error: {}", errorCode.message() );
+    SPDLOG_ERROR( "Error when receiving message: {}", receiveErrorCode.message() );
 
     finished( TransferStatus::CommunicationError );
     return;
   }
 
+  const Helper::ConstRawDataSpan rawPacket{ receiveBuffer.first( bytesTransferred ) };
+  TraceRing::instance().record( TraceEvent::Receive, traceSessionV, rawPacket );
+  PacketCapture::instance().record(
+    CaptureRecord::Role::Client,
+    CaptureRecord::Direction::Receive,
+    traceSessionV,
+    receiveEndpointV,
+    rawPacket );
+
+  // handle the received packet
+  packet( receiveEndpointV, rawPacket );
+}
+
+void OperationImpl::timeoutFirstHandler()
+{
   // if maximum retries exceeded -> abort receive operation
   if ( transmitCounterV > tftpRetriesV )
   {
     SPDLOG_ERROR( "TFTP Retry counter exceeded" );
 
+    TraceRing::instance().record( TraceEvent::Timeout, traceSessionV );
+
+    // no response at all - the path MTU is not the cause
     finished( TransferStatus::CommunicationError );
     return;
   }
 
-  SPDLOG_WARN(
+  SPDLOG_DEBUG(
     "Retransmit last TFTP packet: {}",
     Packets::PacketTypeDescription::instance().name( Packets::Packet::packetType( transmitPacketV ) ) );
 
   try
   {
+    TraceRing::instance().record( TraceEvent::Retransmit, traceSessionV, transmitPacketV );
+
     // Update statistic
     Packets::PacketStatistic::globalTransmit().packet(
       Packets::Packet::packetType( transmitPacketV ),
       transmitPacketV.size() );
 
+    PacketCapture::instance().record(
+      CaptureRecord::Role::Client,
+      CaptureRecord::Direction::Transmit,
+      traceSessionV,
+      remoteV,
+      transmitPacketV );
+
     // resent stored packet
     socketV.send_to( boost::asio::buffer( transmitPacketV ), remoteV );
 
     // increment transmit counter
     ++transmitCounterV;
+    ++retransmissionsV;
 
-    timerV.expires_after( receiveTimeoutV );
-
-    timerV.async_wait( std::bind_front( &OperationImpl::timeoutFirstHandler, this ) );
+    timerV.expiresAfter( receiveTimeoutV, [ this ]{ timeoutFirstHandler(); } );
   }
   catch ( const boost::system::system_error &err )
   {
@@ -510,50 +626,52 @@ void OperationImpl::timeoutFirstHandler( const boost::system::error_code &errorC
   }
 }
 
-void OperationImpl::timeoutHandler( const boost::system::error_code& errorCode )
+void OperationImpl::timeoutHandler()
 {
-  // wait aborted (a packet has been received)
-  if ( boost::asio::error::operation_aborted == errorCode )
-  {
-    return;
-  }
-
-  // internal (timer) error occurred
-  if ( errorCode )
-  {
-    SPDLOG_ERROR( "Timer error: {}", errorCode.message() );
-
-    finished( TransferStatus::CommunicationError );
-    return;
-  }
-
   // if maximum retries exceeded -> abort receive operation
   if ( transmitCounterV > tftpRetriesV )
   {
     SPDLOG_ERROR( "TFTP Retry counter exceeded" );
 
+    TraceRing::instance().record( TraceEvent::Timeout, traceSessionV );
+
+    // large DATA packets may be dropped silently - fall back to a smaller block size for following transfers
+    // (the block size is negotiated, so the DATA phase has started)
+    if ( automaticBlockSizeV )
+    {
+      PathMtu::instance().timeout( remoteV.address(), *automaticBlockSizeV );
+    }
+
     finished( TransferStatus::CommunicationError );
     return;
   }
 
-  SPDLOG_INFO(
+  SPDLOG_DEBUG(
     "Retransmit last TFTP packet: {}",
     Packets::PacketTypeDescription::instance().name( Packets::Packet::packetType( transmitPacketV ) ) );
 
   try
   {
+    TraceRing::instance().record( TraceEvent::Retransmit, traceSessionV, transmitPacketV );
+
     // Update statistic
     Packets::PacketStatistic::globalTransmit().packet(
       Packets::Packet::packetType( transmitPacketV ),
       transmitPacketV.size() );
 
+    PacketCapture::instance().record(
+      CaptureRecord::Role::Client,
+      CaptureRecord::Direction::Transmit,
+      traceSessionV,
+      receiveEndpointV,
+      transmitPacketV );
+
     socketV.send( boost::asio::buffer( transmitPacketV ) );
 
     ++transmitCounterV;
+    ++retransmissionsV;
 
-    timerV.expires_after( receiveTimeoutV );
-
-    timerV.async_wait( std::bind_front( &OperationImpl::timeoutHandler, this ) );
+    timerV.expiresAfter( receiveTimeoutV, [ this ]{ timeoutHandler(); } );
   }
   catch ( const boost::system::system_error &err )
   {
@@ -563,23 +681,8 @@ void OperationImpl::timeoutHandler( const boost::system::error_code& errorCode )
   }
 }
 
-void OperationImpl::timeoutDallyHandler( const boost::system::error_code &errorCode )
+void OperationImpl::timeoutDallyHandler()
 {
-  // operation aborted (a packet has been received)
-  if ( boost::asio::error::operation_aborted == errorCode )
-  {
-    return;
-  }
-
-  // internal (timer) error occurred
-  if ( errorCode )
-  {
-    SPDLOG_ERROR( "Timer error: {}", errorCode.message() );
-
-    finished( TransferStatus::CommunicationError );
-    return;
-  }
-
   SPDLOG_INFO( "Dally Timeout Completed - Finish" );
 
   finished( TransferStatus::Successful );
@@ -18,12 +18,18 @@
 #include <tftp/packets/PacketHandler.hpp>
 #include <tftp/packets/Packets.hpp>
 
+#include <tftp/SocketBufferSizes.hpp>
+#include <tftp/TftpOptionsConfiguration.hpp>
+#include <tftp/TimerWheel.hpp>
+
 #include <boost/asio/ip/udp.hpp>
 #include <boost/asio/io_context.hpp>
-#include <boost/asio/system_timer.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace Tftp::Clients {
@@ -53,6 +59,10 @@ class OperationImpl : protected Packets::PacketHandler
      * @brief Initialises the Operation
      *
      * Creates the socket.
+     * The socket is bound, when the local address or the local port is set.
+     *
+     * @throw CommunicationException
+     *   When the socket cannot be opened or bound.
      **/
     void initialise();
 
@@ -82,6 +92,20 @@ class OperationImpl : protected Packets::PacketHandler
      **/
     [[nodiscard]] const Packets::ErrorInformation& errorInformation() const;
 
+    /**
+     * @brief Returns the Number of transferred Data Bytes.
+     *
+     * @return Number of transferred data bytes.
+     **/
+    [[nodiscard]] uint64_t transferredBytes() const noexcept;
+
+    /**
+     * @brief Returns the Number of Retransmissions.
+     *
+     * @return Number of retransmissions.
+     **/
+    [[nodiscard]] unsigned int retransmissions() const noexcept;
+
     /**
      * @brief Updates TFTP Timeout.
      *
@@ -117,22 +141,20 @@ class OperationImpl : protected Packets::PacketHandler
     void local( boost::asio::ip::udp::endpoint local );
 
     /**
-     * @brief Updates the Operation Completed Handler
+     * @brief Updates the Socket Buffer Sizes.
      *
-     * @param[in] handler
-     *   Handler which is called on completion of the operation.
+     * @param[in] socketBufferSizes
+     *   Socket buffer sizes, applied when the socket is opened.
      **/
-    void completionHandler( OperationCompletedHandler handler );
+    void socketBufferSizes( SocketBufferSizes socketBufferSizes );
 
     /**
-     * @brief Updates the Maximum Receive Packet Size.
-     *
-     * This operation should be called, if a block size option has been negotiated.
+     * @brief Updates the Operation Completed Handler
      *
-     * @param[in] maxReceivePacketSize
-     *   New max receive packet size.
+     * @param[in] handler
+     *   Handler which is called on completion of the operation.
      **/
-    void maxReceivePacketSize( uint16_t maxReceivePacketSize );
+    void completionHandler( OperationCompletedHandler handler );
 
     /**
      * @brief Update the Receive Timeout Value.
@@ -144,6 +166,42 @@ class OperationImpl : protected Packets::PacketHandler
      **/
     void receiveTimeout( std::chrono::seconds receiveTimeout ) noexcept;
 
+    /**
+     * @brief Returns the Block Size Option to request.
+     *
+     * When TftpOptionsConfiguration::blockSizeAutomatic is set and the path MTU to the remote is known, the largest
+     * block size fitting into the path MTU is returned, limited by TftpOptionsConfiguration::blockSizeOption.
+     * Otherwise, TftpOptionsConfiguration::blockSizeOption is returned.
+     *
+     * @param[in] optionsConfiguration
+     *   TFTP Options Configuration.
+     *
+     * @return Block size option to request.
+     **/
+    [[nodiscard]] boost::optional< uint16_t > requestBlockSize(
+      const TftpOptionsConfiguration &optionsConfiguration ) const;
+
+    /**
+     * @brief Informs about the negotiated, automatically selected Block Size.
+     *
+     * When the operation fails by timeout after the negotiation, the path MTU of the remote is lowered for following
+     * transfers (see PathMtu::timeout()).
+     *
+     * @param[in] blockSize
+     *   Negotiated block size.
+     **/
+    void automaticBlockSize( uint16_t blockSize ) noexcept;
+
+    /**
+     * @brief Informs about transferred Data.
+     *
+     * Called for each new (not retransmitted) DATA packet.
+     *
+     * @param[in] bytes
+     *   Payload size of the DATA packet.
+     **/
+    void dataTransferred( std::size_t bytes ) noexcept;
+
     /**
      * @brief Sends the packet to the TFTP server identified by its default endpoint.
      *
@@ -237,60 +295,50 @@ class OperationImpl : protected Packets::PacketHandler
 
   private:
     /**
-     * @brief Called, when data is received the first time.
+     * @brief Called, when the socket is readable the first time.
      *
+     * The packet is received into the ReceiveBuffer of the current thread.
      * In case the first time a TFTP packet has been received, the source is checked and the socket is connected to the
      * final endpoint.
      *
      * @param[in] errorCode
      *   error status of operation.
-     * @param[in] bytesTransferred
-     *   Number of bytes transferred.
      *
      * @throw CommunicationException
      *   On communication error.
      **/
-    void receiveFirstHandler( const boost::system::error_code &errorCode, std::size_t bytesTransferred );
+    void receiveFirstHandler( const boost::system::error_code &errorCode );
 
     /**
-     * @brief Handler, which is called when new data has been received.
+     * @brief Handler, which is called when the socket is readable.
+     *
+     * The packet is received into the ReceiveBuffer of the current thread and handed to the packet handlers.
      *
      * @param[in] errorCode
-     *   Receive error code
-     * @param[in] bytesTransferred
-     *   Number of bytes transferred.
+     *   Wait error code
      **/
-    void receiveHandler( const boost::system::error_code &errorCode, std::size_t bytesTransferred );
+    void receiveHandler( const boost::system::error_code &errorCode );
 
     /**
      * @brief Called when no data is received for the first sent packet.
      *
      * If the retransmission counter has not exceeded, the last sent packet is retransmitted.
-     *
-     * @param[in] errorCode
-     *   error status of operation.
      **/
-    void timeoutFirstHandler( const boost::system::error_code &errorCode );
+    void timeoutFirstHandler();
 
     /**
      * @brief Called when no data is received for the sent packet.
      *
      * If the retransmission counter has not exceeded, the last sent packet is retransmitted.
-     *
-     * @param[in] errorCode
-     *   error status of operation.
      **/
-    void timeoutHandler( const boost::system::error_code &errorCode );
+    void timeoutHandler();
 
     /**
      * @brief Called when no data is received for the last sent ACK.
      *
      * The operation is finished successfully.
-     *
-     * @param[in] errorCode
-     *   error status of operation.
      **/
-    void timeoutDallyHandler( const boost::system::error_code &errorCode );
+    void timeoutDallyHandler();
 
     //! Receive timeout (can be updated by option negotiation)
     std::chrono::seconds receiveTimeoutV{ DefaultTftpReceiveTimeout };
@@ -303,14 +351,14 @@ class OperationImpl : protected Packets::PacketHandler
     boost::asio::ip::udp::endpoint remoteV;
     //! Local address, where the client handles the request from.
     boost::asio::ip::udp::endpoint localV;
+    //! Socket Buffer Sizes
+    SocketBufferSizes socketBufferSizesV;
 
     //! TFTP UDP Socket
     boost::asio::ip::udp::socket socketV;
-    //! Receive timeout timer
-    boost::asio::system_timer timerV;
+    //! Receive timeout timer (registered with the timer wheel of the I/O context)
+    TimerWheel::Timer timerV;
 
-    //! Received Packet Data
-    Helper::RawData receivePacketV;
     //! Remote Address (set, when server sends the first answer)
     boost::asio::ip::udp::endpoint receiveEndpointV;
     //! Last transmitted Packet (used for retries)
@@ -319,6 +367,14 @@ class OperationImpl : protected Packets::PacketHandler
     unsigned int transmitCounterV{ 0U };
     //! Error info
     Packets::ErrorInformation errorInformationV;
+    //! Transferred Data Bytes
+    uint64_t transferredBytesV{ 0U };
+    //! Number of Retransmissions
+    unsigned int retransmissionsV{ 0U };
+    //! Trace Session Identifier (assigned on initialisation)
+    uint32_t traceSessionV{ 0U };
+    //! Negotiated, automatically selected Block Size
+    std::optional< uint16_t > automaticBlockSizeV;
 };
 
 }
@@ -28,6 +28,7 @@
 
 #include <boost/exception/all.hpp>
 
+#include <exception>
 #include <utility>
 
 namespace Tftp::Clients {
@@ -60,12 +61,14 @@ void ReadOperationImpl::request()
     // initialise options with additional options
     Packets::Options options{ additionalOptionsV };
 
-    // Block size Option
-    if ( optionsConfigurationV.blockSizeOption )
+    // Block size Option (might be selected by the path MTU)
+    blockSizeOptionV = requestBlockSize( optionsConfigurationV );
+
+    if ( blockSizeOptionV )
     {
       options.try_emplace(
         std::string{ Packets::TftpOptions_name( Packets::KnownOptions::BlockSize ) },
-        std::to_string( *optionsConfigurationV.blockSizeOption ) );
+        std::to_string( *blockSizeOptionV ) );
     }
 
     // Timeout Option
@@ -112,6 +115,16 @@ const Packets::ErrorInformation& ReadOperationImpl::errorInformation() const
   return OperationImpl::errorInformation();
 }
 
+uint64_t ReadOperationImpl::transferredBytes() const
+{
+  return OperationImpl::transferredBytes();
+}
+
+unsigned int ReadOperationImpl::retransmissions() const
+{
+  return OperationImpl::retransmissions();
+}
+
 ReadOperation& ReadOperationImpl::tftpTimeout( const std::chrono::seconds timeout )
 {
   OperationImpl::tftpTimeout( timeout );
@@ -134,13 +147,6 @@ ReadOperation& ReadOperationImpl::optionsConfiguration( TftpOptionsConfiguration
 {
   optionsConfigurationV = std::move( optionsConfiguration );
 
-  maxReceivePacketSize(
-    static_cast< uint16_t >(
-      Packets::DefaultTftpDataPacketHeaderSize
-      + std::max(
-        Packets::DefaultDataSize,
-        optionsConfigurationV.blockSizeOption.get_value_or( Packets::DefaultDataSize ) ) ) );
-
   return *this;
 }
 
@@ -192,10 +198,23 @@ ReadOperation& ReadOperationImpl::local( const boost::asio::ip::udp::endpoint lo
   return *this;
 }
 
+ReadOperation& ReadOperationImpl::socketBufferSizes( SocketBufferSizes socketBufferSizes )
+{
+  OperationImpl::socketBufferSizes( std::move( socketBufferSizes ) );
+  return *this;
+}
+
 void ReadOperationImpl::finished( const TransferStatus status, Packets::ErrorInformation errorInformation ) noexcept
 {
-  // Complete data handler
-  dataHandlerV->finished();
+  // Complete data handler - errors cannot be reported to the server anymore
+  try
+  {
+    dataHandlerV->finished();
+  }
+  catch ( const std::exception &e )
+  {
+    SPDLOG_ERROR( "Error finishing data: {}", e.what() );
+  }
 
   // Inform base class
   OperationImpl::finished( status, std::move( errorInformation ) );
@@ -210,7 +229,7 @@ void ReadOperationImpl::dataPacket(
   // Check retransmission of last packet
   if ( dataPacket.blockNumber() == lastReceivedBlockNumber )
   {
-    SPDLOG_WARN( "Received the last data package again. Re-ACK them." );
+    SPDLOG_DEBUG( "Received the last data package again. Re-ACK them." );
 
     // Retransmit last ACK packet
     send( Packets::AcknowledgementPacket{ lastReceivedBlockNumber } );
@@ -286,6 +305,7 @@ void ReadOperationImpl::dataPacket(
 
   // pass data
   dataHandlerV->receivedData( dataPacket.data() );
+  dataTransferred( dataPacket.dataSize() );
 
   // increment received block number
   ++lastReceivedBlockNumber;
@@ -371,7 +391,7 @@ void ReadOperationImpl::optionsAcknowledgementPacket(
       Packets::BlockSizeOptionMin,
       Packets::BlockSizeOptionMax );
 
-  if ( !optionsConfigurationV.blockSizeOption && blockSizeValue )
+  if ( !blockSizeOptionV && blockSizeValue )
   {
     SPDLOG_ERROR( "Block Size Option isn't expected" );
 
@@ -397,7 +417,7 @@ void ReadOperationImpl::optionsAcknowledgementPacket(
 
   if ( blockSizeValue )
   {
-    if ( *blockSizeValue > *optionsConfigurationV.blockSizeOption )
+    if ( *blockSizeValue > *blockSizeOptionV )
     {
       SPDLOG_ERROR( "Received Block Size Option bigger than negotiated" );
 
@@ -412,6 +432,11 @@ void ReadOperationImpl::optionsAcknowledgementPacket(
     }
 
     receiveDataSize = *blockSizeValue;
+
+    if ( optionsConfigurationV.blockSizeAutomatic )
+    {
+      automaticBlockSize( receiveDataSize );
+    }
   }
 
   // Timeout Option
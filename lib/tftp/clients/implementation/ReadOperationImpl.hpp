@@ -53,6 +53,12 @@ class ReadOperationImpl final : public ReadOperation, private OperationImpl
     //! @copydoc ReadOperation::errorInformation() const
     [[nodiscard]] const Packets::ErrorInformation& errorInformation() const override;
 
+    //! @copydoc ReadOperation::transferredBytes() const
+    [[nodiscard]] uint64_t transferredBytes() const override;
+
+    //! @copydoc ReadOperation::retransmissions() const
+    [[nodiscard]] unsigned int retransmissions() const override;
+
     //! @copydoc ReadOperation::tftpTimeout()
     ReadOperation& tftpTimeout( std::chrono::seconds timeout ) override;
 
@@ -89,6 +95,9 @@ class ReadOperationImpl final : public ReadOperation, private OperationImpl
     //! @copydoc ReadOperation::local()
     ReadOperation& local( boost::asio::ip::udp::endpoint local ) override;
 
+    //! @copydoc ReadOperation::socketBufferSizes()
+    ReadOperation& socketBufferSizes( SocketBufferSizes socketBufferSizes ) override;
+
   private:
     //! @copydoc OperationImpl::finished()
     void finished( TransferStatus status, Packets::ErrorInformation errorInformation = {} ) noexcept override;
@@ -122,6 +131,8 @@ class ReadOperationImpl final : public ReadOperation, private OperationImpl
 
     //! TFTP Options Configuration.
     TftpOptionsConfiguration optionsConfigurationV;
+    //! Requested Block Size Option (selected on request)
+    boost::optional< uint16_t > blockSizeOptionV;
     //! Additional TFTP options sent to the server.
     Packets::Options additionalOptionsV;
     //! Option Negotiation Handler
@@ -62,12 +62,14 @@ void WriteOperationImpl::request()
     // initialise options with additional options
     Packets::Options options{ additionalOptionsV };
 
-    // Block size Option
-    if ( optionsConfigurationV.blockSizeOption )
+    // Block size Option (might be selected by the path MTU)
+    blockSizeOptionV = requestBlockSize( optionsConfigurationV );
+
+    if ( blockSizeOptionV )
     {
       options.try_emplace(
         std::string{ Packets::TftpOptions_name( Packets::KnownOptions::BlockSize ) },
-        std::to_string( *optionsConfigurationV.blockSizeOption ) );
+        std::to_string( *blockSizeOptionV ) );
     }
 
     // Timeout Option
@@ -121,6 +123,16 @@ const Packets::ErrorInformation& WriteOperationImpl::errorInformation() const
   return OperationImpl::errorInformation();
 }
 
+uint64_t WriteOperationImpl::transferredBytes() const
+{
+  return OperationImpl::transferredBytes();
+}
+
+unsigned int WriteOperationImpl::retransmissions() const
+{
+  return OperationImpl::retransmissions();
+}
+
 WriteOperation& WriteOperationImpl::tftpTimeout( const std::chrono::seconds timeout )
 {
   OperationImpl::tftpTimeout( timeout );
@@ -187,6 +199,12 @@ WriteOperation &WriteOperationImpl::local( const boost::asio::ip::udp::endpoint
   return *this;
 }
 
+WriteOperation &WriteOperationImpl::socketBufferSizes( SocketBufferSizes socketBufferSizes )
+{
+  OperationImpl::socketBufferSizes( std::move( socketBufferSizes ) );
+  return *this;
+}
+
 void WriteOperationImpl::finished( const TransferStatus status, Packets::ErrorInformation errorInformation ) noexcept
 {
   // Complete data handler
@@ -211,6 +229,7 @@ void WriteOperationImpl::sendData()
 
   // send the packet
   send( data );
+  dataTransferred( data.dataSize() );
 }
 
 void WriteOperationImpl::dataPacket(
@@ -235,7 +254,7 @@ void WriteOperationImpl::acknowledgementPacket(
   // check retransmission
   if ( acknowledgementPacket.blockNumber() == lastReceivedBlockNumber )
   {
-    SPDLOG_WARN(
+    SPDLOG_DEBUG(
       "Received previous ACK packet: retry of last data package - "
       "IGNORE it due to Sorcerer's Apprentice Syndrome" );
 
@@ -336,7 +355,7 @@ void WriteOperationImpl::optionsAcknowledgementPacket(
       Packets::BlockSizeOptionMin,
       Packets::BlockSizeOptionMax );
 
-  if ( !optionsConfigurationV.blockSizeOption && blockSizeValue )
+  if ( !blockSizeOptionV && blockSizeValue )
   {
     SPDLOG_ERROR( "Block Size Option isn't expected" );
 
@@ -362,7 +381,7 @@ void WriteOperationImpl::optionsAcknowledgementPacket(
 
   if ( blockSizeValue )
   {
-    if ( *blockSizeValue > *optionsConfigurationV.blockSizeOption )
+    if ( *blockSizeValue > *blockSizeOptionV )
     {
       SPDLOG_ERROR( "Received Block Size Option bigger than negotiated" );
 
@@ -377,6 +396,11 @@ void WriteOperationImpl::optionsAcknowledgementPacket(
     }
 
     transmitDataSize = *blockSizeValue;
+
+    if ( optionsConfigurationV.blockSizeAutomatic )
+    {
+      automaticBlockSize( transmitDataSize );
+    }
   }
 
   // Timeout Option
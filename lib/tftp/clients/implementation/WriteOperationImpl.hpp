@@ -53,6 +53,12 @@ class WriteOperationImpl final : public WriteOperation, private OperationImpl
     //! @copydoc WriteOperation::errorInformation() const
     [[nodiscard]] const Packets::ErrorInformation& errorInformation() const override;
 
+    //! @copydoc WriteOperation::transferredBytes() const
+    [[nodiscard]] uint64_t transferredBytes() const override;
+
+    //! @copydoc WriteOperation::retransmissions() const
+    [[nodiscard]] unsigned int retransmissions() const override;
+
     //! @copydoc WriteOperation::tftpTimeout()
     WriteOperation& tftpTimeout( std::chrono::seconds timeout ) override;
 
@@ -86,6 +92,9 @@ class WriteOperationImpl final : public WriteOperation, private OperationImpl
     //! @copydoc WriteOperation::local()
     WriteOperation& local( boost::asio::ip::udp::endpoint local ) override;
 
+    //! @copydoc WriteOperation::socketBufferSizes()
+    WriteOperation& socketBufferSizes( SocketBufferSizes socketBufferSizes ) override;
+
   private:
     //! @copydoc OperationImpl::finished()
     void finished( TransferStatus status, Packets::ErrorInformation errorInformation = {} ) noexcept override;
@@ -125,6 +134,8 @@ class WriteOperationImpl final : public WriteOperation, private OperationImpl
 
     //! TFTP Options Configuration.
     TftpOptionsConfiguration optionsConfigurationV;
+    //! Requested Block Size Option (selected on request)
+    boost::optional< uint16_t > blockSizeOptionV;
     //! Additional TFTP options sent to the server.
     Packets::Options additionalOptionsV;
     //! Option Negotiation Handler
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of the Asynchronous TFTP Client Operations.
+ **/
+
+#include <tftp/clients/AsyncOperations.hpp>
+#include <tftp/clients/Client.hpp>
+#include <tftp/clients/OperationResult.hpp>
+
+#include <tftp/servers/Server.hpp>
+#include <tftp/servers/ReadOperation.hpp>
+
+#include <tftp/files/NullSinkFile.hpp>
+#include <tftp/files/NullSourceFile.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace Tftp::Clients {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( ClientsTest )
+BOOST_AUTO_TEST_SUITE( AsyncOperationsTest )
+
+namespace {
+
+//! Handler, which is called with the remote endpoint of a received request
+using RequestHandler = std::function< void( const boost::asio::ip::udp::endpoint &remote ) >;
+
+//! Starts a server on the loopback address, which calls @p requestHandler on received requests
+Servers::ServerPtr startServer( boost::asio::io_context &ioContext, const RequestHandler &requestHandler )
+{
+  auto server{ Servers::Server::instance( ioContext ) };
+  server->serverAddress( { boost::asio::ip::address_v4::loopback(), 0U } )
+    .requestHandler(
+      [ requestHandler ](
+        const boost::asio::ip::udp::endpoint &remote,
+        RequestType,
+        std::string_view,
+        Packets::TransferMode,
+        const Packets::TftpOptions &,
+        const Packets::Options & )
+      {
+        requestHandler( remote );
+      } );
+  server->start();
+
+  return server;
+}
+
+}
+
+//! asyncRead() with use_awaitable completes with the transferred bytes
+BOOST_AUTO_TEST_CASE( asyncReadAwaitable )
+{
+  boost::asio::io_context ioContext{ 1 };
+
+  Servers::ReadOperationPtr serverOperation;
+  const Servers::ServerPtr server{ startServer(
+    ioContext,
+    [ & ]( const boost::asio::ip::udp::endpoint &remote )
+    {
+      serverOperation = server->readOperation();
+      serverOperation->dataHandler( std::make_shared< Files::NullSourceFile >( 10000U ) )
+        .remote( remote );
+      serverOperation->start();
+    } ) };
+
+  const auto client{ Client::instance( ioContext ) };
+  std::optional< OperationResult > result;
+
+  boost::asio::co_spawn(
+    ioContext,
+    [ & ]() -> boost::asio::awaitable< void >
+    {
+      result = co_await asyncRead(
+        *client,
+        server->localEndpoint(),
+        "file",
+        std::make_shared< Files::NullSinkFile >(),
+        boost::asio::use_awaitable );
+    },
+    boost::asio::detached );
+
+  ioContext.run_for( std::chrono::milliseconds{ 500 } );
+
+  BOOST_REQUIRE( result );
+  BOOST_CHECK( *result );
+  BOOST_CHECK_EQUAL( result->transferredBytes, 10000U );
+  BOOST_CHECK_EQUAL( result->retransmissions, 0U );
+  BOOST_CHECK( !result->errorInformation );
+}
+
+//! asyncRead() with use_awaitable is aborted through the cancellation slot
+BOOST_AUTO_TEST_CASE( asyncReadCancellation )
+{
+  boost::asio::io_context ioContext{ 1 };
+
+  // the request is never answered
+  const Servers::ServerPtr server{ startServer( ioContext, []( const boost::asio::ip::udp::endpoint & ){} ) };
+
+  const auto client{ Client::instance( ioContext ) };
+  client->tftpTimeoutDefault( std::chrono::seconds{ 10 } );
+
+  boost::asio::cancellation_signal cancellationSignal;
+  std::optional< OperationResult > result;
+
+  boost::asio::co_spawn(
+    ioContext,
+    [ & ]() -> boost::asio::awaitable< void >
+    {
+      result = co_await asyncRead(
+        *client,
+        server->localEndpoint(),
+        "file",
+        std::make_shared< Files::NullSinkFile >(),
+        boost::asio::bind_cancellation_slot( cancellationSignal.slot(), boost::asio::use_awaitable ) );
+    },
+    boost::asio::detached );
+
+  ioContext.run_for( std::chrono::milliseconds{ 200 } );
+  BOOST_CHECK( !result );
+
+  cancellationSignal.emit( boost::asio::cancellation_type::terminal );
+  ioContext.run_for( std::chrono::milliseconds{ 200 } );
+
+  BOOST_REQUIRE( result );
+  BOOST_CHECK( result->status == TransferStatus::Aborted );
+  BOOST_CHECK_EQUAL( result->transferredBytes, 0U );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,367 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Files::ChunkStore.
+ **/
+
+#include "ChunkStore.hpp"
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <random>
+#include <system_error>
+#include <utility>
+
+#if !defined( _WIN32 )
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Tftp::Files {
+
+namespace {
+
+/**
+ * @brief Returns the Chunk Identifier as Hex String.
+ *
+ * @param[in] id
+ *   Chunk Identifier.
+ *
+ * @return 64 lower case hex digits.
+ **/
+std::string hexString( const ChunkStore::ChunkId &id )
+{
+  std::string result;
+  result.reserve( 2U * id.size() );
+
+  for ( const auto byte : id )
+  {
+    std::format_to( std::back_inserter( result ), "{:02x}", std::to_integer< unsigned int >( byte ) );
+  }
+
+  return result;
+}
+
+/**
+ * @brief Writes the Data to a new File and flushes it to the Storage Device.
+ *
+ * The chunk is renamed to its final path afterwards, so a crash does not leave a truncated chunk behind, which is
+ * referenced by a manifest.
+ *
+ * @param[in] path
+ *   File path.
+ * @param[in] data
+ *   File content.
+ *
+ * @return If the data has been written.
+ **/
+bool writeFile( const std::filesystem::path &path, Helper::ConstRawDataSpan data )
+{
+#if defined( _WIN32 )
+  std::ofstream stream{ path, std::ios::out | std::ios::trunc | std::ios::binary };
+  // NOLINTNEXTLINE( cppcoreguidelines-pro-type-reinterpret-cast ): std::byte to char
+  stream.write( reinterpret_cast< const char * >( data.data() ), static_cast< std::streamsize >( data.size() ) );
+  stream.close();
+
+  return static_cast< bool >( stream );
+#else
+  const auto fileDescriptor{ ::open(
+    path.c_str(),
+    O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+    S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH ) };
+
+  if ( fileDescriptor < 0 )
+  {
+    return false;
+  }
+
+  while ( !data.empty() )
+  {
+    const auto written{ ::write( fileDescriptor, data.data(), data.size() ) };
+
+    if ( written < 0 )
+    {
+      if ( EINTR == errno )
+      {
+        continue;
+      }
+
+      break;
+    }
+
+    data = data.subspan( static_cast< std::size_t >( written ) );
+  }
+
+  const bool written{ data.empty() && ( 0 == ::fsync( fileDescriptor ) ) };
+
+  return ( 0 == ::close( fileDescriptor ) ) && written;
+#endif
+}
+
+/**
+ * @brief Decodes one Manifest Line.
+ *
+ * @param[in] line
+ *   Line without terminating LF.
+ *
+ * @return Manifest entry.
+ * @retval std::nullopt
+ *   When the line is malformed.
+ **/
+std::optional< ChunkStore::Chunk > decodeLine( const std::string_view line )
+{
+  constexpr auto DigitCount{ 2U * Sha256::DigestSize };
+
+  if ( ( line.size() < DigitCount + 2U ) || ( line[ DigitCount ] != ' ' ) )
+  {
+    return {};
+  }
+
+  ChunkStore::Chunk chunk{};
+
+  for ( std::size_t index{ 0U }; index < chunk.id.size(); ++index )
+  {
+    unsigned int value{};
+    const auto * const first{ line.data() + ( 2U * index ) };
+
+    if ( const auto [ ptr, ec ]{ std::from_chars( first, first + 2U, value, 16 ) };
+      ( ec != std::errc{} ) || ( ptr != first + 2U ) )
+    {
+      return {};
+    }
+
+    chunk.id[ index ] = static_cast< std::byte >( value );
+  }
+
+  const auto sizeString{ line.substr( DigitCount + 1U ) };
+  const auto * const sizeEnd{ sizeString.data() + sizeString.size() };
+
+  if ( const auto [ ptr, ec ]{ std::from_chars( sizeString.data(), sizeEnd, chunk.size ) };
+    ( ec != std::errc{} ) || ( ptr != sizeEnd ) || ( chunk.size > ChunkStore::MaxChunkSize ) )
+  {
+    return {};
+  }
+
+  return chunk;
+}
+
+}
+
+std::string ChunkStore::Statistic::toString() const
+{
+  return std::format(
+    "{:22}: {}\n{:22}: {}\n{:22}: {}\n{:22}: {}\n",
+    "Stored Chunks",
+    storedChunks,
+    "Stored Bytes",
+    storedBytes,
+    "Duplicate Chunks",
+    duplicateChunks,
+    "Duplicate Bytes",
+    duplicateBytes );
+}
+
+Helper::RawData ChunkStore::encode( const Manifest &manifest )
+{
+  std::string text{ ManifestMagic };
+
+  for ( const auto &chunk : manifest )
+  {
+    text += std::format( "{} {}\n", hexString( chunk.id ), chunk.size );
+  }
+
+  Helper::RawData data( text.size() );
+  std::ranges::transform( text, data.begin(), []( const char c ){ return static_cast< std::byte >( c ); } );
+
+  return data;
+}
+
+std::optional< ChunkStore::Manifest > ChunkStore::decode( const Helper::ConstRawDataSpan data )
+{
+  std::string_view text{
+    // NOLINTNEXTLINE( cppcoreguidelines-pro-type-reinterpret-cast ): std::byte to char view
+    reinterpret_cast< const char * >( data.data() ),
+    data.size() };
+
+  if ( !text.starts_with( ManifestMagic ) )
+  {
+    return {};
+  }
+
+  text.remove_prefix( ManifestMagic.size() );
+
+  Manifest manifest;
+
+  while ( !text.empty() )
+  {
+    const auto lineEnd{ text.find( '\n' ) };
+
+    if ( lineEnd == std::string_view::npos )
+    {
+      return {};
+    }
+
+    const auto chunk{ decodeLine( text.substr( 0U, lineEnd ) ) };
+
+    if ( !chunk )
+    {
+      return {};
+    }
+
+    manifest.push_back( *chunk );
+    text.remove_prefix( lineEnd + 1U );
+  }
+
+  return manifest;
+}
+
+uint64_t ChunkStore::size( const Manifest &manifest ) noexcept
+{
+  uint64_t size{ 0U };
+
+  for ( const auto &chunk : manifest )
+  {
+    size += chunk.size;
+  }
+
+  return size;
+}
+
+ChunkStore::ChunkStore( std::filesystem::path directory ) :
+  directoryV{ std::move( directory ) },
+  instanceV{ ( static_cast< uint64_t >( std::random_device{}() ) << 32U ) | std::random_device{}() }
+{
+  std::error_code error;
+  std::filesystem::create_directories( directoryV, error );
+
+  if ( error || !std::filesystem::is_directory( directoryV ) )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ "Error creating chunk store directory" }
+      << boost::errinfo_file_name{ directoryV.string() } );
+  }
+}
+
+const std::filesystem::path& ChunkStore::directory() const noexcept
+{
+  return directoryV;
+}
+
+ChunkStore::Chunk ChunkStore::store( const Helper::ConstRawDataSpan data )
+{
+  if ( data.size() > MaxChunkSize )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Chunk too big" } );
+  }
+
+  Sha256 sha256;
+  sha256.update( data );
+
+  const Chunk chunk{ sha256.value(), static_cast< uint32_t >( data.size() ) };
+  const auto path{ chunkPath( chunk.id ) };
+
+  if ( std::filesystem::exists( path ) )
+  {
+    const std::lock_guard lock{ mutexV };
+    ++statisticV.duplicateChunks;
+    statisticV.duplicateBytes += data.size();
+    return chunk;
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories( path.parent_path(), error );
+
+  auto temporary{ path };
+  temporary += std::format( ".{:016x}.{}.tmp", instanceV, temporaryV++ );
+
+  if ( !writeFile( temporary, data ) )
+  {
+    std::filesystem::remove( temporary, error );
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ "Error writing chunk" }
+      << boost::errinfo_file_name{ temporary.string() } );
+  }
+
+  // a concurrently stored chunk has the same content and is replaced
+  std::filesystem::rename( temporary, path, error );
+
+  if ( error )
+  {
+    std::filesystem::remove( temporary, error );
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ "Error storing chunk" }
+      << boost::errinfo_file_name{ path.string() } );
+  }
+
+  const std::lock_guard lock{ mutexV };
+  ++statisticV.storedChunks;
+  statisticV.storedBytes += data.size();
+
+  return chunk;
+}
+
+Helper::RawData ChunkStore::load( const Chunk &chunk ) const
+{
+  const auto path{ chunkPath( chunk.id ) };
+
+  // the size is taken from the manifest - do not allocate arbitrary sizes
+  if ( chunk.size > MaxChunkSize )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ "Chunk too big" }
+      << boost::errinfo_file_name{ path.string() } );
+  }
+
+  std::ifstream stream{ path, std::ios::in | std::ios::binary };
+  Helper::RawData data( chunk.size );
+
+  // NOLINTNEXTLINE( cppcoreguidelines-pro-type-reinterpret-cast ): std::byte to char
+  stream.read( reinterpret_cast< char * >( data.data() ), static_cast< std::streamsize >( data.size() ) );
+
+  if ( !stream || ( std::char_traits< char >::eof() != stream.peek() ) )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ "Chunk missing or corrupted" }
+      << boost::errinfo_file_name{ path.string() } );
+  }
+
+  return data;
+}
+
+ChunkStore::Statistic ChunkStore::statistic() const
+{
+  const std::lock_guard lock{ mutexV };
+  return statisticV;
+}
+
+std::filesystem::path ChunkStore::chunkPath( const ChunkId &id ) const
+{
+  const auto name{ hexString( id ) };
+  return directoryV / name.substr( 0U, 2U ) / name;
+}
+
+std::ostream& operator<<( std::ostream &stream, const ChunkStore::Statistic &statistic )
+{
+  return ( stream << statistic.toString() );
+}
+
+}
@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Files::ChunkStore.
+ **/
+
+#ifndef TFTP_FILES_CHUNKSTORE_HPP
+#define TFTP_FILES_CHUNKSTORE_HPP
+
+#include <tftp/files/Files.hpp>
+
+#include <tftp/Sha256.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Tftp::Files {
+
+/**
+ * @brief Content-addressed Chunk Store.
+ *
+ * Storage backend of the DeduplicatingFile.
+ * Chunks are identified by their SHA-256 digest and stored once as `<directory>/<xx>/<digest>`, where `<xx>` are the
+ * first two hex digits of the digest.
+ * Storing a chunk, which already exists, does not write to disk.
+ *
+ * A file is represented by a manifest, which lists the chunks of the file in order.
+ * The manifest is a text file:
+ * @code
+ * TFTP-MANIFEST 1
+ * <digest as 64 hex digits> <chunk size>
+ * ...
+ * @endcode
+ *
+ * Chunks are written to a temporary file and renamed, so concurrent stores of the same chunk (also by different
+ * processes) are safe.
+ * Chunks are never removed by the store.
+ **/
+class TFTP_EXPORT ChunkStore final
+{
+  public:
+    //! Chunk Identifier (SHA-256 Digest of the Chunk Data)
+    using ChunkId = Sha256::Digest;
+
+    //! Manifest Entry
+    struct Chunk
+    {
+      //! Chunk Identifier
+      ChunkId id;
+      //! Chunk Size
+      uint32_t size;
+    };
+
+    //! Manifest (Chunks of a %File in Order)
+    using Manifest = std::vector< Chunk >;
+
+    //! Store Statistic
+    struct TFTP_EXPORT Statistic
+    {
+      //! Number of newly stored Chunks
+      uint64_t storedChunks{ 0U };
+      //! Number of Bytes of newly stored Chunks
+      uint64_t storedBytes{ 0U };
+      //! Number of already existing Chunks
+      uint64_t duplicateChunks{ 0U };
+      //! Number of Bytes of already existing Chunks
+      uint64_t duplicateBytes{ 0U };
+
+      /**
+       * @brief Returns the Statistic as printable String.
+       *
+       * @return Statistic as string representation.
+       **/
+      [[nodiscard]] std::string toString() const;
+    };
+
+    //! Manifest Header (first Line)
+    static constexpr std::string_view ManifestMagic{ "TFTP-MANIFEST 1\n" };
+
+    /**
+     * @brief Maximum Chunk Size.
+     *
+     * Manifests are read from files, which may have been uploaded.
+     * Bigger chunks are rejected, so a manifest cannot cause big allocations.
+     **/
+    static constexpr std::size_t MaxChunkSize{ 16U * 1024U };
+
+    /**
+     * @brief Encodes the Manifest.
+     *
+     * @param[in] manifest
+     *   Manifest.
+     *
+     * @return Encoded manifest.
+     **/
+    [[nodiscard]] static Helper::RawData encode( const Manifest &manifest );
+
+    /**
+     * @brief Decodes the Manifest.
+     *
+     * @param[in] data
+     *   Encoded manifest.
+     *
+     * @return Decoded manifest.
+     * @retval std::nullopt
+     *   When @p data is not a valid manifest or a chunk exceeds MaxChunkSize.
+     **/
+    [[nodiscard]] static std::optional< Manifest > decode( Helper::ConstRawDataSpan data );
+
+    /**
+     * @brief Returns the Size of the File described by the Manifest.
+     *
+     * @param[in] manifest
+     *   Manifest.
+     *
+     * @return Sum of the chunk sizes.
+     **/
+    [[nodiscard]] static uint64_t size( const Manifest &manifest ) noexcept;
+
+    /**
+     * @brief Opens the Store.
+     *
+     * @param[in] directory
+     *   Store directory. Created, if it does not exist.
+     *
+     * @throw TftpException
+     *   When the directory cannot be created.
+     **/
+    explicit ChunkStore( std::filesystem::path directory );
+
+    /**
+     * @brief Returns the Store Directory.
+     *
+     * @return Store directory.
+     **/
+    [[nodiscard]] const std::filesystem::path& directory() const noexcept;
+
+    /**
+     * @brief Stores the Chunk, if it is not already stored.
+     *
+     * @param[in] data
+     *   Chunk data.
+     *
+     * @return Manifest entry of the chunk.
+     *
+     * @throw TftpException
+     *   When the chunk exceeds MaxChunkSize or cannot be written.
+     **/
+    Chunk store( Helper::ConstRawDataSpan data );
+
+    /**
+     * @brief Loads the Chunk.
+     *
+     * @param[in] chunk
+     *   Manifest entry of the chunk.
+     *
+     * @return Chunk data.
+     *
+     * @throw TftpException
+     *   When the chunk exceeds MaxChunkSize, does not exist, or has not the expected size.
+     **/
+    [[nodiscard]] Helper::RawData load( const Chunk &chunk ) const;
+
+    /**
+     * @brief Returns the Store Statistic.
+     *
+     * @return Store statistic.
+     **/
+    [[nodiscard]] Statistic statistic() const;
+
+  private:
+    /**
+     * @brief Returns the Path of the Chunk.
+     *
+     * @param[in] id
+     *   Chunk Identifier.
+     *
+     * @return Path of the chunk file.
+     **/
+    [[nodiscard]] std::filesystem::path chunkPath( const ChunkId &id ) const;
+
+    //! Store Directory
+    std::filesystem::path directoryV;
+    //! Random Identifier of the Instance for unique temporary Filenames
+    const uint64_t instanceV;
+    //! Counter for unique temporary Filenames
+    std::atomic< uint64_t > temporaryV{ 0U };
+    //! Mutex protecting the statistic
+    mutable std::mutex mutexV;
+    //! Statistic
+    Statistic statisticV;
+};
+
+/**
+ * @brief Stream output operator of @p ChunkStore::Statistic.
+ *
+ * @param[in,out] stream
+ *   Output stream
+ * @param[in] statistic
+ *   Store Statistic
+ *
+ * @return @p stream for chaining
+ **/
+TFTP_EXPORT std::ostream& operator<<( std::ostream &stream, const ChunkStore::Statistic &statistic );
+
+}
+
+#endif
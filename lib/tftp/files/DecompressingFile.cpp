@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Files::DecompressingFile.
+ **/
+
+#include "DecompressingFile.hpp"
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <boost/exception/all.hpp>
+#include <boost/iostreams/categories.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <format>
+#include <ios>
+#include <ranges>
+#include <utility>
+
+namespace Tftp::Files {
+
+namespace {
+
+//! Zstandard Frame Magic Number (little endian)
+constexpr std::array< std::byte, 4U > ZstdMagic{
+  std::byte{ 0x28U }, std::byte{ 0xB5U }, std::byte{ 0x2FU }, std::byte{ 0xFDU } };
+
+/**
+ * @brief Decodes a little endian Value.
+ *
+ * @param[in] data
+ *   Encoded value.
+ *
+ * @return Decoded value.
+ **/
+uint64_t littleEndian( const Helper::ConstRawDataSpan data ) noexcept
+{
+  uint64_t value{ 0U };
+
+  for ( const auto byte : data | std::views::reverse )
+  {
+    value = ( value << 8U ) | std::to_integer< uint64_t >( byte );
+  }
+
+  return value;
+}
+
+//! Boost.Iostreams Source, which reads the compressed data from a File
+class FileSource
+{
+  public:
+    //! Character Type
+    using char_type = char;
+    //! Device Category
+    using category = boost::iostreams::source_tag;
+
+    /**
+     * @brief Creates the Source.
+     *
+     * @param[in] file
+     *   Compressed file.
+     **/
+    explicit FileSource( File &file ) noexcept :
+      fileV{ &file }
+    {
+    }
+
+    /**
+     * @brief Reads compressed data.
+     *
+     * @param[out] buffer
+     *   Buffer.
+     * @param[in] size
+     *   Size of buffer.
+     *
+     * @return Number of characters read.
+     * @retval -1
+     *   On end of file.
+     **/
+    std::streamsize read( char * const buffer, const std::streamsize size )
+    {
+      const auto data{ fileV->sendData( static_cast< size_t >( size ) ) };
+
+      if ( data.empty() )
+      {
+        return -1;
+      }
+
+      std::ranges::transform( data, buffer, []( const std::byte byte ){ return static_cast< char >( byte ); } );
+      return static_cast< std::streamsize >( data.size() );
+    }
+
+  private:
+    //! Compressed File
+    File *fileV;
+};
+
+}
+
+std::optional< DecompressingFile::Compression > DecompressingFile::compression(
+  const std::string_view extension ) noexcept
+{
+  if ( ".gz" == extension )
+  {
+    return Compression::Gzip;
+  }
+
+  if ( ".zst" == extension )
+  {
+    return Compression::Zstd;
+  }
+
+  return {};
+}
+
+std::optional< uint64_t > DecompressingFile::uncompressedSize(
+  const Compression compression,
+  const uint64_t compressedSize,
+  const ReadHandler &read )
+{
+  // ISIZE of gzip cannot be verified for multi-member files
+  if ( Compression::Zstd != compression )
+  {
+    return {};
+  }
+
+  const auto header{ read( 0U, HeaderSize ) };
+  const Helper::ConstRawDataSpan headerSpan{ header };
+
+  // magic number and frame header descriptor
+  if ( ( header.size() < ZstdMagic.size() + 1U )
+    || !std::ranges::equal( headerSpan.first( ZstdMagic.size() ), ZstdMagic ) )
+  {
+    return {};
+  }
+
+  const auto descriptor{ std::to_integer< unsigned int >( header[ ZstdMagic.size() ] ) };
+  const auto contentSizeFlag{ descriptor >> 6U };
+  const bool singleSegment{ 0U != ( descriptor & 0x20U ) };
+  const bool checksum{ 0U != ( descriptor & 0x04U ) };
+  constexpr std::array< size_t, 4U > DictionaryIdSizes{ 0U, 1U, 2U, 4U };
+  constexpr std::array< size_t, 4U > ContentSizeSizes{ 0U, 2U, 4U, 8U };
+
+  const auto contentSizeSize{
+    ( ( 0U == contentSizeFlag ) && singleSegment ) ? 1U : ContentSizeSizes[ contentSizeFlag ] };
+
+  if ( 0U == contentSizeSize )
+  {
+    return {};
+  }
+
+  // skip window descriptor and dictionary ID
+  const auto offset{
+    ZstdMagic.size() + 1U + ( singleSegment ? 0U : 1U ) + DictionaryIdSizes[ descriptor & 0x03U ] };
+
+  if ( header.size() < offset + contentSizeSize )
+  {
+    return {};
+  }
+
+  auto size{ littleEndian( headerSpan.subspan( offset, contentSizeSize ) ) };
+  if ( 2U == contentSizeSize )
+  {
+    size += 256U;
+  }
+
+  // the content size covers this frame only - further frames must not follow
+  constexpr std::size_t BlockHeaderSize{ 3U };
+  constexpr std::size_t ChecksumSize{ 4U };
+  uint64_t position{ offset + contentSizeSize };
+
+  for ( ;; )
+  {
+    const auto blockHeader{ read( position, BlockHeaderSize ) };
+
+    if ( blockHeader.size() != BlockHeaderSize )
+    {
+      return {};
+    }
+
+    const auto block{ littleEndian( blockHeader ) };
+    const auto blockType{ ( block >> 1U ) & 0x03U };
+
+    // reserved block type
+    if ( 3U == blockType )
+    {
+      return {};
+    }
+
+    // RLE blocks store a single byte
+    position += BlockHeaderSize + ( ( 1U == blockType ) ? 1U : ( block >> 3U ) );
+
+    // last block
+    if ( 0U != ( block & 0x01U ) )
+    {
+      break;
+    }
+
+    if ( position >= compressedSize )
+    {
+      return {};
+    }
+  }
+
+  if ( checksum )
+  {
+    position += ChecksumSize;
+  }
+
+  if ( position != compressedSize )
+  {
+    return {};
+  }
+
+  return size;
+}
+
+DecompressingFile::DecompressingFile(
+  FilePtr file,
+  const Compression compression,
+  const std::optional< uint64_t > size ) :
+  fileV{ std::move( file ) },
+  compressionV{ compression },
+  sizeV{ size }
+{
+  if ( !fileV )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "File not provided" } );
+  }
+}
+
+DecompressingFile::~DecompressingFile() noexcept = default;
+
+void DecompressingFile::start()
+{
+  fileV->start();
+
+  auto stream{ std::make_unique< boost::iostreams::filtering_istream >() };
+
+  switch ( compressionV )
+  {
+    case Compression::Gzip:
+      stream->push( boost::iostreams::gzip_decompressor{} );
+      break;
+
+    case Compression::Zstd:
+      stream->push( boost::iostreams::zstd_decompressor{} );
+      break;
+
+    default:
+      BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Invalid compression" } );
+  }
+
+  stream->push( FileSource{ *fileV } );
+  streamV = std::move( stream );
+}
+
+void DecompressingFile::finished()
+{
+  streamV.reset();
+  fileV->finished();
+}
+
+bool DecompressingFile::receivedTransferSize( [[maybe_unused]] const uint64_t transferSize )
+{
+  return false;
+}
+
+void DecompressingFile::receivedData( [[maybe_unused]] Helper::ConstRawDataSpan data )
+{
+  BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Receive operation not supported" } );
+}
+
+std::optional< uint64_t> DecompressingFile::requestedTransferSize()
+{
+  return sizeV;
+}
+
+Helper::RawData DecompressingFile::sendData( const size_t maxSize )
+{
+  if ( !streamV )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "File not started" } );
+  }
+
+  Helper::RawData data( maxSize );
+
+  try
+  {
+    // NOLINTNEXTLINE( cppcoreguidelines-pro-type-reinterpret-cast ): std::byte to char buffer
+    streamV->read( reinterpret_cast< char * >( data.data() ), static_cast< std::streamsize >( maxSize ) );
+  }
+  catch ( const std::exception &e )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ std::format( "Error decompressing the file: {}", e.what() ) } );
+  }
+
+  if ( streamV->bad() )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Error decompressing the file" } );
+  }
+
+  data.resize( static_cast< size_t >( streamV->gcount() ) );
+
+  return data;
+}
+
+}
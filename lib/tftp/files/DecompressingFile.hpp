@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Files::DecompressingFile.
+ **/
+
+#ifndef TFTP_FILES_DECOMPRESSINGFILE_HPP
+#define TFTP_FILES_DECOMPRESSINGFILE_HPP
+
+#include <tftp/files/Files.hpp>
+#include <tftp/files/File.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace Tftp::Files {
+
+/**
+ * @brief Decompressing %File.
+ *
+ * %File decorator, which transmits the decompressed content of a compressed file (gzip or Zstandard).
+ * The compressed data is read block by block from the underlying file and decompressed as requested by sendData().
+ * Therefore, the uncompressed file is never stored completely.
+ *
+ * The uncompressed size cannot be determined from the compressed stream in general.
+ * It must be provided on construction to be announced by the `tsize` option.
+ * uncompressedSize() extracts it from the frame header of a Zstandard file.
+ *
+ * This file can only be used for transmit operations.
+ **/
+class TFTP_EXPORT DecompressingFile final : public File
+{
+  public:
+    //! Compression Format
+    enum class Compression
+    {
+      //! gzip (RFC 1952)
+      Gzip,
+      //! Zstandard (RFC 8878)
+      Zstd
+    };
+
+    /**
+     * @brief Reads Data of the compressed File.
+     *
+     * @param[in] offset
+     *   Position within the compressed file.
+     * @param[in] size
+     *   Number of bytes to read.
+     *
+     * @return Read data - less than @p size bytes at the end of the file or on errors.
+     **/
+    using ReadHandler = std::function< Helper::RawData( uint64_t offset, std::size_t size ) >;
+
+    //! Maximum Size of a Zstandard Frame Header
+    static constexpr std::size_t HeaderSize{ 18U };
+
+    /**
+     * @brief Returns the Compression Format of a Filename Extension.
+     *
+     * @param[in] extension
+     *   Filename extension (including the dot).
+     *
+     * @return Compression format.
+     * @retval std::nullopt
+     *   When the extension is not known.
+     **/
+    [[nodiscard]] static std::optional< Compression > compression( std::string_view extension ) noexcept;
+
+    /**
+     * @brief Returns the uncompressed Size stored within the compressed File.
+     *
+     * - Zstandard: Frame content size of the frame header (if present).
+     *   The size is only returned, when the file consists of this single frame.
+     *   Therefore, the block headers of the frame are read up to the end of the file.
+     * - gzip: No size is returned.
+     *   `ISIZE` of the trailer is the size modulo 2^32 of the last member only, which cannot be checked without
+     *   decompressing the file.
+     *
+     * For other files, the size must be provided otherwise (e.g. by a sidecar file).
+     *
+     * @param[in] compression
+     *   Compression format.
+     * @param[in] compressedSize
+     *   Size of the compressed file.
+     * @param[in] read
+     *   Reads data of the compressed file.
+     *
+     * @return Uncompressed size.
+     * @retval std::nullopt
+     *   When the size is not stored, not verifiable, or the data is not valid.
+     **/
+    [[nodiscard]] static std::optional< uint64_t > uncompressedSize(
+      Compression compression,
+      uint64_t compressedSize,
+      const ReadHandler &read );
+
+    /**
+     * @brief Creates the Decompressing File on top of @p file.
+     *
+     * @param[in] file
+     *   File, which provides the compressed data.
+     * @param[in] compression
+     *   Compression format.
+     * @param[in] size
+     *   Uncompressed size.
+     *   If not provided, the transfer size is not announced.
+     *
+     * @throw TftpException
+     *   When @p file is not provided.
+     **/
+    DecompressingFile( FilePtr file, Compression compression, std::optional< uint64_t > size = {} );
+
+    //! Destructor
+    ~DecompressingFile() noexcept override;
+
+    /**
+     * @copydoc File::start
+     *
+     * Starts the underlying file and the decompression.
+     **/
+    void start() override;
+
+    /**
+     * @copydoc File::finished()
+     **/
+    void finished() override;
+
+    /**
+     * @copydoc File::receivedTransferSize()
+     *
+     * @return Always false (receive operation not supported).
+     **/
+    [[nodiscard]] bool receivedTransferSize( uint64_t transferSize ) override;
+
+    /**
+     * @copydoc File::receivedData()
+     *
+     * @throw TftpException
+     *   Always (receive operation not supported).
+     **/
+    void receivedData( Helper::ConstRawDataSpan data ) override;
+
+    /**
+     * @copydoc File::requestedTransferSize()
+     **/
+    [[nodiscard]] std::optional< uint64_t> requestedTransferSize() override;
+
+    /**
+     * @copydoc File::sendData()
+     *
+     * @throw TftpException
+     *   When the compressed data is corrupted.
+     **/
+    [[nodiscard]] Helper::RawData sendData( size_t maxSize ) override;
+
+  private:
+    //! Underlying File
+    FilePtr fileV;
+    //! Compression Format
+    const Compression compressionV;
+    //! Uncompressed Size
+    std::optional< uint64_t > sizeV;
+    //! Decompression Stream
+    std::unique_ptr< std::istream > streamV;
+};
+
+}
+
+#endif
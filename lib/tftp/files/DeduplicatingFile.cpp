@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Files::DeduplicatingFile.
+ **/
+
+#include "DeduplicatingFile.hpp"
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <utility>
+
+namespace Tftp::Files {
+
+namespace {
+
+//! Read Size for the Manifest
+constexpr std::size_t ManifestReadSize{ 4096U };
+
+/**
+ * @brief Creates the Gear Table.
+ *
+ * The values are pseudo random (SplitMix64), but fixed, as the chunk boundaries must not change between runs.
+ *
+ * @return Gear Table.
+ **/
+consteval std::array< uint64_t, 256U > gearTable() noexcept
+{
+  std::array< uint64_t, 256U > table{};
+  uint64_t state{ 0x5449'4654'4344'4331U };
+
+  for ( auto &value : table )
+  {
+    state += 0x9E37'79B9'7F4A'7C15U;
+    uint64_t z{ state };
+    z = ( z ^ ( z >> 30U ) ) * 0xBF58'476D'1CE4'E5B9U;
+    z = ( z ^ ( z >> 27U ) ) * 0x94D0'49BB'1331'11EBU;
+    value = z ^ ( z >> 31U );
+  }
+
+  return table;
+}
+
+//! Gear Table (random Value for each Byte)
+constexpr auto GearTable{ gearTable() };
+
+}
+
+DeduplicatingFile::DeduplicatingFile(
+  const Operation operation,
+  std::shared_ptr< ChunkStore > store,
+  FilePtr file ) :
+  operationV{ operation },
+  storeV{ std::move( store ) },
+  fileV{ std::move( file ) }
+{
+  if ( !storeV )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Chunk store not provided" } );
+  }
+
+  if ( !fileV )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "File not provided" } );
+  }
+}
+
+void DeduplicatingFile::start()
+{
+  fileV->start();
+
+  manifestV.clear();
+  isManifestV = false;
+  pendingV.clear();
+  pendingPositionV = 0U;
+  nextChunkV = 0U;
+  hashV = 0U;
+
+  if ( Operation::Transmit != operationV )
+  {
+    return;
+  }
+
+  // a plain file is kept as pending data, which is sent first
+  pendingV = fileV->sendData( ChunkStore::ManifestMagic.size() );
+
+  if ( !std::ranges::equal(
+    pendingV,
+    ChunkStore::ManifestMagic,
+    []( const std::byte lhs, const char rhs ){ return lhs == static_cast< std::byte >( rhs ); } ) )
+  {
+    return;
+  }
+
+  for ( ;; )
+  {
+    const auto data{ fileV->sendData( ManifestReadSize ) };
+    pendingV.insert( pendingV.end(), data.begin(), data.end() );
+
+    if ( data.size() < ManifestReadSize )
+    {
+      break;
+    }
+  }
+
+  auto manifest{ ChunkStore::decode( pendingV ) };
+
+  if ( !manifest )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Invalid manifest" } );
+  }
+
+  manifestV = std::move( *manifest );
+  isManifestV = true;
+  pendingV.clear();
+}
+
+void DeduplicatingFile::finished()
+{
+  std::exception_ptr error;
+
+  if ( Operation::Receive == operationV )
+  {
+    try
+    {
+      if ( !pendingV.empty() )
+      {
+        storeChunk();
+      }
+
+      fileV->receivedData( ChunkStore::encode( manifestV ) );
+    }
+    catch ( ... )
+    {
+      error = std::current_exception();
+    }
+  }
+
+  fileV->finished();
+
+  if ( error )
+  {
+    std::rethrow_exception( error );
+  }
+}
+
+bool DeduplicatingFile::receivedTransferSize( const uint64_t transferSize )
+{
+  return fileV->receivedTransferSize( transferSize );
+}
+
+void DeduplicatingFile::receivedData( Helper::ConstRawDataSpan data )
+{
+  while ( !data.empty() )
+  {
+    const auto boundary{ chunkBoundary( data ) };
+    const auto size{ boundary.value_or( data.size() ) };
+
+    pendingV.insert( pendingV.end(), data.begin(), data.begin() + static_cast< std::ptrdiff_t >( size ) );
+    data = data.subspan( size );
+
+    if ( boundary )
+    {
+      storeChunk();
+    }
+  }
+}
+
+std::optional< uint64_t> DeduplicatingFile::requestedTransferSize()
+{
+  if ( isManifestV )
+  {
+    return ChunkStore::size( manifestV );
+  }
+
+  return fileV->requestedTransferSize();
+}
+
+Helper::RawData DeduplicatingFile::sendData( const size_t maxSize )
+{
+  Helper::RawData data;
+  data.reserve( maxSize );
+
+  while ( data.size() < maxSize )
+  {
+    if ( pendingPositionV == pendingV.size() )
+    {
+      if ( !isManifestV )
+      {
+        // remaining data of the plain file
+        const auto remaining{ fileV->sendData( maxSize - data.size() ) };
+        data.insert( data.end(), remaining.begin(), remaining.end() );
+        break;
+      }
+
+      if ( nextChunkV == manifestV.size() )
+      {
+        break;
+      }
+
+      pendingV = storeV->load( manifestV[ nextChunkV++ ] );
+      pendingPositionV = 0U;
+      continue;
+    }
+
+    const auto size{ std::min( maxSize - data.size(), pendingV.size() - pendingPositionV ) };
+    const auto first{ pendingV.begin() + static_cast< std::ptrdiff_t >( pendingPositionV ) };
+    data.insert( data.end(), first, first + static_cast< std::ptrdiff_t >( size ) );
+    pendingPositionV += size;
+  }
+
+  return data;
+}
+
+std::optional< std::size_t > DeduplicatingFile::chunkBoundary( const Helper::ConstRawDataSpan data ) noexcept
+{
+  auto chunkSize{ pendingV.size() };
+  std::size_t position{ 0U };
+
+  // the first bytes of a chunk are not hashed, as a boundary is not allowed there
+  if ( chunkSize < MinChunkSize )
+  {
+    position = std::min( MinChunkSize - chunkSize, data.size() );
+    chunkSize += position;
+  }
+
+  for ( ; position < data.size(); ++position )
+  {
+    hashV = ( hashV << 1U ) + GearTable[ std::to_integer< uint8_t >( data[ position ] ) ];
+    ++chunkSize;
+
+    if ( ( 0U == ( hashV & BoundaryMask ) ) || ( chunkSize >= MaxChunkSize ) )
+    {
+      return position + 1U;
+    }
+  }
+
+  return {};
+}
+
+void DeduplicatingFile::storeChunk()
+{
+  manifestV.push_back( storeV->store( pendingV ) );
+  pendingV.clear();
+  hashV = 0U;
+}
+
+}
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Files::DeduplicatingFile.
+ **/
+
+#ifndef TFTP_FILES_DEDUPLICATINGFILE_HPP
+#define TFTP_FILES_DEDUPLICATINGFILE_HPP
+
+#include <tftp/files/Files.hpp>
+#include <tftp/files/File.hpp>
+#include <tftp/files/ChunkStore.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace Tftp::Files {
+
+/**
+ * @brief Deduplicating %File.
+ *
+ * %File decorator, which stores the data within a ChunkStore and the manifest of the data within another file:
+ * - On receive, the data is split into chunks by content-defined chunking.
+ *   Each chunk is stored once within the chunk store.
+ *   When the operation is finished, the manifest is written to the underlying file.
+ * - On transmit, the manifest is read from the underlying file and the data is assembled from the chunk store.
+ *   When the underlying file is not a manifest, it is transmitted unchanged.
+ *
+ * The chunk boundaries are determined by a Gear rolling hash (FastCDC), so they depend on the local content only.
+ * An insertion or deletion changes the surrounding chunks, but not the following ones.
+ * Nearly identical files (e.g. configuration backups of many devices) share most of their chunks, and storage
+ * grows with the actual changes.
+ *
+ * The manifest is written, when the operation is finished - also when it has been aborted.
+ * This matches the behaviour of the other files, which keep the received part of the data.
+ * The server write operation finishes the file before the last data packet is acknowledged, so a manifest, which
+ * cannot be written, fails the transfer.
+ **/
+class TFTP_EXPORT DeduplicatingFile final : public File
+{
+  public:
+    //! Minimum Chunk Size
+    static constexpr std::size_t MinChunkSize{ 1024U };
+    //! Maximum Chunk Size
+    static constexpr std::size_t MaxChunkSize{ ChunkStore::MaxChunkSize };
+    /**
+     * @brief Hash Mask for an average Chunk Size of 4 KiB (above the minimum size).
+     *
+     * The upper bits are used, as they depend on the last 64 bytes, while the lower bits depend on the last bytes
+     * only.
+     **/
+    static constexpr uint64_t BoundaryMask{ 0xFFF0'0000'0000'0000U };
+
+    /**
+     * @brief Creates the Deduplicating File on top of @p file.
+     *
+     * @param[in] operation
+     *   Receive or Transmit Operation.
+     * @param[in] store
+     *   Chunk store.
+     * @param[in] file
+     *   File, which holds the manifest.
+     *
+     * @throw TftpException
+     *   When @p store or @p file is not provided.
+     **/
+    DeduplicatingFile( Operation operation, std::shared_ptr< ChunkStore > store, FilePtr file );
+
+    /**
+     * @copydoc File::start
+     *
+     * Starts the underlying file.
+     * On transmit, the manifest is read.
+     *
+     * @throw TftpException
+     *   When the underlying file starts like a manifest, but is not a valid one.
+     **/
+    void start() override;
+
+    /**
+     * @copydoc File::finished()
+     *
+     * On receive, the last chunk is stored and the manifest is written to the underlying file.
+     * The underlying file is finished in any case.
+     *
+     * @throw TftpException
+     *   When the last chunk or the manifest cannot be stored.
+     **/
+    void finished() override;
+
+    /**
+     * @copydoc File::receivedTransferSize()
+     *
+     * The size is passed on, as the manifest is smaller than the data.
+     **/
+    [[nodiscard]] bool receivedTransferSize( uint64_t transferSize ) override;
+
+    /**
+     * @copydoc File::receivedData()
+     **/
+    void receivedData( Helper::ConstRawDataSpan data ) override;
+
+    /**
+     * @copydoc File::requestedTransferSize()
+     **/
+    [[nodiscard]] std::optional< uint64_t> requestedTransferSize() override;
+
+    /**
+     * @copydoc File::sendData()
+     **/
+    [[nodiscard]] Helper::RawData sendData( size_t maxSize ) override;
+
+  private:
+    /**
+     * @brief Searches the next Chunk Boundary within @p data.
+     *
+     * The current chunk consists of the pending data followed by @p data.
+     *
+     * @param[in] data
+     *   Received data.
+     *
+     * @return Number of bytes of @p data, which belong to the current chunk.
+     * @retval std::nullopt
+     *   When the current chunk does not end within @p data.
+     **/
+    [[nodiscard]] std::optional< std::size_t > chunkBoundary( Helper::ConstRawDataSpan data ) noexcept;
+
+    //! Stores the pending Chunk and adds it to the Manifest.
+    void storeChunk();
+
+    //! Actual Operation
+    const Operation operationV;
+    //! Chunk Store
+    std::shared_ptr< ChunkStore > storeV;
+    //! Underlying File (Manifest)
+    FilePtr fileV;
+    //! Manifest (receive: stored chunks, transmit: chunks to send)
+    ChunkStore::Manifest manifestV;
+    //! Underlying File is a Manifest (transmit)
+    bool isManifestV{ false };
+    //! Pending Data (receive: current chunk, transmit: loaded chunk or start of a plain file)
+    Helper::RawData pendingV;
+    //! Position within the Pending Data (transmit)
+    std::size_t pendingPositionV{ 0U };
+    //! Next Manifest Entry to load (transmit)
+    std::size_t nextChunkV{ 0U };
+    //! Rolling Hash of the current Chunk (receive)
+    uint64_t hashV{ 0U };
+};
+
+}
+
+#endif
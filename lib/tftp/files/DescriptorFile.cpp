@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Files::DescriptorFile.
+ **/
+
+#include "DescriptorFile.hpp"
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/exception/all.hpp>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <unistd.h>
+
+namespace Tftp::Files {
+
+DescriptorFile::SharedDescriptor DescriptorFile::sharedDescriptor( const int fileDescriptor )
+{
+  return { new int{ fileDescriptor }, []( const int * const descriptor )
+  {
+    if ( *descriptor >= 0 )
+    {
+      ::close( *descriptor );
+    }
+    delete descriptor;
+  } };
+}
+
+DescriptorFile::DescriptorFile(
+  const Operation operation,
+  const int fileDescriptor,
+  const std::optional< uint64_t > size ) :
+  DescriptorFile{ operation, sharedDescriptor( fileDescriptor ), size }
+{
+}
+
+DescriptorFile::DescriptorFile(
+  const Operation operation,
+  SharedDescriptor descriptor,
+  const std::optional< uint64_t > size ) :
+  operationV{ operation },
+  descriptorV{ std::move( descriptor ) },
+  sizeV{ size }
+{
+}
+
+DescriptorFile::DescriptorFile( Opener opener ) :
+  operationV{ Operation::Receive },
+  openerV{ std::move( opener ) }
+{
+}
+
+void DescriptorFile::start()
+{
+  offsetV = 0U;
+
+  // a lazily opened file is truncated by its opener
+  if ( ( File::Operation::Receive == operationV ) && descriptorV && ( ::ftruncate( *descriptorV, 0 ) < 0 ) )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ "Error truncating the file" }
+      << boost::errinfo_errno{ errno } );
+  }
+}
+
+void DescriptorFile::finished()
+{
+}
+
+bool DescriptorFile::receivedTransferSize( const uint64_t transferSize )
+{
+  // If no size is provided
+  if ( !sizeV )
+  {
+    // Always accept the file based on size
+    return true;
+  }
+
+  // Accept the file if size is matching the maximum allowed one.
+  return ( transferSize <= sizeV );
+}
+
+void DescriptorFile::receivedData( Helper::ConstRawDataSpan data )
+{
+  if ( !descriptorV )
+  {
+    const auto fileDescriptor{ openerV() };
+
+    if ( fileDescriptor < 0 )
+    {
+      BOOST_THROW_EXCEPTION( TftpException{}
+        << Helper::AdditionalInfo{ "Error opening the file" }
+        << boost::errinfo_errno{ errno } );
+    }
+
+    descriptorV = sharedDescriptor( fileDescriptor );
+  }
+
+  while ( !data.empty() )
+  {
+    const auto written{
+      ::pwrite( *descriptorV, data.data(), data.size(), static_cast< off_t >( offsetV ) ) };
+
+    if ( written < 0 )
+    {
+      if ( EINTR == errno )
+      {
+        continue;
+      }
+
+      SPDLOG_ERROR( "Error writing file: {}", std::generic_category().message( errno ) );
+      return;
+    }
+
+    offsetV += static_cast< uint64_t >( written );
+    data = data.subspan( static_cast< size_t >( written ) );
+  }
+}
+
+std::optional< uint64_t> DescriptorFile::requestedTransferSize()
+{
+  return sizeV;
+}
+
+Helper::RawData DescriptorFile::sendData( const size_t maxSize )
+{
+  Helper::RawData data( maxSize );
+  size_t size{ 0U };
+
+  while ( size < maxSize )
+  {
+    const auto read{
+      ::pread( *descriptorV, data.data() + size, maxSize - size, static_cast< off_t >( offsetV + size ) ) };
+
+    if ( read < 0 )
+    {
+      if ( EINTR == errno )
+      {
+        continue;
+      }
+
+      SPDLOG_ERROR( "Error reading file: {}", std::generic_category().message( errno ) );
+      break;
+    }
+
+    // end of file
+    if ( 0 == read )
+    {
+      break;
+    }
+
+    size += static_cast< size_t >( read );
+  }
+
+  offsetV += size;
+  data.resize( size );
+
+  return data;
+}
+
+}
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Files::DescriptorFile.
+ **/
+
+#ifndef TFTP_FILES_DESCRIPTORFILE_HPP
+#define TFTP_FILES_DESCRIPTORFILE_HPP
+
+#include <tftp/files/Files.hpp>
+#include <tftp/files/File.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace Tftp::Files {
+
+/**
+ * @brief Descriptor %File.
+ *
+ * %File implementation, which uses an already opened POSIX file descriptor for file I/O handling.
+ * In contrast to StreamFile, the file is not opened by name again.
+ * Therefore, the transferred file is exactly the file, which has been checked on request.
+ *
+ * The file descriptor is owned by this instance and closed on destruction.
+ * A shared descriptor can be used by several transfers at the same time, as the file is accessed by positional I/O
+ * (`pread()`/ `pwrite()`) with an own offset per instance.
+ *
+ * This class is only available on POSIX platforms.
+ *
+ * @sa Servers::FileResolver
+ **/
+class TFTP_EXPORT DescriptorFile final : public File
+{
+  public:
+    //! Shared File Descriptor - closed, when the last user is destructed.
+    using SharedDescriptor = std::shared_ptr< const int >;
+    //! Opens the File Descriptor of a lazily opened File (returns `-1` and sets errno on error).
+    using Opener = std::function< int() >;
+
+    /**
+     * @brief Takes ownership of the File Descriptor for sharing.
+     *
+     * @param[in] fileDescriptor
+     *   Opened file descriptor (ownership is taken).
+     *
+     * @return Shared File Descriptor.
+     **/
+    [[nodiscard]] static SharedDescriptor sharedDescriptor( int fileDescriptor );
+
+    /**
+     * @brief Creates the DescriptorFile for the given File Descriptor.
+     *
+     * @param[in] operation
+     *   Receive or Transmit Operation.
+     * @param[in] fileDescriptor
+     *   Opened file descriptor (ownership is taken).
+     *   Must be opened for reading on transmit and for writing on receive operation.
+     * @param[in] size
+     *   Size of the file.
+     *   In Receive Operation, the transfer is rejected if @p size is too big.
+     *   On Transmit Operation this size is provided.
+     **/
+    DescriptorFile( Operation operation, int fileDescriptor, std::optional< uint64_t > size = {} );
+
+    /**
+     * @brief Creates the DescriptorFile for the given shared File Descriptor.
+     *
+     * @param[in] operation
+     *   Receive or Transmit Operation.
+     * @param[in] descriptor
+     *   Shared file descriptor.
+     *   Must be opened for reading on transmit and for writing on receive operation.
+     * @param[in] size
+     *   Size of the file.
+     *   In Receive Operation, the transfer is rejected if @p size is too big.
+     *   On Transmit Operation this size is provided.
+     **/
+    DescriptorFile( Operation operation, SharedDescriptor descriptor, std::optional< uint64_t > size = {} );
+
+    /**
+     * @brief Creates the DescriptorFile for Reception into a lazily opened File.
+     *
+     * The file is opened by @p opener, when the first data is received.
+     * Therefore, a transfer, which fails before, does not create or truncate the file.
+     *
+     * @param[in] opener
+     *   Opens the file for writing (e.g. with `O_CREAT` and `O_TRUNC`).
+     **/
+    explicit DescriptorFile( Opener opener );
+
+    //! Destructor
+    ~DescriptorFile() noexcept override = default;
+
+    DescriptorFile( const DescriptorFile & ) = delete;
+    DescriptorFile& operator=( const DescriptorFile & ) = delete;
+
+    /**
+     * @copydoc File::start
+     *
+     * Rewinds the file offset of this instance.
+     * On receive operation, the already opened file is truncated.
+     **/
+    void start() override;
+
+    /**
+     * @copydoc File::finished()
+     **/
+    void finished() override;
+
+    /**
+     * @copydoc File::receivedTransferSize()
+     **/
+    [[nodiscard]] bool receivedTransferSize( uint64_t transferSize ) override;
+
+    /**
+     * @copydoc File::receivedData()
+     *
+     * A lazily opened file is opened on the first call.
+     *
+     * @throw TftpException
+     *   When the lazily opened file cannot be opened.
+     **/
+    void receivedData( Helper::ConstRawDataSpan data ) override;
+
+    /**
+     * @copydoc File::requestedTransferSize()
+     **/
+    [[nodiscard]] std::optional< uint64_t> requestedTransferSize() override;
+
+    /**
+     * @copydoc File::sendData()
+     **/
+    [[nodiscard]] Helper::RawData sendData( size_t maxSize ) override;
+
+  private:
+    //! Actual Operation
+    const Operation operationV;
+    //! File Descriptor (not set until a lazily opened file is opened)
+    SharedDescriptor descriptorV;
+    //! Opener of a lazily opened File
+    Opener openerV;
+    //! Current File Offset
+    uint64_t offsetV{ 0U };
+    //! File Size
+    std::optional< uint64_t > sizeV;
+};
+
+}
+
+#endif
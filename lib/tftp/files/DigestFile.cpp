@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Files::DigestFile.
+ **/
+
+#include "DigestFile.hpp"
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <format>
+#include <ostream>
+#include <utility>
+
+namespace Tftp::Files {
+
+std::string DigestFile::Digest::toString() const
+{
+  auto result{ std::format( "{:22}: {}\n{:22}: {:08x}\n", "Size", size, "CRC-32C", crc32c ) };
+
+  if ( sha256 )
+  {
+    result += std::format( "{:22}: ", "SHA-256" );
+
+    for ( const auto byte : *sha256 )
+    {
+      result += std::format( "{:02x}", std::to_integer< unsigned int >( byte ) );
+    }
+
+    result += '\n';
+  }
+
+  return result;
+}
+
+DigestFile::DigestFile( FilePtr file, const bool sha256 ) :
+  fileV{ std::move( file ) }
+{
+  if ( !fileV )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "File not provided" } );
+  }
+
+  if ( sha256 )
+  {
+    sha256V.emplace();
+  }
+}
+
+DigestFile::Digest DigestFile::digest() const
+{
+  return {
+    sizeV,
+    crc32cV.value(),
+    sha256V ? std::optional{ sha256V->value() } : std::nullopt };
+}
+
+void DigestFile::start()
+{
+  fileV->start();
+
+  sizeV = 0U;
+  crc32cV.reset();
+
+  if ( sha256V )
+  {
+    sha256V->reset();
+  }
+}
+
+void DigestFile::finished()
+{
+  fileV->finished();
+}
+
+bool DigestFile::receivedTransferSize( const uint64_t transferSize )
+{
+  return fileV->receivedTransferSize( transferSize );
+}
+
+void DigestFile::receivedData( const Helper::ConstRawDataSpan data )
+{
+  update( data );
+  fileV->receivedData( data );
+}
+
+std::optional< uint64_t> DigestFile::requestedTransferSize()
+{
+  return fileV->requestedTransferSize();
+}
+
+Helper::RawData DigestFile::sendData( const size_t maxSize )
+{
+  auto data{ fileV->sendData( maxSize ) };
+  update( data );
+  return data;
+}
+
+void DigestFile::update( const Helper::ConstRawDataSpan data ) noexcept
+{
+  sizeV += data.size();
+  crc32cV.update( data );
+
+  if ( sha256V )
+  {
+    sha256V->update( data );
+  }
+}
+
+std::ostream& operator<<( std::ostream &stream, const DigestFile::Digest &digest )
+{
+  return ( stream << digest.toString() );
+}
+
+}
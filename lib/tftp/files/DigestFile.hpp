@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Files::DigestFile.
+ **/
+
+#ifndef TFTP_FILES_DIGESTFILE_HPP
+#define TFTP_FILES_DIGESTFILE_HPP
+
+#include <tftp/files/Files.hpp>
+#include <tftp/files/File.hpp>
+
+#include <tftp/Crc32c.hpp>
+#include <tftp/Sha256.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+namespace Tftp::Files {
+
+/**
+ * @brief Digest %File.
+ *
+ * %File decorator, which calculates the digests of the transferred data block by block, while it is passed to or
+ * from the underlying file.
+ * Thus, the integrity of a transferred file can be checked without reading the file again.
+ *
+ * The CRC-32C is always calculated.
+ * The SHA-256 digest is optional, as it is considerably more expensive.
+ *
+ * The digests are restarted by start().
+ * After the operation has been completed, digest() returns the digests of the whole file.
+ **/
+class TFTP_EXPORT DigestFile final : public File
+{
+  public:
+    //! Digests of the transferred Data
+    struct TFTP_EXPORT Digest
+    {
+      //! Number of transferred Bytes
+      uint64_t size{ 0U };
+      //! CRC-32C
+      uint32_t crc32c{ 0U };
+      //! SHA-256 (if enabled)
+      std::optional< Sha256::Digest > sha256;
+
+      /**
+       * @brief Returns the Digests as printable String.
+       *
+       * @return Digests as string representation.
+       **/
+      [[nodiscard]] std::string toString() const;
+    };
+
+    /**
+     * @brief Creates the Digest File on top of @p file.
+     *
+     * @param[in] file
+     *   Underlying file.
+     * @param[in] sha256
+     *   If the SHA-256 digest shall be calculated.
+     *
+     * @throw TftpException
+     *   When @p file is not provided.
+     **/
+    explicit DigestFile( FilePtr file, bool sha256 = true );
+
+    /**
+     * @brief Returns the Digests of the Data transferred so far.
+     *
+     * @return Digests.
+     **/
+    [[nodiscard]] Digest digest() const;
+
+    /**
+     * @copydoc File::start
+     *
+     * Starts the underlying file and restarts the digests.
+     **/
+    void start() override;
+
+    /**
+     * @copydoc File::finished()
+     **/
+    void finished() override;
+
+    /**
+     * @copydoc File::receivedTransferSize()
+     **/
+    [[nodiscard]] bool receivedTransferSize( uint64_t transferSize ) override;
+
+    /**
+     * @copydoc File::receivedData()
+     **/
+    void receivedData( Helper::ConstRawDataSpan data ) override;
+
+    /**
+     * @copydoc File::requestedTransferSize()
+     **/
+    [[nodiscard]] std::optional< uint64_t> requestedTransferSize() override;
+
+    /**
+     * @copydoc File::sendData()
+     **/
+    [[nodiscard]] Helper::RawData sendData( size_t maxSize ) override;
+
+  private:
+    /**
+     * @brief Adds @p data to the Digests.
+     *
+     * @param[in] data
+     *   Transferred data.
+     **/
+    void update( Helper::ConstRawDataSpan data ) noexcept;
+
+    //! Underlying File
+    FilePtr fileV;
+    //! Number of transferred Bytes
+    uint64_t sizeV{ 0U };
+    //! CRC-32C
+    Crc32c crc32cV;
+    //! SHA-256 (if enabled)
+    std::optional< Sha256 > sha256V;
+};
+
+/**
+ * @brief Stream output operator of @p DigestFile::Digest.
+ *
+ * @param[in,out] stream
+ *   Output Stream
+ * @param[in] digest
+ *   Digests
+ *
+ * @return @p stream for chaining.
+ **/
+TFTP_EXPORT std::ostream& operator<<( std::ostream &stream, const DigestFile::Digest &digest );
+
+}
+
+#endif
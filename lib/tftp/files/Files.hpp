@@ -27,20 +27,39 @@
  *
  * This namespace provides common handlers of data which shall be received from or transmitted to another TFTP instance.
  *
- * Currently, there are two implementations:
- * - @ref MemoryFile, which handles the data within a local std::vector, and
- * - @ref StreamFile, which handles the data through a std::iostream
- * - @ref NullSinkFile, which drops every received data.
+ * Currently, there are the following implementations:
+ * - @ref MemoryFile, which handles the data within a local std::vector,
+ * - @ref StreamFile, which handles the data through a std::iostream,
+ * - @ref DescriptorFile, which handles the data through an already opened POSIX file descriptor,
+ * - @ref NullSinkFile, which drops every received data, and
+ * - @ref NullSourceFile, which transmits zero bytes.
  *
- * The two implementations do not handle the data in the manner of encoding handling, i.e. only the TFTP OCTET transfer
+ * The implementations do not handle the data in the manner of encoding handling, i.e. only the TFTP OCTET transfer
  * mode is supported.
+ * For the NETASCII transfer mode, they are wrapped into a @ref NetasciiFile.
+ * Compressed files are transmitted decompressed by wrapping them into a @ref DecompressingFile.
+ * Integrity digests of the transferred data are calculated by wrapping files into a @ref DigestFile.
+ * Uploads are stored deduplicated within a @ref ChunkStore by wrapping files into a @ref DeduplicatingFile.
  **/
 namespace Tftp::Files {
 
+class ChunkStore;
+class DecompressingFile;
+class DeduplicatingFile;
+class DescriptorFile;
+class DigestFile;
 class File;
 class MemoryFile;
+class NetasciiFile;
 class StreamFile;
 class NullSinkFile;
+class NullSourceFile;
+
+//! %File Pointer
+using FilePtr = std::shared_ptr< File >;
+
+//! Descriptor %File Pointer
+using DescriptorFilePtr = std::shared_ptr< DescriptorFile >;
 
 //! Memory %File Pointer
 using MemoryFilePtr = std::shared_ptr< MemoryFile>;
@@ -14,25 +14,31 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <utility>
+
 namespace Tftp::Files {
 
 MemoryFile::MemoryFile() :
-  operationV{ Operation::Receive },
-  dataPtr{ dataV.begin() }
+  operationV{ Operation::Receive }
 {
 }
 
 MemoryFile::MemoryFile( Helper::ConstRawDataSpan data ) :
   operationV{ Operation::Transmit },
-  dataV{ data.begin(), data.end() },
-  dataPtr{ dataV.begin() }
+  dataV{ data.begin(), data.end() }
 {
 }
 
 MemoryFile::MemoryFile( Helper::RawData data ) :
   operationV{ Operation::Transmit },
-  dataV{ std::move( data ) },
-  dataPtr{ dataV.begin() }
+  dataV{ std::move( data ) }
+{
+}
+
+MemoryFile::MemoryFile( std::shared_ptr< const Helper::RawData > data ) :
+  operationV{ Operation::Transmit },
+  sharedDataV{ std::move( data ) }
 {
 }
 
@@ -43,17 +49,22 @@ void MemoryFile::start()
     dataV.clear();
   }
 
-  dataPtr = dataV.begin();
+  positionV = 0U;
 }
 
 Helper::ConstRawDataSpan MemoryFile::data() const noexcept
 {
+  if ( sharedDataV )
+  {
+    return *sharedDataV;
+  }
+
   return dataV;
 }
 
 void MemoryFile::finished() noexcept
 {
-  dataPtr = dataV.begin();
+  positionV = 0U;
 }
 
 bool MemoryFile::receivedTransferSize( const uint64_t transferSize )
@@ -68,33 +79,21 @@ void MemoryFile::receivedData( Helper::ConstRawDataSpan data )
   if ( !data.empty() )
   {
     dataV.insert( dataV.end(), data.begin(), data.end() );
-
-    dataPtr = dataV.begin();
   }
 }
 
 std::optional< uint64_t> MemoryFile::requestedTransferSize()
 {
-  return dataV.size();
+  return data().size();
 }
 
 Helper::RawData MemoryFile::sendData( const size_t maxSize )
 {
-  Helper::RawData::const_iterator startPtr{ dataPtr };
-  Helper::RawData::const_iterator endPtr;
-
-  if ( static_cast< size_t >( std::distance< Helper::RawData::const_iterator >( startPtr, dataV.end() ) ) <= maxSize )
-  {
-    endPtr = dataV.end();
-  }
-  else
-  {
-    endPtr = dataPtr + static_cast< ptrdiff_t >( maxSize );
-  }
+  const auto block{ data().subspan( positionV, std::min( maxSize, data().size() - positionV ) ) };
 
-  dataPtr = endPtr;
+  positionV += block.size();
 
-  return { startPtr, endPtr };
+  return { block.begin(), block.end() };
 }
 
 }
@@ -16,6 +16,8 @@
 #include <tftp/files/Files.hpp>
 #include <tftp/files/File.hpp>
 
+#include <memory>
+
 namespace Tftp::Files {
 
 /**
@@ -53,6 +55,17 @@ class TFTP_EXPORT MemoryFile final : public File
      **/
     explicit MemoryFile( Helper::RawData data );
 
+    /**
+     * @brief Creates a memory file on shared data.
+     *
+     * The data is not copied.
+     * This constructor is useful for transmitting cached data by several operations at the same time.
+     *
+     * @param[in] data
+     *   Shared data of memory file.
+     **/
+    explicit MemoryFile( std::shared_ptr< const Helper::RawData > data );
+
     /**
      * @copydoc File::start
      *
@@ -103,8 +116,10 @@ class TFTP_EXPORT MemoryFile final : public File
     const Operation operationV;
     //! Data
     Helper::RawData dataV;
+    //! Shared Data (replaces dataV if set)
+    std::shared_ptr< const Helper::RawData > sharedDataV;
     //! Current Read Position
-    Helper::RawData::const_iterator dataPtr;
+    size_t positionV{ 0U };
 };
 
 }
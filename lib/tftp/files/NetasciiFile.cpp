@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Files::NetasciiFile.
+ **/
+
+#include "NetasciiFile.hpp"
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace Tftp::Files {
+
+namespace {
+
+//! Word with the lowest bit of each byte set
+constexpr uint64_t LowBits{ 0x0101'0101'0101'0101U };
+//! Word with the highest bit of each byte set
+constexpr uint64_t HighBits{ 0x8080'8080'8080'8080U };
+
+/**
+ * @brief Returns, if any byte of @p word is zero.
+ *
+ * @param[in] word
+ *   Data word.
+ *
+ * @return If any byte is zero.
+ **/
+constexpr bool hasZeroByte( const uint64_t word ) noexcept
+{
+  return 0U != ( ( word - LowBits ) & ~word & HighBits );
+}
+
+/**
+ * @brief Returns the position of the first @p first or @p second within @p data.
+ *
+ * Words of 8 bytes are checked at once.
+ *
+ * @param[in] data
+ *   Data to scan.
+ * @param[in] first
+ *   First character to search.
+ * @param[in] second
+ *   Second character to search.
+ *
+ * @return Position of the first match.
+ * @retval data.size()
+ *   When no character matches.
+ **/
+std::size_t findFirstOf(
+  const Helper::ConstRawDataSpan data,
+  const std::byte first,
+  const std::byte second ) noexcept
+{
+  const auto firstPattern{ LowBits * std::to_integer< uint64_t >( first ) };
+  const auto secondPattern{ LowBits * std::to_integer< uint64_t >( second ) };
+
+  std::size_t position{ 0U };
+
+  for ( ; position + sizeof( uint64_t ) <= data.size(); position += sizeof( uint64_t ) )
+  {
+    uint64_t word{};
+    std::memcpy( &word, data.data() + position, sizeof( word ) );
+
+    if ( hasZeroByte( word ^ firstPattern ) || hasZeroByte( word ^ secondPattern ) )
+    {
+      break;
+    }
+  }
+
+  for ( ; position < data.size(); ++position )
+  {
+    if ( ( first == data[ position ] ) || ( second == data[ position ] ) )
+    {
+      break;
+    }
+  }
+
+  return position;
+}
+
+}
+
+uint64_t NetasciiFile::encodedSize( Helper::ConstRawDataSpan data ) noexcept
+{
+  // each CR and LF is encoded to two characters
+  return data.size()
+    + static_cast< uint64_t >( std::ranges::count( data, CarriageReturn ) )
+    + static_cast< uint64_t >( std::ranges::count( data, LineFeed ) );
+}
+
+NetasciiFile::NetasciiFile(
+  const Operation operation,
+  FilePtr file,
+  const std::optional< uint64_t > transferSize ) :
+  operationV{ operation },
+  fileV{ std::move( file ) },
+  transferSizeV{ transferSize }
+{
+  if ( !fileV )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "File not provided" } );
+  }
+}
+
+NetasciiFile::NetasciiFile( FilePtr file, TransferSizeProvider transferSizeProvider ) :
+  NetasciiFile{ Operation::Transmit, std::move( file ) }
+{
+  transferSizeProviderV = std::move( transferSizeProvider );
+}
+
+void NetasciiFile::start()
+{
+  fileV->start();
+
+  inputV.clear();
+  inputPositionV = 0U;
+  inputEndV = false;
+  pendingV.reset();
+  carriageReturnV = false;
+}
+
+void NetasciiFile::finished()
+{
+  if ( ( Operation::Receive == operationV ) && carriageReturnV )
+  {
+    carriageReturnV = false;
+    const std::byte carriageReturn[]{ CarriageReturn };
+    fileV->receivedData( carriageReturn );
+  }
+
+  fileV->finished();
+}
+
+bool NetasciiFile::receivedTransferSize( const uint64_t transferSize )
+{
+  return fileV->receivedTransferSize( transferSize );
+}
+
+void NetasciiFile::receivedData( Helper::ConstRawDataSpan data )
+{
+  // fast path - nothing to decode
+  if ( !carriageReturnV && ( findFirstOf( data, CarriageReturn, CarriageReturn ) == data.size() ) )
+  {
+    fileV->receivedData( data );
+    return;
+  }
+
+  Helper::RawData decoded;
+  decoded.reserve( data.size() + 1U );
+
+  // complete the sequence of the last block
+  if ( carriageReturnV && !data.empty() )
+  {
+    carriageReturnV = false;
+
+    if ( LineFeed == data.front() )
+    {
+      decoded.push_back( LineFeed );
+      data = data.subspan( 1U );
+    }
+    else
+    {
+      // CR NUL - or a bare CR, which is passed on as is
+      decoded.push_back( CarriageReturn );
+      if ( Null == data.front() )
+      {
+        data = data.subspan( 1U );
+      }
+    }
+  }
+
+  while ( !data.empty() )
+  {
+    const auto plain{ findFirstOf( data, CarriageReturn, CarriageReturn ) };
+    decoded.insert( decoded.end(), data.begin(), data.begin() + static_cast< std::ptrdiff_t >( plain ) );
+
+    if ( plain == data.size() )
+    {
+      break;
+    }
+
+    // sequence is continued within the next block
+    if ( plain + 1U == data.size() )
+    {
+      carriageReturnV = true;
+      break;
+    }
+
+    const auto next{ data[ plain + 1U ] };
+
+    if ( LineFeed == next )
+    {
+      decoded.push_back( LineFeed );
+      data = data.subspan( plain + 2U );
+    }
+    else if ( Null == next )
+    {
+      decoded.push_back( CarriageReturn );
+      data = data.subspan( plain + 2U );
+    }
+    else
+    {
+      decoded.push_back( CarriageReturn );
+      data = data.subspan( plain + 1U );
+    }
+  }
+
+  if ( !decoded.empty() )
+  {
+    fileV->receivedData( decoded );
+  }
+}
+
+std::optional< uint64_t> NetasciiFile::requestedTransferSize()
+{
+  if ( transferSizeProviderV )
+  {
+    // the provider may have read the underlying file
+    transferSizeV = std::exchange( transferSizeProviderV, {} )( *fileV );
+    start();
+  }
+
+  return transferSizeV;
+}
+
+Helper::RawData NetasciiFile::sendData( const size_t maxSize )
+{
+  Helper::RawData data;
+  data.reserve( maxSize );
+
+  while ( data.size() < maxSize )
+  {
+    if ( pendingV )
+    {
+      data.push_back( *pendingV );
+      pendingV.reset();
+      continue;
+    }
+
+    if ( inputPositionV == inputV.size() )
+    {
+      if ( inputEndV )
+      {
+        break;
+      }
+
+      inputV = fileV->sendData( maxSize );
+      inputPositionV = 0U;
+      inputEndV = inputV.size() < maxSize;
+      continue;
+    }
+
+    const auto input{ Helper::ConstRawDataSpan{ inputV }.subspan(
+      inputPositionV,
+      std::min( maxSize - data.size(), inputV.size() - inputPositionV ) ) };
+
+    const auto plain{ findFirstOf( input, LineFeed, CarriageReturn ) };
+    data.insert( data.end(), input.begin(), input.begin() + static_cast< std::ptrdiff_t >( plain ) );
+    inputPositionV += plain;
+
+    if ( plain < input.size() )
+    {
+      // LF -> CR LF, CR -> CR NUL
+      pendingV = ( LineFeed == input[ plain ] ) ? LineFeed : Null;
+      data.push_back( CarriageReturn );
+      ++inputPositionV;
+    }
+  }
+
+  return data;
+}
+
+}
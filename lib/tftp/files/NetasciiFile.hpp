@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Files::NetasciiFile.
+ **/
+
+#ifndef TFTP_FILES_NETASCIIFILE_HPP
+#define TFTP_FILES_NETASCIIFILE_HPP
+
+#include <tftp/files/Files.hpp>
+#include <tftp/files/File.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace Tftp::Files {
+
+/**
+ * @brief NETASCII %File.
+ *
+ * %File decorator, which translates the data of another file for the TFTP NETASCII transfer mode (RFC 1350):
+ * - On transmit, LF is encoded to CR LF and CR is encoded to CR NUL.
+ * - On receive, CR LF is decoded to LF and CR NUL is decoded to CR.
+ *
+ * Sequences, which are split between two blocks, are handled.
+ * The data is scanned word-wise for line ends, so blocks without line ends are passed on without byte-wise
+ * processing.
+ *
+ * The transfer size of the encoded data cannot be determined without reading the whole file.
+ * Therefore, it must be provided on construction (see encodedSize()) to be announced by the `tsize` option.
+ * Alternatively, a provider can be given, which is called only, when the transfer size is requested.
+ **/
+class TFTP_EXPORT NetasciiFile final : public File
+{
+  public:
+    //! Carriage Return (CR)
+    static constexpr std::byte CarriageReturn{ 0x0DU };
+    //! Line Feed (LF)
+    static constexpr std::byte LineFeed{ 0x0AU };
+    //! Null Character (NUL)
+    static constexpr std::byte Null{ 0x00U };
+
+    /**
+     * @brief Provider of the encoded Transfer Size.
+     *
+     * Gets the underlying file, which may be read to determine the size.
+     **/
+    using TransferSizeProvider = std::function< std::optional< uint64_t >( File &file ) >;
+
+    /**
+     * @brief Returns the NETASCII encoded Size of the Data.
+     *
+     * The encoded size of a file is the sum of the encoded sizes of its parts.
+     *
+     * @param[in] data
+     *   Local data.
+     *
+     * @return Size of @p data, when encoded.
+     **/
+    [[nodiscard]] static uint64_t encodedSize( Helper::ConstRawDataSpan data ) noexcept;
+
+    /**
+     * @brief Creates the NETASCII File on top of @p file.
+     *
+     * @param[in] operation
+     *   Receive or Transmit Operation.
+     * @param[in] file
+     *   File, which holds the local data.
+     * @param[in] transferSize
+     *   Encoded size of the file (transmit operation).
+     *   If not provided, the transfer size is not announced.
+     *
+     * @throw TftpException
+     *   When @p file is not provided.
+     **/
+    NetasciiFile( Operation operation, FilePtr file, std::optional< uint64_t > transferSize = {} );
+
+    /**
+     * @brief Creates the NETASCII File on top of @p file with a deferred Transfer Size (transmit operation).
+     *
+     * @param[in] file
+     *   File, which holds the local data.
+     * @param[in] transferSizeProvider
+     *   Called once on the first requestedTransferSize().
+     *
+     * @throw TftpException
+     *   When @p file is not provided.
+     **/
+    NetasciiFile( FilePtr file, TransferSizeProvider transferSizeProvider );
+
+    /**
+     * @copydoc File::start
+     *
+     * Starts the underlying file and resets the translation state.
+     **/
+    void start() override;
+
+    /**
+     * @copydoc File::finished()
+     *
+     * On receive operation, a CR at the end of the data is passed on as is.
+     **/
+    void finished() override;
+
+    /**
+     * @copydoc File::receivedTransferSize()
+     *
+     * The size is passed on, as the decoded data is never bigger than the encoded one.
+     **/
+    [[nodiscard]] bool receivedTransferSize( uint64_t transferSize ) override;
+
+    /**
+     * @copydoc File::receivedData()
+     **/
+    void receivedData( Helper::ConstRawDataSpan data ) override;
+
+    /**
+     * @copydoc File::requestedTransferSize()
+     *
+     * When a transfer size provider is given, it is called and the file is started again, so this must not be called
+     * after data has been sent.
+     **/
+    [[nodiscard]] std::optional< uint64_t> requestedTransferSize() override;
+
+    /**
+     * @copydoc File::sendData()
+     **/
+    [[nodiscard]] Helper::RawData sendData( size_t maxSize ) override;
+
+  private:
+    //! Actual Operation
+    const Operation operationV;
+    //! Underlying File
+    FilePtr fileV;
+    //! Encoded Transfer Size
+    std::optional< uint64_t > transferSizeV;
+    //! Provider of the Encoded Transfer Size (until called)
+    TransferSizeProvider transferSizeProviderV;
+    //! Local Data read from the underlying File (transmit)
+    Helper::RawData inputV;
+    //! Position within the Local Data (transmit)
+    std::size_t inputPositionV{ 0U };
+    //! End of the underlying File reached (transmit)
+    bool inputEndV{ false };
+    //! Second Character of an Escape Sequence, which did not fit into the last Block (transmit)
+    std::optional< std::byte > pendingV;
+    //! Last Block ended with CR (receive)
+    bool carriageReturnV{ false };
+};
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Files::NullSourceFile.
+ **/
+
+#include "NullSourceFile.hpp"
+
+#include <algorithm>
+
+namespace Tftp::Files {
+
+NullSourceFile::NullSourceFile( const uint64_t size ):
+  size{ size }
+{
+}
+
+void NullSourceFile::start()
+{
+  position = 0U;
+}
+
+void NullSourceFile::finished() noexcept
+{
+}
+
+std::optional< uint64_t > NullSourceFile::requestedTransferSize()
+{
+  return size;
+}
+
+Helper::RawData NullSourceFile::sendData( const size_t maxSize )
+{
+  const auto dataSize{ std::min< uint64_t >( maxSize, size - position ) };
+  position += dataSize;
+
+  return Helper::RawData( static_cast< size_t >( dataSize ) );
+}
+
+}
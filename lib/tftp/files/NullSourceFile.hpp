@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Files::NullSourceFile.
+ **/
+
+#ifndef TFTP_FILES_NULLSOURCEFILE_HPP
+#define TFTP_FILES_NULLSOURCEFILE_HPP
+
+#include <tftp/files/Files.hpp>
+#include <tftp/TransmitDataHandler.hpp>
+
+#include <cstdint>
+
+namespace Tftp::Files {
+
+/**
+ * @brief NULL Source %File.
+ *
+ * This class provides a transmit data handler, which transmits the given number of zero bytes.
+ * This handler is the counterpart of @ref NullSinkFile and can be used for testing purposes and load generation.
+ **/
+class TFTP_EXPORT NullSourceFile final : public TransmitDataHandler
+{
+  public:
+    /**
+     * @brief Constructs file with the given size.
+     *
+     * @param[in] size
+     *   Number of bytes to transmit.
+     **/
+    explicit NullSourceFile( uint64_t size );
+
+    /**
+     * @copydoc TransmitDataHandler::start
+     *
+     * Rewinds the file.
+     **/
+    void start() override;
+
+    /**
+     * @copydoc TransmitDataHandler::finished
+     **/
+    void finished() noexcept override;
+
+    /**
+     * @copydoc TransmitDataHandler::requestedTransferSize
+     *
+     * Returns the size given on construction.
+     **/
+    [[nodiscard]] std::optional< uint64_t > requestedTransferSize() override;
+
+    /**
+     * @copydoc TransmitDataHandler::sendData
+     *
+     * Returns zero bytes until the size is reached.
+     **/
+    [[nodiscard]] Helper::RawData sendData( size_t maxSize ) override;
+
+  private:
+    //! Size
+    const uint64_t size;
+    //! Number of already transmitted bytes
+    uint64_t position{ 0U };
+};
+
+}
+
+#endif
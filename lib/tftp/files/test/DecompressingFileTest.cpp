@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::Files::DecompressingFile.
+ **/
+
+#include <tftp/files/DecompressingFile.hpp>
+#include <tftp/files/MemoryFile.hpp>
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Tftp::Files {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( FileTest )
+BOOST_AUTO_TEST_SUITE( DecompressingFileTest )
+
+namespace {
+
+//! Returns test data of @p size bytes
+Helper::RawData testData( const size_t size )
+{
+  Helper::RawData data( size );
+
+  for ( size_t index{ 0U }; index < size; ++index )
+  {
+    data[ index ] = static_cast< std::byte >( ( index * 7U ) % 251U );
+  }
+
+  return data;
+}
+
+//! Compresses @p data with gzip
+Helper::RawData gzip( const Helper::RawData &data )
+{
+  std::vector< char > compressed;
+  boost::iostreams::filtering_ostream stream;
+  stream.push( boost::iostreams::gzip_compressor{} );
+  stream.push( boost::iostreams::back_inserter( compressed ) );
+  // NOLINTNEXTLINE( cppcoreguidelines-pro-type-reinterpret-cast ): std::byte to char buffer
+  stream.write( reinterpret_cast< const char * >( data.data() ), static_cast< std::streamsize >( data.size() ) );
+  stream.reset();
+
+  Helper::RawData result( compressed.size() );
+  std::ranges::transform( compressed, result.begin(), []( const char c ){ return static_cast< std::byte >( c ); } );
+  return result;
+}
+
+//! Creates a Zstandard frame with a single raw block
+Helper::RawData zstdRaw( const Helper::RawData &data )
+{
+  // magic, single segment with 2-byte content size, raw last block
+  const auto blockHeader{ ( data.size() << 3U ) | 0x01U };
+  Helper::RawData frame{
+    std::byte{ 0x28U }, std::byte{ 0xB5U }, std::byte{ 0x2FU }, std::byte{ 0xFDU },
+    std::byte{ 0x60U },
+    static_cast< std::byte >( ( data.size() - 256U ) & 0xFFU ),
+    static_cast< std::byte >( ( data.size() - 256U ) >> 8U ),
+    static_cast< std::byte >( blockHeader & 0xFFU ),
+    static_cast< std::byte >( ( blockHeader >> 8U ) & 0xFFU ),
+    static_cast< std::byte >( ( blockHeader >> 16U ) & 0xFFU ) };
+  frame.insert( frame.end(), data.begin(), data.end() );
+  return frame;
+}
+
+//! Returns a read handler on @p data
+DecompressingFile::ReadHandler reader( Helper::RawData data )
+{
+  return [ data = std::move( data ) ]( const uint64_t offset, const std::size_t size )
+  {
+    const Helper::ConstRawDataSpan span{ data };
+
+    if ( offset >= span.size() )
+    {
+      return Helper::RawData{};
+    }
+
+    const auto read{ span.subspan( static_cast< std::size_t >( offset ) ) };
+    const auto first{ read.first( std::min( size, read.size() ) ) };
+    return Helper::RawData{ first.begin(), first.end() };
+  };
+}
+
+//! Transmits the whole file in blocks of @p blockSize
+Helper::RawData transmit( DecompressingFile &file, const size_t blockSize )
+{
+  Helper::RawData data;
+  file.start();
+
+  for ( ;; )
+  {
+    const auto block{ file.sendData( blockSize ) };
+    data.insert( data.end(), block.begin(), block.end() );
+
+    if ( block.size() < blockSize )
+    {
+      break;
+    }
+  }
+
+  file.finished();
+  return data;
+}
+
+}
+
+//! compression test
+BOOST_AUTO_TEST_CASE( compression )
+{
+  BOOST_CHECK( DecompressingFile::compression( ".gz" ) == DecompressingFile::Compression::Gzip );
+  BOOST_CHECK( DecompressingFile::compression( ".zst" ) == DecompressingFile::Compression::Zstd );
+  BOOST_CHECK( !DecompressingFile::compression( ".txt" ) );
+}
+
+//! uncompressedSize test
+BOOST_AUTO_TEST_CASE( uncompressedSize )
+{
+  const auto data{ testData( 1000U ) };
+
+  const auto zstdData{ zstdRaw( data ) };
+  BOOST_CHECK(
+    DecompressingFile::uncompressedSize( DecompressingFile::Compression::Zstd, zstdData.size(), reader( zstdData ) )
+      == 1000U );
+
+  // the content size of the first frame does not cover following frames
+  auto zstdFrames{ zstdData };
+  zstdFrames.insert( zstdFrames.end(), zstdData.begin(), zstdData.end() );
+  BOOST_CHECK( !DecompressingFile::uncompressedSize(
+    DecompressingFile::Compression::Zstd,
+    zstdFrames.size(),
+    reader( zstdFrames ) ) );
+
+  // truncated frame
+  BOOST_CHECK( !DecompressingFile::uncompressedSize(
+    DecompressingFile::Compression::Zstd,
+    zstdData.size() - 1U,
+    reader( Helper::RawData{ zstdData.begin(), zstdData.end() - 1 } ) ) );
+
+  // ISIZE of gzip files is not used
+  const auto gzipData{ gzip( data ) };
+  BOOST_CHECK(
+    !DecompressingFile::uncompressedSize( DecompressingFile::Compression::Gzip, gzipData.size(), reader( gzipData ) ) );
+
+  // wrong format
+  BOOST_CHECK(
+    !DecompressingFile::uncompressedSize( DecompressingFile::Compression::Zstd, gzipData.size(), reader( gzipData ) ) );
+  BOOST_CHECK( !DecompressingFile::uncompressedSize( DecompressingFile::Compression::Zstd, 0U, reader( {} ) ) );
+}
+
+//! Gzip transmit test
+BOOST_AUTO_TEST_CASE( sendDataGzip )
+{
+  const auto data{ testData( 5000U ) };
+  DecompressingFile file{
+    std::make_shared< MemoryFile >( gzip( data ) ),
+    DecompressingFile::Compression::Gzip,
+    data.size() };
+
+  BOOST_CHECK( file.requestedTransferSize() == data.size() );
+  BOOST_CHECK( transmit( file, 512U ) == data );
+  // repeated transfer
+  BOOST_CHECK( transmit( file, 1000U ) == data );
+  BOOST_CHECK( !file.receivedTransferSize( 0U ) );
+  BOOST_CHECK_THROW( file.receivedData( {} ), TftpException );
+}
+
+//! Zstandard transmit test
+BOOST_AUTO_TEST_CASE( sendDataZstd )
+{
+  const auto data{ testData( 1000U ) };
+  DecompressingFile file{ std::make_shared< MemoryFile >( zstdRaw( data ) ), DecompressingFile::Compression::Zstd };
+
+  BOOST_CHECK( !file.requestedTransferSize() );
+  BOOST_CHECK( transmit( file, 512U ) == data );
+}
+
+//! Corrupted data test
+BOOST_AUTO_TEST_CASE( corrupted )
+{
+  auto compressed{ gzip( testData( 1000U ) ) };
+  compressed.resize( compressed.size() / 2U );
+  compressed[ 12U ] ^= std::byte{ 0xFFU };
+
+  DecompressingFile file{ std::make_shared< MemoryFile >( compressed ), DecompressingFile::Compression::Gzip };
+  file.start();
+  BOOST_CHECK_THROW( ( void )file.sendData( 2000U ), TftpException );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
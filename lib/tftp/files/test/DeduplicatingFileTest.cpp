@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::Files::DeduplicatingFile.
+ **/
+
+#include <tftp/files/DeduplicatingFile.hpp>
+#include <tftp/files/ChunkStore.hpp>
+#include <tftp/files/MemoryFile.hpp>
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <system_error>
+
+namespace Tftp::Files {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( FileTest )
+BOOST_AUTO_TEST_SUITE( DeduplicatingFileTest )
+
+namespace {
+
+//! Chunk Store within a temporary Directory, which is removed afterwards
+struct StoreFixture
+{
+  StoreFixture() :
+    directory{ std::filesystem::temp_directory_path() / std::format( "tftp-chunks-{}", std::random_device{}() ) },
+    store{ std::make_shared< ChunkStore >( directory ) }
+  {
+  }
+
+  ~StoreFixture()
+  {
+    std::error_code error;
+    std::filesystem::remove_all( directory, error );
+  }
+
+  std::filesystem::path directory;
+  std::shared_ptr< ChunkStore > store;
+};
+
+//! File, which fails to receive Data
+class FailingFile final : public File
+{
+  public:
+    void start() override
+    {
+    }
+
+    void finished() override
+    {
+      finishedV = true;
+    }
+
+    [[nodiscard]] bool receivedTransferSize( uint64_t ) override
+    {
+      return true;
+    }
+
+    void receivedData( Helper::ConstRawDataSpan ) override
+    {
+      throw TftpException{};
+    }
+
+    [[nodiscard]] std::optional< uint64_t > requestedTransferSize() override
+    {
+      return {};
+    }
+
+    [[nodiscard]] Helper::RawData sendData( size_t ) override
+    {
+      return {};
+    }
+
+    //! finished() has been called
+    bool finishedV{ false };
+};
+
+//! Returns @p size pseudo random bytes
+Helper::RawData randomData( const size_t size, const unsigned int seed )
+{
+  std::mt19937 generator{ seed };
+  Helper::RawData data( size );
+  std::ranges::generate( data, [ &generator ]{ return static_cast< std::byte >( generator() ); } );
+  return data;
+}
+
+//! Receives @p data in blocks of 512 bytes and returns the manifest
+Helper::RawData receive( const std::shared_ptr< ChunkStore > &store, const Helper::ConstRawDataSpan data )
+{
+  const auto manifestFile{ std::make_shared< MemoryFile >() };
+  DeduplicatingFile file{ File::Operation::Receive, store, manifestFile };
+
+  file.start();
+
+  for ( size_t position{ 0U }; position < data.size(); position += 512U )
+  {
+    file.receivedData( data.subspan( position, std::min< size_t >( 512U, data.size() - position ) ) );
+  }
+
+  file.finished();
+
+  const auto manifest{ manifestFile->data() };
+  return { manifest.begin(), manifest.end() };
+}
+
+//! Transmits the file described by @p manifest in blocks of 512 bytes
+Helper::RawData transmit( const std::shared_ptr< ChunkStore > &store, Helper::RawData manifest )
+{
+  DeduplicatingFile file{ File::Operation::Transmit, store, std::make_shared< MemoryFile >( std::move( manifest ) ) };
+  Helper::RawData data;
+
+  file.start();
+  const auto transferSize{ file.requestedTransferSize() };
+
+  for ( ;; )
+  {
+    const auto block{ file.sendData( 512U ) };
+    data.insert( data.end(), block.begin(), block.end() );
+
+    if ( block.size() < 512U )
+    {
+      break;
+    }
+  }
+
+  file.finished();
+
+  BOOST_CHECK( transferSize == data.size() );
+  return data;
+}
+
+}
+
+//! Manifest encode/ decode test
+BOOST_AUTO_TEST_CASE( manifest )
+{
+  const ChunkStore::Manifest manifest{ { ChunkStore::ChunkId{ std::byte{ 0xAB } }, 4711U }, { {}, 1U } };
+
+  const auto decoded{ ChunkStore::decode( ChunkStore::encode( manifest ) ) };
+  BOOST_REQUIRE( decoded );
+  BOOST_REQUIRE_EQUAL( decoded->size(), 2U );
+  BOOST_CHECK( ( *decoded )[ 0 ].id == manifest[ 0 ].id );
+  BOOST_CHECK_EQUAL( ( *decoded )[ 0 ].size, 4711U );
+  BOOST_CHECK_EQUAL( ChunkStore::size( *decoded ), 4712U );
+
+  BOOST_CHECK( ChunkStore::decode( ChunkStore::encode( {} ) ) );
+  BOOST_CHECK( !ChunkStore::decode( {} ) );
+
+  auto truncated{ ChunkStore::encode( manifest ) };
+  truncated.pop_back();
+  BOOST_CHECK( !ChunkStore::decode( truncated ) );
+
+  // chunks bigger than the maximum chunk size
+  const ChunkStore::Manifest big{ { {}, ChunkStore::MaxChunkSize + 1U } };
+  BOOST_CHECK( !ChunkStore::decode( ChunkStore::encode( big ) ) );
+}
+
+//! The chunk size is checked before the chunk is loaded
+BOOST_FIXTURE_TEST_CASE( chunkSize, StoreFixture )
+{
+  const auto data{ randomData( ChunkStore::MaxChunkSize, 5U ) };
+  auto chunk{ store->store( data ) };
+  BOOST_CHECK( store->load( chunk ) == data );
+
+  chunk.size = std::numeric_limits< uint32_t >::max();
+  BOOST_CHECK_THROW( static_cast< void >( store->load( chunk ) ), TftpException );
+
+  BOOST_CHECK_THROW( store->store( randomData( ChunkStore::MaxChunkSize + 1U, 5U ) ), TftpException );
+}
+
+//! Errors storing the manifest are reported
+BOOST_FIXTURE_TEST_CASE( manifestError, StoreFixture )
+{
+  const auto manifestFile{ std::make_shared< FailingFile >() };
+  DeduplicatingFile file{ File::Operation::Receive, store, manifestFile };
+
+  file.start();
+  file.receivedData( randomData( 100U, 6U ) );
+  BOOST_CHECK_THROW( file.finished(), TftpException );
+
+  // the underlying file is finished anyway
+  BOOST_CHECK( manifestFile->finishedV );
+}
+
+//! Constructor test
+BOOST_FIXTURE_TEST_CASE( constructor, StoreFixture )
+{
+  BOOST_CHECK_THROW( ( DeduplicatingFile{ File::Operation::Receive, {}, std::make_shared< MemoryFile >() } ),
+    TftpException );
+  BOOST_CHECK_THROW( ( DeduplicatingFile{ File::Operation::Receive, store, {} } ), TftpException );
+}
+
+//! Receive and transmit test
+BOOST_FIXTURE_TEST_CASE( roundTrip, StoreFixture )
+{
+  for ( const size_t size : { 0U, 100U, 1024U, 100'000U } )
+  {
+    const auto data{ randomData( size, 1U ) };
+    const auto manifest{ receive( store, data ) };
+
+    const auto decoded{ ChunkStore::decode( manifest ) };
+    BOOST_REQUIRE( decoded );
+    BOOST_CHECK_EQUAL( ChunkStore::size( *decoded ), size );
+
+    for ( const auto &chunk : *decoded )
+    {
+      BOOST_CHECK( chunk.size <= DeduplicatingFile::MaxChunkSize );
+    }
+
+    BOOST_CHECK( transmit( store, manifest ) == data );
+  }
+}
+
+//! Deduplication of nearly identical files
+BOOST_FIXTURE_TEST_CASE( deduplication, StoreFixture )
+{
+  auto data{ randomData( 200'000U, 2U ) };
+  static_cast< void >( receive( store, data ) );
+  const auto initial{ store->statistic() };
+  BOOST_CHECK_EQUAL( initial.storedBytes, data.size() );
+
+  // insert some bytes within the middle
+  const auto inserted{ randomData( 10U, 3U ) };
+  data.insert( data.begin() + 100'000, inserted.begin(), inserted.end() );
+
+  const auto manifest{ receive( store, data ) };
+  const auto statistic{ store->statistic() };
+
+  BOOST_CHECK( statistic.duplicateChunks > 0U );
+  BOOST_CHECK( statistic.storedBytes - initial.storedBytes <= 2U * DeduplicatingFile::MaxChunkSize );
+  BOOST_CHECK( transmit( store, manifest ) == data );
+}
+
+//! Files, which are not manifests, are transmitted unchanged
+BOOST_FIXTURE_TEST_CASE( plainFile, StoreFixture )
+{
+  for ( const size_t size : { 0U, 10U, 1000U } )
+  {
+    const auto data{ randomData( size, 4U ) };
+    BOOST_CHECK( transmit( store, data ) == data );
+  }
+
+  auto invalid{ ChunkStore::encode( {} ) };
+  invalid.push_back( std::byte{ 'x' } );
+
+  DeduplicatingFile file{ File::Operation::Transmit, store, std::make_shared< MemoryFile >( invalid ) };
+  BOOST_CHECK_THROW( file.start(), TftpException );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::Files::NetasciiFile.
+ **/
+
+#include <tftp/files/NetasciiFile.hpp>
+#include <tftp/files/MemoryFile.hpp>
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace Tftp::Files {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( FileTest )
+BOOST_AUTO_TEST_SUITE( NetasciiFileTest )
+
+namespace {
+
+//! Returns the characters of @p text as raw data
+Helper::RawData rawData( const std::string_view text )
+{
+  Helper::RawData data( text.size() );
+  std::ranges::transform( text, data.begin(), []( const char c ){ return static_cast< std::byte >( c ); } );
+  return data;
+}
+
+//! Transmits the whole file in blocks of @p blockSize
+Helper::RawData transmit( NetasciiFile &file, const size_t blockSize )
+{
+  Helper::RawData data;
+  file.start();
+
+  for ( ;; )
+  {
+    const auto block{ file.sendData( blockSize ) };
+    BOOST_CHECK( block.size() <= blockSize );
+    data.insert( data.end(), block.begin(), block.end() );
+
+    if ( block.size() < blockSize )
+    {
+      break;
+    }
+  }
+
+  file.finished();
+  return data;
+}
+
+}
+
+//! encodedSize test
+BOOST_AUTO_TEST_CASE( encodedSize )
+{
+  BOOST_CHECK_EQUAL( NetasciiFile::encodedSize( {} ), 0U );
+  BOOST_CHECK_EQUAL( NetasciiFile::encodedSize( rawData( "0123456789abcdef" ) ), 16U );
+  BOOST_CHECK_EQUAL( NetasciiFile::encodedSize( rawData( "a\nb\rc\r\n" ) ), 11U );
+}
+
+//! Constructor test
+BOOST_AUTO_TEST_CASE( constructor )
+{
+  BOOST_CHECK_THROW( ( NetasciiFile{ File::Operation::Transmit, {} } ), TftpException );
+
+  NetasciiFile file{ File::Operation::Transmit, std::make_shared< MemoryFile >( rawData( "a\n" ) ), 3U };
+  BOOST_CHECK( file.requestedTransferSize() == 3U );
+}
+
+//! Deferred transfer size test
+BOOST_AUTO_TEST_CASE( transferSizeProvider )
+{
+  using std::literals::operator""sv;
+
+  const auto local{ rawData( "a\nb\rc" ) };
+  unsigned int calls{ 0U };
+
+  NetasciiFile file{
+    std::make_shared< MemoryFile >( local ),
+    [ &calls ]( File &underlying ) -> std::optional< uint64_t >
+    {
+      ++calls;
+      // reads the underlying file
+      underlying.start();
+      return NetasciiFile::encodedSize( underlying.sendData( 512U ) );
+    } };
+
+  // not called without request
+  file.start();
+  BOOST_CHECK_EQUAL( calls, 0U );
+
+  BOOST_CHECK( file.requestedTransferSize() == 7U );
+  BOOST_CHECK( file.requestedTransferSize() == 7U );
+  BOOST_CHECK_EQUAL( calls, 1U );
+
+  // the underlying file is started again
+  BOOST_CHECK( file.sendData( 512U ) == rawData( "a\r\nb\r\0c"sv ) );
+}
+
+//! Transmit test
+BOOST_AUTO_TEST_CASE( sendData )
+{
+  using std::literals::operator""sv;
+
+  const auto local{ rawData( "line 1 without line end\nline 2\r\n\n\rend" ) };
+  const auto expected{ rawData( "line 1 without line end\r\nline 2\r\0\r\n\r\n\r\0end"sv ) };
+  BOOST_REQUIRE_EQUAL( NetasciiFile::encodedSize( local ), expected.size() );
+
+  // block sizes splitting the escape sequences at different positions
+  for ( size_t blockSize{ 1U }; blockSize <= expected.size() + 1U; ++blockSize )
+  {
+    NetasciiFile file{ File::Operation::Transmit, std::make_shared< MemoryFile >( local ) };
+    BOOST_CHECK( transmit( file, blockSize ) == expected );
+  }
+
+  // repeated transfer
+  NetasciiFile file{ File::Operation::Transmit, std::make_shared< MemoryFile >( local ) };
+  BOOST_CHECK( transmit( file, 4U ) == expected );
+  BOOST_CHECK( transmit( file, 512U ) == expected );
+}
+
+//! Receive test
+BOOST_AUTO_TEST_CASE( receivedData )
+{
+  using std::literals::operator""sv;
+
+  const auto received{ rawData( "line 1 without line end\r\nline 2\r\0\r\n\r\n\r\0end\r"sv ) };
+  const auto expected{ rawData( "line 1 without line end\nline 2\r\n\n\rend\r" ) };
+
+  for ( size_t blockSize{ 1U }; blockSize <= received.size(); ++blockSize )
+  {
+    const auto memoryFile{ std::make_shared< MemoryFile >() };
+    NetasciiFile file{ File::Operation::Receive, memoryFile };
+    file.start();
+
+    for ( size_t position{ 0U }; position < received.size(); position += blockSize )
+    {
+      file.receivedData(
+        Helper::ConstRawDataSpan{ received }.subspan( position, std::min( blockSize, received.size() - position ) ) );
+    }
+
+    file.finished();
+    BOOST_CHECK( std::ranges::equal( memoryFile->data(), expected ) );
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::Files::NullSourceFile.
+ **/
+
+#include <tftp/files/NullSourceFile.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+namespace Tftp::Files {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( FileTest )
+BOOST_AUTO_TEST_SUITE( NullSourceFileTest )
+
+//! Send data test
+BOOST_AUTO_TEST_CASE( sendData )
+{
+  NullSourceFile file{ 1000 };
+  BOOST_CHECK( file.requestedTransferSize() == 1000U );
+
+  file.start();
+  const auto data1{ file.sendData( 512 ) };
+  BOOST_CHECK_EQUAL( data1.size(), 512U );
+  BOOST_CHECK( std::ranges::all_of( data1, []( const std::byte value ){ return std::byte{ 0 } == value; } ) );
+  BOOST_CHECK_EQUAL( file.sendData( 512 ).size(), 488U );
+  BOOST_CHECK( file.sendData( 512 ).empty() );
+
+  // restart
+  file.start();
+  BOOST_CHECK_EQUAL( file.sendData( 2000 ).size(), 1000U );
+  BOOST_CHECK_NO_THROW( file.finished() );
+
+  NullSourceFile empty{ 0 };
+  empty.start();
+  BOOST_CHECK( empty.sendData( 512 ).empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -30,17 +30,31 @@ AcknowledgementPacket::AcknowledgementPacket( const BlockNumber blockNumber ) no
 {
 }
 
+DecodeResult< AcknowledgementPacket > AcknowledgementPacket::decode( Helper::ConstRawDataSpan rawPacket )
+{
+  AcknowledgementPacket packet{};
+
+  if ( const auto result{ packet.decodeHeader( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  if ( const auto result{ packet.decodeBody( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  return packet;
+}
+
 AcknowledgementPacket::AcknowledgementPacket( Helper::ConstRawDataSpan rawPacket ) :
-  Packet{ PacketType::Acknowledgement, rawPacket }
+  AcknowledgementPacket{ DecodeResult_value( decode( rawPacket ) ) }
 {
-  decodeBody( rawPacket );
 }
 
 AcknowledgementPacket& AcknowledgementPacket::operator=( Helper::ConstRawDataSpan rawPacket )
 {
-  decodeHeader( rawPacket );
-  decodeBody( rawPacket );
-  return *this;
+  return *this = DecodeResult_value( decode( rawPacket ) );
 }
 
 BlockNumber AcknowledgementPacket::blockNumber() const
@@ -74,13 +88,12 @@ Helper::RawData AcknowledgementPacket::encode() const
   return rawPacket;
 }
 
-void AcknowledgementPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
+DecodeResult< void > AcknowledgementPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
 {
   // check size
   if ( rawPacket.size() != PacketSize )
   {
-    BOOST_THROW_EXCEPTION( InvalidPacketException()
-      << Helper::AdditionalInfo{ "Invalid packet size of ACK packet" } );
+    return std::unexpected{ "Invalid packet size of ACK packet" };
   }
 
   auto rawSpan{ Helper::ConstRawDataSpan{ rawPacket }.subspan( HeaderSize ) };
@@ -88,6 +101,8 @@ void AcknowledgementPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
   // decode block number
   std::tie( rawSpan, static_cast< uint16_t & >( blockNumberV ) ) = Helper::RawData_getInt< uint16_t >( rawSpan );
   assert( rawSpan.empty() ); // Keep assertion, as otherwise above runtime check would be wrong
+
+  return {};
 }
 
 }
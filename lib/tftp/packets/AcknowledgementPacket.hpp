@@ -47,6 +47,18 @@ class TFTP_EXPORT AcknowledgementPacket final : public Packet
      **/
     explicit AcknowledgementPacket( BlockNumber blockNumber = {} ) noexcept;
 
+    /**
+     * @brief Decodes a TFTP acknowledgement packet from a data buffer.
+     *
+     * In contrast to AcknowledgementPacket(Helper::ConstRawDataSpan), this operation does not throw on invalid packets.
+     *
+     * @param[in] rawPacket
+     *   Packet, which shall be decoded.
+     *
+     * @return Decoded packet or the decoding error.
+     **/
+    [[nodiscard]] static DecodeResult< AcknowledgementPacket > decode( Helper::ConstRawDataSpan rawPacket );
+
     /**
      * @brief Generates a TFTP acknowledgement packet from a data buffer.
      *
@@ -103,12 +115,9 @@ class TFTP_EXPORT AcknowledgementPacket final : public Packet
      * @param[in] rawPacket
      *   Raw TFP packet
      *
-     * @throw InvalidPacketException
-     *   If data or packet is invalid.
-     * @throw InvalidPacketException
-     *   When packet size is invalid
+     * @return If data or packet is valid.
      **/
-    void decodeBody( Helper::ConstRawDataSpan rawPacket );
+    [[nodiscard]] DecodeResult< void > decodeBody( Helper::ConstRawDataSpan rawPacket );
 
     //! Block Number of Packet
     BlockNumber blockNumberV;
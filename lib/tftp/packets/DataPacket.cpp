@@ -30,17 +30,31 @@ DataPacket::DataPacket( const BlockNumber blockNumber, Data data ) noexcept :
 {
 }
 
+DecodeResult< DataPacket > DataPacket::decode( Helper::ConstRawDataSpan rawPacket )
+{
+  DataPacket packet{};
+
+  if ( const auto result{ packet.decodeHeader( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  if ( const auto result{ packet.decodeBody( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  return packet;
+}
+
 DataPacket::DataPacket( Helper::ConstRawDataSpan rawPacket ) :
-  Packet{ PacketType::Data, rawPacket }
+  DataPacket{ DecodeResult_value( decode( rawPacket ) ) }
 {
-  decodeBody( rawPacket );
 }
 
 DataPacket& DataPacket::operator=( Helper::ConstRawDataSpan rawPacket )
 {
-  decodeHeader( rawPacket );
-  decodeBody( rawPacket );
-  return *this;
+  return *this = DecodeResult_value( decode( rawPacket ) );
 }
 
 BlockNumber DataPacket::blockNumber() const
@@ -101,13 +115,12 @@ Helper::RawData DataPacket::encode() const
   return rawPacket;
 }
 
-void DataPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
+DecodeResult< void > DataPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
 {
   // check size
   if ( rawPacket.size() < MinPacketSize )
   {
-    BOOST_THROW_EXCEPTION( InvalidPacketException()
-      << Helper::AdditionalInfo{ "Invalid packet size of DATA packet" } );
+    return std::unexpected{ "Invalid packet size of DATA packet" };
   }
 
   auto remaining{ Helper::ConstRawDataSpan{ rawPacket }.subspan( HeaderSize ) };
@@ -117,6 +130,8 @@ void DataPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
 
   // copy data
   dataV.assign( remaining.begin(), remaining.end() );
+
+  return {};
 }
 
 }
@@ -52,6 +52,18 @@ class TFTP_EXPORT DataPacket final : public Packet
      **/
     explicit DataPacket( BlockNumber blockNumber = {}, Data data = {} ) noexcept;
 
+    /**
+     * @brief Decodes a TFTP Data packet from a data buffer.
+     *
+     * In contrast to DataPacket(Helper::ConstRawDataSpan), this operation does not throw on invalid packets.
+     *
+     * @param[in] rawPacket
+     *   Packet, which shall be decoded.
+     *
+     * @return Decoded packet or the decoding error.
+     **/
+    [[nodiscard]] static DecodeResult< DataPacket > decode( Helper::ConstRawDataSpan rawPacket );
+
     /**
      * @brief Generates a TFTP Data packet from a data buffer.
      *
@@ -157,10 +169,9 @@ class TFTP_EXPORT DataPacket final : public Packet
      * @param[in] rawPacket
      *   Raw TFP packet
      *
-     * @throw InvalidPacketException
-     *   If data or packet is invalid.
+     * @return If data or packet is valid.
      **/
-    void decodeBody( Helper::ConstRawDataSpan rawPacket );
+    [[nodiscard]] DecodeResult< void > decodeBody( Helper::ConstRawDataSpan rawPacket );
 
     //! Block Number of Packet.
     BlockNumber blockNumberV;
@@ -36,17 +36,31 @@ ErrorPacket::ErrorPacket( const ErrorCode errorCode, std::string errorMessage )
 {
 }
 
-ErrorPacket::ErrorPacket( const Helper::ConstRawDataSpan rawPacket ) :
-  Packet{ PacketType::Error, rawPacket }
+DecodeResult< ErrorPacket > ErrorPacket::decode( Helper::ConstRawDataSpan rawPacket )
 {
-  decodeBody( rawPacket );
+  ErrorPacket packet{};
+
+  if ( const auto result{ packet.decodeHeader( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  if ( const auto result{ packet.decodeBody( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  return packet;
 }
 
-ErrorPacket& ErrorPacket::operator=( const Helper::ConstRawDataSpan rawPacket )
+ErrorPacket::ErrorPacket( Helper::ConstRawDataSpan rawPacket ) :
+  ErrorPacket{ DecodeResult_value( decode( rawPacket ) ) }
 {
-  decodeHeader( rawPacket );
-  decodeBody( rawPacket );
-  return *this;
+}
+
+ErrorPacket& ErrorPacket::operator=( Helper::ConstRawDataSpan rawPacket )
+{
+  return *this = DecodeResult_value( decode( rawPacket ) );
 }
 
 ErrorPacket::operator std::string() const
@@ -101,13 +115,12 @@ Helper::RawData ErrorPacket::encode() const
   return rawPacket;
 }
 
-void ErrorPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
+DecodeResult< void > ErrorPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
 {
   // check size
   if ( rawPacket.size() < MinPacketSize )
   {
-    BOOST_THROW_EXCEPTION( InvalidPacketException{}
-      << Helper::AdditionalInfo{ "Invalid packet size of ERROR packet" } );
+    return std::unexpected{ "Invalid packet size of ERROR packet" };
   }
 
   auto rawSpan{ Helper::ConstRawDataSpan{ rawPacket }.subspan( HeaderSize ) };
@@ -120,11 +133,12 @@ void ErrorPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
   // check terminating 0 character
   if ( rawSpan.back() != std::byte{ 0 } )
   {
-    BOOST_THROW_EXCEPTION( InvalidPacketException{}
-      << Helper::AdditionalInfo{ "error message not 0-terminated" } );
+    return std::unexpected{ "error message not 0-terminated" };
   }
 
   std::tie( rawSpan, errorMessageV ) = Helper::RawData_getString( rawSpan, rawSpan.size() - 1U );
+
+  return {};
 }
 
 }
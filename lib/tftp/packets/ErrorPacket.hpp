@@ -52,6 +52,18 @@ class TFTP_EXPORT ErrorPacket final : public Packet
      **/
     explicit ErrorPacket( ErrorCode errorCode, std::string errorMessage = {} );
 
+    /**
+     * @brief Decodes a TFTP error packet from a data buffer.
+     *
+     * In contrast to ErrorPacket(Helper::ConstRawDataSpan), this operation does not throw on invalid packets.
+     *
+     * @param[in] rawPacket
+     *   Packet, which shall be decoded.
+     *
+     * @return Decoded packet or the decoding error.
+     **/
+    [[nodiscard]] static DecodeResult< ErrorPacket > decode( Helper::ConstRawDataSpan rawPacket );
+
     /**
      * @brief Generates a TFTP error packet from a data buffer.
      *
@@ -139,14 +151,9 @@ class TFTP_EXPORT ErrorPacket final : public Packet
      * @param[in] rawPacket
      *   Raw TFP packet
      *
-     * @throw InvalidPacketException
-     *   If data or packet is invalid.
-     * @throw InvalidPacketException
-     *   When rawPacket is not a valid packet.
-     * @throw InvalidPacketException
-     *   When the error message is not 0-terminated.
+     * @return If data or packet is valid.
      **/
-    void decodeBody( Helper::ConstRawDataSpan rawPacket );
+    [[nodiscard]] DecodeResult< void > decodeBody( Helper::ConstRawDataSpan rawPacket );
 
     //! Error Code.
     ErrorCode errorCodeV{ ErrorCode::Invalid };
@@ -41,7 +41,7 @@ std::string Options_toString( const Options &options )
   return result;
 }
 
-Options Options_options( std::string_view rawOptions )
+DecodeResult< Options > Options_decodeOptions( std::string_view rawOptions )
 {
   Options options;
 
@@ -51,8 +51,7 @@ Options Options_options( std::string_view rawOptions )
 
     if ( nameEnd == std::string_view::npos )
     {
-      BOOST_THROW_EXCEPTION( Packets::InvalidPacketException()
-        << Helper::AdditionalInfo{ "Unexpected end of input data" } );
+      return std::unexpected{ "Unexpected end of input data" };
     }
 
     std::string name{ optionsString.substr( 0, nameEnd ) };
@@ -62,8 +61,7 @@ Options Options_options( std::string_view rawOptions )
 
     if ( valueEnd == std::string_view::npos )
     {
-      BOOST_THROW_EXCEPTION( Packets::InvalidPacketException()
-        << Helper::AdditionalInfo{ "Unexpected end of input data" } );
+      return std::unexpected{ "Unexpected end of input data" };
     }
 
     std::string value{ optionsString.substr( 0, valueEnd ) };
@@ -75,6 +73,11 @@ Options Options_options( std::string_view rawOptions )
   return options;
 }
 
+Options Options_options( std::string_view rawOptions )
+{
+  return DecodeResult_value( Options_decodeOptions( rawOptions ) );
+}
+
 RawOptions Options_rawOptions( const Options &options )
 {
   RawOptions rawOptions;
@@ -40,6 +40,18 @@ namespace Tftp::Packets {
  **/
 [[nodiscard]] TFTP_EXPORT std::string Options_toString( const Options &options );
 
+/**
+ * @brief Decodes Options from the given Raw Data without throwing.
+ *
+ * @param[in] rawOptions
+ *   Raw Options
+ *
+ * @return Decoded Options or the decoding error.
+ *
+ * @sa Options_options()
+ **/
+[[nodiscard]] TFTP_EXPORT DecodeResult< Options > Options_decodeOptions( std::string_view rawOptions );
+
 /**
  * @brief Decodes Options from the given Raw Data.
  *
@@ -69,6 +81,32 @@ namespace Tftp::Packets {
  **/
 [[nodiscard]] TFTP_EXPORT RawOptions Options_rawOptions( const Options &options );
 
+/**
+ * @brief Decodes the Option Value.
+ *
+ * Converts @p value to the given @p IntT and checks it against the allowed ranges @p min and @p max.
+ * This operation does not allocate memory and does not throw.
+ *
+ * @tparam IntT
+ *   Unsigned Integer Type.
+ *
+ * @param[in] value
+ *   Option Value
+ * @param[in] min
+ *   Minimum allowed Value
+ * @param[in] max
+ *   Maximum allowed Value
+ *
+ * @return Decoded Option Value.
+ * @retval {}
+ *   When @p value is empty, invalid, or not in the range of @p min and @p max.
+ **/
+template< std::unsigned_integral IntT >
+[[nodiscard]] std::optional< IntT > Options_decodeOption(
+  std::string_view value,
+  IntT min = std::numeric_limits< IntT >::min(),
+  IntT max = std::numeric_limits< IntT >::max() ) noexcept;
+
 /**
  * @brief Decodes the Named Option.
  *
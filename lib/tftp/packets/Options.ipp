@@ -13,8 +13,37 @@
 #ifndef TFTP_PACKETS_OPTIONS_IPP
 #define TFTP_PACKETS_OPTIONS_IPP
 
+#include <charconv>
+#include <cstdint>
+#include <system_error>
+
 namespace Tftp::Packets {
 
+template< std::unsigned_integral IntT >
+std::optional< IntT > Options_decodeOption( std::string_view value, const IntT min, const IntT max ) noexcept
+{
+  if ( value.empty() )
+  {
+    return {};
+  }
+
+  uint64_t optionValue{};
+
+  const auto [ end, errorCode ]{ std::from_chars( value.data(), value.data() + value.size(), optionValue ) };
+
+  if ( ( errorCode != std::errc{} ) || ( end != value.data() + value.size() ) )
+  {
+    return {};
+  }
+
+  if ( ( optionValue < min ) || ( optionValue > max ) )
+  {
+    return {};
+  }
+
+  return static_cast< IntT >( optionValue );
+}
+
 template< std::unsigned_integral IntT >
 std::pair< bool, std::optional< IntT > > Options_getOption(
   Options &options,
@@ -32,42 +61,10 @@ std::pair< bool, std::optional< IntT > > Options_getOption(
     return { true, {} };
   }
 
-  const auto &optionString{ option.mapped() };
-
-  if ( optionString.empty() )
-  {
-    // Option negotiation failed
-    return { false, {} };
-  }
-
-  try
-  {
-    const auto optionValue{ std::stoull( optionString ) };
-
-    if ( ( optionValue < min ) || ( optionValue > max ) )
-    {
-      // Option negotiation failed
-      return { false, {} };
-    }
+  const auto optionValue{ Options_decodeOption< IntT >( option.mapped(), min, max ) };
 
-    // Option negotiation passed with value
-    return { true, static_cast< IntT >( optionValue ) };
-  }
-  catch ( const std::invalid_argument & )
-  {
-    // Option negotiation failed
-    return { false, {} };
-  }
-  catch ( const std::out_of_range & )
-  {
-    // Option negotiation failed
-    return { false, {} };
-  }
-  catch ( ... )
-  {
-    // Option negotiation failed
-    return { false, {} };
-  }
+  // Option negotiation passed with value or failed
+  return { optionValue.has_value(), optionValue };
 }
 
 }
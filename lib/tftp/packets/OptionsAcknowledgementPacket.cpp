@@ -30,17 +30,31 @@ OptionsAcknowledgementPacket::OptionsAcknowledgementPacket( Options options ) :
 {
 }
 
-OptionsAcknowledgementPacket::OptionsAcknowledgementPacket( Helper::ConstRawDataSpan rawPacket ):
-  Packet{ PacketType::OptionsAcknowledgement, rawPacket }
+DecodeResult< OptionsAcknowledgementPacket > OptionsAcknowledgementPacket::decode( Helper::ConstRawDataSpan rawPacket )
+{
+  OptionsAcknowledgementPacket packet{ Options{} };
+
+  if ( const auto result{ packet.decodeHeader( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  if ( const auto result{ packet.decodeBody( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  return packet;
+}
+
+OptionsAcknowledgementPacket::OptionsAcknowledgementPacket( Helper::ConstRawDataSpan rawPacket ) :
+  OptionsAcknowledgementPacket{ DecodeResult_value( decode( rawPacket ) ) }
 {
-  decodeBody( rawPacket );
 }
 
 OptionsAcknowledgementPacket& OptionsAcknowledgementPacket::operator=( Helper::ConstRawDataSpan rawPacket )
 {
-  decodeHeader( rawPacket );
-  decodeBody( rawPacket );
-  return *this;
+  return *this = DecodeResult_value( decode( rawPacket ) );
 }
 
 const Options& OptionsAcknowledgementPacket::options() const
@@ -77,20 +91,28 @@ Helper::RawData OptionsAcknowledgementPacket::encode() const
   return rawPacket;
 }
 
-void OptionsAcknowledgementPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
+DecodeResult< void > OptionsAcknowledgementPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
 {
   // check size
   if ( rawPacket.size() <= HeaderSize )
   {
-    BOOST_THROW_EXCEPTION( InvalidPacketException()
-      << Helper::AdditionalInfo{ "Invalid packet size of OACK packet" } );
+    return std::unexpected{ "Invalid packet size of OACK packet" };
   }
 
   auto rawSpan{ rawPacket.subspan( HeaderSize ) };
 
   // assign options
-  auto [ _, options ]{ Helper::RawData_getString( rawSpan, rawSpan.size() ) };
-  optionsV = Options_options( options );
+  auto [ _, rawOptions ]{ Helper::RawData_getString( rawSpan, rawSpan.size() ) };
+  auto options{ Options_decodeOptions( rawOptions ) };
+
+  if ( !options )
+  {
+    return std::unexpected{ options.error() };
+  }
+
+  optionsV = std::move( *options );
+
+  return {};
 }
 
 }
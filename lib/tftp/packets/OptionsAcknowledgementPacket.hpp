@@ -44,6 +44,19 @@ class TFTP_EXPORT OptionsAcknowledgementPacket final : public Packet
      **/
     explicit OptionsAcknowledgementPacket( Options options );
 
+    /**
+     * @brief Decodes a TFTP options acknowledgement packet from a data buffer.
+     *
+     * In contrast to OptionsAcknowledgementPacket(Helper::ConstRawDataSpan), this operation does not throw on invalid
+     * packets.
+     *
+     * @param[in] rawPacket
+     *   Packet, which shall be decoded.
+     *
+     * @return Decoded packet or the decoding error.
+     **/
+    [[nodiscard]] static DecodeResult< OptionsAcknowledgementPacket > decode( Helper::ConstRawDataSpan rawPacket );
+
     /**
      * @brief Generates a TFTP Options Acknowledgement packet from a data buffer
      *
@@ -109,10 +122,9 @@ class TFTP_EXPORT OptionsAcknowledgementPacket final : public Packet
      * @param[in] rawPacket
      *   Raw TFP packet
      *
-     * @throw InvalidPacketException
-     *   If data or packet is invalid.
+     * @return If data or packet is valid.
      **/
-    void decodeBody( Helper::ConstRawDataSpan rawPacket );
+    [[nodiscard]] DecodeResult< void > decodeBody( Helper::ConstRawDataSpan rawPacket );
 
     //! Stored Options.
     Options optionsV;
@@ -93,11 +93,6 @@ Packet::Packet( const PacketType packetType ) noexcept:
 {
 }
 
-Packet::Packet( const PacketType packetType, Helper::ConstRawDataSpan rawPacket ) : packetTypeV{ packetType }
-{
-  decodeHeader( rawPacket );
-}
-
 Packet::operator Helper::RawData() const
 {
   return encode();
@@ -126,13 +121,12 @@ void Packet::insertHeader( Helper::RawDataSpan rawPacket ) const
   Helper::RawData_setInt( rawPacket, std::to_underlying( packetTypeV ) );
 }
 
-void Packet::decodeHeader( Helper::ConstRawDataSpan rawPacket )
+DecodeResult< void > Packet::decodeHeader( Helper::ConstRawDataSpan rawPacket ) const noexcept
 {
   // check size
   if ( rawPacket.size() < HeaderSize )
   {
-    BOOST_THROW_EXCEPTION( InvalidPacketException()
-      << Helper::AdditionalInfo{ "Invalid packet size (HEADER SIZE)" } );
+    return std::unexpected{ "Invalid packet size (HEADER SIZE)" };
   }
 
   // Check Opcode
@@ -140,9 +134,10 @@ void Packet::decodeHeader( Helper::ConstRawDataSpan rawPacket )
 
   if ( opcode != std::to_underlying( packetTypeV ) )
   {
-    BOOST_THROW_EXCEPTION( InvalidPacketException()
-      << Helper::AdditionalInfo{ "Invalid opcode" } );
+    return std::unexpected{ "Invalid opcode" };
   }
+
+  return {};
 }
 
 }
@@ -79,18 +79,6 @@ class TFTP_EXPORT Packet
      **/
     explicit Packet( PacketType packetType ) noexcept;
 
-    /**
-     * @brief Generates a basic TFTP packet from a data buffer
-     *
-     * Only decodes TFTP header.
-     *
-     * @param[in] packetType
-     *   Packet type of the packet.
-     * @param[in] rawPacket
-     *   Packet, which shall be decoded.
-     **/
-    Packet( PacketType packetType, Helper::ConstRawDataSpan rawPacket );
-
     /**
      * @brief Copy Constructor
      *
@@ -155,8 +143,10 @@ class TFTP_EXPORT Packet
      *
      * @param[in] rawPacket
      *   Packet, which shall be decoded.
+     *
+     * @return If the header is valid.
      **/
-    void decodeHeader( Helper::ConstRawDataSpan rawPacket );
+    [[nodiscard]] DecodeResult< void > decodeHeader( Helper::ConstRawDataSpan rawPacket ) const noexcept;
 
   private:
     //! TFTP Packet Type
@@ -13,9 +13,18 @@
 #ifndef TFTP_PACKETS_PACKETEXCEPTION_HPP
 #define TFTP_PACKETS_PACKETEXCEPTION_HPP
 
+#include <tftp/packets/Packets.hpp>
+
 #include <tftp/Tftp.hpp>
 #include <tftp/TftpException.hpp>
 
+#include <helper/Exception.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <string>
+#include <utility>
+
 namespace Tftp::Packets {
 
 //! TFTP %Packet Processing Exception.
@@ -32,6 +41,34 @@ class TFTP_EXPORT InvalidPacketException : public TftpException
 //! TFTP Packet Type Information.
 using PacketTypeInfo = boost::error_info< struct PacketTypeInfoTag, PacketType >;
 
+/**
+ * @brief Returns the Value of the Decode Result.
+ *
+ * Used to implement the throwing constructors on top of the exception-free decoding functions.
+ *
+ * @tparam T
+ *   Decoded Type.
+ *
+ * @param[in] result
+ *   Decode Result.
+ *
+ * @return Decoded Value.
+ *
+ * @throw InvalidPacketException
+ *   When @p result contains an error.
+ **/
+template< typename T >
+[[nodiscard]] T DecodeResult_value( DecodeResult< T > result )
+{
+  if ( !result )
+  {
+    BOOST_THROW_EXCEPTION( InvalidPacketException{}
+      << Helper::AdditionalInfo{ std::string{ result.error() } } );
+  }
+
+  return std::move( *result );
+}
+
 }
 
 #endif
@@ -16,7 +16,6 @@
 #include <tftp/packets/DataPacket.hpp>
 #include <tftp/packets/ErrorPacket.hpp>
 #include <tftp/packets/OptionsAcknowledgementPacket.hpp>
-#include <tftp/packets/PacketException.hpp>
 #include <tftp/packets/PacketStatistic.hpp>
 #include <tftp/packets/ReadRequestPacket.hpp>
 #include <tftp/packets/WriteRequestPacket.hpp>
@@ -30,16 +29,16 @@ void PacketHandler::packet( const boost::asio::ip::udp::endpoint &remote, Helper
   switch ( Packet::packetType( rawPacket ) )
   {
     case PacketType::ReadRequest:
-      try
+      if ( const auto readRequest{ ReadRequestPacket::decode( rawPacket ) }; readRequest )
       {
-        readRequestPacket( remote, ReadRequestPacket{ rawPacket } );
+        readRequestPacket( remote, *readRequest );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::ReadRequest, rawPacket.size() );
       }
-      catch ( const InvalidPacketException &e )
+      else
       {
-        SPDLOG_ERROR( "Error decoding/ handling RRQ packet: {}", e.what() );
+        SPDLOG_ERROR( "Error decoding RRQ packet: {}", readRequest.error() );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::Invalid, rawPacket.size() );
@@ -49,16 +48,16 @@ void PacketHandler::packet( const boost::asio::ip::udp::endpoint &remote, Helper
       break;
 
     case PacketType::WriteRequest:
-      try
+      if ( const auto writeRequest{ WriteRequestPacket::decode( rawPacket ) }; writeRequest )
       {
-        writeRequestPacket( remote, WriteRequestPacket{ rawPacket } );
+        writeRequestPacket( remote, *writeRequest );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::WriteRequest, rawPacket.size() );
       }
-      catch ( const InvalidPacketException &e )
+      else
       {
-       SPDLOG_ERROR( "Error decoding/ handling WRQ packet: {}", e.what() );
+        SPDLOG_ERROR( "Error decoding WRQ packet: {}", writeRequest.error() );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::Invalid, rawPacket.size() );
@@ -68,16 +67,16 @@ void PacketHandler::packet( const boost::asio::ip::udp::endpoint &remote, Helper
       break;
 
     case PacketType::Data:
-      try
+      if ( const auto data{ DataPacket::decode( rawPacket ) }; data )
       {
-        dataPacket( remote, Packets::DataPacket{ rawPacket } );
+        dataPacket( remote, *data );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::Data, rawPacket.size() );
       }
-      catch ( const InvalidPacketException &e )
+      else
       {
-        SPDLOG_ERROR( "Error decoding/ handling DATA packet: {}", e.what() );
+        SPDLOG_ERROR( "Error decoding DATA packet: {}", data.error() );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::Invalid, rawPacket.size() );
@@ -87,16 +86,16 @@ void PacketHandler::packet( const boost::asio::ip::udp::endpoint &remote, Helper
       break;
 
     case PacketType::Acknowledgement:
-      try
+      if ( const auto acknowledgement{ AcknowledgementPacket::decode( rawPacket ) }; acknowledgement )
       {
-        acknowledgementPacket( remote, AcknowledgementPacket{ rawPacket } );
+        acknowledgementPacket( remote, *acknowledgement );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::Acknowledgement, rawPacket.size() );
       }
-      catch ( const InvalidPacketException &e )
+      else
       {
-        SPDLOG_ERROR( "Error decoding/ handling ACK packet: {}", e.what() );
+        SPDLOG_ERROR( "Error decoding ACK packet: {}", acknowledgement.error() );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::Invalid, rawPacket.size() );
@@ -106,16 +105,16 @@ void PacketHandler::packet( const boost::asio::ip::udp::endpoint &remote, Helper
       break;
 
     case PacketType::Error:
-      try
+      if ( const auto error{ ErrorPacket::decode( rawPacket ) }; error )
       {
-        errorPacket( remote, ErrorPacket{ rawPacket } );
+        errorPacket( remote, *error );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::Error, rawPacket.size() );
       }
-      catch ( const Packets::InvalidPacketException &e )
+      else
       {
-        SPDLOG_ERROR( "Error decoding/ handling ERR packet: {}", e.what() );
+        SPDLOG_ERROR( "Error decoding ERR packet: {}", error.error() );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::Invalid, rawPacket.size() );
@@ -125,16 +124,16 @@ void PacketHandler::packet( const boost::asio::ip::udp::endpoint &remote, Helper
       break;
 
     case PacketType::OptionsAcknowledgement:
-      try
+      if ( const auto optionsAcknowledgement{ OptionsAcknowledgementPacket::decode( rawPacket ) }; optionsAcknowledgement )
       {
-        optionsAcknowledgementPacket( remote, OptionsAcknowledgementPacket{ rawPacket } );
+        optionsAcknowledgementPacket( remote, *optionsAcknowledgement );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::OptionsAcknowledgement, rawPacket.size() );
       }
-      catch ( const Packets::InvalidPacketException &e )
+      else
       {
-        SPDLOG_ERROR( "Error decoding/ handling OACK packet: {}", e.what() );
+        SPDLOG_ERROR( "Error decoding OACK packet: {}", optionsAcknowledgement.error() );
 
         // Update statistic
         PacketStatistic::globalReceive().packet( PacketType::Invalid, rawPacket.size() );
@@ -151,5 +150,4 @@ void PacketHandler::packet( const boost::asio::ip::udp::endpoint &remote, Helper
       break;
   }
 }
-
 }
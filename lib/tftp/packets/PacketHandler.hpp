@@ -40,11 +40,9 @@ class TFTP_EXPORT PacketHandler
      *
      * This handler tries to decode the received packet as TFTP packet and calls the suitable handler method.
      *
-     * If the packet cannot be decoded handleInvalidPacket() is called.
-     *
-     * If during handling (including packet conversion) a InvalidPacketException exception is thrown,
-     * @ref invalidPacket is called automatically.
-     * This exception is not re-thrown.
+     * The packets are decoded by the exception-free decode operations of the packet classes (i.e.
+     * DataPacket::decode()).
+     * If the packet cannot be decoded @ref invalidPacket is called.
      *
      * @param[in] remote
      *   Source of the TFTP Packet.
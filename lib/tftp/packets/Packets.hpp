@@ -22,10 +22,12 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <expected>
 #include <map>
 #include <optional>
 #include <span>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -155,6 +157,24 @@ using Options = std::map< std::string, std::string, std::less< > >;
 //! Error Information
 using ErrorInformation = std::optional< std::tuple< ErrorCode, std::string > >;
 
+/**
+ * @brief %Packet Decoding Error.
+ *
+ * Static description, why the raw data could not be decoded.
+ **/
+using DecodeError = std::string_view;
+
+/**
+ * @brief Result of a %Packet Decoding Operation.
+ *
+ * Decoding functions report malformed input by @p std::unexpected instead of throwing an exception.
+ *
+ * @tparam T
+ *   Decoded Type.
+ **/
+template< typename T >
+using DecodeResult = std::expected< T, DecodeError >;
+
 }
 
 #endif
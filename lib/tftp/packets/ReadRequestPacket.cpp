@@ -12,6 +12,8 @@
 
 #include "ReadRequestPacket.hpp"
 
+#include <tftp/packets/PacketException.hpp>
+
 namespace Tftp::Packets {
 
 ReadRequestPacket::ReadRequestPacket( std::string filename, const TransferMode mode, Options options ) noexcept :
@@ -19,16 +21,31 @@ ReadRequestPacket::ReadRequestPacket( std::string filename, const TransferMode m
 {
 }
 
+DecodeResult< ReadRequestPacket > ReadRequestPacket::decode( Helper::ConstRawDataSpan rawPacket )
+{
+  ReadRequestPacket packet{ {}, TransferMode::Invalid, {} };
+
+  if ( const auto result{ packet.decodeHeader( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  if ( const auto result{ packet.decodeBody( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  return packet;
+}
+
 ReadRequestPacket::ReadRequestPacket( Helper::ConstRawDataSpan rawPacket ) :
-  ReadWriteRequestPacket( PacketType::ReadRequest, rawPacket )
+  ReadRequestPacket{ DecodeResult_value( decode( rawPacket ) ) }
 {
 }
 
 ReadRequestPacket& ReadRequestPacket::operator=( Helper::ConstRawDataSpan rawPacket )
 {
-  decodeHeader( rawPacket );
-  decodeBody( rawPacket );
-  return *this;
+  return *this = DecodeResult_value( decode( rawPacket ) );
 }
 
 }
@@ -39,6 +39,18 @@ class TFTP_EXPORT ReadRequestPacket final : public ReadWriteRequestPacket
      **/
     ReadRequestPacket( std::string filename, TransferMode mode, Options options ) noexcept;
 
+    /**
+     * @brief Decodes a TFTP Read Request packet from a data buffer.
+     *
+     * In contrast to ReadRequestPacket(Helper::ConstRawDataSpan), this operation does not throw on invalid packets.
+     *
+     * @param[in] rawPacket
+     *   Packet, which shall be decoded.
+     *
+     * @return Decoded packet or the decoding error.
+     **/
+    [[nodiscard]] static DecodeResult< ReadRequestPacket > decode( Helper::ConstRawDataSpan rawPacket );
+
     /**
      * @brief Generates a TFTP Read Request packet from a data buffer
      *
@@ -14,12 +14,14 @@
 
 #include <tftp/packets/PacketException.hpp>
 #include <tftp/packets/Options.hpp>
+#include <tftp/packets/ReadWriteRequestPacketView.hpp>
 
 #include <helper/Exception.hpp>
 
 #include <boost/exception/all.hpp>
 
 #include <algorithm>
+#include <cctype>
 #include <format>
 #include <utility>
 
@@ -47,21 +49,29 @@ std::string_view ReadWriteRequestPacket::decodeMode( const TransferMode mode )
 
 TransferMode ReadWriteRequestPacket::decodeMode( std::string_view mode )
 {
-  std::string upperMode;
-
-  std::ranges::transform( mode, std::back_inserter( upperMode ), toupper );
-
-  if ( upperMode == "OCTET" )
+  // case-insensitive compare without creating a temporary upper-case copy
+  const auto equals{ [ mode ]( std::string_view name )
+  {
+    return std::ranges::equal(
+      mode,
+      name,
+      []( const char lhs, const char rhs )
+      {
+        return std::toupper( static_cast< unsigned char >( lhs ) ) == rhs;
+      } );
+  } };
+
+  if ( equals( "OCTET" ) )
   {
     return TransferMode::OCTET;
   }
 
-  if ( upperMode == "NETASCII" )
+  if ( equals( "NETASCII" ) )
   {
     return TransferMode::NETASCII;
   }
 
-  if ( upperMode == "MAIL" )
+  if ( equals( "MAIL" ) )
   {
     return TransferMode::MAIL;
   }
@@ -138,72 +148,20 @@ ReadWriteRequestPacket::ReadWriteRequestPacket(
   }
 }
 
-ReadWriteRequestPacket::ReadWriteRequestPacket( const PacketType packetType, Helper::ConstRawDataSpan rawPacket ) :
-  Packet{ packetType, rawPacket },
-  modeV{}
-{
-  switch ( packetType )
-  {
-    case PacketType::ReadRequest:
-    case PacketType::WriteRequest:
-      break;
-
-    default:
-      BOOST_THROW_EXCEPTION( InvalidPacketException()
-        << Helper::AdditionalInfo{
-          "Wrong packet type supplied only RRQ/WRW allowed" } );
-      /* no break - because BOOST_THROW_EXCEPTION throws */
-  }
-
-  decodeBody( rawPacket );
-}
-
-void ReadWriteRequestPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
+DecodeResult< void > ReadWriteRequestPacket::decodeBody( Helper::ConstRawDataSpan rawPacket )
 {
-  // check size
-  if ( rawPacket.size() <= HeaderSize )
-  {
-    BOOST_THROW_EXCEPTION( InvalidPacketException()
-      << Helper::AdditionalInfo{ "Invalid packet size of RRQ/WRQ packet" } );
-  }
-
-  auto rawSpan{ Helper::ConstRawDataSpan{ rawPacket }.subspan( HeaderSize ) };
-
-  // check terminating 0 character
-  if ( rawSpan.back() != std::byte{ 0 } )
-  {
-    BOOST_THROW_EXCEPTION( InvalidPacketException()
-      << Helper::AdditionalInfo{ "RRQ/WRQ message not 0-terminated" } );
-  }
-
-  auto [ _, rawRequestString ]{ Helper::RawData_getString( rawSpan, rawSpan.size() ) };
-
-  // filename
-  const auto filenameEnd{ rawRequestString.find( '\0' ) };
-
-  if ( filenameEnd == std::string_view::npos )
-  {
-    BOOST_THROW_EXCEPTION( InvalidPacketException()
-      << Helper::AdditionalInfo{ "No 0-termination for filename found" } );
-  }
-
-  filenameV = rawRequestString.substr( 0, filenameEnd );
-  rawRequestString = rawRequestString.substr( filenameEnd + 1U );
-
-  // transfer mode
-  const auto modeEnd{ rawRequestString.find( '\0' ) };
+  const ReadWriteRequestPacketView requestPacket{ rawPacket };
 
-  if ( modeEnd == std::string_view::npos )
+  if ( !requestPacket )
   {
-    BOOST_THROW_EXCEPTION( InvalidPacketException()
-      << Helper::AdditionalInfo{ "No 0-termination for operation found" } );
+    return std::unexpected{ "Invalid RRQ/WRQ packet" };
   }
 
-  modeV = decodeMode( rawRequestString.substr( 0, modeEnd ) );
-  rawRequestString = rawRequestString.substr( modeEnd + 1U );
+  filenameV = requestPacket.filename();
+  modeV = requestPacket.mode();
+  optionsV = requestPacket.ownedOptions();
 
-  // assign options
-  optionsV = Options_options( rawRequestString );
+  return {};
 }
 
 Helper::RawData ReadWriteRequestPacket::encode() const
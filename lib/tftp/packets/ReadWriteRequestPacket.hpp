@@ -155,30 +155,17 @@ class TFTP_EXPORT ReadWriteRequestPacket : public Packet
      **/
     ReadWriteRequestPacket( PacketType packetType, std::string filename, TransferMode mode, Options options );
 
-    /**
-     * @brief Generates a TFTP Read/ Write Request packet from a data buffer
-     *
-     * @param[in] packetType
-     *   The type of the packet. Only READ_REQUEST or
-     *   WRITE_REQUEST is allowed.
-     * @param[in] rawPacket
-     *   Packet, which shall be decoded.
-     *
-     * @throw InvalidPacketException
-     *   When rawPacket is not a valid packet.
-     **/
-    ReadWriteRequestPacket( PacketType packetType, Helper::ConstRawDataSpan rawPacket );
-
     /**
      * @brief Decodes the TFTP body.
      *
+     * The body is validated by ReadWriteRequestPacketView and copied afterwards.
+     *
      * @param[in] rawPacket
      *   Raw TFP packet
      *
-     * @throw InvalidPacketException
-     *   If data or packet is invalid.
+     * @return If data or packet is valid.
      **/
-    void decodeBody( Helper::ConstRawDataSpan rawPacket );
+    [[nodiscard]] DecodeResult< void > decodeBody( Helper::ConstRawDataSpan rawPacket );
 
   private:
     /**
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Packets::ReadWriteRequestPacketView.
+ **/
+
+#include "ReadWriteRequestPacketView.hpp"
+
+#include <tftp/packets/Options.hpp>
+#include <tftp/packets/Packet.hpp>
+#include <tftp/packets/ReadWriteRequestPacket.hpp>
+
+#include <algorithm>
+#include <format>
+
+namespace Tftp::Packets {
+
+ReadWriteRequestPacketView::OptionIterator::OptionIterator( std::string_view rawOptions ) noexcept :
+  remainingV{ rawOptions }
+{
+  decode();
+}
+
+ReadWriteRequestPacketView::OptionIterator::value_type
+ReadWriteRequestPacketView::OptionIterator::operator*() const noexcept
+{
+  return currentV;
+}
+
+ReadWriteRequestPacketView::OptionIterator& ReadWriteRequestPacketView::OptionIterator::operator++() noexcept
+{
+  // skip name, value, and both terminators
+  remainingV.remove_prefix( currentV.first.size() + 1U + currentV.second.size() + 1U );
+  decode();
+  return *this;
+}
+
+ReadWriteRequestPacketView::OptionIterator ReadWriteRequestPacketView::OptionIterator::operator++( int ) noexcept
+{
+  auto iterator{ *this };
+  ++( *this );
+  return iterator;
+}
+
+bool ReadWriteRequestPacketView::OptionIterator::operator==( std::default_sentinel_t ) const noexcept
+{
+  return remainingV.empty();
+}
+
+void ReadWriteRequestPacketView::OptionIterator::decode() noexcept
+{
+  if ( remainingV.empty() )
+  {
+    currentV = {};
+    return;
+  }
+
+  // termination has been validated by ReadWriteRequestPacketView
+  const auto nameEnd{ remainingV.find( '\0' ) };
+  const auto valueEnd{ remainingV.find( '\0', nameEnd + 1U ) };
+
+  currentV = {
+    remainingV.substr( 0, nameEnd ),
+    remainingV.substr( nameEnd + 1U, valueEnd - nameEnd - 1U ) };
+}
+
+ReadWriteRequestPacketView::ReadWriteRequestPacketView( Helper::ConstRawDataSpan rawPacket ) noexcept
+{
+  const auto packetType{ Packet::packetType( rawPacket ) };
+
+  if ( ( PacketType::ReadRequest != packetType ) && ( PacketType::WriteRequest != packetType ) )
+  {
+    return;
+  }
+
+  // check size
+  if ( rawPacket.size() <= Packet::HeaderSize )
+  {
+    return;
+  }
+
+  const std::string_view rawRequestString{
+    // NOLINTNEXTLINE( cppcoreguidelines-pro-type-reinterpret-cast ): std::byte to char view
+    reinterpret_cast< const char * >( rawPacket.data() ) + Packet::HeaderSize,
+    rawPacket.size() - Packet::HeaderSize };
+
+  // check terminating 0 character
+  if ( rawRequestString.back() != '\0' )
+  {
+    return;
+  }
+
+  // filename
+  const auto filenameEnd{ rawRequestString.find( '\0' ) };
+
+  // transfer mode
+  const auto modeEnd{ rawRequestString.find( '\0', filenameEnd + 1U ) };
+
+  if ( modeEnd == std::string_view::npos )
+  {
+    return;
+  }
+
+  // options - each option consists of a 0-terminated name and a 0-terminated value
+  const auto rawOptions{ rawRequestString.substr( modeEnd + 1U ) };
+
+  if ( ( std::ranges::count( rawOptions, '\0' ) % 2U ) != 0U )
+  {
+    return;
+  }
+
+  packetTypeV = packetType;
+  filenameV = rawRequestString.substr( 0, filenameEnd );
+  modeV = rawRequestString.substr( filenameEnd + 1U, modeEnd - filenameEnd - 1U );
+  rawOptionsV = rawOptions;
+}
+
+ReadWriteRequestPacketView::operator bool() const noexcept
+{
+  return PacketType::Invalid != packetTypeV;
+}
+
+PacketType ReadWriteRequestPacketView::packetType() const noexcept
+{
+  return packetTypeV;
+}
+
+std::string_view ReadWriteRequestPacketView::filename() const noexcept
+{
+  return filenameV;
+}
+
+std::string_view ReadWriteRequestPacketView::rawMode() const noexcept
+{
+  return modeV;
+}
+
+TransferMode ReadWriteRequestPacketView::mode() const noexcept
+{
+  return ReadWriteRequestPacket::decodeMode( modeV );
+}
+
+ReadWriteRequestPacketView::OptionsRange ReadWriteRequestPacketView::options() const noexcept
+{
+  return { OptionIterator{ rawOptionsV }, std::default_sentinel };
+}
+
+std::optional< std::string_view > ReadWriteRequestPacketView::option( std::string_view name ) const noexcept
+{
+  for ( const auto &[ optionName, optionValue ] : options() )
+  {
+    if ( optionName == name )
+    {
+      return optionValue;
+    }
+  }
+
+  return {};
+}
+
+Options ReadWriteRequestPacketView::ownedOptions() const
+{
+  Options ownedOptions;
+
+  for ( const auto &[ name, value ] : options() )
+  {
+    ownedOptions.emplace( name, value );
+  }
+
+  return ownedOptions;
+}
+
+ReadWriteRequestPacketView::operator std::string() const
+{
+  if ( !*this )
+  {
+    return "RRQ/WRQ: *Invalid*";
+  }
+
+  return std::format(
+    "{}: FILE: '{}' MODE: '{}' OPT: '{}'",
+    PacketType::ReadRequest == packetTypeV ? "RRQ" : "WRQ",
+    filenameV,
+    modeV,
+    Options_toString( ownedOptions() ) );
+}
+
+}
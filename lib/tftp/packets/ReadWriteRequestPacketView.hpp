@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Packets::ReadWriteRequestPacketView.
+ **/
+
+#ifndef TFTP_PACKETS_READWRITEREQUESTPACKETVIEW_HPP
+#define TFTP_PACKETS_READWRITEREQUESTPACKETVIEW_HPP
+
+#include <tftp/packets/Packets.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace Tftp::Packets {
+
+/**
+ * @brief Validated View of a TFTP Read-/ Write- Request %Packet.
+ *
+ * In contrast to ReadWriteRequestPacket, this class does not copy any data of the received datagram.
+ * Filename, transfer mode, and options are provided as `std::string_view`, which refer to the raw packet.
+ * Therefore, the raw packet must outlive the view.
+ *
+ * Malformed packets are not reported by exceptions.
+ * The validity of the decoded packet is checked by @ref operator bool().
+ *
+ * This class is intended for request intake, where the request should be cheaply validated before the decision is
+ * made whether it is accepted or not.
+ *
+ * @sa ReadWriteRequestPacket
+ **/
+class TFTP_EXPORT ReadWriteRequestPacketView final
+{
+  public:
+    //! Option Name and Value Pair
+    using Option = std::pair< std::string_view, std::string_view >;
+
+    /**
+     * @brief Iterator over the Options of the Request.
+     *
+     * The end of the option list is signaled by comparison with `std::default_sentinel`.
+     **/
+    class TFTP_EXPORT OptionIterator
+    {
+      public:
+        //! Value Type
+        using value_type = Option;
+        //! Difference Type
+        using difference_type = std::ptrdiff_t;
+
+        //! Creates an exhausted Iterator.
+        OptionIterator() noexcept = default;
+
+        /**
+         * @brief Creates the Iterator over the validated Raw Options.
+         *
+         * @param[in] rawOptions
+         *   Raw Options. Must be validated before.
+         **/
+        explicit OptionIterator( std::string_view rawOptions ) noexcept;
+
+        /**
+         * @brief Returns the current Option.
+         *
+         * @return Current Option.
+         **/
+        [[nodiscard]] value_type operator*() const noexcept;
+
+        /**
+         * @brief Advances to the next Option.
+         *
+         * @return *this
+         **/
+        OptionIterator& operator++() noexcept;
+
+        /**
+         * @brief Advances to the next Option.
+         *
+         * @return Iterator before increment.
+         **/
+        OptionIterator operator++( int ) noexcept;
+
+        /**
+         * @brief Checks if the Iterator is exhausted.
+         *
+         * @return If the end of the option list is reached.
+         **/
+        [[nodiscard]] bool operator==( std::default_sentinel_t ) const noexcept;
+
+      private:
+        //! Decodes the current Option from the remaining Raw Options
+        void decode() noexcept;
+
+        //! Remaining Raw Options (including the current one)
+        std::string_view remainingV;
+        //! Current Option
+        value_type currentV;
+    };
+
+    //! Range of Options
+    using OptionsRange = std::ranges::subrange< OptionIterator, std::default_sentinel_t >;
+
+    /**
+     * @brief Decodes and validates the raw RRQ/ WRQ packet.
+     *
+     * When the packet is malformed, the view is invalid (@ref operator bool() returns false).
+     *
+     * @param[in] rawPacket
+     *   Raw Packet. Must outlive the view.
+     **/
+    explicit ReadWriteRequestPacketView( Helper::ConstRawDataSpan rawPacket ) noexcept;
+
+    /**
+     * @brief Returns if the Packet has been decoded successfully.
+     *
+     * @return If the Packet is a valid RRQ or WRQ.
+     **/
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /**
+     * @brief Returns the Packet Type.
+     *
+     * @return Packet Type.
+     * @retval PacketType::Invalid
+     *   When the packet is not valid.
+     **/
+    [[nodiscard]] PacketType packetType() const noexcept;
+
+    /**
+     * @brief Returns the request Filename.
+     *
+     * @return Filename
+     **/
+    [[nodiscard]] std::string_view filename() const noexcept;
+
+    /**
+     * @brief Returns the Transfer Mode String as received.
+     *
+     * @return Raw Transfer Mode.
+     **/
+    [[nodiscard]] std::string_view rawMode() const noexcept;
+
+    /**
+     * @brief Returns the decoded Transfer Mode.
+     *
+     * @return Transfer Mode.
+     * @retval TransferMode::Invalid
+     *   When the mode is not a valid transfer mode.
+     **/
+    [[nodiscard]] TransferMode mode() const noexcept;
+
+    /**
+     * @brief Returns the Options of the Request.
+     *
+     * @return Options Range.
+     **/
+    [[nodiscard]] OptionsRange options() const noexcept;
+
+    /**
+     * @brief Returns the value of the named Option.
+     *
+     * @param[in] name
+     *   Option Name.
+     *
+     * @return Option Value
+     * @retval {}
+     *   When option is not present.
+     **/
+    [[nodiscard]] std::optional< std::string_view > option( std::string_view name ) const noexcept;
+
+    /**
+     * @brief Returns a copy of the Options.
+     *
+     * @return Options.
+     **/
+    [[nodiscard]] Options ownedOptions() const;
+
+    /**
+     * @brief Returns a string, which describes the packet.
+     *
+     * This operation is used for debugging and information purposes.
+     *
+     * @return Packet description.
+     **/
+    explicit operator std::string() const;
+
+  private:
+    //! Packet Type
+    PacketType packetTypeV{ PacketType::Invalid };
+    //! Filename
+    std::string_view filenameV;
+    //! Transfer Mode as received
+    std::string_view modeV;
+    //! Raw Options
+    std::string_view rawOptionsV;
+};
+
+}
+
+#endif
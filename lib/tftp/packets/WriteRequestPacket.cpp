@@ -12,6 +12,8 @@
 
 #include "WriteRequestPacket.hpp"
 
+#include <tftp/packets/PacketException.hpp>
+
 namespace Tftp::Packets {
 
 WriteRequestPacket::WriteRequestPacket( std::string filename, TransferMode mode, Options options ) noexcept :
@@ -19,16 +21,31 @@ WriteRequestPacket::WriteRequestPacket( std::string filename, TransferMode mode,
 {
 }
 
+DecodeResult< WriteRequestPacket > WriteRequestPacket::decode( Helper::ConstRawDataSpan rawPacket )
+{
+  WriteRequestPacket packet{ {}, TransferMode::Invalid, {} };
+
+  if ( const auto result{ packet.decodeHeader( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  if ( const auto result{ packet.decodeBody( rawPacket ) }; !result )
+  {
+    return std::unexpected{ result.error() };
+  }
+
+  return packet;
+}
+
 WriteRequestPacket::WriteRequestPacket( Helper::ConstRawDataSpan rawPacket ) :
-  ReadWriteRequestPacket{ PacketType::WriteRequest, rawPacket }
+  WriteRequestPacket{ DecodeResult_value( decode( rawPacket ) ) }
 {
 }
 
 WriteRequestPacket& WriteRequestPacket::operator=( Helper::ConstRawDataSpan rawPacket )
 {
-  decodeHeader( rawPacket);
-  decodeBody( rawPacket);
-  return *this;
+  return *this = DecodeResult_value( decode( rawPacket ) );
 }
 
 }
@@ -36,6 +36,18 @@ class TFTP_EXPORT WriteRequestPacket final : public ReadWriteRequestPacket
      **/
     WriteRequestPacket( std::string filename, TransferMode mode, Options options ) noexcept;
 
+    /**
+     * @brief Decodes a TFTP Write Request packet from a data buffer.
+     *
+     * In contrast to WriteRequestPacket(Helper::ConstRawDataSpan), this operation does not throw on invalid packets.
+     *
+     * @param[in] rawPacket
+     *   Packet, which shall be decoded.
+     *
+     * @return Decoded packet or the decoding error.
+     **/
+    [[nodiscard]] static DecodeResult< WriteRequestPacket > decode( Helper::ConstRawDataSpan rawPacket );
+
     /**
      * @brief Generates a TFTP Write Request packet from a data buffer
      *
@@ -89,6 +89,18 @@ BOOST_AUTO_TEST_CASE( constructor2 )
     Tftp::Packets::InvalidPacketException );
 }
 
+//! Exception-free decoding Test
+BOOST_AUTO_TEST_CASE( decode )
+{
+  const auto ack{ AcknowledgementPacket::decode( std::as_bytes( std::span{ rawAckPacket } ) ) };
+  BOOST_REQUIRE( ack );
+  BOOST_CHECK( ack->blockNumber() == BlockNumber( 0x1001U ) );
+
+  BOOST_CHECK( !AcknowledgementPacket::decode( std::as_bytes( std::span{ rawAckPacketInv1 } ) ) );
+  BOOST_CHECK( !AcknowledgementPacket::decode( std::as_bytes( std::span{ rawAckPacketInv2 } ) ) );
+  BOOST_CHECK( !AcknowledgementPacket::decode( std::as_bytes( std::span{ rawAckPacketInv3 } ) ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
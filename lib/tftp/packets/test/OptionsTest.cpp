@@ -61,6 +61,25 @@ BOOST_AUTO_TEST_CASE( optionsDecode )
   BOOST_CHECK_THROW( boost::ignore_unused( Options_options( optionStr2 ) ), TftpException );
   BOOST_CHECK_THROW( boost::ignore_unused( Options_options( optionStr3 ) ), TftpException );
   BOOST_CHECK_THROW( boost::ignore_unused( Options_options( optionStr4 ) ), TftpException );
+
+  BOOST_CHECK( Options_decodeOptions( optionStr1 ) );
+  BOOST_CHECK( !Options_decodeOptions( optionStr2 ) );
+  BOOST_CHECK( !Options_decodeOptions( optionStr3 ) );
+  BOOST_CHECK( !Options_decodeOptions( optionStr4 ) );
+}
+
+//! Options_decodeOption tests
+BOOST_AUTO_TEST_CASE( decodeOption )
+{
+  BOOST_CHECK( !Options_decodeOption< uint16_t >( "" ) );
+  BOOST_CHECK( !Options_decodeOption< uint16_t >( "abc" ) );
+  BOOST_CHECK( !Options_decodeOption< uint16_t >( "12a" ) );
+  BOOST_CHECK( !Options_decodeOption< uint16_t >( "-1" ) );
+  BOOST_CHECK( !Options_decodeOption< uint16_t >( "65536" ) );
+  BOOST_CHECK( Options_decodeOption< uint16_t >( "65535" ) == std::optional< uint16_t >{ 65535 } );
+  BOOST_CHECK( Options_decodeOption< uint16_t >( "0", 0, 100 ) == std::optional< uint16_t >{ 0 } );
+  BOOST_CHECK( !Options_decodeOption< uint16_t >( "0", 1, 100 ) );
+  BOOST_CHECK( !Options_decodeOption< uint64_t >( "99999999999999999999" ) );
 }
 
 //! TftpOptions_getOption tests
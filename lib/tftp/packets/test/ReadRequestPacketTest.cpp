@@ -123,6 +123,20 @@ BOOST_AUTO_TEST_CASE( constructor2 )
   BOOST_CHECK_THROW( ReadRequestPacket{ std::as_bytes( std::span{ rawReadPacketInv3 } ) }, InvalidPacketException );
 }
 
+//! Exception-free decoding Test
+BOOST_AUTO_TEST_CASE( decode )
+{
+  const auto rrq{ ReadRequestPacket::decode( std::as_bytes( std::span{ rawReadPacket2 } ) ) };
+  BOOST_REQUIRE( rrq );
+  BOOST_CHECK( rrq->filename() == "file" );
+  BOOST_CHECK( rrq->mode() == TransferMode::OCTET );
+  BOOST_CHECK( rrq->options().size() == 2 );
+
+  BOOST_CHECK( !ReadRequestPacket::decode( std::as_bytes( std::span{ rawReadPacketInv1 } ) ) );
+  BOOST_CHECK( !ReadRequestPacket::decode( std::as_bytes( std::span{ rawReadPacketInv2 } ) ) );
+  BOOST_CHECK( !ReadRequestPacket::decode( std::as_bytes( std::span{ rawReadPacketInv3 } ) ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Unit Tests of Class Tftp::Packets::ReadWriteRequestPacketView.
+ **/
+
+#include <boost/test/unit_test.hpp>
+
+#include <tftp/packets/ReadWriteRequestPacketView.hpp>
+#include <tftp/packets/ReadRequestPacket.hpp>
+
+#include <iterator>
+
+namespace Tftp::Packets {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( PacketsTest )
+BOOST_AUTO_TEST_SUITE( TftpReadWriteRequestPacketView )
+
+//! Raw Read Request Packet w.o. options
+static const uint8_t rawReadPacket1[]{
+  0x00, 0x01,
+  'f', 'i', 'l', 'e', 0x00,
+  'o', 'c', 't', 'e', 't', 0x00 };
+
+//! Raw Write Request Packet with options
+static const uint8_t rawWritePacket2[]{
+  0x00, 0x02,
+  'f', 'i', 'l', 'e', 0x00,
+  'N', 'e', 't', 'A', 's', 'c', 'i', 'i', 0x00,
+  'o', 'p', 't', '1', 0x00, 'v', 'a', 'l', '1', 0x00,
+  'o', 'p', 't', '2', 0x00, 0x00 };
+
+//! Raw Packet - Wrong Opcode
+static const uint8_t rawPacketInv1[]{
+  0x00, 0x03,
+  'f', 'i', 'l', 'e', 0x00,
+  'o', 'c', 't', 'e', 't', 0x00 };
+
+//! Raw Packet - Missing Mode
+static const uint8_t rawPacketInv2[]{
+  0x00, 0x01,
+  'f', 'i', 'l', 'e', 0x00 };
+
+//! Raw Packet - Missing Option Value
+static const uint8_t rawPacketInv3[]{
+  0x00, 0x01,
+  'f', 'i', 'l', 'e', 0x00,
+  'o', 'c', 't', 'e', 't', 0x00,
+  'o', 'p', 't', '1', 0x00, 'v', 'a', 'l', '1', 0x00,
+  'o', 'p', 't', '2', 0x00 };
+
+//! Raw Packet - Not 0-terminated
+static const uint8_t rawPacketInv4[]{
+  0x00, 0x01,
+  'f', 'i', 'l', 'e', 0x00,
+  'o', 'c', 't', 'e', 't' };
+
+//! Raw Packet - Header only
+static const uint8_t rawPacketInv5[]{ 0x00, 0x01 };
+
+//! Valid Packet Tests
+BOOST_AUTO_TEST_CASE( validPackets )
+{
+  const ReadWriteRequestPacketView view1{ std::as_bytes( std::span{ rawReadPacket1 } ) };
+  BOOST_REQUIRE( view1 );
+  BOOST_CHECK( view1.packetType() == PacketType::ReadRequest );
+  BOOST_CHECK( view1.filename() == "file" );
+  BOOST_CHECK( view1.rawMode() == "octet" );
+  BOOST_CHECK( view1.mode() == TransferMode::OCTET );
+  BOOST_CHECK( view1.options().empty() );
+  BOOST_CHECK( !view1.option( "opt1" ) );
+
+  const ReadWriteRequestPacketView view2{ std::as_bytes( std::span{ rawWritePacket2 } ) };
+  BOOST_REQUIRE( view2 );
+  BOOST_CHECK( view2.packetType() == PacketType::WriteRequest );
+  BOOST_CHECK( view2.filename() == "file" );
+  BOOST_CHECK( view2.mode() == TransferMode::NETASCII );
+  BOOST_CHECK( std::ranges::distance( view2.options() ) == 2 );
+  BOOST_CHECK( view2.option( "opt1" ) == std::optional< std::string_view >{ "val1" } );
+  BOOST_CHECK( view2.option( "opt2" ) == std::optional< std::string_view >{ "" } );
+  BOOST_CHECK( !view2.option( "opt3" ) );
+
+  const auto options{ view2.ownedOptions() };
+  BOOST_CHECK( options.size() == 2 );
+  BOOST_CHECK( options.at( "opt1" ) == "val1" );
+  BOOST_CHECK( options.at( "opt2" ).empty() );
+}
+
+//! Invalid Packet Tests
+BOOST_AUTO_TEST_CASE( invalidPackets )
+{
+  BOOST_CHECK( !ReadWriteRequestPacketView{ std::as_bytes( std::span{ rawPacketInv1 } ) } );
+  BOOST_CHECK( !ReadWriteRequestPacketView{ std::as_bytes( std::span{ rawPacketInv2 } ) } );
+  BOOST_CHECK( !ReadWriteRequestPacketView{ std::as_bytes( std::span{ rawPacketInv3 } ) } );
+  BOOST_CHECK( !ReadWriteRequestPacketView{ std::as_bytes( std::span{ rawPacketInv4 } ) } );
+  BOOST_CHECK( !ReadWriteRequestPacketView{ std::as_bytes( std::span{ rawPacketInv5 } ) } );
+  BOOST_CHECK( !ReadWriteRequestPacketView{ Helper::ConstRawDataSpan{} } );
+
+  const ReadWriteRequestPacketView view{ std::as_bytes( std::span{ rawPacketInv1 } ) };
+  BOOST_CHECK( view.packetType() == PacketType::Invalid );
+  BOOST_CHECK( view.filename().empty() );
+  BOOST_CHECK( view.options().empty() );
+}
+
+//! Compares the view with the decoding of ReadRequestPacket
+BOOST_AUTO_TEST_CASE( readRequestPacket )
+{
+  const ReadRequestPacket rrq{ "testfile.bin", TransferMode::OCTET, { { "blksize", "1024" }, { "tsize", "0" } } };
+  const auto raw{ static_cast< Helper::RawData >( rrq ) };
+
+  const ReadWriteRequestPacketView view{ raw };
+  BOOST_REQUIRE( view );
+  BOOST_CHECK( view.packetType() == rrq.packetType() );
+  BOOST_CHECK( view.filename() == rrq.filename() );
+  BOOST_CHECK( view.mode() == rrq.mode() );
+  BOOST_CHECK( view.ownedOptions() == rrq.options() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
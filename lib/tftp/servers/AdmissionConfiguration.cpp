@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::AdmissionConfiguration.
+ **/
+
+#include "AdmissionConfiguration.hpp"
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <boost/program_options/value_semantic.hpp>
+
+#include <format>
+#include <string_view>
+
+namespace Tftp::Servers {
+
+AdmissionConfiguration::AdmissionConfiguration( const boost::property_tree::ptree &properties )
+{
+  fromProperties( properties );
+}
+
+void AdmissionConfiguration::fromProperties( const boost::property_tree::ptree &properties )
+{
+  addressRate = properties.get_optional< double >( "address.rate" );
+  addressBurst = properties.get( "address.burst", DefaultAddressBurst );
+
+  subnetRate = properties.get_optional< double >( "subnet.rate" );
+  subnetBurst = properties.get( "subnet.burst", DefaultSubnetBurst );
+  subnetPrefixLengthV4 = properties.get( "subnet.prefix_length_v4", DefaultSubnetPrefixLengthV4 );
+  subnetPrefixLengthV6 = properties.get( "subnet.prefix_length_v6", DefaultSubnetPrefixLengthV6 );
+
+  globalRate = properties.get_optional< double >( "global.rate" );
+  globalBurst = properties.get( "global.burst", DefaultGlobalBurst );
+
+  maxSessions = properties.get_optional< std::size_t >( "max_sessions" );
+  rejectSilently = properties.get( "reject_silently", false );
+
+  validate();
+}
+
+void AdmissionConfiguration::validate() const
+{
+  const auto validateLimit{
+    []( const boost::optional< double > &rate, const uint32_t burst, const std::string_view name )
+    {
+      if ( rate && ( !( *rate > 0.0 ) || ( 0U == burst ) ) )
+      {
+        BOOST_THROW_EXCEPTION( TftpException{}
+          << Helper::AdditionalInfo{
+            std::format( "Invalid {} admission limit: rate and burst must be positive", name ) } );
+      }
+    } };
+
+  validateLimit( addressRate, addressBurst, "address" );
+  validateLimit( subnetRate, subnetBurst, "subnet" );
+  validateLimit( globalRate, globalBurst, "global" );
+}
+
+boost::property_tree::ptree AdmissionConfiguration::toProperties( const bool full ) const
+{
+  boost::property_tree::ptree properties{};
+
+  if ( full || addressRate )
+  {
+    properties.add( "address.rate", addressRate );
+  }
+
+  if ( full || ( DefaultAddressBurst != addressBurst ) )
+  {
+    properties.add( "address.burst", addressBurst );
+  }
+
+  if ( full || subnetRate )
+  {
+    properties.add( "subnet.rate", subnetRate );
+  }
+
+  if ( full || ( DefaultSubnetBurst != subnetBurst ) )
+  {
+    properties.add( "subnet.burst", subnetBurst );
+  }
+
+  if ( full || ( DefaultSubnetPrefixLengthV4 != subnetPrefixLengthV4 ) )
+  {
+    properties.add( "subnet.prefix_length_v4", subnetPrefixLengthV4 );
+  }
+
+  if ( full || ( DefaultSubnetPrefixLengthV6 != subnetPrefixLengthV6 ) )
+  {
+    properties.add( "subnet.prefix_length_v6", subnetPrefixLengthV6 );
+  }
+
+  if ( full || globalRate )
+  {
+    properties.add( "global.rate", globalRate );
+  }
+
+  if ( full || ( DefaultGlobalBurst != globalBurst ) )
+  {
+    properties.add( "global.burst", globalBurst );
+  }
+
+  if ( full || maxSessions )
+  {
+    properties.add( "max_sessions", maxSessions );
+  }
+
+  if ( full || rejectSilently )
+  {
+    properties.add( "reject_silently", rejectSilently );
+  }
+
+  return properties;
+}
+
+boost::program_options::options_description AdmissionConfiguration::options()
+{
+  boost::program_options::options_description options{ "TFTP Server Admission Control Options" };
+
+  options.add_options()
+  (
+    "admission-address-rate",
+    boost::program_options::value( &addressRate )->value_name( "requests/s" ),
+    "Limits the request rate per client address."
+  )
+  (
+    "admission-address-burst",
+    boost::program_options::value( &addressBurst )->default_value( addressBurst )->value_name( "requests" ),
+    "Burst size of the request rate limit per client address."
+  )
+  (
+    "admission-subnet-rate",
+    boost::program_options::value( &subnetRate )->value_name( "requests/s" ),
+    "Limits the request rate per client subnet."
+  )
+  (
+    "admission-subnet-burst",
+    boost::program_options::value( &subnetBurst )->default_value( subnetBurst )->value_name( "requests" ),
+    "Burst size of the request rate limit per client subnet."
+  )
+  (
+    "admission-subnet-prefix-v4",
+    boost::program_options::value( &subnetPrefixLengthV4 )
+      ->default_value( subnetPrefixLengthV4 )
+      ->value_name( "length" ),
+    "Prefix length of IPv4 client subnets."
+  )
+  (
+    "admission-subnet-prefix-v6",
+    boost::program_options::value( &subnetPrefixLengthV6 )
+      ->default_value( subnetPrefixLengthV6 )
+      ->value_name( "length" ),
+    "Prefix length of IPv6 client subnets."
+  )
+  (
+    "admission-global-rate",
+    boost::program_options::value( &globalRate )->value_name( "requests/s" ),
+    "Limits the overall request rate."
+  )
+  (
+    "admission-global-burst",
+    boost::program_options::value( &globalBurst )->default_value( globalBurst )->value_name( "requests" ),
+    "Burst size of the overall request rate limit."
+  )
+  (
+    "max-sessions",
+    boost::program_options::value( &maxSessions )->value_name( "sessions" ),
+    "Limits the number of concurrently active transfers."
+  )
+  (
+    "admission-drop",
+    boost::program_options::value( &rejectSilently )
+      ->implicit_value( true, "true" )
+      ->value_name( "true|false" ),
+    "Drops rejected requests silently instead of responding with an error packet."
+  );
+
+  return options;
+}
+
+}
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::AdmissionConfiguration.
+ **/
+
+#ifndef TFTP_SERVERS_ADMISSIONCONFIGURATION_HPP
+#define TFTP_SERVERS_ADMISSIONCONFIGURATION_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <boost/optional.hpp>
+
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <boost/program_options/options_description.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server Admission Control Configuration.
+ *
+ * Admission control is applied to received read and write requests, before the request handler is called and
+ * therefore before any operation is created.
+ *
+ * Request rates are limited by token buckets:
+ * - per client IP address,
+ * - per client subnet, and
+ * - globally for all clients.
+ * Each bucket is refilled with the configured rate (requests per second) up to the configured burst size.
+ * A limit, which rate is not set, is disabled.
+ *
+ * Additionally, the number of concurrently active server operations can be limited.
+ *
+ * Rejected requests are responded with an error packet, or silently dropped, when @ref rejectSilently is set.
+ *
+ * @sa Server::admissionConfiguration()
+ **/
+class TFTP_EXPORT AdmissionConfiguration
+{
+  public:
+    //! Default Burst Size per Client Address
+    static constexpr uint32_t DefaultAddressBurst{ 10U };
+    //! Default Burst Size per Client Subnet
+    static constexpr uint32_t DefaultSubnetBurst{ 50U };
+    //! Default Global Burst Size
+    static constexpr uint32_t DefaultGlobalBurst{ 200U };
+    //! Default IPv4 Subnet Prefix Length
+    static constexpr unsigned int DefaultSubnetPrefixLengthV4{ 24U };
+    //! Default IPv6 Subnet Prefix Length
+    static constexpr unsigned int DefaultSubnetPrefixLengthV6{ 64U };
+
+    /**
+     * @brief Initialises the Configuration with Default Values.
+     *
+     * By default, no admission control is performed.
+     **/
+    AdmissionConfiguration() noexcept = default;
+
+    /**
+     * @brief Loads the Configuration via a Property Tree.
+     *
+     * @param[in] properties
+     *   Stored Admission Configuration.
+     **/
+    explicit AdmissionConfiguration( const boost::property_tree::ptree &properties );
+
+    /**
+     * @brief Load Configuration from given Property Tree.
+     *
+     * @param[in] properties
+     *   Configuration as Property Tree
+     *
+     * @throw TftpException
+     *   When the configuration is invalid.
+     **/
+    void fromProperties( const boost::property_tree::ptree &properties );
+
+    /**
+     * @brief Checks the Configuration Values.
+     *
+     * @throw TftpException
+     *   When a configured rate is not positive or its burst size is zero - such a limit would reject every request.
+     **/
+    void validate() const;
+
+    /**
+     * @brief Converts the configuration values to a Property Tree.
+     *
+     * @param[in] full
+     *   If set to true, all options are added to the property tree, even if defaulted.
+     *
+     * @return Configuration represented as Property Tree.
+     **/
+    [[nodiscard]] boost::property_tree::ptree toProperties( bool full = false ) const;
+
+    /**
+     * @brief Returns an option description, which can be used to parse a command line.
+     *
+     * @return Admission Configuration Options
+     **/
+    [[nodiscard]] boost::program_options::options_description options();
+
+    //! Request Rate per Client Address (requests per second)
+    boost::optional< double > addressRate;
+    //! Burst Size per Client Address
+    uint32_t addressBurst{ DefaultAddressBurst };
+
+    //! Request Rate per Client Subnet (requests per second)
+    boost::optional< double > subnetRate;
+    //! Burst Size per Client Subnet
+    uint32_t subnetBurst{ DefaultSubnetBurst };
+    //! Prefix Length of IPv4 Client Subnets
+    unsigned int subnetPrefixLengthV4{ DefaultSubnetPrefixLengthV4 };
+    //! Prefix Length of IPv6 Client Subnets
+    unsigned int subnetPrefixLengthV6{ DefaultSubnetPrefixLengthV6 };
+
+    //! Global Request Rate (requests per second)
+    boost::optional< double > globalRate;
+    //! Global Burst Size
+    uint32_t globalBurst{ DefaultGlobalBurst };
+
+    //! Maximum Number of concurrently active Operations
+    boost::optional< std::size_t > maxSessions;
+
+    //! If set, rejected requests are dropped without sending an error packet
+    bool rejectSilently{ false };
+};
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::AdmissionStatistic.
+ **/
+
+#include "AdmissionStatistic.hpp"
+
+#include <format>
+#include <ostream>
+
+namespace Tftp::Servers {
+
+std::size_t AdmissionStatistic::rejected() const noexcept
+{
+  return rejectedAddressRate + rejectedSubnetRate + rejectedGlobalRate + rejectedSessions;
+}
+
+std::string AdmissionStatistic::toString() const
+{
+  return std::format(
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n",
+    "Accepted", accepted,
+    "Rejected Address Rate", rejectedAddressRate,
+    "Rejected Subnet Rate", rejectedSubnetRate,
+    "Rejected Global Rate", rejectedGlobalRate,
+    "Rejected Sessions", rejectedSessions,
+    "Active Sessions", activeSessions );
+}
+
+std::ostream& operator<<( std::ostream &stream, const AdmissionStatistic &statistic )
+{
+  return ( stream << statistic.toString() );
+}
+
+}
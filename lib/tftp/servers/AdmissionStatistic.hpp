@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::AdmissionStatistic.
+ **/
+
+#ifndef TFTP_SERVERS_ADMISSIONSTATISTIC_HPP
+#define TFTP_SERVERS_ADMISSIONSTATISTIC_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server Admission Control Statistic.
+ *
+ * Counts accepted and rejected read and write requests and holds the number of currently active operations.
+ *
+ * @sa Server::admissionStatistic()
+ **/
+struct TFTP_EXPORT AdmissionStatistic
+{
+  //! Accepted Requests
+  std::size_t accepted{ 0U };
+  //! Requests rejected by the Client Address Rate Limit
+  std::size_t rejectedAddressRate{ 0U };
+  //! Requests rejected by the Client Subnet Rate Limit
+  std::size_t rejectedSubnetRate{ 0U };
+  //! Requests rejected by the Global Rate Limit
+  std::size_t rejectedGlobalRate{ 0U };
+  //! Requests rejected by the Maximum Sessions Limit
+  std::size_t rejectedSessions{ 0U };
+  //! Currently active Operations
+  std::size_t activeSessions{ 0U };
+
+  /**
+   * @brief Returns the total number of rejected requests.
+   *
+   * @return Total number of rejected requests.
+   **/
+  [[nodiscard]] std::size_t rejected() const noexcept;
+
+  /**
+   * @brief Gives the statistic as printable string.
+   *
+   * @return Statistic as string representation
+   **/
+  [[nodiscard]] std::string toString() const;
+};
+
+/**
+ * @brief Stream output operator of @p AdmissionStatistic.
+ *
+ * @param[in,out] stream
+ *   Output Stream
+ * @param[in] statistic
+ *   Admission Statistic
+ *
+ * @return @p stream for chaining.
+ **/
+TFTP_EXPORT std::ostream& operator<<( std::ostream &stream, const AdmissionStatistic &statistic );
+
+}
+
+#endif
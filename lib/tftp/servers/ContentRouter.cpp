@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::ContentRouter.
+ **/
+
+#include "ContentRouter.hpp"
+
+#include <tftp/files/MemoryFile.hpp>
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/exception/all.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <format>
+#include <utility>
+
+namespace Tftp::Servers {
+
+ContentRouter& ContentRouter::route(
+  std::regex pattern,
+  ContentGenerator generator,
+  CacheKeyGenerator cacheKey )
+{
+  if ( !generator )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{} << Helper::AdditionalInfo{ "Content generator not provided" } );
+  }
+
+  routesV.emplace_back( std::move( pattern ), std::move( generator ), std::move( cacheKey ) );
+  return *this;
+}
+
+ContentRouter& ContentRouter::cache( const std::chrono::milliseconds timeToLive, const std::size_t capacity )
+{
+  const std::scoped_lock lock{ mutexV };
+  timeToLiveV = timeToLive;
+  capacityV = capacity;
+  cacheV.clear();
+  return *this;
+}
+
+void ContentRouter::clearCache()
+{
+  const std::scoped_lock lock{ mutexV };
+  cacheV.clear();
+}
+
+std::optional< ContentRouter::Result > ContentRouter::resolve(
+  const boost::asio::ip::udp::endpoint &remote,
+  const RequestType requestType,
+  const std::string_view filename ) const
+{
+  if ( routesV.empty() )
+  {
+    return {};
+  }
+
+  const std::string name{ filename };
+  std::smatch match;
+
+  const auto route{ std::ranges::find_if(
+    routesV,
+    [ &name, &match ]( const Route &route ){ return std::regex_match( name, match, route.pattern ); } ) };
+
+  if ( route == routesV.end() )
+  {
+    return {};
+  }
+
+  if ( RequestType::Read != requestType )
+  {
+    SPDLOG_ERROR( "Write request to generated file '{}'", filename );
+    return std::unexpected( Packets::ErrorCode::AccessViolation );
+  }
+
+  // keys of different routes must not collide
+  const auto key{ std::format(
+    "{}:{}",
+    std::ranges::distance( routesV.begin(), route ),
+    route->cacheKey ? route->cacheKey( remote, match ) : name ) };
+
+  // serve from cache
+  {
+    const std::scoped_lock lock{ mutexV };
+
+    if ( const auto entry{ cacheV.find( key ) }; entry != cacheV.end() )
+    {
+      if ( Clock::now() < entry->second.expiry )
+      {
+        return std::make_shared< Files::MemoryFile >( entry->second.content );
+      }
+
+      cacheV.erase( entry );
+    }
+  }
+
+  // render outside the lock
+  Content content;
+
+  try
+  {
+    content = route->generator( remote, match );
+  }
+  catch ( const std::exception &e )
+  {
+    SPDLOG_ERROR( "Error generating '{}': {}", filename, e.what() );
+    return std::unexpected( Packets::ErrorCode::NotDefined );
+  }
+
+  if ( !content )
+  {
+    return std::unexpected( content.error() );
+  }
+
+  auto data{ std::make_shared< const Helper::RawData >( std::move( *content ) ) };
+
+  {
+    const std::scoped_lock lock{ mutexV };
+
+    if ( 0U != capacityV )
+    {
+      const auto now{ Clock::now() };
+
+      // make room by removing expired entries
+      if ( cacheV.size() >= capacityV )
+      {
+        std::erase_if( cacheV, [ now ]( const auto &entry ){ return entry.second.expiry <= now; } );
+      }
+
+      if ( cacheV.size() < capacityV )
+      {
+        cacheV.insert_or_assign( key, CachedContent{ data, now + timeToLiveV } );
+      }
+    }
+  }
+
+  return std::make_shared< Files::MemoryFile >( std::move( data ) );
+}
+
+}
@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::ContentRouter.
+ **/
+
+#ifndef TFTP_SERVERS_CONTENTROUTER_HPP
+#define TFTP_SERVERS_CONTENTROUTER_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <tftp/files/Files.hpp>
+
+#include <tftp/packets/Packets.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/asio/ip/udp.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief Routes Read Requests to Content Generators.
+ *
+ * Used within the ReceivedTftpRequestHandler in front of the static file handling (e.g. FileResolver) to serve
+ * generated content, like per-device boot configurations, which are selected by the MAC or IP address within the
+ * filename.
+ *
+ * Routes are registered by route() with a filename pattern and a generator.
+ * The first route, whose pattern matches the whole filename, is used.
+ * The rendered content is cached by a key, which defaults to the filename.
+ * A custom key function can be provided to share the content between several devices (e.g. a device class).
+ * Keys are scoped to their route, so routes with the same keys do not share content.
+ * Following requests with the same key are served from memory until the entry expires.
+ *
+ * The content is provided as Files::MemoryFile.
+ * Therefore, the transfer size (`tsize` option) is the size of the rendered content.
+ *
+ * @code
+ * router.route(
+ *   std::regex{ R"(pxelinux\.cfg/01-([0-9a-f-]{17}))" },
+ *   []( const auto &remote, const std::smatch &match ) -> ContentRouter::Content
+ *   {
+ *     return renderConfiguration( match[ 1 ].str() );
+ *   } );
+ *
+ * if ( auto file{ router.resolve( remote, requestType, filename ) }; file )
+ * {
+ *   // *file is the content or the error code to respond
+ * }
+ * @endcode
+ *
+ * The router may be used from different threads.
+ * Generators are called without holding internal locks.
+ **/
+class TFTP_EXPORT ContentRouter final
+{
+  public:
+    //! Generated Content or TFTP Error Code to respond.
+    using Content = std::expected< Helper::RawData, Packets::ErrorCode >;
+
+    //! Opened %File or TFTP Error Code to respond.
+    using Result = std::expected< Files::FilePtr, Packets::ErrorCode >;
+
+    /**
+     * @brief Content Generator.
+     *
+     * @param[in] remote
+     *   Remote Endpoint of the request.
+     * @param[in] match
+     *   Match of the route pattern against the filename (index `0` is the whole filename).
+     *
+     * @return Rendered content or error code to respond.
+     **/
+    using ContentGenerator =
+      std::function< Content( const boost::asio::ip::udp::endpoint &remote, const std::smatch &match ) >;
+
+    /**
+     * @brief Cache Key Generator.
+     *
+     * Requests of the same route with the same key share the rendered content.
+     *
+     * @param[in] remote
+     *   Remote Endpoint of the request.
+     * @param[in] match
+     *   Match of the route pattern against the filename.
+     *
+     * @return Cache key.
+     **/
+    using CacheKeyGenerator =
+      std::function< std::string( const boost::asio::ip::udp::endpoint &remote, const std::smatch &match ) >;
+
+    /**
+     * @brief Registers a Route.
+     *
+     * @param[in] pattern
+     *   Filename pattern (must match the whole filename).
+     * @param[in] generator
+     *   Content generator.
+     * @param[in] cacheKey
+     *   Cache key generator.
+     *   If not provided, the filename is used.
+     *
+     * @return @p *this for chaining.
+     *
+     * @throw TftpException
+     *   When no generator is provided.
+     **/
+    ContentRouter& route( std::regex pattern, ContentGenerator generator, CacheKeyGenerator cacheKey = {} );
+
+    /**
+     * @brief Configures the Content Cache.
+     *
+     * By default, rendered content is not cached.
+     *
+     * @param[in] timeToLive
+     *   Time, how long rendered content is served from memory.
+     * @param[in] capacity
+     *   Maximum number of cached contents.
+     *   When the cache is full, further content is not cached until entries expire.
+     *   `0` disables the cache.
+     *
+     * @return @p *this for chaining.
+     **/
+    ContentRouter& cache( std::chrono::milliseconds timeToLive, std::size_t capacity );
+
+    /**
+     * @brief Clears the Content Cache.
+     *
+     * Must be called, when the data used by the generators has been changed.
+     **/
+    void clearCache();
+
+    /**
+     * @brief Resolves the Request against the registered Routes.
+     *
+     * Write requests to routed filenames are rejected with Packets::ErrorCode::AccessViolation.
+     * Exceptions thrown by a generator are logged and reported as Packets::ErrorCode::NotDefined.
+     *
+     * @param[in] remote
+     *   Remote Endpoint of the request.
+     * @param[in] requestType
+     *   Read or Write request.
+     * @param[in] filename
+     *   Requested filename.
+     *
+     * @return Generated content as file or error code to respond.
+     * @retval std::nullopt
+     *   When no route matches - the request shall be handled otherwise.
+     **/
+    [[nodiscard]] std::optional< Result > resolve(
+      const boost::asio::ip::udp::endpoint &remote,
+      RequestType requestType,
+      std::string_view filename ) const;
+
+  private:
+    //! Clock of the Cache
+    using Clock = std::chrono::steady_clock;
+
+    //! Route
+    struct Route
+    {
+      //! Filename Pattern
+      std::regex pattern;
+      //! Content Generator
+      ContentGenerator generator;
+      //! Cache Key Generator
+      CacheKeyGenerator cacheKey;
+    };
+
+    //! Cached Content
+    struct CachedContent
+    {
+      //! Rendered Content
+      std::shared_ptr< const Helper::RawData > content;
+      //! Expiry of the Entry
+      Clock::time_point expiry;
+    };
+
+    //! Registered Routes
+    std::vector< Route > routesV;
+
+    //! Mutex protecting the cache
+    mutable std::mutex mutexV;
+    //! Cache Time to Live
+    std::chrono::milliseconds timeToLiveV{};
+    //! Cache Capacity
+    std::size_t capacityV{ 0U };
+    //! Content Cache (Key to Content)
+    mutable std::map< std::string, CachedContent, std::less<> > cacheV;
+};
+
+}
+
+#endif
@@ -0,0 +1,869 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::FileResolver.
+ **/
+
+#include "FileResolver.hpp"
+
+#include <tftp/files/MemoryFile.hpp>
+#include <tftp/files/NetasciiFile.hpp>
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/exception/all.hpp>
+
+#if defined( _WIN32 )
+#include <tftp/files/StreamFile.hpp>
+#else
+#include <tftp/servers/implementation/OpenBeneath.hpp>
+
+#include <tftp/files/DescriptorFile.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined( __linux__ )
+#include <sys/inotify.h>
+#endif
+#endif
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <utility>
+
+namespace Tftp::Servers {
+
+#if !defined( _WIN32 )
+namespace {
+
+/**
+ * @brief Maps the errno of a failed open to the TFTP Error Code.
+ *
+ * @param[in] error
+ *   errno value.
+ *
+ * @return TFTP Error Code.
+ **/
+Packets::ErrorCode errorCode( const int error ) noexcept
+{
+  switch ( error )
+  {
+    case ENOENT:
+    case ENOTDIR:
+      return Packets::ErrorCode::FileNotFound;
+
+    case ENOSPC:
+    case EDQUOT:
+      return Packets::ErrorCode::DiskFullOrAllocationExceeds;
+
+    default:
+      // EACCES, EPERM, EXDEV (beneath violation), ELOOP (symbolic link), EISDIR, ...
+      return Packets::ErrorCode::AccessViolation;
+  }
+}
+
+/**
+ * @brief Creates or truncates the File @p name within @p directory for writing.
+ *
+ * @param[in] directory
+ *   Directory descriptor.
+ * @param[in] name
+ *   Filename (without directory components).
+ *
+ * @return Opened file descriptor.
+ * @retval -1
+ *   On error - errno is set.
+ **/
+int createFile( const int directory, const std::string &name )
+{
+  // O_NONBLOCK prevents blocking on FIFOs, which are rejected below
+  const auto fileDescriptor{ ::openat(
+    directory,
+    name.c_str(),
+    O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_NONBLOCK | O_NOCTTY | O_CLOEXEC,
+    CreateMode ) };
+
+  if ( fileDescriptor < 0 )
+  {
+    return -1;
+  }
+
+  // the file may have been replaced since the request
+  if ( struct stat status{}; ( ::fstat( fileDescriptor, &status ) < 0 ) || !S_ISREG( status.st_mode ) )
+  {
+    ::close( fileDescriptor );
+    errno = EINVAL;
+    return -1;
+  }
+
+  ::fcntl( fileDescriptor, F_SETFL, ::fcntl( fileDescriptor, F_GETFL ) & ~O_NONBLOCK );
+
+  return fileDescriptor;
+}
+
+}
+#endif
+
+FileResolver::FileResolver( const std::filesystem::path &baseDir )
+{
+  std::error_code errorCode;
+  baseDirV = std::filesystem::canonical( baseDir, errorCode );
+
+  if ( errorCode )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ "Could not make base directory canonical or does not exist" }
+      << boost::errinfo_file_name{ baseDir.string() } );
+  }
+
+#if !defined( _WIN32 )
+  directoryV = ::open( baseDirV.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+
+  if ( directoryV < 0 )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ "Could not open base directory" }
+      << boost::errinfo_file_name{ baseDirV.string() }
+      << boost::errinfo_errno{ errno } );
+  }
+#endif
+}
+
+FileResolver::~FileResolver() noexcept
+{
+  // release cached descriptors before the directory
+  metadataCacheV.clear();
+
+#if defined( __linux__ )
+  if ( notifyV >= 0 )
+  {
+    ::close( notifyV );
+  }
+#endif
+
+#if !defined( _WIN32 )
+  ::close( directoryV );
+#endif
+}
+
+const std::filesystem::path& FileResolver::baseDir() const noexcept
+{
+  return baseDirV;
+}
+
+void FileResolver::negativeCache( const std::chrono::milliseconds timeToLive, const std::size_t capacity )
+{
+  const std::scoped_lock lock{ mutexV };
+  negativeTimeToLiveV = timeToLive;
+  negativeCapacityV = capacity;
+  negativeCacheV.clear();
+}
+
+void FileResolver::metadataCache( const std::chrono::milliseconds timeToLive, const std::size_t capacity )
+{
+  const std::scoped_lock lock{ mutexV };
+
+  while ( !metadataCacheV.empty() )
+  {
+    eraseMetadata( metadataCacheV.begin() );
+  }
+
+#if defined( _WIN32 )
+  if ( 0U != capacity )
+  {
+    SPDLOG_WARN( "Metadata cache is not supported on this platform" );
+  }
+#else
+  metadataTimeToLiveV = timeToLive;
+  metadataCapacityV = capacity;
+
+#if defined( __linux__ )
+  if ( ( 0U != capacity ) && ( notifyV < 0 ) )
+  {
+    notifyV = ::inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+
+    if ( notifyV < 0 )
+    {
+      SPDLOG_WARN(
+        "inotify not available - cached files are reused until expiry: {}",
+        std::generic_category().message( errno ) );
+    }
+  }
+#endif
+#endif
+}
+
+void FileResolver::precompressed( const bool enabled, const uint64_t memoizeLimit )
+{
+  const std::scoped_lock lock{ mutexV };
+  precompressedV = enabled;
+  memoizeLimitV = memoizeLimit;
+
+  while ( !metadataCacheV.empty() )
+  {
+    eraseMetadata( metadataCacheV.begin() );
+  }
+}
+
+FileResolverStatistic FileResolver::statistic() const
+{
+  const std::scoped_lock lock{ mutexV };
+  handleNotifications();
+  auto statistic{ statisticV };
+  statistic.negativeCacheEntries = negativeCacheV.size();
+  statistic.metadataCacheEntries = metadataCacheV.size();
+  return statistic;
+}
+
+FileResolver::Result FileResolver::open(
+  const std::string_view filename,
+  const RequestType requestType,
+  const Packets::TransferMode mode ) const
+{
+  auto result{ openCached( filename, requestType ) };
+
+  if ( !result )
+  {
+    return std::unexpected( result.error() );
+  }
+
+  if ( Packets::TransferMode::NETASCII != mode )
+  {
+    return std::move( result->file );
+  }
+
+  if ( RequestType::Read == requestType )
+  {
+    // the file is read only, when the transfer size is negotiated
+    return std::make_shared< Files::NetasciiFile >(
+      std::move( result->file ),
+      [ descriptor = std::move( result->descriptor ), sizes = netasciiSizesV ]( Files::File &file )
+      {
+        return netasciiSize( file, descriptor, *sizes );
+      } );
+  }
+
+  return std::make_shared< Files::NetasciiFile >( Files::File::Operation::Receive, std::move( result->file ) );
+}
+
+std::expected< FileResolver::OpenedFile, Packets::ErrorCode > FileResolver::openCached(
+  const std::string_view filename,
+  const RequestType requestType ) const
+{
+  const bool read{ RequestType::Read == requestType };
+
+  if ( read )
+  {
+    const std::scoped_lock lock{ mutexV };
+    const auto now{ Clock::now() };
+
+#if !defined( _WIN32 )
+    // serve already opened files from the metadata cache
+    if ( !metadataCacheV.empty() )
+    {
+      handleNotifications();
+
+      if ( const auto entry{ metadataCacheV.find( filename ) }; entry != metadataCacheV.end() )
+      {
+        if ( now < entry->second.expiry )
+        {
+          ++statisticV.metadataCacheHits;
+          ++statisticV.opened;
+          return OpenedFile{
+            cachedFile( entry->second ),
+            entry->second.descriptor,
+            entry->second.size,
+            entry->second.compression,
+            entry->second.content };
+        }
+
+        eraseMetadata( entry );
+      }
+    }
+#endif
+
+    // answer probes for not existing files from the negative cache
+    if ( const auto entry{ negativeCacheV.find( filename ) }; entry != negativeCacheV.end() )
+    {
+      if ( now < entry->second )
+      {
+        ++statisticV.negativeCacheHits;
+        ++statisticV.notFound;
+        return std::unexpected( Packets::ErrorCode::FileNotFound );
+      }
+
+      negativeCacheV.erase( entry );
+    }
+  }
+
+  auto result{ openFile( filename, requestType ) };
+
+  if ( read && !result && ( Packets::ErrorCode::FileNotFound == result.error() ) )
+  {
+    bool precompressed{};
+    {
+      const std::scoped_lock lock{ mutexV };
+      precompressed = precompressedV;
+    }
+
+    if ( precompressed )
+    {
+      result = openPrecompressed( filename );
+    }
+  }
+
+  const std::scoped_lock lock{ mutexV };
+
+  if ( result )
+  {
+    ++statisticV.opened;
+
+    if ( read )
+    {
+      cacheMetadata( filename, *result );
+    }
+    else
+    {
+      // the file will be created or changed
+      if ( const auto entry{ negativeCacheV.find( filename ) }; entry != negativeCacheV.end() )
+      {
+        negativeCacheV.erase( entry );
+      }
+
+      if ( const auto entry{ metadataCacheV.find( filename ) }; entry != metadataCacheV.end() )
+      {
+        eraseMetadata( entry );
+      }
+    }
+
+    return result;
+  }
+
+  if ( Packets::ErrorCode::FileNotFound != result.error() )
+  {
+    ++statisticV.rejected;
+    return std::unexpected( result.error() );
+  }
+
+  ++statisticV.notFound;
+
+  if ( read && ( 0U != negativeCapacityV ) )
+  {
+    const auto now{ Clock::now() };
+
+    // make room by removing expired entries
+    if ( negativeCacheV.size() >= negativeCapacityV )
+    {
+      std::erase_if( negativeCacheV, [ now ]( const auto &entry ){ return entry.second <= now; } );
+    }
+
+    if ( negativeCacheV.size() < negativeCapacityV )
+    {
+      negativeCacheV.insert_or_assign( std::string{ filename }, now + negativeTimeToLiveV );
+    }
+  }
+
+  return std::unexpected( result.error() );
+}
+
+std::expected< FileResolver::OpenedFile, Packets::ErrorCode > FileResolver::openPrecompressed(
+  const std::string_view filename ) const
+{
+  constexpr std::array< std::string_view, 2U > Extensions{ ".zst", ".gz" };
+
+  for ( const auto extension : Extensions )
+  {
+    const auto compressedFilename{ std::format( "{}{}", filename, extension ) };
+    auto compressed{ openFile( compressedFilename, RequestType::Read ) };
+
+    if ( !compressed )
+    {
+      if ( Packets::ErrorCode::FileNotFound == compressed.error() )
+      {
+        continue;
+      }
+
+      return compressed;
+    }
+
+    const auto compression{ *Files::DecompressingFile::compression( extension ) };
+    const auto size{ uncompressedSize( compressedFilename, *compressed, compression ) };
+
+    OpenedFile opened{
+      std::make_shared< Files::DecompressingFile >( std::move( compressed->file ), compression, size ),
+      std::move( compressed->descriptor ),
+      size,
+      compression,
+      {} };
+
+    uint64_t memoizeLimit{};
+    bool metadataCache{};
+    {
+      const std::scoped_lock lock{ mutexV };
+      memoizeLimit = memoizeLimitV;
+      metadataCache = 0U != metadataCapacityV;
+    }
+
+    if ( !metadataCache || !size || ( *size > memoizeLimit ) )
+    {
+      return opened;
+    }
+
+    // decompress once for the metadata cache
+    auto content{ std::make_shared< Helper::RawData >() };
+    content->reserve( static_cast< size_t >( *size ) );
+
+    try
+    {
+      constexpr std::size_t ChunkSize{ 65536U };
+      opened.file->start();
+
+      for ( ;; )
+      {
+        const auto data{ opened.file->sendData( ChunkSize ) };
+        content->insert( content->end(), data.begin(), data.end() );
+
+        if ( data.size() < ChunkSize )
+        {
+          break;
+        }
+      }
+
+      opened.file->finished();
+    }
+    catch ( const TftpException &e )
+    {
+      SPDLOG_ERROR( "Could not decompress file '{}': {}", compressedFilename, boost::diagnostic_information( e ) );
+      return std::unexpected( Packets::ErrorCode::NotDefined );
+    }
+
+    // a wrong size would break the tsize option
+    if ( content->size() != *size )
+    {
+      SPDLOG_WARN( "Uncompressed size of '{}' does not match - not memoized", compressedFilename );
+      return opened;
+    }
+
+    opened.file = std::make_shared< Files::MemoryFile >( content );
+    opened.content = std::move( content );
+    return opened;
+  }
+
+  return std::unexpected( Packets::ErrorCode::FileNotFound );
+}
+
+std::optional< uint64_t > FileResolver::uncompressedSize(
+  const std::string_view filename,
+  [[maybe_unused]] const OpenedFile &file,
+  [[maybe_unused]] const Compression compression ) const
+{
+  // sidecar file with decimal size
+  if ( auto sidecar{ openFile( std::format( "{}.size", filename ), RequestType::Read ) }; sidecar )
+  {
+    sidecar->file->start();
+    const auto data{ sidecar->file->sendData( 32U ) };
+    sidecar->file->finished();
+
+    // NOLINTNEXTLINE( cppcoreguidelines-pro-type-reinterpret-cast ): std::byte to char view
+    const std::string_view text{ reinterpret_cast< const char * >( data.data() ), data.size() };
+    const auto begin{ text.find_first_not_of( " \t\r\n" ) };
+
+    if ( uint64_t size{}; begin != std::string_view::npos )
+    {
+      if ( const auto [ end, error ]{ std::from_chars( text.data() + begin, text.data() + text.size(), size ) };
+        std::errc{} == error )
+      {
+        return size;
+      }
+    }
+
+    SPDLOG_WARN( "Invalid size sidecar file for '{}'", filename );
+  }
+
+#if defined( _WIN32 )
+  return {};
+#else
+  // frame header
+  if ( !file.descriptor || !file.size )
+  {
+    return {};
+  }
+
+  return Files::DecompressingFile::uncompressedSize(
+    compression,
+    *file.size,
+    [ descriptor = *file.descriptor ]( const uint64_t offset, const std::size_t size )
+    {
+      Helper::RawData data( size );
+      const auto read{ ::pread( descriptor, data.data(), data.size(), static_cast< off_t >( offset ) ) };
+      data.resize( ( read < 0 ) ? 0U : static_cast< std::size_t >( read ) );
+      return data;
+    } );
+#endif
+}
+
+Files::FilePtr FileResolver::cachedFile( const Metadata &metadata )
+{
+  if ( metadata.content )
+  {
+    return std::make_shared< Files::MemoryFile >( metadata.content );
+  }
+
+#if defined( _WIN32 )
+  return {};
+#else
+  if ( metadata.compression )
+  {
+    return std::make_shared< Files::DecompressingFile >(
+      std::make_shared< Files::DescriptorFile >( Files::File::Operation::Transmit, metadata.descriptor ),
+      *metadata.compression,
+      metadata.size );
+  }
+
+  return std::make_shared< Files::DescriptorFile >(
+    Files::File::Operation::Transmit,
+    metadata.descriptor,
+    metadata.size );
+#endif
+}
+
+std::optional< uint64_t > FileResolver::netasciiSize(
+  [[maybe_unused]] Files::File &file,
+  [[maybe_unused]] const std::shared_ptr< const int > &descriptor,
+  [[maybe_unused]] NetasciiSizes &sizes )
+{
+#if defined( _WIN32 )
+  // Files::StreamFile cannot be started twice
+  return {};
+#else
+  // a changed file gets a new key
+  std::optional< NetasciiSizes::Key > key;
+
+  if ( struct stat status{}; descriptor && ( ::fstat( *descriptor, &status ) == 0 ) )
+  {
+    key = NetasciiSizes::Key{
+      static_cast< uint64_t >( status.st_dev ),
+      static_cast< uint64_t >( status.st_ino ),
+      static_cast< int64_t >( status.st_mtim.tv_sec ),
+      static_cast< int64_t >( status.st_mtim.tv_nsec ),
+      static_cast< int64_t >( status.st_size ) };
+
+    const std::scoped_lock lock{ sizes.mutex };
+
+    if ( const auto entry{ sizes.sizes.find( *key ) }; entry != sizes.sizes.end() )
+    {
+      return entry->second;
+    }
+  }
+
+  // read the whole file - the NETASCII file starts it again
+  constexpr std::size_t ChunkSize{ 65536U };
+  uint64_t size{ 0U };
+
+  file.start();
+
+  for ( ;; )
+  {
+    const auto data{ file.sendData( ChunkSize ) };
+    size += Files::NetasciiFile::encodedSize( data );
+
+    if ( data.size() < ChunkSize )
+    {
+      break;
+    }
+  }
+
+  if ( key )
+  {
+    const std::scoped_lock lock{ sizes.mutex };
+
+    // entries of changed files are never hit again - bound the cache
+    if ( sizes.sizes.size() >= NetasciiSizes::Capacity )
+    {
+      sizes.sizes.clear();
+    }
+
+    sizes.sizes.insert_or_assign( *key, size );
+  }
+
+  return size;
+#endif
+}
+
+std::expected< FileResolver::OpenedFile, Packets::ErrorCode > FileResolver::openFile(
+  const std::string_view filename,
+  const RequestType requestType ) const
+{
+  if ( filename.empty() || ( filename.find( '\0' ) != std::string_view::npos ) )
+  {
+    return std::unexpected( Packets::ErrorCode::AccessViolation );
+  }
+
+  const bool read{ RequestType::Read == requestType };
+
+#if defined( _WIN32 )
+  // lexical check - the base directory is already canonical
+  const auto filePath{ ( baseDirV / std::filesystem::path{ filename } ).lexically_normal() };
+
+  if ( !std::equal( baseDirV.begin(), baseDirV.end(), filePath.begin(), filePath.end() ) )
+  {
+    SPDLOG_ERROR( "File path is not within the base directory." );
+    return std::unexpected( Packets::ErrorCode::AccessViolation );
+  }
+
+  if ( !read )
+  {
+    return OpenedFile{ std::make_shared< Files::StreamFile >( Files::File::Operation::Receive, filePath ) };
+  }
+
+  std::error_code errorCode;
+  const auto size{ std::filesystem::file_size( filePath, errorCode ) };
+
+  if ( errorCode || !std::filesystem::is_regular_file( filePath, errorCode ) )
+  {
+    return std::unexpected( Packets::ErrorCode::FileNotFound );
+  }
+
+  return OpenedFile{
+    std::make_shared< Files::StreamFile >( Files::File::Operation::Transmit, filePath, size ),
+    {},
+    size };
+#else
+  if ( !read )
+  {
+    return openWriteFile( filename );
+  }
+
+  // O_NONBLOCK prevents blocking on FIFOs, which are rejected below
+  const int flags{ O_RDONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC };
+
+  const auto fileDescriptor{ openBeneath( directoryV, std::string{ filename }, flags ) };
+
+  if ( fileDescriptor < 0 )
+  {
+    const auto error{ errno };
+    SPDLOG_ERROR( "Could not open file '{}': {}", filename, std::generic_category().message( error ) );
+    return std::unexpected( errorCode( error ) );
+  }
+
+  struct stat status{};
+
+  if ( ( ::fstat( fileDescriptor, &status ) < 0 ) || !S_ISREG( status.st_mode ) )
+  {
+    SPDLOG_ERROR( "'{}' is not a regular file", filename );
+    ::close( fileDescriptor );
+    return std::unexpected( Packets::ErrorCode::FileNotFound );
+  }
+
+  // regular file I/O does not block - restore blocking mode anyway
+  ::fcntl( fileDescriptor, F_SETFL, ::fcntl( fileDescriptor, F_GETFL ) & ~O_NONBLOCK );
+
+  auto descriptor{ Files::DescriptorFile::sharedDescriptor( fileDescriptor ) };
+  const auto size{ static_cast< uint64_t >( status.st_size ) };
+
+  return OpenedFile{
+    std::make_shared< Files::DescriptorFile >( Files::File::Operation::Transmit, descriptor, size ),
+    descriptor,
+    size };
+#endif
+}
+
+#if !defined( _WIN32 )
+std::expected< FileResolver::OpenedFile, Packets::ErrorCode > FileResolver::openWriteFile(
+  const std::string_view filename ) const
+{
+  const auto separator{ filename.rfind( '/' ) };
+  const std::string name{ ( std::string_view::npos == separator ) ? filename : filename.substr( separator + 1U ) };
+
+  if ( name.empty() || ( name == "." ) || ( name == ".." ) )
+  {
+    SPDLOG_ERROR( "'{}' is not a valid filename", filename );
+    return std::unexpected( Packets::ErrorCode::AccessViolation );
+  }
+
+  // the directory is opened beneath the root directory - the file is created within it without path resolution
+  std::string directory{ "." };
+
+  if ( std::string_view::npos != separator )
+  {
+    // an absolute path keeps its leading slash, so it is rejected
+    const auto end{ filename.find_last_not_of( '/', separator ) };
+    directory = ( std::string_view::npos == end ) ? "/" : filename.substr( 0U, end + 1U );
+  }
+
+  const auto directoryDescriptor{ openBeneath( directoryV, directory, O_RDONLY | O_DIRECTORY | O_CLOEXEC ) };
+
+  if ( directoryDescriptor < 0 )
+  {
+    const auto error{ errno };
+    SPDLOG_ERROR( "Could not open directory of '{}': {}", filename, std::generic_category().message( error ) );
+    return std::unexpected( errorCode( error ) );
+  }
+
+  auto parent{ Files::DescriptorFile::sharedDescriptor( directoryDescriptor ) };
+
+  // an existing file must be a regular file (symbolic links are rejected)
+  struct stat status{};
+  const bool exists{ 0 == ::fstatat( *parent, name.c_str(), &status, AT_SYMLINK_NOFOLLOW ) };
+
+  if ( exists && !S_ISREG( status.st_mode ) )
+  {
+    SPDLOG_ERROR( "'{}' is not a regular file", filename );
+    return std::unexpected( Packets::ErrorCode::AccessViolation );
+  }
+
+  if ( !exists && ( ENOENT != errno ) )
+  {
+    const auto error{ errno };
+    SPDLOG_ERROR( "Could not access file '{}': {}", filename, std::generic_category().message( error ) );
+    return std::unexpected( errorCode( error ) );
+  }
+
+  // reject the request early, when the file cannot be written or created
+  if ( ::faccessat( *parent, exists ? name.c_str() : ".", W_OK, AT_EACCESS ) < 0 )
+  {
+    const auto error{ errno };
+    SPDLOG_ERROR( "Could not write file '{}': {}", filename, std::generic_category().message( error ) );
+    return std::unexpected( errorCode( error ) );
+  }
+
+  return OpenedFile{ std::make_shared< Files::DescriptorFile >(
+    [ parent = std::move( parent ), name ]{ return createFile( *parent, name ); } ) };
+}
+#endif
+
+void FileResolver::cacheMetadata( const std::string_view filename, const OpenedFile &file ) const
+{
+  if ( ( 0U == metadataCapacityV ) || !file.descriptor )
+  {
+    return;
+  }
+
+  const auto now{ Clock::now() };
+
+  // make room by removing expired entries
+  if ( metadataCacheV.size() >= metadataCapacityV )
+  {
+    for ( auto entry{ metadataCacheV.cbegin() }; entry != metadataCacheV.cend(); )
+    {
+      const auto current{ entry++ };
+
+      if ( current->second.expiry <= now )
+      {
+        eraseMetadata( current );
+      }
+    }
+
+    if ( metadataCacheV.size() >= metadataCapacityV )
+    {
+      return;
+    }
+  }
+
+  Metadata metadata{
+    file.descriptor,
+    file.size,
+    file.compression,
+    file.content,
+    -1,
+    now + metadataTimeToLiveV };
+
+#if defined( __linux__ )
+  if ( notifyV >= 0 )
+  {
+    // watch the opened inode, not the name
+    metadata.watch = ::inotify_add_watch(
+      notifyV,
+      std::format( "/proc/self/fd/{}", *file.descriptor ).c_str(),
+      IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF | IN_ONESHOT );
+
+    if ( metadata.watch < 0 )
+    {
+      // without watch, the file would be reused until expiry
+      SPDLOG_WARN( "Could not watch file '{}': {}", filename, std::generic_category().message( errno ) );
+      return;
+    }
+  }
+#endif
+
+  if ( const auto entry{ metadataCacheV.find( filename ) }; entry != metadataCacheV.end() )
+  {
+    eraseMetadata( entry );
+  }
+
+  metadataCacheV.emplace( std::string{ filename }, std::move( metadata ) );
+}
+
+void FileResolver::eraseMetadata( const MetadataCache::const_iterator entry ) const
+{
+#if defined( __linux__ )
+  // the same inode (e.g. hard links) shares the watch
+  if ( const auto watch{ entry->second.watch };
+    ( watch >= 0 )
+    && ( 1 == std::ranges::count_if(
+      metadataCacheV,
+      [ watch ]( const auto &other ){ return other.second.watch == watch; } ) ) )
+  {
+    ::inotify_rm_watch( notifyV, watch );
+  }
+#endif
+
+  metadataCacheV.erase( entry );
+}
+
+void FileResolver::handleNotifications() const
+{
+#if defined( __linux__ )
+  if ( notifyV < 0 )
+  {
+    return;
+  }
+
+  alignas( inotify_event ) std::array< char, 4096U > buffer{};
+
+  for ( ;; )
+  {
+    const auto size{ ::read( notifyV, buffer.data(), buffer.size() ) };
+
+    // EAGAIN: no more events
+    if ( size <= 0 )
+    {
+      break;
+    }
+
+    for ( std::size_t offset{ 0U }; offset < static_cast< std::size_t >( size ); )
+    {
+      inotify_event event{};
+      // NOLINTNEXTLINE( cppcoreguidelines-pro-type-reinterpret-cast ): copy of the event header
+      std::copy_n( buffer.data() + offset, sizeof( event ), reinterpret_cast< char * >( &event ) );
+      offset += sizeof( event ) + event.len;
+
+      // the one-shot watch has been removed by the kernel
+      statisticV.metadataCacheInvalidations += std::erase_if(
+        metadataCacheV,
+        [ &event ]( const auto &entry ){ return entry.second.watch == event.wd; } );
+    }
+  }
+#endif
+}
+
+}
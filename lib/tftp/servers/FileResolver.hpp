@@ -0,0 +1,419 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::FileResolver.
+ **/
+
+#ifndef TFTP_SERVERS_FILERESOLVER_HPP
+#define TFTP_SERVERS_FILERESOLVER_HPP
+
+#include <tftp/servers/Servers.hpp>
+#include <tftp/servers/FileResolverStatistic.hpp>
+
+#include <tftp/files/Files.hpp>
+#include <tftp/files/DecompressingFile.hpp>
+
+#include <tftp/packets/Packets.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief Resolves requested Filenames beneath a %Server Root Directory.
+ *
+ * Replacement for checkFilename(), which canonicalises the base directory and the requested path on every request,
+ * and leaves the actual open of the file to the caller.
+ *
+ * The resolver holds an open descriptor of the root directory.
+ * Requested filenames are opened relative to this descriptor:
+ * - On Linux, `openat2()` with `RESOLVE_BENEATH` is used, which rejects absolute paths, `..` components, and
+ *   symbolic links, which escape the root directory, within the kernel.
+ * - Otherwise (or when `openat2()` is not supported by the kernel), the path is opened component by component by
+ *   `openat()` with `O_NOFOLLOW`.
+ *   Absolute paths, `..` components, and symbolic links are rejected.
+ *
+ * The opened file is returned as Files::DescriptorFile.
+ * As the file is not opened by name again, the check is free of races.
+ *
+ * On platforms without `openat()` (Windows), the filename is checked lexically against the root directory, which is
+ * canonicalised once on construction, and a Files::StreamFile is returned.
+ *
+ * Boot loaders (PXELINUX, iPXE) probe a long sequence of not existing configuration files.
+ * When enabled by negativeCache(), read requests for not existing files are remembered for a limited time and
+ * answered with Packets::ErrorCode::FileNotFound without accessing the file system.
+ * Files created by write requests of this resolver are removed from the cache immediately.
+ *
+ * Many clients requesting the same file (e.g. a boot image) are served by the metadata cache, when enabled by
+ * metadataCache().
+ * The descriptor and size of successfully opened files are kept, and following read requests get a
+ * Files::DescriptorFile on the shared descriptor without path resolution, `open()`, and `fstat()`.
+ * On Linux, cached files are watched by `inotify`, and the entry is dropped, when the file is modified, renamed, or
+ * deleted.
+ * Additionally, entries expire after a configurable time, which also covers changes, which are not reported by
+ * `inotify` (e.g. renamed parent directories).
+ * The metadata cache is not available on Windows.
+ *
+ * When enabled by precompressed(), a read request for `<filename>`, which does not exist, is served from
+ * `<filename>.zst` or `<filename>.gz` by a Files::DecompressingFile.
+ * The uncompressed size for the `tsize` option is taken from the sidecar file `<filename>.zst.size` resp.
+ * `<filename>.gz.size` (decimal number), if present, otherwise from the frame header of single frame Zstandard files.
+ * Without sidecar file, the size of gzip files and multi-frame Zstandard files is not announced
+ * (see Files::DecompressingFile::uncompressedSize()).
+ * Small files can be decompressed once and kept within the metadata cache, so hot files are served from memory.
+ *
+ * The resolver may be used from different threads.
+ **/
+class TFTP_EXPORT FileResolver final
+{
+  public:
+    //! Opened %File or TFTP Error Code to respond.
+    using Result = std::expected< Files::FilePtr, Packets::ErrorCode >;
+
+    /**
+     * @brief Opens the Root Directory.
+     *
+     * @param[in] baseDir
+     *   Root directory.
+     *
+     * @throw TftpException
+     *   When the root directory cannot be opened.
+     **/
+    explicit FileResolver( const std::filesystem::path &baseDir );
+
+    //! Destructor - closes the root directory.
+    ~FileResolver() noexcept;
+
+    FileResolver( const FileResolver & ) = delete;
+    FileResolver& operator=( const FileResolver & ) = delete;
+
+    /**
+     * @brief Returns the canonical Root Directory.
+     *
+     * @return Root directory.
+     **/
+    [[nodiscard]] const std::filesystem::path& baseDir() const noexcept;
+
+    /**
+     * @brief Configures the Negative Cache.
+     *
+     * By default, the negative cache is disabled.
+     *
+     * @param[in] timeToLive
+     *   Time, how long a not existing file is remembered.
+     *   Files, which are created by other means, are found after this time at the latest.
+     * @param[in] capacity
+     *   Maximum number of remembered files.
+     *   When the cache is full, further files are not cached until entries expire.
+     *   `0` disables the negative cache.
+     **/
+    void negativeCache( std::chrono::milliseconds timeToLive, std::size_t capacity );
+
+    /**
+     * @brief Configures the Metadata Cache.
+     *
+     * By default, the metadata cache is disabled.
+     *
+     * @param[in] timeToLive
+     *   Maximum time, how long an opened file is reused.
+     * @param[in] capacity
+     *   Maximum number of cached files (each holds an open file descriptor).
+     *   When the cache is full, further files are not cached until entries expire.
+     *   `0` disables the metadata cache.
+     **/
+    void metadataCache( std::chrono::milliseconds timeToLive, std::size_t capacity );
+
+    /**
+     * @brief Configures serving of pre-compressed Files.
+     *
+     * By default, pre-compressed files are not served.
+     *
+     * @param[in] enabled
+     *   If pre-compressed files are served.
+     * @param[in] memoizeLimit
+     *   Maximum uncompressed size of files, which are decompressed once and kept within the metadata cache.
+     *   Only used, when the metadata cache is enabled and the uncompressed size is known.
+     *   `0` disables memoization.
+     **/
+    void precompressed( bool enabled, uint64_t memoizeLimit = 0U );
+
+    /**
+     * @brief Returns the Resolver Statistic.
+     *
+     * @return File Resolver Statistic.
+     **/
+    [[nodiscard]] FileResolverStatistic statistic() const;
+
+    /**
+     * @brief Opens the requested File beneath the Root Directory.
+     *
+     * On read requests, the file must be an existing regular file.
+     * On write requests, the directory of the file is opened and checked on request.
+     * The file is created resp. truncated, when the first data is received, so a transfer, which fails before (e.g.
+     * by option negotiation), leaves the file system untouched.
+     *
+     * For the NETASCII transfer mode, the file is wrapped into a Files::NetasciiFile.
+     * On read requests, the encoded transfer size is determined by reading the file only, when the `tsize` option is
+     * negotiated.
+     * The size is cached by the identity of the file content (device, inode, modification time, and size), independent
+     * of the metadata cache.
+     *
+     * @param[in] filename
+     *   Requested filename (relative to the root directory).
+     * @param[in] requestType
+     *   Read or Write request.
+     * @param[in] mode
+     *   Transfer Mode (OCTET or NETASCII).
+     *
+     * @return Opened file, which can be used as data handler of the operation.
+     * @retval Packets::ErrorCode::FileNotFound
+     *   When the file does not exist (read request).
+     * @retval Packets::ErrorCode::AccessViolation
+     *   When the filename is not beneath the root directory or the file cannot be opened.
+     * @retval Packets::ErrorCode::DiskFullOrAllocationExceeds
+     *   When the file cannot be created.
+     **/
+    [[nodiscard]] Result open(
+      std::string_view filename,
+      RequestType requestType,
+      Packets::TransferMode mode = Packets::TransferMode::OCTET ) const;
+
+  private:
+    //! Clock of the Caches
+    using Clock = std::chrono::steady_clock;
+
+    //! Compression Format
+    using Compression = Files::DecompressingFile::Compression;
+
+    //! Opened %File
+    struct OpenedFile
+    {
+      //! %File
+      Files::FilePtr file;
+      //! Shared Descriptor of the (compressed) %File (not used on Windows)
+      std::shared_ptr< const int > descriptor{};
+      //! %File Size (uncompressed)
+      std::optional< uint64_t > size{};
+      //! Compression of a pre-compressed %File
+      std::optional< Compression > compression{};
+      //! Decompressed Content of a memoized pre-compressed %File
+      std::shared_ptr< const Helper::RawData > content{};
+    };
+
+    //! Metadata Cache Entry
+    struct Metadata
+    {
+      //! Shared Descriptor of the (compressed) %File
+      std::shared_ptr< const int > descriptor;
+      //! %File Size (uncompressed)
+      std::optional< uint64_t > size;
+      //! Compression of a pre-compressed %File
+      std::optional< Compression > compression;
+      //! Decompressed Content of a memoized pre-compressed %File
+      std::shared_ptr< const Helper::RawData > content;
+      //! `inotify` Watch Descriptor (`-1` if not watched)
+      int watch{ -1 };
+      //! Expiry of the Entry
+      Clock::time_point expiry;
+    };
+
+    //! Metadata Cache
+    using MetadataCache = std::map< std::string, Metadata, std::less<> >;
+
+    //! NETASCII Transfer Size Cache
+    struct NetasciiSizes
+    {
+      //! Identity of the %File Content (device, inode, modification time, size)
+      using Key = std::tuple< uint64_t, uint64_t, int64_t, int64_t, int64_t >;
+      //! Maximum Number of Entries
+      static constexpr std::size_t Capacity{ 1024U };
+
+      //! Mutex protecting the sizes
+      std::mutex mutex;
+      //! NETASCII encoded Sizes
+      std::map< Key, uint64_t > sizes;
+    };
+
+    /**
+     * @brief Opens the requested File by the Caches (OCTET Mode).
+     *
+     * @param[in] filename
+     *   Requested filename.
+     * @param[in] requestType
+     *   Read or Write request.
+     *
+     * @return Opened file or error code.
+     **/
+    [[nodiscard]] std::expected< OpenedFile, Packets::ErrorCode > openCached(
+      std::string_view filename,
+      RequestType requestType ) const;
+
+    /**
+     * @brief Opens the pre-compressed Variant of the requested File.
+     *
+     * @param[in] filename
+     *   Requested filename.
+     *
+     * @return Opened and decompressing file or error code.
+     **/
+    [[nodiscard]] std::expected< OpenedFile, Packets::ErrorCode > openPrecompressed( std::string_view filename ) const;
+
+    /**
+     * @brief Returns the uncompressed Size of the pre-compressed File.
+     *
+     * @param[in] filename
+     *   Filename of the compressed file.
+     * @param[in] file
+     *   Opened compressed file.
+     * @param[in] compression
+     *   Compression format.
+     *
+     * @return Uncompressed size
+     * @retval std::nullopt
+     *   When the size is not known.
+     **/
+    [[nodiscard]] std::optional< uint64_t > uncompressedSize(
+      std::string_view filename,
+      const OpenedFile &file,
+      Compression compression ) const;
+
+    /**
+     * @brief Creates the File for the Metadata Cache Entry.
+     *
+     * @param[in] metadata
+     *   Metadata cache entry.
+     *
+     * @return File for the transmit operation.
+     **/
+    [[nodiscard]] static Files::FilePtr cachedFile( const Metadata &metadata );
+
+    /**
+     * @brief Returns the NETASCII Transfer Size of the opened File.
+     *
+     * The size is taken from @p sizes or determined by reading @p file.
+     *
+     * @param[in] file
+     *   Underlying file of the NETASCII file.
+     * @param[in] descriptor
+     *   Shared descriptor of the file (identifies the file content).
+     * @param[in,out] sizes
+     *   NETASCII transfer size cache.
+     *
+     * @return NETASCII encoded size.
+     * @retval std::nullopt
+     *   When the size cannot be determined.
+     **/
+    [[nodiscard]] static std::optional< uint64_t > netasciiSize(
+      Files::File &file,
+      const std::shared_ptr< const int > &descriptor,
+      NetasciiSizes &sizes );
+
+    /**
+     * @brief Opens the requested File (without Caches).
+     *
+     * @copydetails open()
+     **/
+    [[nodiscard]] std::expected< OpenedFile, Packets::ErrorCode > openFile(
+      std::string_view filename,
+      RequestType requestType ) const;
+
+    /**
+     * @brief Opens the Directory of the requested File for a Write Request.
+     *
+     * An existing file must be a regular file, which can be written.
+     * The returned file creates resp. truncates the file on reception of the first data.
+     * Not available on Windows.
+     *
+     * @param[in] filename
+     *   Requested filename.
+     *
+     * @return File or error code.
+     **/
+    [[nodiscard]] std::expected< OpenedFile, Packets::ErrorCode > openWriteFile( std::string_view filename ) const;
+
+    /**
+     * @brief Adds the opened File to the Metadata Cache.
+     *
+     * Must be called with locked mutex.
+     *
+     * @param[in] filename
+     *   Requested filename.
+     * @param[in] file
+     *   Opened file.
+     **/
+    void cacheMetadata( std::string_view filename, const OpenedFile &file ) const;
+
+    /**
+     * @brief Removes the Entry from the Metadata Cache.
+     *
+     * The `inotify` watch is removed, if not used by another entry.
+     * Must be called with locked mutex.
+     *
+     * @param[in] entry
+     *   Metadata cache entry.
+     **/
+    void eraseMetadata( MetadataCache::const_iterator entry ) const;
+
+    /**
+     * @brief Drops the Metadata Cache Entries of changed Files.
+     *
+     * Handles the pending `inotify` events.
+     * Must be called with locked mutex.
+     **/
+    void handleNotifications() const;
+
+    //! Canonical Root Directory
+    std::filesystem::path baseDirV;
+    //! Root Directory Descriptor (not used on Windows)
+    int directoryV{ -1 };
+
+    //! `inotify` Descriptor (Linux only)
+    int notifyV{ -1 };
+
+    //! Mutex protecting the caches and the statistic
+    mutable std::mutex mutexV;
+    //! Negative Cache Time to Live
+    std::chrono::milliseconds negativeTimeToLiveV{};
+    //! Negative Cache Capacity
+    std::size_t negativeCapacityV{ 0U };
+    //! Negative Cache (Filename to Expiry)
+    mutable std::map< std::string, Clock::time_point, std::less<> > negativeCacheV;
+    //! Metadata Cache Time to Live
+    std::chrono::milliseconds metadataTimeToLiveV{};
+    //! Metadata Cache Capacity
+    std::size_t metadataCapacityV{ 0U };
+    //! Metadata Cache (Filename to Metadata)
+    mutable MetadataCache metadataCacheV;
+    //! NETASCII Transfer Size Cache (shared with the opened files)
+    std::shared_ptr< NetasciiSizes > netasciiSizesV{ std::make_shared< NetasciiSizes >() };
+    //! Serve pre-compressed Files
+    bool precompressedV{ false };
+    //! Maximum Size of memoized decompressed Files
+    uint64_t memoizeLimitV{ 0U };
+    //! Statistic
+    mutable FileResolverStatistic statisticV;
+};
+
+}
+
+#endif
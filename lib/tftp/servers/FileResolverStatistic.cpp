@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Struct Tftp::Servers::FileResolverStatistic.
+ **/
+
+#include "FileResolverStatistic.hpp"
+
+#include <format>
+#include <ostream>
+
+namespace Tftp::Servers {
+
+std::string FileResolverStatistic::toString() const
+{
+  return std::format(
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n",
+    "Opened", opened,
+    "Not Found", notFound,
+    "Rejected", rejected,
+    "Negative Cache Hits", negativeCacheHits,
+    "Negative Cache Entries", negativeCacheEntries,
+    "Metadata Cache Hits", metadataCacheHits,
+    "Metadata Invalidations", metadataCacheInvalidations,
+    "Metadata Cache Entries", metadataCacheEntries );
+}
+
+std::ostream& operator<<( std::ostream &stream, const FileResolverStatistic &statistic )
+{
+  return ( stream << statistic.toString() );
+}
+
+}
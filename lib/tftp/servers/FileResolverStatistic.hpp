@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Struct Tftp::Servers::FileResolverStatistic.
+ **/
+
+#ifndef TFTP_SERVERS_FILERESOLVERSTATISTIC_HPP
+#define TFTP_SERVERS_FILERESOLVERSTATISTIC_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server %File Resolver Statistic.
+ *
+ * Counts the requests resolved by a FileResolver and the requests answered by its caches.
+ *
+ * @sa FileResolver::statistic()
+ **/
+struct TFTP_EXPORT FileResolverStatistic
+{
+  //! Successfully opened Files
+  std::size_t opened{ 0U };
+  //! Requests for not existing Files (including negative cache hits)
+  std::size_t notFound{ 0U };
+  //! Requests rejected for other reasons (e.g. access violation)
+  std::size_t rejected{ 0U };
+  //! Requests answered by the Negative Cache
+  std::size_t negativeCacheHits{ 0U };
+  //! Entries currently held by the Negative Cache
+  std::size_t negativeCacheEntries{ 0U };
+  //! Requests answered by the Metadata Cache (included in opened)
+  std::size_t metadataCacheHits{ 0U };
+  //! Metadata Cache Entries dropped, because the file has been changed
+  std::size_t metadataCacheInvalidations{ 0U };
+  //! Entries currently held by the Metadata Cache
+  std::size_t metadataCacheEntries{ 0U };
+
+  /**
+   * @brief Gives the statistic as printable string.
+   *
+   * @return Statistic as string representation
+   **/
+  [[nodiscard]] std::string toString() const;
+};
+
+/**
+ * @brief Stream output operator of @p FileResolverStatistic.
+ *
+ * @param[in,out] stream
+ *   Output Stream
+ * @param[in] statistic
+ *   File Resolver Statistic
+ *
+ * @return @p stream for chaining.
+ **/
+TFTP_EXPORT std::ostream& operator<<( std::ostream &stream, const FileResolverStatistic &statistic );
+
+}
+
+#endif
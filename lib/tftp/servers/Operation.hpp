@@ -112,6 +112,20 @@ class TFTP_EXPORT Operation
      **/
     virtual Operation& local( boost::asio::ip::udp::endpoint local ) = 0;
 
+    /**
+     * @brief Updates the Socket Buffer Sizes.
+     *
+     * Applied to the dedicated socket of the operation, when it is opened.
+     * Shared sockets are configured by the server.
+     * Larger receive buffers prevent packet drops by the IP stack with large block sizes.
+     *
+     * @param[in] socketBufferSizes
+     *   Socket buffer sizes.
+     *
+     * @return @p *this for chaining.
+     **/
+    virtual Operation& socketBufferSizes( SocketBufferSizes socketBufferSizes ) = 0;
+
     /**
      * @brief Updates the Client Options
      *
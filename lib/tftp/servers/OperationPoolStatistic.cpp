@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Struct Tftp::Servers::OperationPoolStatistic.
+ **/
+
+#include "OperationPoolStatistic.hpp"
+
+#include <format>
+#include <ostream>
+
+namespace Tftp::Servers {
+
+std::string OperationPoolStatistic::toString() const
+{
+  return std::format(
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n",
+    "Hits", hits,
+    "Misses", misses,
+    "Recycled", recycled,
+    "Discarded", discarded,
+    "Available", available );
+}
+
+OperationPoolStatistic& OperationPoolStatistic::operator+=( const OperationPoolStatistic &other ) noexcept
+{
+  hits += other.hits;
+  misses += other.misses;
+  recycled += other.recycled;
+  discarded += other.discarded;
+  available += other.available;
+  return *this;
+}
+
+std::ostream& operator<<( std::ostream &stream, const OperationPoolStatistic &statistic )
+{
+  return ( stream << statistic.toString() );
+}
+
+}
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Struct Tftp::Servers::OperationPoolStatistic.
+ **/
+
+#ifndef TFTP_SERVERS_OPERATIONPOOLSTATISTIC_HPP
+#define TFTP_SERVERS_OPERATIONPOOLSTATISTIC_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server %Operation Pool Statistic.
+ *
+ * Counts the operations handed out by the operation pools of the server.
+ *
+ * @sa Server::operationPoolSize()
+ * @sa Server::operationPoolStatistic()
+ **/
+struct TFTP_EXPORT OperationPoolStatistic
+{
+  //! Operations taken from the Pool
+  std::size_t hits{ 0U };
+  //! Operations newly created, because the Pool was empty
+  std::size_t misses{ 0U };
+  //! Released Operations, which have been returned to the Pool
+  std::size_t recycled{ 0U };
+  //! Released Operations, which have been destroyed, because the Pool was full
+  std::size_t discarded{ 0U };
+  //! Operations currently available within the Pool
+  std::size_t available{ 0U };
+
+  /**
+   * @brief Gives the statistic as printable string.
+   *
+   * @return Statistic as string representation
+   **/
+  [[nodiscard]] std::string toString() const;
+
+  /**
+   * @brief Accumulates the Statistic of another Pool.
+   *
+   * @param[in] other
+   *   Statistic to add.
+   *
+   * @return *this
+   **/
+  OperationPoolStatistic& operator+=( const OperationPoolStatistic &other ) noexcept;
+};
+
+/**
+ * @brief Stream output operator of @p OperationPoolStatistic.
+ *
+ * @param[in,out] stream
+ *   Output Stream
+ * @param[in] statistic
+ *   Operation Pool Statistic
+ *
+ * @return @p stream for chaining.
+ **/
+TFTP_EXPORT std::ostream& operator<<( std::ostream &stream, const OperationPoolStatistic &statistic );
+
+}
+
+#endif
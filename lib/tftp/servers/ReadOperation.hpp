@@ -68,6 +68,9 @@ class TFTP_EXPORT ReadOperation : public Operation
     //! @copydoc Operation::local()
     ReadOperation& local( boost::asio::ip::udp::endpoint local ) override = 0;
 
+    //! @copydoc Operation::socketBufferSizes()
+    ReadOperation& socketBufferSizes( SocketBufferSizes socketBufferSizes ) override = 0;
+
     //! @copydoc Operation::clientOptions()
     ReadOperation& clientOptions( Packets::TftpOptions clientOptions ) override = 0;
 
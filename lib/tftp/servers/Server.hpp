@@ -16,12 +16,20 @@
 #define TFTP_SERVERS_SERVER_HPP
 
 #include <tftp/servers/Servers.hpp>
+#include <tftp/servers/AdmissionConfiguration.hpp>
+#include <tftp/servers/AdmissionStatistic.hpp>
+#include <tftp/servers/OperationPoolStatistic.hpp>
+#include <tftp/servers/ShapingConfiguration.hpp>
+#include <tftp/servers/ShapingStatistic.hpp>
+#include <tftp/servers/TuningConfiguration.hpp>
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
 
 #include <chrono>
 #include <optional>
 #include <string>
+#include <string_view>
 
 namespace Tftp::Servers {
 
@@ -34,6 +42,10 @@ namespace Tftp::Servers {
  * If no expected packets or invalid packets are received, an error is sent back to the sender.
  *
  * Valid requests are TFTP Read Request (RRQ) and TFTP Write Request (WRQ)
+ *
+ * The server and its operations are not thread-safe.
+ * The I/O context must be run by a single thread.
+ * To use several threads, run one I/O context with its own server per thread.
  **/
 class TFTP_EXPORT Server
 {
@@ -85,8 +97,82 @@ class TFTP_EXPORT Server
      **/
     virtual Server& serverAddress( boost::asio::ip::udp::endpoint serverAddress ) = 0;
 
+    /**
+     * @brief Updates the Admission Control Configuration.
+     *
+     * Received read and write requests are checked against the configured rate and session limits, before the
+     * request handler is called.
+     * Rejected requests are responded with an error packet or dropped silently.
+     *
+     * By default, all requests are admitted.
+     *
+     * @param[in] admissionConfiguration
+     *   Admission Control Configuration.
+     *
+     * @return *this for chaining.
+     *
+     * @throw TftpException
+     *   When the configuration is invalid.
+     **/
+    virtual Server& admissionConfiguration( AdmissionConfiguration admissionConfiguration ) = 0;
+
+    /**
+     * @brief Updates the Transmit Shaping Configuration.
+     *
+     * DATA packets of read operations created by this server are paced to meet the configured global and per
+     * operation transmit rates.
+     *
+     * By default, transmission is not shaped.
+     *
+     * @param[in] shapingConfiguration
+     *   Transmit Shaping Configuration.
+     *
+     * @return *this for chaining.
+     **/
+    virtual Server& shapingConfiguration( ShapingConfiguration shapingConfiguration ) = 0;
+
+    /**
+     * @brief Updates the Tuning Configuration.
+     *
+     * Each received request is matched against the tuning profiles by its client address and filename.
+     * Operations created by @ref readOperation(const boost::asio::ip::address&,std::string_view) and
+     * @ref writeOperation(const boost::asio::ip::address&,std::string_view) apply the matching profile on start.
+     * The profile takes precedence over the defaults and the configuration of the operation.
+     *
+     * By default, no profile is configured and the defaults are used for all requests.
+     *
+     * @param[in] tuningConfiguration
+     *   Tuning Configuration.
+     *
+     * @return *this for chaining.
+     **/
+    virtual Server& tuningConfiguration( TuningConfiguration tuningConfiguration ) = 0;
+
     /** @} **/
 
+    /**
+     * @brief Returns the Admission Control Statistic.
+     *
+     * @return Admission Control Statistic.
+     **/
+    [[nodiscard]] virtual AdmissionStatistic admissionStatistic() const = 0;
+
+    /**
+     * @brief Returns the Transmit Shaping Statistic.
+     *
+     * @return Transmit Shaping Statistic.
+     **/
+    [[nodiscard]] virtual ShapingStatistic shapingStatistic() const = 0;
+
+    /**
+     * @brief Returns the Statistic of the Operation Pools.
+     *
+     * The statistic of the read and write operation pools is accumulated.
+     *
+     * @return Operation Pool Statistic.
+     **/
+    [[nodiscard]] virtual OperationPoolStatistic operationPoolStatistic() const = 0;
+
     /**
      * @brief Returns the effective local endpoint.
      *
@@ -174,6 +260,57 @@ class TFTP_EXPORT Server
      **/
     virtual Server& localDefault( boost::asio::ip::address local ) = 0;
 
+    /**
+     * @brief Updates the Number of Sockets shared by the Operations.
+     *
+     * By default, every operation opens its own socket with an ephemeral port.
+     * If set to a value greater than zero, the server opens the given number of sockets on @ref start() and the
+     * created operations share them.
+     * Received packets are demultiplexed by the remote endpoint.
+     * This reduces the number of file descriptors and the setup cost per operation.
+     *
+     * When an operation cannot use a shared socket (e.g. another operation with the same remote endpoint is active),
+     * it falls back to its own socket.
+     *
+     * @param[in] sharedSockets
+     *   Number of shared sockets. `0` disables socket sharing.
+     *
+     * @return @p *this for chaining.
+     **/
+    virtual Server& sharedSockets( std::size_t sharedSockets ) = 0;
+
+    /**
+     * @brief Updates the Socket Buffer Sizes.
+     *
+     * The sizes are applied to the server socket and the shared sockets on @ref start() and to the sockets of every
+     * created operation.
+     * Larger receive buffers prevent packet drops by the IP stack with large block sizes and many concurrent
+     * transfers.
+     *
+     * @param[in] socketBufferSizes
+     *   Socket buffer sizes (`SO_RCVBUF`, `SO_SNDBUF`).
+     *
+     * @return @p *this for chaining.
+     **/
+    virtual Server& socketBufferSizes( SocketBufferSizes socketBufferSizes ) = 0;
+
+    /**
+     * @brief Updates the Capacity of the Operation Pools.
+     *
+     * By default, every created operation is allocated and destroyed on release.
+     * If set to a value greater than zero, released read and write operations are returned to a pool and reused by
+     * @ref readOperation() and @ref writeOperation().
+     * The pools keep the sockets, timers and packet buffers of the operations.
+     * On @ref start(), the pools are filled with pre-constructed operations.
+     * This reduces the allocations, when many requests are received at once.
+     *
+     * @param[in] operationPoolSize
+     *   Maximum number of idle operations held per pool. `0` disables pooling.
+     *
+     * @return @p *this for chaining.
+     **/
+    virtual Server& operationPoolSize( std::size_t operationPoolSize ) = 0;
+
     /** @} **/
 
     /**
@@ -201,6 +338,23 @@ class TFTP_EXPORT Server
      **/
     [[nodiscard]] virtual ReadOperationPtr readOperation() = 0;
 
+    /**
+     * @brief Creates a TFTP %Server %Operation (TFTP RRQ) tuned for the Request.
+     *
+     * Like @ref readOperation(), but the tuning profile matching the request is applied on start (see
+     * @ref tuningConfiguration()).
+     *
+     * @param[in] remote
+     *   Client address of the request.
+     * @param[in] filename
+     *   Requested filename.
+     *
+     * @return TFTP server read operation.
+     **/
+    [[nodiscard]] virtual ReadOperationPtr readOperation(
+      const boost::asio::ip::address &remote,
+      std::string_view filename ) = 0;
+
     /**
      * @brief Creates a TFTP Server Operation (TFTP WRQ), which receives data from a TFTP Client and weites them to
      *   disk.
@@ -211,6 +365,23 @@ class TFTP_EXPORT Server
      **/
     [[nodiscard]] virtual WriteOperationPtr writeOperation() = 0;
 
+    /**
+     * @brief Creates a TFTP Server Operation (TFTP WRQ) tuned for the Request.
+     *
+     * Like @ref writeOperation(), but the tuning profile matching the request is applied on start (see
+     * @ref tuningConfiguration()).
+     *
+     * @param[in] remote
+     *   Client address of the request.
+     * @param[in] filename
+     *   Requested filename.
+     *
+     * @return TFTP server write operation.
+     **/
+    [[nodiscard]] virtual WriteOperationPtr writeOperation(
+      const boost::asio::ip::address &remote,
+      std::string_view filename ) = 0;
+
     /**
      * @brief Executes TFTP Error Operation.
      *
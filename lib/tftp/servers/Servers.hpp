@@ -44,6 +44,12 @@
  *   The actual operations can be created by using the Server class instances.
  * - @ref ReceiveDataHandler and @ref TransmitDataHandler
  *   This interface class must be implemented by the user of this library to make use of the TFTP server operations.
+ *
+ * Within the @ref ReceivedTftpRequestHandler, the data handler for the request can be obtained by:
+ * - @ref ContentRouter
+ *   Generated content selected by filename patterns.
+ * - @ref FileResolver
+ *   Files beneath a root directory.
  **/
 namespace Tftp::Servers {
 
@@ -130,6 +136,8 @@ using OperationCompletedHandler = std::function< void( TransferStatus transferSt
  * @return The processed file path
  * @retval std::nullopt
  *   When the filename is not valid
+ *
+ * @sa FileResolver, which opens the file race-free without canonicalisation per request.
  **/
 [[nodiscard]] TFTP_EXPORT std::optional< std::filesystem::path > checkFilename(
   const std::filesystem::path &baseDir,
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::ShapingConfiguration.
+ **/
+
+#include "ShapingConfiguration.hpp"
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <boost/program_options/value_semantic.hpp>
+
+namespace Tftp::Servers {
+
+ShapingConfiguration::ShapingConfiguration( const boost::property_tree::ptree &properties )
+{
+  fromProperties( properties );
+}
+
+void ShapingConfiguration::fromProperties( const boost::property_tree::ptree &properties )
+{
+  globalRate = properties.get_optional< uint64_t >( "global.rate" );
+  globalBurst = properties.get( "global.burst", DefaultGlobalBurst );
+
+  sessionRate = properties.get_optional< uint64_t >( "session.rate" );
+  sessionBurst = properties.get( "session.burst", DefaultSessionBurst );
+}
+
+boost::property_tree::ptree ShapingConfiguration::toProperties( const bool full ) const
+{
+  boost::property_tree::ptree properties{};
+
+  if ( full || globalRate )
+  {
+    properties.add( "global.rate", globalRate );
+  }
+
+  if ( full || ( DefaultGlobalBurst != globalBurst ) )
+  {
+    properties.add( "global.burst", globalBurst );
+  }
+
+  if ( full || sessionRate )
+  {
+    properties.add( "session.rate", sessionRate );
+  }
+
+  if ( full || ( DefaultSessionBurst != sessionBurst ) )
+  {
+    properties.add( "session.burst", sessionBurst );
+  }
+
+  return properties;
+}
+
+boost::program_options::options_description ShapingConfiguration::options()
+{
+  boost::program_options::options_description options{ "TFTP Server Transmit Shaping Options" };
+
+  options.add_options()
+  (
+    "egress-rate",
+    boost::program_options::value( &globalRate )->value_name( "bytes/s" ),
+    "Limits the overall transmit rate of DATA packets."
+  )
+  (
+    "egress-burst",
+    boost::program_options::value( &globalBurst )->default_value( globalBurst )->value_name( "bytes" ),
+    "Burst size of the overall transmit rate limit."
+  )
+  (
+    "session-egress-rate",
+    boost::program_options::value( &sessionRate )->value_name( "bytes/s" ),
+    "Limits the transmit rate of DATA packets per transfer."
+  )
+  (
+    "session-egress-burst",
+    boost::program_options::value( &sessionBurst )->default_value( sessionBurst )->value_name( "bytes" ),
+    "Burst size of the transmit rate limit per transfer."
+  );
+
+  return options;
+}
+
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::ShapingConfiguration.
+ **/
+
+#ifndef TFTP_SERVERS_SHAPINGCONFIGURATION_HPP
+#define TFTP_SERVERS_SHAPINGCONFIGURATION_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <boost/optional.hpp>
+
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <boost/program_options/options_description.hpp>
+
+#include <cstdint>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server Transmit Shaping Configuration.
+ *
+ * Limits the egress rate of DATA packets sent by server read operations.
+ * Limits can be set globally for all operations and per operation (session).
+ * A limit, which rate is not set, is disabled.
+ *
+ * The burst size defines how many bytes may be sent back to back, before sending is paced according to the rate.
+ * Paced DATA packets are delayed instead of dropped.
+ *
+ * @sa Server::shapingConfiguration()
+ **/
+class TFTP_EXPORT ShapingConfiguration
+{
+  public:
+    //! Default Global Burst Size in Bytes
+    static constexpr uint64_t DefaultGlobalBurst{ 64U * 1024U };
+    //! Default Burst Size per Session in Bytes
+    static constexpr uint64_t DefaultSessionBurst{ 16U * 1024U };
+
+    /**
+     * @brief Initialises the Configuration with Default Values.
+     *
+     * By default, transmission is not shaped.
+     **/
+    ShapingConfiguration() noexcept = default;
+
+    /**
+     * @brief Loads the Configuration via a Property Tree.
+     *
+     * @param[in] properties
+     *   Stored Shaping Configuration.
+     **/
+    explicit ShapingConfiguration( const boost::property_tree::ptree &properties );
+
+    /**
+     * @brief Load Configuration from given Property Tree.
+     *
+     * @param[in] properties
+     *   Configuration as Property Tree
+     **/
+    void fromProperties( const boost::property_tree::ptree &properties );
+
+    /**
+     * @brief Converts the configuration values to a Property Tree.
+     *
+     * @param[in] full
+     *   If set to true, all options are added to the property tree, even if defaulted.
+     *
+     * @return Configuration represented as Property Tree.
+     **/
+    [[nodiscard]] boost::property_tree::ptree toProperties( bool full = false ) const;
+
+    /**
+     * @brief Returns an option description, which can be used to parse a command line.
+     *
+     * @return Shaping Configuration Options
+     **/
+    [[nodiscard]] boost::program_options::options_description options();
+
+    //! Global Transmit Rate (bytes per second)
+    boost::optional< uint64_t > globalRate;
+    //! Global Burst Size (bytes)
+    uint64_t globalBurst{ DefaultGlobalBurst };
+
+    //! Transmit Rate per Session (bytes per second)
+    boost::optional< uint64_t > sessionRate;
+    //! Burst Size per Session (bytes)
+    uint64_t sessionBurst{ DefaultSessionBurst };
+};
+
+}
+
+#endif
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::ShapingStatistic.
+ **/
+
+#include "ShapingStatistic.hpp"
+
+#include <format>
+#include <ostream>
+
+namespace Tftp::Servers {
+
+std::string ShapingStatistic::toString() const
+{
+  return std::format(
+    "{:22}: Count: {} Total Size: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {}\n"
+    "{:22}: {} us\n"
+    "{:22}: {} us\n",
+    "Shaped", packets, bytes,
+    "Delayed", delayedPackets,
+    "Pending", pendingPackets,
+    "Total Delay", totalDelay.count(),
+    "Maximum Delay", maximumDelay.count() );
+}
+
+std::ostream& operator<<( std::ostream &stream, const ShapingStatistic &statistic )
+{
+  return ( stream << statistic.toString() );
+}
+
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::ShapingStatistic.
+ **/
+
+#ifndef TFTP_SERVERS_SHAPINGSTATISTIC_HPP
+#define TFTP_SERVERS_SHAPINGSTATISTIC_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server Transmit Shaping Statistic.
+ *
+ * Counts the shaped DATA packets and how much they have been delayed by pacing.
+ *
+ * @sa Server::shapingStatistic()
+ **/
+struct TFTP_EXPORT ShapingStatistic
+{
+  //! Packets passed through the Shaper
+  std::size_t packets{ 0U };
+  //! Bytes passed through the Shaper
+  std::size_t bytes{ 0U };
+  //! Packets, which have been delayed
+  std::size_t delayedPackets{ 0U };
+  //! Currently delayed Packets (Sessions waiting for their next transmission)
+  std::size_t pendingPackets{ 0U };
+  //! Accumulated Delay
+  std::chrono::microseconds totalDelay{};
+  //! Maximum Delay of a single Packet
+  std::chrono::microseconds maximumDelay{};
+
+  /**
+   * @brief Gives the statistic as printable string.
+   *
+   * @return Statistic as string representation
+   **/
+  [[nodiscard]] std::string toString() const;
+};
+
+/**
+ * @brief Stream output operator of @p ShapingStatistic.
+ *
+ * @param[in,out] stream
+ *   Output Stream
+ * @param[in] statistic
+ *   Shaping Statistic
+ *
+ * @return @p stream for chaining.
+ **/
+TFTP_EXPORT std::ostream& operator<<( std::ostream &stream, const ShapingStatistic &statistic );
+
+}
+
+#endif
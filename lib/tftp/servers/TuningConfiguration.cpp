@@ -0,0 +1,367 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::TuningConfiguration.
+ **/
+
+#include "TuningConfiguration.hpp"
+
+#include <tftp/packets/Packets.hpp>
+
+#include <tftp/TftpException.hpp>
+
+#include <helper/Exception.hpp>
+
+#include <boost/exception/all.hpp>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <boost/program_options/value_semantic.hpp>
+
+#include <charconv>
+#include <format>
+#include <limits>
+#include <ranges>
+#include <regex>
+
+namespace Tftp::Servers {
+
+namespace {
+
+/**
+ * @brief Decodes an unsigned Number within the given Limits.
+ *
+ * @tparam T
+ *   Number type.
+ * @param[in] key
+ *   Key of the value (for error reporting).
+ * @param[in] value
+ *   Value to decode.
+ * @param[in] min
+ *   Minimum value.
+ * @param[in] max
+ *   Maximum value.
+ *
+ * @return Decoded number.
+ *
+ * @throw TftpException
+ *   When the value is not a number within the limits.
+ **/
+template< typename T >
+T decodeNumber( const std::string_view key, const std::string_view value, const T min, const T max )
+{
+  T number{};
+
+  if ( const auto [ end, error ]{ std::from_chars( value.data(), value.data() + value.size(), number ) };
+    ( std::errc{} != error ) || ( end != value.data() + value.size() ) || ( number < min ) || ( number > max ) )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ std::format( "Invalid tuning profile value {}={}", key, value ) } );
+  }
+
+  return number;
+}
+
+/**
+ * @brief Decodes the Subnet of a Profile.
+ *
+ * @param[in,out] profile
+ *   Profile to update.
+ * @param[in] subnet
+ *   Subnet (`<address>/<prefix length>`).
+ *
+ * @throw TftpException
+ *   When the subnet is invalid.
+ **/
+void decodeSubnet( TuningConfiguration::Profile &profile, const std::string_view subnet )
+{
+  const auto separator{ subnet.find( '/' ) };
+
+  boost::system::error_code errorCode;
+  const auto address{ boost::asio::ip::make_address( subnet.substr( 0, separator ), errorCode ) };
+
+  if ( errorCode || ( std::string_view::npos == separator ) )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{ std::format( "Invalid tuning profile subnet {}", subnet ) } );
+  }
+
+  profile.subnet = address;
+  profile.subnetPrefixLength =
+    decodeNumber( "subnet", subnet.substr( separator + 1U ), 0U, address.is_v4() ? 32U : 128U );
+}
+
+/**
+ * @brief Decodes the Filename Pattern of a Profile.
+ *
+ * @param[in,out] profile
+ *   Profile to update.
+ * @param[in] filename
+ *   Filename pattern (regular expression).
+ *
+ * @throw TftpException
+ *   When the pattern is not a valid regular expression.
+ **/
+void decodeFilename( TuningConfiguration::Profile &profile, const std::string_view filename )
+{
+  try
+  {
+    // validate pattern - the server compiles it again
+    [[maybe_unused]] const std::regex pattern{ filename.begin(), filename.end() };
+  }
+  catch ( const std::regex_error &e )
+  {
+    BOOST_THROW_EXCEPTION( TftpException{}
+      << Helper::AdditionalInfo{
+        std::format( "Invalid tuning profile filename pattern {}: {}", filename, e.what() ) } );
+  }
+
+  profile.filename = filename;
+}
+
+}
+
+TuningConfiguration::Profile TuningConfiguration::Profile::fromString( const std::string_view specification )
+{
+  Profile profile{};
+
+  for ( const auto element : std::views::split( specification, ',' ) )
+  {
+    const std::string_view pair{ element.begin(), element.end() };
+    const auto separator{ pair.find( '=' ) };
+
+    if ( std::string_view::npos == separator )
+    {
+      BOOST_THROW_EXCEPTION( TftpException{}
+        << Helper::AdditionalInfo{ std::format( "Invalid tuning profile element {}", pair ) } );
+    }
+
+    const auto key{ pair.substr( 0, separator ) };
+    const auto value{ pair.substr( separator + 1U ) };
+
+    if ( key == "name" )
+    {
+      profile.name = value;
+    }
+    else if ( key == "subnet" )
+    {
+      decodeSubnet( profile, value );
+    }
+    else if ( key == "filename" )
+    {
+      decodeFilename( profile, value );
+    }
+    else if ( key == "block-size" )
+    {
+      profile.blockSizeOption = decodeNumber( key, value, Packets::BlockSizeOptionMin, Packets::BlockSizeOptionMax );
+    }
+    else if ( key == "timeout" )
+    {
+      profile.timeoutOption = std::chrono::seconds{ decodeNumber< std::chrono::seconds::rep >(
+        key,
+        value,
+        Packets::TimeoutOptionMin,
+        Packets::TimeoutOptionMax ) };
+    }
+    else if ( key == "tftp-timeout" )
+    {
+      profile.tftpTimeout = std::chrono::seconds{ decodeNumber< std::chrono::seconds::rep >(
+        key,
+        value,
+        1,
+        std::numeric_limits< uint16_t >::max() ) };
+    }
+    else
+    {
+      BOOST_THROW_EXCEPTION( TftpException{}
+        << Helper::AdditionalInfo{ std::format( "Unknown tuning profile key {}", key ) } );
+    }
+  }
+
+  return profile;
+}
+
+std::string TuningConfiguration::Profile::toString() const
+{
+  std::string specification{};
+
+  const auto add{ [ &specification ]( const std::string_view key, const auto &value )
+  {
+    specification += std::format( "{}{}={}", specification.empty() ? "" : ",", key, value );
+  } };
+
+  if ( !name.empty() )
+  {
+    add( "name", name );
+  }
+
+  if ( subnet )
+  {
+    add( "subnet", std::format( "{}/{}", subnet->to_string(), subnetPrefixLength ) );
+  }
+
+  if ( !filename.empty() )
+  {
+    add( "filename", filename );
+  }
+
+  if ( blockSizeOption )
+  {
+    add( "block-size", *blockSizeOption );
+  }
+
+  if ( timeoutOption )
+  {
+    add( "timeout", timeoutOption->count() );
+  }
+
+  if ( tftpTimeout )
+  {
+    add( "tftp-timeout", tftpTimeout->count() );
+  }
+
+  return specification;
+}
+
+TuningConfiguration::TuningConfiguration( const boost::property_tree::ptree &properties )
+{
+  fromProperties( properties );
+}
+
+void TuningConfiguration::fromProperties( const boost::property_tree::ptree &properties )
+{
+  profiles.clear();
+
+  const auto profilesProperties{ properties.get_child_optional( "profiles" ) };
+
+  if ( !profilesProperties )
+  {
+    return;
+  }
+
+  for ( const auto &[ key, profileProperties ] : *profilesProperties )
+  {
+    if ( key != "profile" )
+    {
+      continue;
+    }
+
+    Profile profile{};
+
+    profile.name = profileProperties.get( "name", std::string{} );
+
+    if ( const auto subnet{ profileProperties.get_optional< std::string >( "subnet" ) }; subnet )
+    {
+      decodeSubnet( profile, *subnet );
+    }
+
+    if ( const auto filename{ profileProperties.get_optional< std::string >( "filename" ) }; filename )
+    {
+      decodeFilename( profile, *filename );
+    }
+
+    profile.blockSizeOption = profileProperties.get_optional< uint16_t >( "block_size" );
+    // convert to std::chrono (is similar to std::optional::transform)
+    profile.timeoutOption =
+      profileProperties.get_optional< std::chrono::seconds::rep >( "timeout" )
+        .map(
+          []( const auto timeout )
+          {
+            return std::chrono::seconds{ timeout };
+          } );
+    profile.tftpTimeout =
+      profileProperties.get_optional< std::chrono::seconds::rep >( "tftp_timeout" )
+        .map(
+          []( const auto timeout )
+          {
+            return std::chrono::seconds{ timeout };
+          } );
+
+    profiles.emplace_back( std::move( profile ) );
+  }
+}
+
+boost::property_tree::ptree TuningConfiguration::toProperties( const bool full ) const
+{
+  boost::property_tree::ptree properties{};
+
+  if ( full && profiles.empty() )
+  {
+    properties.add_child( "profiles", boost::property_tree::ptree{} );
+  }
+
+  for ( const auto &profile : profiles )
+  {
+    boost::property_tree::ptree profileProperties{};
+
+    if ( full || !profile.name.empty() )
+    {
+      profileProperties.add( "name", profile.name );
+    }
+
+    if ( profile.subnet )
+    {
+      profileProperties.add(
+        "subnet",
+        std::format( "{}/{}", profile.subnet->to_string(), profile.subnetPrefixLength ) );
+    }
+
+    if ( full || !profile.filename.empty() )
+    {
+      profileProperties.add( "filename", profile.filename );
+    }
+
+    if ( profile.blockSizeOption )
+    {
+      profileProperties.add( "block_size", *profile.blockSizeOption );
+    }
+
+    if ( profile.timeoutOption )
+    {
+      profileProperties.add( "timeout", profile.timeoutOption->count() );
+    }
+
+    if ( profile.tftpTimeout )
+    {
+      profileProperties.add( "tftp_timeout", profile.tftpTimeout->count() );
+    }
+
+    properties.add_child( "profiles.profile", profileProperties );
+  }
+
+  return properties;
+}
+
+boost::program_options::options_description TuningConfiguration::options()
+{
+  boost::program_options::options_description options{ "TFTP Server Tuning Options" };
+
+  options.add_options()
+  (
+    "tuning-profile",
+    boost::program_options::value< std::vector< std::string > >()
+      ->composing()
+      ->value_name( "profile" )
+      ->notifier(
+        [ this ]( const auto &specifications )
+        {
+          for ( const auto &specification : specifications )
+          {
+            profiles.emplace_back( Profile::fromString( specification ) );
+          }
+        } ),
+    "Option negotiation profile for matching requests (e.g. subnet=192.168.0.0/16,block-size=8192,timeout=1). "
+    "Keys: name, subnet, filename (regular expression), block-size, timeout, tftp-timeout. "
+    "The first matching profile is used. Can be given multiple times."
+  );
+
+  return options;
+}
+
+}
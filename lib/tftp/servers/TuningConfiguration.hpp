@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::TuningConfiguration.
+ **/
+
+#ifndef TFTP_SERVERS_TUNINGCONFIGURATION_HPP
+#define TFTP_SERVERS_TUNINGCONFIGURATION_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <boost/asio/ip/address.hpp>
+
+#include <boost/optional.hpp>
+
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <boost/program_options/options_description.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server Tuning Configuration.
+ *
+ * Tuning profiles select the option negotiation parameters per request path.
+ * A profile matches a request by the client subnet and/ or the requested filename.
+ * The first matching profile overrides the block size option, timeout option, and TFTP timeout of the server
+ * defaults (see Server::optionsConfigurationDefault() and Server::tftpTimeoutDefault()).
+ * Parameters not set by the profile are kept.
+ *
+ * E.g. LAN clients with jumbo frames negotiate a block size of 8192 with a short timeout, whereas VPN clients
+ * negotiate a block size of 1428, which fits into the tunnel MTU, with a longer timeout.
+ * The negotiated values never exceed the values requested by the client.
+ *
+ * @sa Server::tuningConfiguration()
+ **/
+class TFTP_EXPORT TuningConfiguration
+{
+  public:
+    //! Tuning Profile
+    struct TFTP_EXPORT Profile
+    {
+      /**
+       * @brief Decodes a Profile Specification.
+       *
+       * The specification is a comma separated list of `key=value` pairs:
+       * - `name`: Profile name,
+       * - `subnet`: Client subnet (`<address>/<prefix length>`),
+       * - `filename`: Filename pattern (regular expression, which must match the whole filename),
+       * - `block-size`: Block size option,
+       * - `timeout`: Timeout option in seconds,
+       * - `tftp-timeout`: TFTP timeout in seconds, when no timeout option is negotiated.
+       *
+       * @param[in] specification
+       *   Profile specification (e.g. `subnet=192.168.0.0/16,block-size=8192,timeout=1`).
+       *
+       * @return Decoded profile.
+       *
+       * @throw TftpException
+       *   When the specification is invalid.
+       **/
+      [[nodiscard]] static Profile fromString( std::string_view specification );
+
+      /**
+       * @brief Encodes the Profile Specification.
+       *
+       * @return Profile specification, which can be decoded by fromString().
+       **/
+      [[nodiscard]] std::string toString() const;
+
+      //! Profile Name (only informational)
+      std::string name;
+      //! Client Subnet Address (if not set, every client matches)
+      boost::optional< boost::asio::ip::address > subnet;
+      //! Client Subnet Prefix Length
+      unsigned int subnetPrefixLength{ 0U };
+      //! Filename Pattern - regular expression (if empty, every filename matches)
+      std::string filename;
+
+      //! If set, this value is used for block size option negotiation
+      boost::optional< uint16_t > blockSizeOption;
+      //! If set, this value is used for timeout option negotiation
+      boost::optional< std::chrono::seconds > timeoutOption;
+      //! If set, this TFTP timeout is used, when no timeout option is negotiated
+      boost::optional< std::chrono::seconds > tftpTimeout;
+    };
+
+    /**
+     * @brief Initialises the Configuration with Default Values.
+     *
+     * By default, no profile is configured.
+     **/
+    TuningConfiguration() noexcept = default;
+
+    /**
+     * @brief Loads the Configuration via a Property Tree.
+     *
+     * @param[in] properties
+     *   Stored Tuning Configuration.
+     **/
+    explicit TuningConfiguration( const boost::property_tree::ptree &properties );
+
+    /**
+     * @brief Load Configuration from given Property Tree.
+     *
+     * @param[in] properties
+     *   Configuration as Property Tree
+     **/
+    void fromProperties( const boost::property_tree::ptree &properties );
+
+    /**
+     * @brief Converts the configuration values to a Property Tree.
+     *
+     * @param[in] full
+     *   If set to true, all options are added to the property tree, even if defaulted.
+     *
+     * @return Configuration represented as Property Tree.
+     **/
+    [[nodiscard]] boost::property_tree::ptree toProperties( bool full = false ) const;
+
+    /**
+     * @brief Returns an option description, which can be used to parse a command line.
+     *
+     * @return Tuning Configuration Options
+     **/
+    [[nodiscard]] boost::program_options::options_description options();
+
+    //! Tuning Profiles (the first matching profile is used)
+    std::vector< Profile > profiles;
+};
+
+}
+
+#endif
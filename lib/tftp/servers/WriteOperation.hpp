@@ -80,6 +80,9 @@ class TFTP_EXPORT WriteOperation : public Operation
     //! @copydoc Operation::local()
     WriteOperation& local( boost::asio::ip::udp::endpoint local ) override = 0;
 
+    //! @copydoc Operation::socketBufferSizes()
+    WriteOperation& socketBufferSizes( SocketBufferSizes socketBufferSizes ) override = 0;
+
     //! @copydoc Operation::clientOptions()
     WriteOperation& clientOptions( Packets::TftpOptions clientOptions ) override = 0;
 
@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::AdmissionControl.
+ **/
+
+#include "AdmissionControl.hpp"
+
+#include <boost/asio/ip/network_v4.hpp>
+#include <boost/asio/ip/network_v6.hpp>
+
+#include <algorithm>
+
+namespace Tftp::Servers {
+
+AdmissionControl::Session::Session( std::shared_ptr< AdmissionControl > admissionControl ) noexcept :
+  admissionControlV{ std::move( admissionControl ) }
+{
+  if ( admissionControlV )
+  {
+    ++admissionControlV->activeSessionsV;
+  }
+}
+
+AdmissionControl::Session::~Session() noexcept
+{
+  release();
+}
+
+AdmissionControl::Session& AdmissionControl::Session::operator=( Session &&other ) noexcept
+{
+  if ( this != &other )
+  {
+    release();
+    admissionControlV = std::move( other.admissionControlV );
+  }
+
+  return *this;
+}
+
+void AdmissionControl::Session::release() noexcept
+{
+  if ( admissionControlV )
+  {
+    --admissionControlV->activeSessionsV;
+    admissionControlV.reset();
+  }
+}
+
+void AdmissionControl::configuration( AdmissionConfiguration configuration )
+{
+  configuration.validate();
+
+  std::lock_guard lock{ mutexV };
+
+  configurationV = std::move( configuration );
+  addressBucketsV.clear();
+  subnetBucketsV.clear();
+  globalBucketV.reset();
+}
+
+AdmissionControl::Result AdmissionControl::admit( const boost::asio::ip::address &address )
+{
+  return admit( address, Clock::now() );
+}
+
+AdmissionControl::Result AdmissionControl::admit(
+  const boost::asio::ip::address &address,
+  const Clock::time_point now )
+{
+  std::lock_guard lock{ mutexV };
+
+  // Refill all configured buckets first, tokens are only consumed when all limits are met
+  TokenBucket * addressBucket{ nullptr };
+  TokenBucket * subnetBucket{ nullptr };
+  TokenBucket * globalBucket{ nullptr };
+
+  Result result{ Result::Accepted };
+
+  if ( configurationV.maxSessions && ( activeSessionsV >= *configurationV.maxSessions ) )
+  {
+    result = Result::SessionsExceeded;
+  }
+
+  if ( configurationV.globalRate )
+  {
+    if ( !globalBucketV )
+    {
+      globalBucketV = TokenBucket{ static_cast< double >( configurationV.globalBurst ), now };
+    }
+
+    globalBucket = &*globalBucketV;
+
+    if ( !refill( *globalBucket, *configurationV.globalRate, configurationV.globalBurst, now ) )
+    {
+      result = Result::GlobalRateExceeded;
+    }
+  }
+
+  if ( configurationV.subnetRate )
+  {
+    subnetBucket = &bucket(
+      subnetBucketsV,
+      subnet( address ),
+      *configurationV.subnetRate,
+      configurationV.subnetBurst,
+      now );
+
+    if ( !refill( *subnetBucket, *configurationV.subnetRate, configurationV.subnetBurst, now ) )
+    {
+      result = Result::SubnetRateExceeded;
+    }
+  }
+
+  if ( configurationV.addressRate )
+  {
+    addressBucket = &bucket(
+      addressBucketsV,
+      address,
+      *configurationV.addressRate,
+      configurationV.addressBurst,
+      now );
+
+    if ( !refill( *addressBucket, *configurationV.addressRate, configurationV.addressBurst, now ) )
+    {
+      result = Result::AddressRateExceeded;
+    }
+  }
+
+  switch ( result )
+  {
+    case Result::Accepted:
+      for ( auto * const consumedBucket : { addressBucket, subnetBucket, globalBucket } )
+      {
+        if ( nullptr != consumedBucket )
+        {
+          consumedBucket->tokens -= 1.0;
+        }
+      }
+      ++statisticV.accepted;
+      break;
+
+    case Result::AddressRateExceeded:
+      ++statisticV.rejectedAddressRate;
+      break;
+
+    case Result::SubnetRateExceeded:
+      ++statisticV.rejectedSubnetRate;
+      break;
+
+    case Result::GlobalRateExceeded:
+      ++statisticV.rejectedGlobalRate;
+      break;
+
+    case Result::SessionsExceeded:
+      ++statisticV.rejectedSessions;
+      break;
+
+    default:
+      break;
+  }
+
+  return result;
+}
+
+AdmissionStatistic AdmissionControl::statistic() const
+{
+  std::lock_guard lock{ mutexV };
+
+  auto statistic{ statisticV };
+  statistic.activeSessions = activeSessionsV;
+  return statistic;
+}
+
+std::size_t AdmissionControl::buckets() const
+{
+  std::lock_guard lock{ mutexV };
+
+  return addressBucketsV.buckets.size() + subnetBucketsV.buckets.size();
+}
+
+void AdmissionControl::TokenBuckets::clear() noexcept
+{
+  buckets.clear();
+  overflow.reset();
+  lastCleanup = {};
+}
+
+bool AdmissionControl::refill(
+  TokenBucket &bucket,
+  const double rate,
+  const uint32_t burst,
+  const Clock::time_point now ) noexcept
+{
+  const std::chrono::duration< double > elapsed{ now - bucket.lastRefill };
+
+  bucket.tokens = std::min( bucket.tokens + elapsed.count() * rate, static_cast< double >( burst ) );
+  bucket.lastRefill = now;
+
+  return bucket.tokens >= 1.0;
+}
+
+AdmissionControl::TokenBucket& AdmissionControl::bucket(
+  TokenBuckets &buckets,
+  const boost::asio::ip::address &key,
+  const double rate,
+  const uint32_t burst,
+  const Clock::time_point now )
+{
+  if ( const auto existingBucket{ buckets.buckets.find( key ) }; existingBucket != buckets.buckets.end() )
+  {
+    return existingBucket->second;
+  }
+
+  // remove buckets, which would be full by now - they behave like new ones
+  if ( ( buckets.buckets.size() >= MaxBuckets ) && ( now - buckets.lastCleanup >= CleanupInterval ) )
+  {
+    buckets.lastCleanup = now;
+
+    std::erase_if(
+      buckets.buckets,
+      [ rate, burst, now ]( const auto &entry )
+      {
+        const std::chrono::duration< double > elapsed{ now - entry.second.lastRefill };
+        return ( entry.second.tokens + elapsed.count() * rate ) >= static_cast< double >( burst );
+      } );
+  }
+
+  // still too many (all buckets in use) - share the overflow bucket, no bucket is evicted with its consumed tokens
+  if ( buckets.buckets.size() >= MaxBuckets )
+  {
+    if ( !buckets.overflow )
+    {
+      buckets.overflow = TokenBucket{ static_cast< double >( burst ), now };
+    }
+
+    return *buckets.overflow;
+  }
+
+  return buckets.buckets.emplace( key, TokenBucket{ static_cast< double >( burst ), now } ).first->second;
+}
+
+boost::asio::ip::address AdmissionControl::subnet( const boost::asio::ip::address &address ) const
+{
+  if ( address.is_v4() )
+  {
+    return boost::asio::ip::make_network_v4(
+      address.to_v4(),
+      std::min( configurationV.subnetPrefixLengthV4, 32U ) ).network();
+  }
+
+  // IPv4 clients of a dual-stack socket are received as IPv4-mapped IPv6 addresses
+  if ( address.to_v6().is_v4_mapped() )
+  {
+    return subnet( boost::asio::ip::make_address_v4( boost::asio::ip::v4_mapped, address.to_v6() ) );
+  }
+
+  return boost::asio::ip::make_network_v6(
+    address.to_v6(),
+    std::min( configurationV.subnetPrefixLengthV6, 128U ) ).network();
+}
+
+}
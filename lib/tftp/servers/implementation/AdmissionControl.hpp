@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::AdmissionControl.
+ **/
+
+#ifndef TFTP_SERVERS_ADMISSIONCONTROL_HPP
+#define TFTP_SERVERS_ADMISSIONCONTROL_HPP
+
+#include <tftp/servers/Servers.hpp>
+#include <tftp/servers/AdmissionConfiguration.hpp>
+#include <tftp/servers/AdmissionStatistic.hpp>
+
+#include <boost/asio/ip/address.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <optional>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server Admission Control.
+ *
+ * Decides, whether a received request is accepted, by the token buckets and session limit configured by
+ * AdmissionConfiguration.
+ * Active operations are tracked by @ref Session instances, which are held by the operations.
+ *
+ * The instance is shared between the server and its operations.
+ * The statistic may be queried from other threads than the one running the I/O context.
+ **/
+class TFTP_EXPORT AdmissionControl final
+{
+  public:
+    //! Clock used for the Token Buckets
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Maximum Number of Buckets per Map (client addresses resp. subnets).
+     *
+     * When reached, further clients share one overflow bucket, so the memory is bounded and a flood with many source
+     * addresses gains no tokens.
+     * Buckets, which would be full by now, are removed at most once per @ref CleanupInterval.
+     **/
+    static constexpr std::size_t MaxBuckets{ 4096U };
+
+    //! Minimum Interval between Removals of full Buckets
+    static constexpr std::chrono::seconds CleanupInterval{ 1 };
+
+    //! Admission Result
+    enum class Result
+    {
+      Accepted,
+      AddressRateExceeded,
+      SubnetRateExceeded,
+      GlobalRateExceeded,
+      SessionsExceeded
+    };
+
+    /**
+     * @brief Active Session.
+     *
+     * Increments the active sessions counter of the admission control on creation and decrements it on destruction
+     * or @ref release().
+     **/
+    class Session
+    {
+      public:
+        //! Creates a Session, which is not tracked.
+        Session() noexcept = default;
+
+        /**
+         * @brief Creates a tracked Session.
+         *
+         * @param[in] admissionControl
+         *   Admission Control, which tracks the session.
+         **/
+        explicit Session( std::shared_ptr< AdmissionControl > admissionControl ) noexcept;
+
+        //! Releases the Session.
+        ~Session() noexcept;
+
+        Session( const Session & ) = delete;
+        Session& operator=( const Session & ) = delete;
+
+        //! Move Constructor
+        Session( Session &&other ) noexcept = default;
+
+        /**
+         * @brief Move Assignment.
+         *
+         * @param[in] other
+         *   Moved Session.
+         *
+         * @return *this
+         **/
+        Session& operator=( Session &&other ) noexcept;
+
+        /**
+         * @brief Releases the Session.
+         *
+         * Further calls have no effect.
+         **/
+        void release() noexcept;
+
+      private:
+        //! Admission Control
+        std::shared_ptr< AdmissionControl > admissionControlV;
+    };
+
+    /**
+     * @brief Updates the Admission Configuration.
+     *
+     * Resets all token buckets.
+     *
+     * @param[in] configuration
+     *   Admission Configuration.
+     *
+     * @throw TftpException
+     *   When the configuration is invalid.
+     **/
+    void configuration( AdmissionConfiguration configuration );
+
+    /**
+     * @brief Checks whether a request of the given client is admitted.
+     *
+     * A token of each configured bucket is only consumed, when the request is accepted.
+     *
+     * @param[in] address
+     *   Client Address.
+     *
+     * @return Admission Result.
+     **/
+    [[nodiscard]] Result admit( const boost::asio::ip::address &address );
+
+    /**
+     * @copydoc admit(const boost::asio::ip::address&)
+     *
+     * @param[in] now
+     *   Current time (used by the token buckets).
+     **/
+    [[nodiscard]] Result admit( const boost::asio::ip::address &address, Clock::time_point now );
+
+    /**
+     * @brief Returns the Admission Statistic.
+     *
+     * @return Admission Statistic.
+     **/
+    [[nodiscard]] AdmissionStatistic statistic() const;
+
+    /**
+     * @brief Returns the Number of tracked Token Buckets.
+     *
+     * @return Number of client address and subnet buckets.
+     **/
+    [[nodiscard]] std::size_t buckets() const;
+
+  private:
+    //! Token Bucket
+    struct TokenBucket
+    {
+      //! Available Tokens
+      double tokens;
+      //! Last Refill Time
+      Clock::time_point lastRefill;
+    };
+
+    //! Client Bucket Map
+    struct TokenBuckets
+    {
+      //! Buckets per Client Address resp. Subnet
+      std::map< boost::asio::ip::address, TokenBucket > buckets;
+      //! Bucket shared by the Clients, which are not tracked, because the map is full
+      std::optional< TokenBucket > overflow;
+      //! Time of the last Removal of full Buckets
+      Clock::time_point lastCleanup;
+
+      //! Removes all Buckets
+      void clear() noexcept;
+    };
+
+    /**
+     * @brief Refills the Bucket with the given rate up to burst and checks for an available token.
+     *
+     * @param[in,out] bucket
+     *   Token Bucket.
+     * @param[in] rate
+     *   Rate in tokens per second.
+     * @param[in] burst
+     *   Bucket Size.
+     * @param[in] now
+     *   Current Time.
+     *
+     * @return If a token is available.
+     **/
+    static bool refill( TokenBucket &bucket, double rate, uint32_t burst, Clock::time_point now ) noexcept;
+
+    /**
+     * @brief Returns the Bucket of the given Client.
+     *
+     * When the map is full, buckets, which would be full by now, are removed - at most once per CleanupInterval.
+     * If the map is still full, the overflow bucket is returned.
+     *
+     * @sa MaxBuckets
+     *
+     * @param[in,out] buckets
+     *   Token Buckets.
+     * @param[in] key
+     *   Client Address or Subnet.
+     * @param[in] rate
+     *   Rate in tokens per second.
+     * @param[in] burst
+     *   Bucket Size.
+     * @param[in] now
+     *   Current Time.
+     *
+     * @return Token Bucket of the client.
+     **/
+    static TokenBucket& bucket(
+      TokenBuckets &buckets,
+      const boost::asio::ip::address &key,
+      double rate,
+      uint32_t burst,
+      Clock::time_point now );
+
+    /**
+     * @brief Returns the Subnet Address of the given Client Address.
+     *
+     * @param[in] address
+     *   Client Address.
+     *
+     * @return Subnet Address.
+     **/
+    [[nodiscard]] boost::asio::ip::address subnet( const boost::asio::ip::address &address ) const;
+
+    //! Mutex protecting configuration, buckets and statistic
+    mutable std::mutex mutexV;
+    //! Admission Configuration
+    AdmissionConfiguration configurationV;
+    //! Token Buckets per Client Address
+    TokenBuckets addressBucketsV;
+    //! Token Buckets per Client Subnet
+    TokenBuckets subnetBucketsV;
+    //! Global Token Bucket
+    std::optional< TokenBucket > globalBucketV;
+    //! Admission Statistic (without active sessions)
+    AdmissionStatistic statisticV;
+    //! Number of active Sessions
+    std::atomic< std::size_t > activeSessionsV{ 0U };
+};
+
+}
+
+#endif
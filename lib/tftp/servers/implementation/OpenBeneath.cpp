@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Functions Tftp::Servers::openBeneath() and Tftp::Servers::openComponents().
+ **/
+
+#include "OpenBeneath.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined( __linux__ )
+#include <linux/openat2.h>
+#include <sys/syscall.h>
+#endif
+
+namespace Tftp::Servers {
+
+int openComponents( const int directory, std::string_view filename, const int flags )
+{
+  if ( filename.starts_with( '/' ) )
+  {
+    errno = EXDEV;
+    return -1;
+  }
+
+  int current{ directory };
+
+  // closes the current intermediate directory, but keeps errno
+  const auto closeCurrent{ [ &current, directory ]
+  {
+    if ( current != directory )
+    {
+      const auto savedErrno{ errno };
+      ::close( current );
+      errno = savedErrno;
+    }
+  } };
+
+  while ( true )
+  {
+    const auto separator{ filename.find( '/' ) };
+    const std::string component{ filename.substr( 0, separator ) };
+
+    if ( component == ".." )
+    {
+      closeCurrent();
+      errno = EXDEV;
+      return -1;
+    }
+
+    // last component - the file itself
+    if ( separator == std::string_view::npos )
+    {
+      const auto fileDescriptor{ ::openat( current, component.c_str(), flags | O_NOFOLLOW, CreateMode ) };
+      closeCurrent();
+      return fileDescriptor;
+    }
+
+    filename.remove_prefix( separator + 1U );
+
+    // skip empty and "." components
+    if ( component.empty() || ( component == "." ) )
+    {
+      continue;
+    }
+
+    const auto next{
+      ::openat( current, component.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC ) };
+    closeCurrent();
+
+    if ( next < 0 )
+    {
+      return -1;
+    }
+
+    current = next;
+  }
+}
+
+int openBeneath( const int directory, const std::string &filename, const int flags )
+{
+#if defined( __linux__ ) && defined( SYS_openat2 )
+  // cleared, when the kernel does not support openat2()
+  static std::atomic_bool openat2Supported{ true };
+
+  if ( openat2Supported.load( std::memory_order_relaxed ) )
+  {
+    open_how how{};
+    how.flags = static_cast< uint64_t >( flags );
+    how.mode = ( 0 != ( flags & O_CREAT ) ) ? CreateMode : 0U;
+    how.resolve = RESOLVE_BENEATH | RESOLVE_NO_MAGICLINKS;
+
+    const auto fileDescriptor{
+      static_cast< int >( ::syscall( SYS_openat2, directory, filename.c_str(), &how, sizeof( how ) ) ) };
+
+    if ( ( fileDescriptor >= 0 ) || ( ENOSYS != errno ) )
+    {
+      return fileDescriptor;
+    }
+
+    SPDLOG_INFO( "openat2() not supported - fall back to component-wise resolution" );
+    openat2Supported.store( false, std::memory_order_relaxed );
+  }
+#endif
+
+  return openComponents( directory, filename, flags );
+}
+
+}
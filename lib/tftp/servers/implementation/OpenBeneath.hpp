@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Functions Tftp::Servers::openBeneath() and Tftp::Servers::openComponents().
+ *
+ * Only available on POSIX platforms.
+ **/
+
+#ifndef TFTP_SERVERS_OPENBENEATH_HPP
+#define TFTP_SERVERS_OPENBENEATH_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <string>
+#include <string_view>
+
+#include <sys/types.h>
+
+namespace Tftp::Servers {
+
+//! Permissions of created files (reduced by umask)
+inline constexpr mode_t CreateMode{ 0666 };
+
+/**
+ * @brief Opens @p filename beneath @p directory component by component.
+ *
+ * Absolute paths, `..` components, and symbolic links are rejected with `EXDEV` resp. `ELOOP`.
+ *
+ * @param[in] directory
+ *   Root directory descriptor.
+ * @param[in] filename
+ *   Relative filename.
+ * @param[in] flags
+ *   Open flags of the file.
+ *
+ * @return Opened file descriptor.
+ * @retval -1
+ *   On error - errno is set.
+ **/
+TFTP_EXPORT int openComponents( int directory, std::string_view filename, int flags );
+
+/**
+ * @brief Opens @p filename beneath @p directory.
+ *
+ * Uses `openat2()` with `RESOLVE_BENEATH` on Linux and falls back to openComponents().
+ *
+ * @param[in] directory
+ *   Root directory descriptor.
+ * @param[in] filename
+ *   Relative filename.
+ * @param[in] flags
+ *   Open flags of the file.
+ *
+ * @return Opened file descriptor.
+ * @retval -1
+ *   On error - errno is set.
+ **/
+TFTP_EXPORT int openBeneath( int directory, const std::string &filename, int flags );
+
+}
+
+#endif
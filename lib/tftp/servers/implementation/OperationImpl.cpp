@@ -19,8 +19,12 @@
 #include <tftp/packets/ReadRequestPacket.hpp>
 #include <tftp/packets/WriteRequestPacket.hpp>
 
+#include <tftp/PacketCapture.hpp>
+#include <tftp/PathMtu.hpp>
+#include <tftp/ReceiveBuffer.hpp>
 #include <tftp/TftpException.hpp>
 #include <tftp/TftpOptionsConfiguration.hpp>
+#include <tftp/TraceRing.hpp>
 
 #include <helper/Exception.hpp>
 
@@ -30,23 +34,98 @@
 
 #include <boost/bind/bind.hpp>
 
+#include <algorithm>
+
 namespace Tftp::Servers {
 
-OperationImpl::OperationImpl( boost::asio::io_context &ioContext ) :
+OperationImpl::OperationImpl(
+  boost::asio::io_context &ioContext,
+  AdmissionControl::Session session,
+  std::shared_ptr< TransmitShaper > shaper,
+  SharedSocketPtr sharedSocket ) :
   socket{ ioContext },
   timer{ ioContext },
-  receivePacket( Packets::DefaultMaxPacketSize )
+  sessionV{ std::move( session ) },
+  shaperV{ std::move( shaper ) },
+  pacingTimer{ ioContext },
+  sharedSocketV{ std::move( sharedSocket ) }
+{
+}
+
+OperationImpl::~OperationImpl()
 {
+  if ( attachedV )
+  {
+    sharedSocketV->detach( remoteV );
+  }
 }
 
-OperationImpl::~OperationImpl() = default;
+void OperationImpl::reset(
+  AdmissionControl::Session session,
+  std::shared_ptr< TransmitShaper > shaper,
+  SharedSocketPtr sharedSocket )
+{
+  // stop an operation, which has not been finished
+  timer.cancel();
+
+  if ( attachedV )
+  {
+    sharedSocketV->detach( remoteV );
+    attachedV = false;
+  }
+
+  if ( socket.is_open() )
+  {
+    boost::system::error_code errorCode;
+    socket.close( errorCode );
+  }
+
+  cancelPacing();
+
+  receiveTimeoutV = Tftp::DefaultTftpReceiveTimeout;
+  tftpRetriesV = Tftp::DefaultTftpRetries;
+  tuningProfileV.reset();
+  completionHandlerV = {};
+  remoteV = {};
+  localV = {};
+  socketBufferSizesV = {};
+
+  // keep the allocated buffer
+  transmitPacket.clear();
+  transmitCounter = 0U;
+  errorInformationV = {};
+
+  sessionV = std::move( session );
+  shaperV = std::move( shaper );
+  shapingStateV = {};
+  pacingDelayV = {};
+  sharedSocketV = std::move( sharedSocket );
+}
 
 void OperationImpl::initialise()
 {
+  traceSessionV = TraceRing::session();
+  TraceRing::instance().record( TraceEvent::Started, traceSessionV );
+
+  automaticBlockSizeV.reset();
+
+  // use the shared socket, if the local endpoint matches
+  if ( sharedSocketV
+    && ( 0U == localV.port() )
+    && ( localV.address().is_unspecified() || ( localV.address() == sharedSocketV->localEndpoint().address() ) )
+    && sharedSocketV->attach(
+      remoteV,
+      [ this ]( const Helper::ConstRawDataSpan rawPacket ){ sharedSocketPacket( rawPacket ); } ) )
+  {
+    attachedV = true;
+    return;
+  }
+
   try
   {
     // Open the socket
     socket.open( remoteV.protocol() );
+    socketBufferSizesV.apply( socket );
 
     // bind to local address
     if ( !localV.address().is_unspecified() )
@@ -109,6 +188,34 @@ void OperationImpl::tftpRetries( const uint16_t retries )
   tftpRetriesV = retries;
 }
 
+void OperationImpl::tuningProfile( TuningConfiguration::Profile profile )
+{
+  tuningProfileV = std::move( profile );
+}
+
+void OperationImpl::applyTuningProfile( TftpOptionsConfiguration &optionsConfiguration )
+{
+  if ( !tuningProfileV )
+  {
+    return;
+  }
+
+  if ( tuningProfileV->tftpTimeout )
+  {
+    receiveTimeoutV = *tuningProfileV->tftpTimeout;
+  }
+
+  if ( tuningProfileV->blockSizeOption )
+  {
+    optionsConfiguration.blockSizeOption = tuningProfileV->blockSizeOption;
+  }
+
+  if ( tuningProfileV->timeoutOption )
+  {
+    optionsConfiguration.timeoutOption = tuningProfileV->timeoutOption;
+  }
+}
+
 void OperationImpl::remote( boost::asio::ip::udp::endpoint remote )
 {
   remoteV = std::move( remote );
@@ -119,14 +226,14 @@ void OperationImpl::local( boost::asio::ip::udp::endpoint local )
   localV = std::move( local );
 }
 
-void OperationImpl::completionHandler( OperationCompletedHandler handler )
+void OperationImpl::socketBufferSizes( SocketBufferSizes socketBufferSizes )
 {
-  completionHandlerV = std::move( handler );
+  socketBufferSizesV = std::move( socketBufferSizes );
 }
 
-void OperationImpl::maxReceivePacketSize( const uint16_t maxReceivePacketSize )
+void OperationImpl::completionHandler( OperationCompletedHandler handler )
 {
-  receivePacket.resize( maxReceivePacketSize );
+  completionHandlerV = std::move( handler );
 }
 
 void OperationImpl::receiveTimeout( const std::chrono::seconds receiveTimeout ) noexcept
@@ -134,46 +241,103 @@ void OperationImpl::receiveTimeout( const std::chrono::seconds receiveTimeout )
   receiveTimeoutV = receiveTimeout;
 }
 
-void OperationImpl::send( const Packets::Packet &packet )
+std::optional< uint16_t > OperationImpl::negotiateBlockSize(
+  const TftpOptionsConfiguration &optionsConfiguration,
+  const std::optional< uint16_t > clientBlockSize )
 {
-  SPDLOG_TRACE( "TX: {}", static_cast< std::string>( packet ) );
+  if ( !clientBlockSize )
+  {
+    return {};
+  }
 
-  try
+  auto blockSize{ optionsConfiguration.blockSizeOption };
+  std::optional< uint16_t > pathMtuBlockSize{};
+
+  if ( optionsConfiguration.blockSizeAutomatic )
   {
-    // Reset transmit counter
-    transmitCounter = 1U;
+    pathMtuBlockSize = PathMtu::instance().blockSize( remoteV );
 
-    // Encode the raw packet
-    transmitPacket = static_cast< Helper::RawData >( packet );
+    if ( pathMtuBlockSize )
+    {
+      blockSize = std::min( *pathMtuBlockSize, blockSize.get_value_or( *pathMtuBlockSize ) );
+    }
+  }
 
-    // Update statistic
-    Packets::PacketStatistic::globalTransmit().packet( packet.packetType(), transmitPacket.size() );
+  if ( !blockSize )
+  {
+    return {};
+  }
 
-    // Send the packet to the remote client
-    socket.send( boost::asio::buffer( transmitPacket ) );
+  const auto negotiatedBlockSize{ std::min( *clientBlockSize, *blockSize ) };
+
+  if ( pathMtuBlockSize )
+  {
+    automaticBlockSizeV = negotiatedBlockSize;
   }
-  catch ( const boost::system::system_error &err )
+
+  return negotiatedBlockSize;
+}
+
+void OperationImpl::send( const Packets::Packet &packet )
+{
+  SPDLOG_TRACE( "TX: {}", static_cast< std::string>( packet ) );
+
+  // Reset transmit counter
+  transmitCounter = 1U;
+
+  // Encode the raw packet
+  transmitPacket = static_cast< Helper::RawData >( packet );
+
+  transmit();
+}
+
+void OperationImpl::sendPaced( const Packets::Packet &packet )
+{
+  if ( !shaperV )
   {
-    SPDLOG_ERROR( "TX Error: {}", err.what() );
+    send( packet );
+    return;
+  }
 
-    finished( TransferStatus::CommunicationError );
+  SPDLOG_TRACE( "TX (paced): {}", static_cast< std::string>( packet ) );
+
+  // Reset transmit counter
+  transmitCounter = 1U;
+
+  // Encode the raw packet
+  transmitPacket = static_cast< Helper::RawData >( packet );
+
+  pacingDelayV = shaperV->schedule( shapingStateV, transmitPacket.size() );
+
+  if ( pacingDelayV <= TransmitShaper::Clock::duration::zero() )
+  {
+    pacingDelayV = {};
+    transmit();
+    return;
   }
+
+  SPDLOG_TRACE(
+    "Pacing delay: {} us",
+    std::chrono::duration_cast< std::chrono::microseconds >( pacingDelayV ).count() );
+
+  pacingPendingV = true;
+  pacingTimer.expires_after( pacingDelayV );
+  pacingTimer.async_wait( std::bind_front( &OperationImpl::pacingHandler, this, ++pacingGenerationV ) );
 }
 
 void OperationImpl::receive()
 {
   try
   {
-    // start the receive operation
-    socket.async_receive(
-      boost::asio::buffer( receivePacket ),
-      std::bind_front( &OperationImpl::receiveHandler, this ) );
-
-    // set receive timeout
-    timer.expires_after( receiveTimeoutV );
+    // start the receive operation - the shared socket calls sharedSocketPacket() instead
+    if ( !attachedV )
+    {
+      waitReceive();
+    }
 
-    // start waiting for receive timeout
-    timer.async_wait( std::bind_front( &OperationImpl::timeoutHandler, this ) );
+    // set receive timeout - a pending paced packet is not sent yet
+    timer.expiresAfter( receiveTimeoutV + pacingDelayV, [ this ]{ timeoutHandler(); } );
+    pacingDelayV = {};
   }
   catch ( const boost::system::system_error &err )
   {
@@ -187,16 +351,14 @@ void OperationImpl::receiveDally()
 {
   try
   {
-    // start the receive operation
-    socket.async_receive(
-      boost::asio::buffer( receivePacket ),
-      std::bind_front( &OperationImpl::receiveHandler, this ) );
+    // start the receive operation - the shared socket calls sharedSocketPacket() instead
+    if ( !attachedV )
+    {
+      waitReceive();
+    }
 
     // set receive timeout
-    timer.expires_after( 2U * receiveTimeoutV );
-
-    // start waiting for receive timeout
-    timer.async_wait( std::bind_front( &OperationImpl::timeoutDallyHandler, this ) );
+    timer.expiresAfter( 2U * receiveTimeoutV, [ this ]{ timeoutDallyHandler(); } );
   }
   catch ( const boost::system::system_error &err )
   {
@@ -210,15 +372,34 @@ void OperationImpl::finished( const TransferStatus status, Packets::ErrorInforma
 {
   SPDLOG_INFO( "TFTP Server operation finished" );
 
+  TraceRing::instance().record( TraceEvent::Finished, traceSessionV, static_cast< uint16_t >( status ) );
+
   errorInformationV = std::move( errorInformation );
 
   timer.cancel();
-  socket.cancel();
-  socket.close();
 
-  if ( completionHandlerV )
+  if ( attachedV )
   {
-    completionHandlerV( status );
+    sharedSocketV->detach( remoteV );
+    attachedV = false;
+  }
+  else
+  {
+    // called by noexcept finished() overrides - must not throw
+    boost::system::error_code errorCode;
+    socket.cancel( errorCode );
+    socket.close( errorCode );
+  }
+
+  cancelPacing();
+
+  // operation is not active anymore
+  sessionV.release();
+
+  // the handler may release the operation, which resets it
+  if ( const auto handler{ std::move( completionHandlerV ) }; handler )
+  {
+    handler( status );
   }
 }
 
@@ -308,72 +489,192 @@ void OperationImpl::invalidPacket(
   finished( TransferStatus::TransferError, errorPacket.errorInformation() );
 }
 
-void OperationImpl::receiveHandler( const boost::system::error_code &errorCode, const std::size_t bytesTransferred )
+void OperationImpl::sendTransmitPacket()
 {
-  // operation has been aborted (maybe timeout)
-  // error is not handled here.
-  if ( boost::asio::error::operation_aborted == errorCode )
+  PacketCapture::instance().record(
+    CaptureRecord::Role::Server,
+    CaptureRecord::Direction::Transmit,
+    traceSessionV,
+    remoteV,
+    transmitPacket );
+
+  if ( attachedV )
+  {
+    sharedSocketV->send( remoteV, transmitPacket );
+  }
+  else
+  {
+    socket.send( boost::asio::buffer( transmitPacket ) );
+  }
+}
+
+void OperationImpl::sharedSocketPacket( const Helper::ConstRawDataSpan rawPacket )
+{
+  TraceRing::instance().record( TraceEvent::Receive, traceSessionV, rawPacket );
+  PacketCapture::instance().record(
+    CaptureRecord::Role::Server,
+    CaptureRecord::Direction::Receive,
+    traceSessionV,
+    remoteV,
+    rawPacket );
+
+  packet( remoteV, rawPacket );
+}
+
+void OperationImpl::transmit()
+{
+  try
+  {
+    TraceRing::instance().record( TraceEvent::Transmit, traceSessionV, transmitPacket );
+
+    // Update statistic
+    Packets::PacketStatistic::globalTransmit().packet(
+      Packets::Packet::packetType( transmitPacket ),
+      transmitPacket.size() );
+
+    // Send the packet to the remote client
+    sendTransmitPacket();
+  }
+  catch ( const boost::system::system_error &err )
+  {
+    SPDLOG_ERROR( "TX Error: {}", err.what() );
+
+    finished( TransferStatus::CommunicationError );
+  }
+}
+
+void OperationImpl::cancelPacing() noexcept
+{
+  // invalidate handlers, which are already queued
+  ++pacingGenerationV;
+
+  if ( !pacingPendingV )
   {
     return;
   }
 
-  // (internal) receive error occurred
+  pacingPendingV = false;
+  pacingTimer.cancel();
+  shaperV->delayedPacketSent();
+}
+
+void OperationImpl::pacingHandler( const uint32_t generation, const boost::system::error_code &errorCode )
+{
+  // pacing cancelled (operation finished or reset) - the timer might have expired before the cancellation
+  if ( ( boost::asio::error::operation_aborted == errorCode ) || !pacingPendingV || ( generation != pacingGenerationV ) )
+  {
+    return;
+  }
+
+  pacingPendingV = false;
+  shaperV->delayedPacketSent();
+
+  // internal (timer) error occurred
   if ( errorCode )
   {
-    SPDLOG_ERROR( "Error when receiving message: {}", errorCode.message() );
+    SPDLOG_ERROR( "Timer error: {}", errorCode.message() );
 
     finished( TransferStatus::CommunicationError );
     return;
   }
 
-  // handle the received packet
-  packet( socket.remote_endpoint(), Helper::ConstRawDataSpan{ receivePacket.begin(), bytesTransferred } );
+  transmit();
+}
+
+void OperationImpl::waitReceive()
+{
+  socket.async_wait(
+    boost::asio::socket_base::wait_read,
+    std::bind_front( &OperationImpl::receiveHandler, this ) );
 }
 
-void OperationImpl::timeoutHandler( const boost::system::error_code& errorCode )
+void OperationImpl::receiveHandler( const boost::system::error_code &errorCode )
 {
-  // wait aborted (a packet has been received)
+  // operation has been aborted (maybe timeout)
+  // error is not handled here.
   if ( boost::asio::error::operation_aborted == errorCode )
   {
     return;
   }
 
-  // internal (timer) error occurred
+  // (internal) wait error occurred
   if ( errorCode )
   {
-    SPDLOG_ERROR( "Timer error: {}", errorCode.message() );
+    SPDLOG_ERROR( "Error when receiving message: {}", errorCode.message() );
 
     finished( TransferStatus::CommunicationError );
     return;
   }
 
+  // the socket is readable - receive into the buffer of this thread
+  const auto receiveBuffer{ ReceiveBuffer::instance() };
+  boost::system::error_code receiveErrorCode;
+  const auto bytesTransferred{ socket.receive(
+    boost::asio::buffer( receiveBuffer.data(), receiveBuffer.size() ),
+    0,
+    receiveErrorCode ) };
+
+  // (internal) receive error occurred
+  if ( receiveErrorCode )
+  {
+    SPDLOG_ERROR( "Error when receiving message: {}", receiveErrorCode.message() );
+
+    finished( TransferStatus::CommunicationError );
+    return;
+  }
+
+  const Helper::ConstRawDataSpan rawPacket{ receiveBuffer.first( bytesTransferred ) };
+  TraceRing::instance().record( TraceEvent::Receive, traceSessionV, rawPacket );
+  PacketCapture::instance().record(
+    CaptureRecord::Role::Server,
+    CaptureRecord::Direction::Receive,
+    traceSessionV,
+    remoteV,
+    rawPacket );
+
+  // handle the received packet
+  packet( socket.remote_endpoint(), rawPacket );
+}
+
+void OperationImpl::timeoutHandler()
+{
   // if maximum retries exceeded -> abort receive operation
   if ( transmitCounter > tftpRetriesV )
   {
     SPDLOG_ERROR( "TFTP Retry counter exceeded" );
 
+    TraceRing::instance().record( TraceEvent::Timeout, traceSessionV );
+
+    // large DATA packets may be dropped silently - fall back to a smaller block size for following transfers
+    // (not on an unanswered OACK, the DATA phase has not started)
+    if ( automaticBlockSizeV
+      && ( Packets::PacketType::OptionsAcknowledgement != Packets::Packet::packetType( transmitPacket ) ) )
+    {
+      PathMtu::instance().timeout( remoteV.address(), *automaticBlockSizeV );
+    }
+
     finished( TransferStatus::CommunicationError );
     return;
   }
 
-  SPDLOG_INFO(
+  SPDLOG_DEBUG(
     "Retransmit last TFTP packet: {}",
     Packets::PacketTypeDescription::instance().name( Packets::Packet::packetType( transmitPacket ) ) );
 
   try
   {
+    TraceRing::instance().record( TraceEvent::Retransmit, traceSessionV, transmitPacket );
+
     // Update statistic
     Packets::PacketStatistic::globalTransmit().packet(
       Packets::Packet::packetType( transmitPacket ),
       transmitPacket.size() );
 
-    socket.send( boost::asio::buffer( transmitPacket ) );
+    sendTransmitPacket();
 
     ++transmitCounter;
 
-    timer.expires_after( receiveTimeoutV );
-
-    timer.async_wait( std::bind_front( &OperationImpl::timeoutHandler, this ) );
+    timer.expiresAfter( receiveTimeoutV, [ this ]{ timeoutHandler(); } );
   }
   catch ( const boost::system::system_error &err )
   {
@@ -383,23 +684,8 @@ void OperationImpl::timeoutHandler( const boost::system::error_code& errorCode )
   }
 }
 
-void OperationImpl::timeoutDallyHandler( const boost::system::error_code &errorCode )
+void OperationImpl::timeoutDallyHandler()
 {
-  // operation aborted (packet received)
-  if ( boost::asio::error::operation_aborted == errorCode )
-  {
-    return;
-  }
-
-  // internal (timer) error occurred
-  if ( errorCode )
-  {
-    SPDLOG_ERROR( "Timer error: {}", errorCode.message() );
-
-    finished( TransferStatus::CommunicationError );
-    return;
-  }
-
   SPDLOG_INFO( "Dally Timeout Completed - Finish" );
 
   finished( TransferStatus::Successful );
@@ -15,15 +15,25 @@
 
 #include <tftp/servers/Servers.hpp>
 #include <tftp/servers/Operation.hpp>
+#include <tftp/servers/TuningConfiguration.hpp>
+
+#include <tftp/servers/implementation/AdmissionControl.hpp>
+#include <tftp/servers/implementation/SharedSocket.hpp>
+#include <tftp/servers/implementation/TransmitShaper.hpp>
 
 #include <tftp/packets/PacketHandler.hpp>
 
+#include <tftp/SocketBufferSizes.hpp>
+#include <tftp/TftpOptionsConfiguration.hpp>
+#include <tftp/TimerWheel.hpp>
+
 #include <boost/asio/ip/udp.hpp>
 #include <boost/asio/io_context.hpp>
-#include <boost/asio/system_timer.hpp>
+#include <boost/asio/steady_timer.hpp>
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace Tftp::Servers {
@@ -41,18 +51,50 @@ class OperationImpl : protected Packets::PacketHandler
      *
      * @param[in] ioContext
      *   I/O context used for communication.
+     * @param[in] session
+     *   Admission Control Session, which is held until the operation is finished.
+     * @param[in] shaper
+     *   Transmit Shaper used by sendPaced().
+     *   If not set, packets are not paced.
+     * @param[in] sharedSocket
+     *   Socket shared with other operations.
+     *   If not set, or the operation cannot be attached to it, a dedicated socket is used.
      **/
-    explicit OperationImpl( boost::asio::io_context &ioContext );
+    explicit OperationImpl(
+      boost::asio::io_context &ioContext,
+      AdmissionControl::Session session = {},
+      std::shared_ptr< TransmitShaper > shaper = {},
+      SharedSocketPtr sharedSocket = {} );
 
     /**
      * @brief Destructor.
      **/
     ~OperationImpl() override;
 
+    /**
+     * @brief Resets the Operation for Reuse by the OperationPool.
+     *
+     * Stops pending activities (without calling the completion handler) and restores the state of a newly
+     * constructed operation.
+     * The socket, the timers, and the allocated packet buffers are kept.
+     *
+     * @param[in] session
+     *   Admission Control Session, which is held until the operation is finished.
+     * @param[in] shaper
+     *   Transmit Shaper used by sendPaced().
+     * @param[in] sharedSocket
+     *   Socket shared with other operations.
+     **/
+    void reset(
+      AdmissionControl::Session session = {},
+      std::shared_ptr< TransmitShaper > shaper = {},
+      SharedSocketPtr sharedSocket = {} );
+
     /**
      * @brief Initialises the Operation
      *
-     * Setup the socket.
+     * Attaches the operation to the shared socket, if possible.
+     * Otherwise, opens, binds and connects a dedicated socket.
      **/
     void initialise();
 
@@ -100,6 +142,27 @@ class OperationImpl : protected Packets::PacketHandler
      **/
     void tftpRetries( uint16_t retries );
 
+    /**
+     * @brief Updates the Tuning Profile.
+     *
+     * The profile is applied on start and takes precedence over the TFTP timeout and the options configuration of
+     * the operation.
+     *
+     * @param[in] profile
+     *   Tuning profile matching the request.
+     **/
+    void tuningProfile( TuningConfiguration::Profile profile );
+
+    /**
+     * @brief Applies the Tuning Profile, if set.
+     *
+     * Must be called on start before the options are negotiated.
+     *
+     * @param[in,out] optionsConfiguration
+     *   TFTP Options Configuration of the operation, overridden by the profile.
+     **/
+    void applyTuningProfile( TftpOptionsConfiguration &optionsConfiguration );
+
     /**
      * @brief Updates the remote (client address)
      *
@@ -117,22 +180,20 @@ class OperationImpl : protected Packets::PacketHandler
     void local( boost::asio::ip::udp::endpoint local );
 
     /**
-     * @brief Updates the Operation Completed Handler
+     * @brief Updates the Socket Buffer Sizes.
      *
-     * @param[in] handler
-     *   Handler which is called on completion of the operation.
+     * @param[in] socketBufferSizes
+     *   Socket buffer sizes, applied when the socket is opened.
      **/
-    void completionHandler( OperationCompletedHandler handler );
+    void socketBufferSizes( SocketBufferSizes socketBufferSizes );
 
     /**
-     * @brief Updates the Maximum Receive Packet Size.
-     *
-     * This operation should be called if a block size option has been negotiated.
+     * @brief Updates the Operation Completed Handler
      *
-     * @param[in] maxReceivePacketSize
-     *   New max receive packet size.
+     * @param[in] handler
+     *   Handler which is called on completion of the operation.
      **/
-    void maxReceivePacketSize( uint16_t maxReceivePacketSize );
+    void completionHandler( OperationCompletedHandler handler );
 
     /**
      * @brief Update the Receive Timeout Value.
@@ -144,6 +205,28 @@ class OperationImpl : protected Packets::PacketHandler
      **/
     void receiveTimeout( std::chrono::seconds receiveTimeout ) noexcept;
 
+    /**
+     * @brief Negotiates the Block Size.
+     *
+     * The block size requested by the client is limited by TftpOptionsConfiguration::blockSizeOption.
+     * When TftpOptionsConfiguration::blockSizeAutomatic is set and the path MTU to the client is known, it is
+     * additionally limited to the largest block size fitting into the path MTU.
+     * When the operation fails by timeout in the DATA phase with an automatically limited block size, the path MTU
+     * of the client is lowered for following transfers (see PathMtu::timeout()).
+     *
+     * @param[in] optionsConfiguration
+     *   TFTP Options Configuration.
+     * @param[in] clientBlockSize
+     *   Block size requested by the client.
+     *
+     * @return Negotiated block size.
+     * @retval {}
+     *   If no block size is negotiated.
+     **/
+    [[nodiscard]] std::optional< uint16_t > negotiateBlockSize(
+      const TftpOptionsConfiguration &optionsConfiguration,
+      std::optional< uint16_t > clientBlockSize );
+
     /**
      * @brief Sends the given Packet to the %Client.
      *
@@ -154,6 +237,19 @@ class OperationImpl : protected Packets::PacketHandler
      **/
     void send( const Packets::Packet &packet );
 
+    /**
+     * @brief Sends the given Packet to the %Client, paced by the Transmit Shaper.
+     *
+     * When the shaper requests a delay, the packet is sent asynchronously after the delay.
+     * The receive timeout of the following receive() is extended by the delay.
+     *
+     * Without a shaper, this operation behaves like send().
+     *
+     * @param[in] packet
+     *   Packet, which is sent to the client.
+     **/
+    void sendPaced( const Packets::Packet &packet );
+
     /**
      * @brief Receives a packet and calls the packet handlers
      **/
@@ -229,39 +325,83 @@ class OperationImpl : protected Packets::PacketHandler
 
   private:
     /**
-     * @brief Handler, which is called when new data has been received.
+     * @brief Sends the encoded Packet via the shared or dedicated Socket.
      *
-     * @param[in] errorCode
-     *   Receive error code
-     * @param[in] bytesTransferred
-     *   Number of bytes transferred.
+     * @throw boost::system::system_error
+     *   On send error.
      **/
-    void receiveHandler( const boost::system::error_code &errorCode, std::size_t bytesTransferred );
+    void sendTransmitPacket();
 
     /**
-     * @brief Called when no data is received for the sent packet.
+     * @brief Handles a Packet received on the shared Socket.
      *
-     * If the retransmission counter has not exceeded, the last sent packet is retransmitted.
+     * @param[in] rawPacket
+     *   Received Packet.
+     **/
+    void sharedSocketPacket( Helper::ConstRawDataSpan rawPacket );
+
+    /**
+     * @brief Transmits the encoded Packet.
      *
+     * On error, the operation is finished.
+     **/
+    void transmit();
+
+    /**
+     * @brief Cancels a pending paced Packet.
+     *
+     * Handlers of the pacing timer, which are already queued, are neutralised by the pacing generation.
+     **/
+    void cancelPacing() noexcept;
+
+    /**
+     * @brief Called when the pacing delay of a packet has expired.
+     *
+     * Handlers of a cancelled pacing (operation finished or reset) are ignored, also when the timer has already
+     * expired.
+     *
+     * @param[in] generation
+     *   Pacing generation, when the timer has been started.
      * @param[in] errorCode
      *   error status of operation.
      **/
-    void timeoutHandler( const boost::system::error_code &errorCode );
+    void pacingHandler( uint32_t generation, const boost::system::error_code &errorCode );
 
     /**
-     * @brief Called when no data is received for the last sent ACK.
+     * @brief Waits until a Packet can be received from the dedicated Socket.
+     **/
+    void waitReceive();
+
+    /**
+     * @brief Handler, which is called when the dedicated Socket is readable.
      *
-     * The operation is finished successfully.
+     * The packet is received into the ReceiveBuffer of the current thread and handed to the packet handlers.
      *
      * @param[in] errorCode
-     *   error status of operation.
+     *   Wait error code
+     **/
+    void receiveHandler( const boost::system::error_code &errorCode );
+
+    /**
+     * @brief Called when no data is received for the sent packet.
+     *
+     * If the retransmission counter has not exceeded, the last sent packet is retransmitted.
+     **/
+    void timeoutHandler();
+
+    /**
+     * @brief Called when no data is received for the last sent ACK.
+     *
+     * The operation is finished successfully.
      **/
-    void timeoutDallyHandler( const boost::system::error_code &errorCode );
+    void timeoutDallyHandler();
 
     //! Receive timeout (can be updated by option negotiation)
     std::chrono::seconds receiveTimeoutV{ Tftp::DefaultTftpReceiveTimeout };
     //! TFTP Retries
     uint16_t tftpRetriesV{ Tftp::DefaultTftpRetries };
+    //! Tuning Profile applied on start
+    std::optional< TuningConfiguration::Profile > tuningProfileV;
 
     //! Handler which is called on completion of the operation.
     OperationCompletedHandler completionHandlerV;
@@ -269,20 +409,44 @@ class OperationImpl : protected Packets::PacketHandler
     boost::asio::ip::udp::endpoint remoteV;
     //! Local address, where the server handles the request from.
     boost::asio::ip::udp::endpoint localV;
+    //! Socket Buffer Sizes
+    SocketBufferSizes socketBufferSizesV;
 
     //! TFTP UDP Socket
     boost::asio::ip::udp::socket socket;
-    //! Receive timeout timer
-    boost::asio::system_timer timer;
+    //! Receive timeout timer (registered with the timer wheel of the I/O context)
+    TimerWheel::Timer timer;
 
-    //! Received Packet Data
-    Helper::RawData receivePacket;
     //! Last transmitted Packet (used for retries)
     Helper::RawData transmitPacket;
     //! Re-transmission counter
     unsigned int transmitCounter{ 0U };
     //! Error info
     Packets::ErrorInformation errorInformationV;
+    //! Admission Control Session
+    AdmissionControl::Session sessionV;
+    //! Trace Session Identifier (assigned on initialisation)
+    uint32_t traceSessionV{ 0U };
+    //! Negotiated, automatically limited Block Size
+    std::optional< uint16_t > automaticBlockSizeV;
+
+    //! Transmit Shaper
+    std::shared_ptr< TransmitShaper > shaperV;
+    //! Shaping state of this operation
+    TransmitShaper::SessionState shapingStateV;
+    //! Pacing timer
+    boost::asio::steady_timer pacingTimer;
+    //! Delay of the last paced packet (extends the next receive timeout)
+    TransmitShaper::Clock::duration pacingDelayV{};
+    //! Set while a paced packet waits for transmission
+    bool pacingPendingV{ false };
+    //! Pacing generation (incremented on every paced packet and cancellation)
+    uint32_t pacingGenerationV{ 0U };
+
+    //! Shared Socket
+    SharedSocketPtr sharedSocketV;
+    //! Set, when the operation is attached to the shared socket
+    bool attachedV{ false };
 };
 
 }
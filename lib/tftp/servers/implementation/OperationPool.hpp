@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration and Definition of Class Template Tftp::Servers::OperationPool.
+ **/
+
+#ifndef TFTP_SERVERS_OPERATIONPOOL_HPP
+#define TFTP_SERVERS_OPERATIONPOOL_HPP
+
+#include <tftp/servers/Servers.hpp>
+#include <tftp/servers/OperationPoolStatistic.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief Recycling Pool of TFTP %Server Operations.
+ *
+ * Hands out operations of type @p OperationT as `std::shared_ptr`.
+ * When the last reference of an operation is released, the operation is returned to the pool instead of being
+ * destroyed - as long as the pool capacity is not exceeded.
+ * Recycled operations keep their socket, timers and allocated packet buffers.
+ * On release, the operation is reset by `OperationT::reset()`, which stops pending activities and releases the
+ * references held by the operation (handlers, admission session, shared socket).
+ * On reuse, the operation is reset by `OperationT::reset( args... )` to the state of a newly constructed operation.
+ * Otherwise, the operation is constructed by `OperationT( ioContext, args... )`.
+ *
+ * Operations may outlive the pool.
+ * Such operations are destroyed on release.
+ *
+ * The pool may be used from different threads.
+ *
+ * @tparam OperationT
+ *   Operation Type.
+ **/
+template< typename OperationT >
+class OperationPool final
+{
+  public:
+    /**
+     * @brief Creates the Operation Pool.
+     *
+     * @param[in] ioContext
+     *   I/O context used for the created operations.
+     **/
+    explicit OperationPool( boost::asio::io_context &ioContext ) :
+      ioContextV{ ioContext },
+      stateV{ std::make_shared< State >() }
+    {
+    }
+
+    /**
+     * @brief Updates the Pool Capacity.
+     *
+     * Superfluous available operations are destroyed.
+     * A capacity of `0` disables pooling.
+     *
+     * @param[in] capacity
+     *   Maximum number of available operations held by the pool.
+     **/
+    void capacity( const std::size_t capacity )
+    {
+      const std::scoped_lock lock{ stateV->mutex };
+      stateV->capacity = capacity;
+
+      if ( stateV->available.size() > capacity )
+      {
+        stateV->available.resize( capacity );
+      }
+    }
+
+    /**
+     * @brief Pre-constructs Operations up to the Pool Capacity.
+     *
+     * Called on server start, so the first requests are served without allocation.
+     **/
+    void fill()
+    {
+      const std::scoped_lock lock{ stateV->mutex };
+
+      stateV->available.reserve( stateV->capacity );
+      while ( stateV->available.size() < stateV->capacity )
+      {
+        stateV->available.emplace_back( std::make_unique< OperationT >( ioContextV ) );
+      }
+    }
+
+    /**
+     * @brief Returns an Operation.
+     *
+     * The operation is taken from the pool and reset, or newly constructed when the pool is empty.
+     *
+     * @tparam Args
+     *   Operation argument types.
+     * @param[in] args
+     *   Operation arguments (without I/O context).
+     *
+     * @return Operation, which is returned to the pool on release.
+     **/
+    template< typename... Args >
+    [[nodiscard]] std::shared_ptr< OperationT > acquire( Args &&...args )
+    {
+      std::unique_ptr< OperationT > operation;
+
+      {
+        const std::scoped_lock lock{ stateV->mutex };
+
+        if ( 0U == stateV->capacity )
+        {
+          ++stateV->statistic.misses;
+          return std::make_shared< OperationT >( ioContextV, std::forward< Args >( args )... );
+        }
+
+        if ( stateV->available.empty() )
+        {
+          ++stateV->statistic.misses;
+        }
+        else
+        {
+          ++stateV->statistic.hits;
+          operation = std::move( stateV->available.back() );
+          stateV->available.pop_back();
+        }
+      }
+
+      if ( operation )
+      {
+        operation->reset( std::forward< Args >( args )... );
+      }
+      else
+      {
+        operation = std::make_unique< OperationT >( ioContextV, std::forward< Args >( args )... );
+      }
+
+      return { operation.release(), Recycler{ stateV } };
+    }
+
+    /**
+     * @brief Returns the Pool Statistic.
+     *
+     * @return Operation Pool Statistic.
+     **/
+    [[nodiscard]] OperationPoolStatistic statistic() const
+    {
+      const std::scoped_lock lock{ stateV->mutex };
+      auto statistic{ stateV->statistic };
+      statistic.available = stateV->available.size();
+      return statistic;
+    }
+
+  private:
+    //! Pool State (shared with the handed out operations)
+    struct State
+    {
+      //! Mutex protecting the state
+      std::mutex mutex;
+      //! Maximum Number of available Operations
+      std::size_t capacity{ 0U };
+      //! Available Operations
+      std::vector< std::unique_ptr< OperationT > > available;
+      //! Statistic
+      OperationPoolStatistic statistic;
+    };
+
+    //! Deleter, which returns the released Operation to the Pool.
+    class Recycler
+    {
+      public:
+        /**
+         * @brief Creates the Recycler.
+         *
+         * @param[in] state
+         *   Pool State.
+         **/
+        explicit Recycler( std::weak_ptr< State > state ) noexcept :
+          stateV{ std::move( state ) }
+        {
+        }
+
+        /**
+         * @brief Returns the Operation to the Pool or destroys it.
+         *
+         * The operation is reset before it is returned to the pool.
+         *
+         * @param[in] operation
+         *   Released Operation.
+         **/
+        void operator()( OperationT * const operation ) const
+        {
+          std::unique_ptr< OperationT > ownedOperation{ operation };
+
+          const auto state{ stateV.lock() };
+          if ( !state )
+          {
+            return;
+          }
+
+          // stop the operation and release its references outside the lock
+          ownedOperation->reset();
+
+          const std::scoped_lock lock{ state->mutex };
+
+          if ( state->available.size() >= state->capacity )
+          {
+            ++state->statistic.discarded;
+            return;
+          }
+
+          ++state->statistic.recycled;
+          state->available.emplace_back( std::move( ownedOperation ) );
+        }
+
+      private:
+        //! Pool State
+        std::weak_ptr< State > stateV;
+    };
+
+    //! I/O context
+    boost::asio::io_context &ioContextV;
+    //! Pool State
+    std::shared_ptr< State > stateV;
+};
+
+}
+
+#endif
@@ -20,20 +20,43 @@
 #include <tftp/TransmitDataHandler.hpp>
 
 #include <helper/Exception.hpp>
+#include <helper/RawData.hpp>
 
 #include <spdlog/spdlog.h>
 
 #include <boost/exception/all.hpp>
 
+#include <exception>
 #include <utility>
 
 namespace Tftp::Servers {
 
-ReadOperationImpl::ReadOperationImpl( boost::asio::io_context &ioContext ) :
-  OperationImpl{ ioContext }
+ReadOperationImpl::ReadOperationImpl(
+  boost::asio::io_context &ioContext,
+  AdmissionControl::Session session,
+  std::shared_ptr< TransmitShaper > shaper,
+  SharedSocketPtr sharedSocket ) :
+  OperationImpl{ ioContext, std::move( session ), std::move( shaper ), std::move( sharedSocket ) }
 {
 }
 
+void ReadOperationImpl::reset(
+  AdmissionControl::Session session,
+  std::shared_ptr< TransmitShaper > shaper,
+  SharedSocketPtr sharedSocket )
+{
+  OperationImpl::reset( std::move( session ), std::move( shaper ), std::move( sharedSocket ) );
+
+  optionsConfigurationV = {};
+  dataHandlerV.reset();
+  clientOptionsV = {};
+  additionalNegotiatedOptionsV.clear();
+  transmitDataSize = Packets::DefaultDataSize;
+  lastDataPacketTransmitted = false;
+  lastTransmittedBlockNumber = Packets::BlockNumber{ 0U };
+  lastReceivedBlockNumber = Packets::BlockNumber{ 0U };
+}
+
 ReadOperation& ReadOperationImpl::tftpTimeout(
   const std::chrono::seconds timeout )
 {
@@ -47,6 +70,11 @@ ReadOperation& ReadOperationImpl::tftpRetries( const uint16_t retries )
   return *this;
 }
 
+void ReadOperationImpl::tuningProfile( TuningConfiguration::Profile profile )
+{
+  OperationImpl::tuningProfile( std::move( profile ) );
+}
+
 ReadOperation& ReadOperationImpl::optionsConfiguration( TftpOptionsConfiguration optionsConfiguration )
 {
   optionsConfigurationV = std::move( optionsConfiguration );
@@ -77,6 +105,12 @@ ReadOperation& ReadOperationImpl::local( boost::asio::ip::udp::endpoint local )
   return *this;
 }
 
+ReadOperation& ReadOperationImpl::socketBufferSizes( SocketBufferSizes socketBufferSizes )
+{
+  OperationImpl::socketBufferSizes( std::move( socketBufferSizes ) );
+  return *this;
+}
+
 ReadOperation& ReadOperationImpl::clientOptions( Packets::TftpOptions clientOptions )
 {
   clientOptionsV = std::move( clientOptions );
@@ -98,6 +132,9 @@ void ReadOperationImpl::start()
       << TransferPhaseInfo{ TransferPhase::Initialisation } );
   }
 
+  // the tuning profile overrides the configuration of the operation
+  applyTuningProfile( optionsConfigurationV );
+
   try
   {
     // initialise socket
@@ -110,7 +147,10 @@ void ReadOperationImpl::start()
     if ( !clientOptionsV && additionalNegotiatedOptionsV.empty() )
     {
       // Then no OACK is sent back - data is sent immediately
-      sendData();
+      if ( !sendData() )
+      {
+        return;
+      }
     }
     else
     {
@@ -118,9 +158,9 @@ void ReadOperationImpl::start()
       Packets::Options serverOptions{ additionalNegotiatedOptionsV };
 
       // check for the block size option - if set, use it
-      if ( optionsConfigurationV.blockSizeOption && clientOptionsV.blockSize )
+      if ( const auto blockSize{ negotiateBlockSize( optionsConfigurationV, clientOptionsV.blockSize ) }; blockSize )
       {
-        transmitDataSize = std::min( *clientOptionsV.blockSize, *optionsConfigurationV.blockSizeOption );
+        transmitDataSize = *blockSize;
 
         // respond option string
         serverOptions.try_emplace(
@@ -178,7 +218,10 @@ void ReadOperationImpl::start()
       else
       {
         // directly send data
-        sendData();
+        if ( !sendData() )
+        {
+          return;
+        }
       }
     }
 
@@ -219,21 +262,40 @@ void ReadOperationImpl::finished( const TransferStatus status, Packets::ErrorInf
   OperationImpl::finished( status, std::move( errorInformation ) );
 }
 
-void ReadOperationImpl::sendData()
+bool ReadOperationImpl::sendData()
 {
+  Helper::RawData buffer;
+
+  try
+  {
+    buffer = dataHandlerV->sendData( transmitDataSize );
+  }
+  catch ( const std::exception &e )
+  {
+    SPDLOG_ERROR( "Error reading data: {}", e.what() );
+
+    const Packets::ErrorPacket errorPacket{ Packets::ErrorCode::NotDefined, "Error reading data" };
+    send( errorPacket );
+
+    // Operation completed
+    finished( TransferStatus::TransferError, errorPacket.errorInformation() );
+    return false;
+  }
+
   ++lastTransmittedBlockNumber;
 
   SPDLOG_TRACE( "Send Data #{}", static_cast< uint16_t >( lastTransmittedBlockNumber ) );
 
-  const Packets::DataPacket data{ lastTransmittedBlockNumber, dataHandlerV->sendData( transmitDataSize ) };
+  const Packets::DataPacket data{ lastTransmittedBlockNumber, std::move( buffer ) };
 
   if ( data.dataSize() < transmitDataSize )
   {
     lastDataPacketTransmitted = true;
   }
 
-  // send data packet
-  send( data );
+  // send data packet (paced by the transmit shaper)
+  sendPaced( data );
+  return true;
 }
 
 void ReadOperationImpl::dataPacket(
@@ -258,7 +320,7 @@ void ReadOperationImpl::acknowledgementPacket(
   // check retransmission
   if ( acknowledgementPacket.blockNumber() == lastReceivedBlockNumber )
   {
-    SPDLOG_WARN(
+    SPDLOG_DEBUG(
       "Received previous ACK packet: retry of last data package - "
       "IGNORE it due to Sorcerer's Apprentice Syndrome" );
 
@@ -295,7 +357,10 @@ void ReadOperationImpl::acknowledgementPacket(
   }
 
   // send data
-  sendData();
+  if ( !sendData() )
+  {
+    return;
+  }
 
   // receive the next packet
   receive();
@@ -27,6 +27,7 @@
 #include <boost/asio/io_context.hpp>
 
 #include <chrono>
+#include <memory>
 #include <string>
 
 namespace Tftp::Servers {
@@ -47,18 +48,46 @@ class ReadOperationImpl final : public ReadOperation, private OperationImpl
      *
      * @param[in] ioContext
      *   I/O context used for communication.
+     * @param[in] session
+     *   Admission Control Session, which is held until the operation is finished.
+     * @param[in] shaper
+     *   Transmit Shaper, which paces the DATA packets.
+     * @param[in] sharedSocket
+     *   Socket shared with other operations.
      **/
-    explicit ReadOperationImpl( boost::asio::io_context &ioContext );
+    explicit ReadOperationImpl(
+      boost::asio::io_context &ioContext,
+      AdmissionControl::Session session = {},
+      std::shared_ptr< TransmitShaper > shaper = {},
+      SharedSocketPtr sharedSocket = {} );
 
     //! Destructor.
     ~ReadOperationImpl() override = default;
 
+    /**
+     * @brief Resets the Operation for Reuse by the OperationPool.
+     *
+     * @param[in] session
+     *   Admission Control Session, which is held until the operation is finished.
+     * @param[in] shaper
+     *   Transmit Shaper, which paces the DATA packets.
+     * @param[in] sharedSocket
+     *   Socket shared with other operations.
+     **/
+    void reset(
+      AdmissionControl::Session session = {},
+      std::shared_ptr< TransmitShaper > shaper = {},
+      SharedSocketPtr sharedSocket = {} );
+
     //! @copydoc ReadOperation::tftpTimeout()
     ReadOperation& tftpTimeout( std::chrono::seconds timeout ) override;
 
     //! @copydoc ReadOperation::tftpRetries()
     ReadOperation& tftpRetries( uint16_t retries ) override;
 
+    //! @copydoc OperationImpl::tuningProfile()
+    void tuningProfile( TuningConfiguration::Profile profile );
+
     //! @copydoc ReadOperation::optionsConfiguration()
     ReadOperation& optionsConfiguration( TftpOptionsConfiguration optionsConfiguration ) override;
 
@@ -74,6 +103,9 @@ class ReadOperationImpl final : public ReadOperation, private OperationImpl
     //! @copydoc ReadOperation::local()
     ReadOperation& local( boost::asio::ip::udp::endpoint local ) override;
 
+    //! @copydoc ReadOperation::socketBufferSizes()
+    ReadOperation& socketBufferSizes( SocketBufferSizes socketBufferSizes ) override;
+
     //! @copydoc ReadOperation::clientOptions()
     ReadOperation& clientOptions( Packets::TftpOptions clientOptions ) override;
 
@@ -101,8 +133,12 @@ class ReadOperationImpl final : public ReadOperation, private OperationImpl
      *
      * The Data packet is assembled by calling the registered handler operation TftpWriteOperationHandler::sendData().
      * If the last data packet is sent, the internal flag will be set appropriately.
+     *
+     * When the handler fails to provide the data, an error is sent back and the operation is finished.
+     *
+     * @return If the data packet has been sent.
      **/
-    void sendData();
+    [[nodiscard]] bool sendData();
 
     /**
      * @copydoc Packets::PacketHandler::dataPacket
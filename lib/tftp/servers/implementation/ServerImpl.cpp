@@ -12,18 +12,19 @@
 
 #include "ServerImpl.hpp"
 
-#include <tftp/servers/implementation/ReadOperationImpl.hpp>
-#include <tftp/servers/implementation/WriteOperationImpl.hpp>
-
 #include <tftp/packets/AcknowledgementPacket.hpp>
 #include <tftp/packets/DataPacket.hpp>
+#include <tftp/packets/ErrorPacket.hpp>
 #include <tftp/packets/Options.hpp>
 #include <tftp/packets/OptionsAcknowledgementPacket.hpp>
 #include <tftp/packets/PacketStatistic.hpp>
 #include <tftp/packets/ReadRequestPacket.hpp>
+#include <tftp/packets/ReadWriteRequestPacketView.hpp>
 #include <tftp/packets/WriteRequestPacket.hpp>
 
+#include <tftp/PacketCapture.hpp>
 #include <tftp/TftpException.hpp>
+#include <tftp/TraceRing.hpp>
 
 #include <helper/Exception.hpp>
 
@@ -33,13 +34,52 @@
 
 #include <boost/bind/bind.hpp>
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <string_view>
+#include <utility>
+
 namespace Tftp::Servers {
 
+namespace {
+
+//! Error Code and Message of the Server Error Responses (indexed by ServerImpl::ServerError)
+constexpr std::array< std::pair< Packets::ErrorCode, std::string_view >, 6U > ServerErrors{ {
+  { Packets::ErrorCode::FileNotFound, "Request isn't accepted" },
+  { Packets::ErrorCode::NotDefined, "Too many requests" },
+  { Packets::ErrorCode::IllegalTftpOperation, "DATA packet isn't expected" },
+  { Packets::ErrorCode::IllegalTftpOperation, "ACK packet isn't expected" },
+  { Packets::ErrorCode::IllegalTftpOperation, "ERR packet isn't expected" },
+  { Packets::ErrorCode::IllegalTftpOperation, "OACK packet isn't expected" } } };
+
+}
+
 ServerImpl::ServerImpl( boost::asio::io_context &ioContext ) :
+  admissionControlV{ std::make_shared< AdmissionControl >() },
+  transmitShaperV{ std::make_shared< TransmitShaper >() },
   ioContextV{ ioContext },
   socketV{ ioContextV },
-  receivePacketV( Packets::DefaultMaxPacketSize )
+  readOperationPoolV{ ioContextV },
+  writeOperationPoolV{ ioContextV },
+  receivePacketV( std::numeric_limits< uint16_t >::max() )
 {
+  static_assert( ServerErrors.size() == static_cast< std::size_t >( ServerError::Count ) );
+
+  std::ranges::transform(
+    ServerErrors,
+    serverErrorPacketsV.begin(),
+    []( const auto &serverError )
+    {
+      return static_cast< Helper::RawData >(
+        Packets::ErrorPacket{ serverError.first, std::string{ serverError.second } } );
+    } );
+
+  for ( std::size_t errorCode{ 0U }; errorCode < errorCodePacketsV.size(); ++errorCode )
+  {
+    errorCodePacketsV[ errorCode ] = static_cast< Helper::RawData >(
+      Packets::ErrorPacket{ static_cast< Packets::ErrorCode >( errorCode ) } );
+  }
 }
 
 ServerImpl::~ServerImpl() = default;
@@ -56,6 +96,42 @@ Server& ServerImpl::serverAddress( boost::asio::ip::udp::endpoint serverAddress
   return *this;
 }
 
+Server& ServerImpl::admissionConfiguration( AdmissionConfiguration admissionConfiguration )
+{
+  rejectSilentlyV = admissionConfiguration.rejectSilently;
+  admissionControlV->configuration( std::move( admissionConfiguration ) );
+  return *this;
+}
+
+AdmissionStatistic ServerImpl::admissionStatistic() const
+{
+  return admissionControlV->statistic();
+}
+
+Server& ServerImpl::shapingConfiguration( ShapingConfiguration shapingConfiguration )
+{
+  transmitShaperV->configuration( std::move( shapingConfiguration ) );
+  return *this;
+}
+
+ShapingStatistic ServerImpl::shapingStatistic() const
+{
+  return transmitShaperV->statistic();
+}
+
+Server& ServerImpl::tuningConfiguration( TuningConfiguration tuningConfiguration )
+{
+  tuningProfilesV.configuration( std::move( tuningConfiguration ) );
+  return *this;
+}
+
+OperationPoolStatistic ServerImpl::operationPoolStatistic() const
+{
+  auto statistic{ readOperationPoolV.statistic() };
+  statistic += writeOperationPoolV.statistic();
+  return statistic;
+}
+
 boost::asio::ip::udp::endpoint ServerImpl::localEndpoint() const
 {
   return socketV.local_endpoint();
@@ -91,6 +167,25 @@ Server& ServerImpl::localDefault( boost::asio::ip::address local )
   return *this;
 }
 
+Server& ServerImpl::sharedSockets( const std::size_t sharedSockets )
+{
+  sharedSocketsCountV = sharedSockets;
+  return *this;
+}
+
+Server& ServerImpl::socketBufferSizes( SocketBufferSizes socketBufferSizes )
+{
+  socketBufferSizesV = std::move( socketBufferSizes );
+  return *this;
+}
+
+Server& ServerImpl::operationPoolSize( const std::size_t operationPoolSize )
+{
+  readOperationPoolV.capacity( operationPoolSize );
+  writeOperationPoolV.capacity( operationPoolSize );
+  return *this;
+}
+
 void ServerImpl::start()
 {
   SPDLOG_INFO( "Start TFTP Server on {}:{}", serverAddressV.address().to_string(), serverAddressV.port() );
@@ -98,8 +193,23 @@ void ServerImpl::start()
   try
   {
     socketV.open( serverAddressV.protocol() );
+    socketBufferSizesV.apply( socketV );
     socketV.bind( serverAddressV );
 
+    // open shared sockets with ephemeral ports
+    const boost::asio::ip::udp::endpoint sharedLocal{
+      localV.is_unspecified() ? serverAddressV.address() : localV,
+      0U };
+
+    for ( std::size_t socket{ 0U }; socket < sharedSocketsCountV; ++socket )
+    {
+      sharedSocketsV.emplace_back( std::make_shared< SharedSocket >( ioContextV, sharedLocal, socketBufferSizesV ) );
+    }
+
+    // pre-construct pooled operations
+    readOperationPoolV.fill();
+    writeOperationPoolV.fill();
+
     // start receive
     receive();
   }
@@ -111,6 +221,8 @@ void ServerImpl::start()
       socketV.close();
     }
 
+    sharedSocketsV.clear();
+
     BOOST_THROW_EXCEPTION( CommunicationException{}
       << Helper::AdditionalInfo{ err.what() }
       << TransferPhaseInfo{ TransferPhase::Initialisation } );
@@ -123,11 +235,41 @@ void ServerImpl::stop()
 
   socketV.cancel();
   socketV.close();
+
+  // active operations keep their shared socket
+  sharedSocketsV.clear();
 }
 
 ReadOperationPtr ServerImpl::readOperation()
 {
-  auto operation{ std::make_shared< ReadOperationImpl >( ioContextV ) };
+  return readOperation( nullptr );
+}
+
+ReadOperationPtr ServerImpl::readOperation(
+  const boost::asio::ip::address &remote,
+  const std::string_view filename )
+{
+  return readOperation( tuningProfile( remote, filename ) );
+}
+
+WriteOperationPtr ServerImpl::writeOperation()
+{
+  return writeOperation( nullptr );
+}
+
+WriteOperationPtr ServerImpl::writeOperation(
+  const boost::asio::ip::address &remote,
+  const std::string_view filename )
+{
+  return writeOperation( tuningProfile( remote, filename ) );
+}
+
+ReadOperationPtr ServerImpl::readOperation( const TuningConfiguration::Profile * const profile )
+{
+  auto operation{ readOperationPoolV.acquire(
+    AdmissionControl::Session{ admissionControlV },
+    transmitShaperV,
+    sharedSocket() ) };
 
   if ( tftpTimeoutDefaultV )
   {
@@ -144,17 +286,26 @@ ReadOperationPtr ServerImpl::readOperation()
     operation->optionsConfiguration( *optionsConfigurationDefaultV );
   }
 
+  if ( nullptr != profile )
+  {
+    operation->tuningProfile( *profile );
+  }
+
   if ( !localV.is_unspecified() )
   {
     operation->local( { localV, 0 } );
   }
 
+  operation->socketBufferSizes( socketBufferSizesV );
+
   return operation;
 }
 
-WriteOperationPtr ServerImpl::writeOperation()
+WriteOperationPtr ServerImpl::writeOperation( const TuningConfiguration::Profile * const profile )
 {
-  auto operation{ std::make_shared< WriteOperationImpl >( ioContextV ) };
+  auto operation{ writeOperationPoolV.acquire(
+    AdmissionControl::Session{ admissionControlV },
+    sharedSocket() ) };
 
   if ( tftpTimeoutDefaultV )
   {
@@ -176,11 +327,18 @@ WriteOperationPtr ServerImpl::writeOperation()
     operation->optionsConfiguration( *optionsConfigurationDefaultV );
   }
 
+  if ( nullptr != profile )
+  {
+    operation->tuningProfile( *profile );
+  }
+
   if ( !localV.is_unspecified() )
   {
     operation->local( { localV, 0 } );
   }
 
+  operation->socketBufferSizes( socketBufferSizesV );
+
   return operation;
 }
 
@@ -189,28 +347,45 @@ void ServerImpl::errorOperation(
   const Packets::ErrorCode errorCode,
   std::string errorMessage )
 {
-  const Packets::ErrorPacket errorPacket{ errorCode, std::move( errorMessage ) };
-
-  SPDLOG_INFO( "TX: {}", static_cast< std::string>( errorPacket ) );
+  SPDLOG_DEBUG( "TX: ERR: EC: {} - DESC: \"{}\"", static_cast< uint16_t >( errorCode ), errorMessage );
 
-  try
+  // requests are typically rejected by error code only
+  if ( const auto index{ static_cast< std::size_t >( errorCode ) };
+    errorMessage.empty() && ( index < errorCodePacketsV.size() ) )
   {
-    boost::asio::ip::udp::socket errSocket{ ioContextV };
+    errorOperation( remote, errorCodePacketsV[ index ] );
+    return;
+  }
 
-    errSocket.open( remote.protocol() );
+  errorOperation(
+    remote,
+    static_cast< Helper::RawData >( Packets::ErrorPacket{ errorCode, std::move( errorMessage ) } ) );
+}
 
-    errSocket.connect( remote );
+void ServerImpl::serverErrorOperation( const boost::asio::ip::udp::endpoint &remote, const ServerError serverError )
+{
+  const auto index{ static_cast< std::size_t >( serverError ) };
 
-    auto rawPacket{ static_cast< Helper::RawData >( errorPacket ) };
+  SPDLOG_DEBUG(
+    "TX: ERR: EC: {} - DESC: \"{}\"",
+    static_cast< uint16_t >( ServerErrors[ index ].first ),
+    ServerErrors[ index ].second );
 
-    // Update statistic
-    Packets::PacketStatistic::globalTransmit().packet( errorPacket.packetType(), rawPacket.size() );
+  errorOperation( remote, serverErrorPacketsV[ index ] );
+}
 
-    errSocket.send( boost::asio::buffer( rawPacket ) );
+void ServerImpl::errorOperation(
+  const boost::asio::ip::udp::endpoint &remote,
+  const Helper::ConstRawDataSpan rawPacket )
+{
+  // use listening socket, if possible
+  if ( socketV.is_open() && ( serverAddressV.protocol() == remote.protocol() ) )
+  {
+    sendErrorPacket( remote, rawPacket );
   }
-  catch ( const boost::system::system_error &err )
+  else
   {
-    SPDLOG_ERROR( err.what() );
+    sendErrorPacket( remote, std::nullopt, rawPacket );
   }
 }
 
@@ -220,26 +395,62 @@ void ServerImpl::errorOperation(
   const Packets::ErrorCode errorCode,
   std::string errorMessage )
 {
-  const Packets::ErrorPacket errorPacket{ errorCode, std::move( errorMessage ) };
+  SPDLOG_DEBUG( "TX: ERR: EC: {} - DESC: \"{}\"", static_cast< uint16_t >( errorCode ), errorMessage );
 
-  SPDLOG_INFO( "TX: {}", static_cast< std::string >( errorPacket ) );
+  const auto rawPacket{
+    static_cast< Helper::RawData >( Packets::ErrorPacket{ errorCode, std::move( errorMessage ) } ) };
 
+  // use listening socket, if it is bound to the requested local endpoint
+  if ( socketV.is_open() && ( serverAddressV == local ) )
+  {
+    sendErrorPacket( remote, rawPacket );
+  }
+  else
+  {
+    sendErrorPacket( remote, local, rawPacket );
+  }
+}
+
+void ServerImpl::sendErrorPacket(
+  const boost::asio::ip::udp::endpoint &remote,
+  const Helper::ConstRawDataSpan rawPacket )
+{
+  boost::system::error_code errorCode;
+
+  socketV.send_to( boost::asio::buffer( rawPacket.data(), rawPacket.size() ), remote, 0, errorCode );
+
+  if ( errorCode )
+  {
+    SPDLOG_ERROR( "Error sending ERR packet: {}", errorCode.message() );
+    return;
+  }
+
+  // Update statistic
+  Packets::PacketStatistic::globalTransmit().packet( Packets::PacketType::Error, rawPacket.size() );
+}
+
+void ServerImpl::sendErrorPacket(
+  const boost::asio::ip::udp::endpoint &remote,
+  const std::optional< boost::asio::ip::udp::endpoint > &local,
+  const Helper::ConstRawDataSpan rawPacket )
+{
   try
   {
     boost::asio::ip::udp::socket errSocket{ ioContextV };
 
     errSocket.open( remote.protocol() );
 
-    errSocket.bind( local );
+    if ( local )
+    {
+      errSocket.bind( *local );
+    }
 
     errSocket.connect( remote );
 
-    auto rawPacket{ static_cast< Helper::RawData >( errorPacket ) };
-
     // Update statistic
-    Packets::PacketStatistic::globalTransmit().packet( errorPacket.packetType(), rawPacket.size() );
+    Packets::PacketStatistic::globalTransmit().packet( Packets::PacketType::Error, rawPacket.size() );
 
-    errSocket.send( boost::asio::buffer( rawPacket ) );
+    errSocket.send( boost::asio::buffer( rawPacket.data(), rawPacket.size() ) );
   }
   catch ( const boost::system::system_error &err )
   {
@@ -247,6 +458,35 @@ void ServerImpl::errorOperation(
   }
 }
 
+const TuningConfiguration::Profile * ServerImpl::tuningProfile(
+  const boost::asio::ip::address &remote,
+  const std::string_view filename ) const
+{
+  const auto profile{ tuningProfilesV.match( remote, filename ) };
+
+  if ( nullptr != profile )
+  {
+    SPDLOG_DEBUG( "Request from {} tuned by profile \"{}\"", remote.to_string(), profile->toString() );
+  }
+
+  return profile;
+}
+
+SharedSocketPtr ServerImpl::sharedSocket() const
+{
+  const auto sharedSocket{ std::ranges::min_element(
+    sharedSocketsV,
+    {},
+    []( const auto &socket ){ return socket->size(); } ) };
+
+  if ( sharedSocket == sharedSocketsV.end() )
+  {
+    return {};
+  }
+
+  return *sharedSocket;
+}
+
 void ServerImpl::receive()
 {
   try
@@ -283,8 +523,21 @@ void ServerImpl::receiveHandler( const boost::system::error_code &errorCode, con
 
   try
   {
-    // handle the received packet (decode it and call the appropriate handler)
-    packet( remoteEndpointV, Helper::ConstRawDataSpan{ receivePacketV.begin(), bytesTransferred } );
+    const Helper::ConstRawDataSpan rawPacket{ receivePacketV.begin(), bytesTransferred };
+
+    switch ( Packets::Packet::packetType( rawPacket ) )
+    {
+      case Packets::PacketType::ReadRequest:
+      case Packets::PacketType::WriteRequest:
+        // requests are validated without decoding them into owned packets
+        requestPacket( remoteEndpointV, rawPacket );
+        break;
+
+      default:
+        // handle the received packet (decode it and call the appropriate handler)
+        packet( remoteEndpointV, rawPacket );
+        break;
+    }
   }
   catch ( const TftpException &e )
   {
@@ -294,40 +547,35 @@ void ServerImpl::receiveHandler( const boost::system::error_code &errorCode, con
   receive();
 }
 
-void ServerImpl::readRequestPacket(
+void ServerImpl::requestPacket(
   const boost::asio::ip::udp::endpoint &remote,
-  const Packets::ReadRequestPacket &readRequestPacket )
+  const Helper::ConstRawDataSpan rawPacket )
 {
-  SPDLOG_TRACE( "RX: {}", static_cast< std::string>( readRequestPacket ) );
+  const Packets::ReadWriteRequestPacketView request{ rawPacket };
 
-  // check handler
-  if ( !requestHandlerV )
+  if ( !request )
   {
-    SPDLOG_WARN( "No registered handler - reject" );
+    SPDLOG_ERROR( "Error decoding RRQ/WRQ packet" );
 
-    // execute error operation
-    errorOperation( remote, Packets::ErrorCode::FileNotFound, "RRQ packet isn't accepted" );
+    // Update statistic
+    Packets::PacketStatistic::globalReceive().packet( Packets::PacketType::Invalid, rawPacket.size() );
+
+    invalidPacket( remote, rawPacket );
+    return;
   }
 
-  // extract known TFTP Options
-  auto receivedOptions{ readRequestPacket.options() };
-  const auto decodedOptions{ tftpOptions( receivedOptions ) };
+  // Update statistic
+  Packets::PacketStatistic::globalReceive().packet( request.packetType(), rawPacket.size() );
 
-  // call the handler, which handles the received request
-  requestHandlerV(
+  TraceRing::instance().record( TraceEvent::Request, 0U, rawPacket );
+  PacketCapture::instance().record(
+    CaptureRecord::Role::Server,
+    CaptureRecord::Direction::Receive,
+    0U,
     remote,
-    RequestType::Read,
-    readRequestPacket.filename(),
-    readRequestPacket.mode(),
-    decodedOptions,
-    receivedOptions );
-}
+    rawPacket );
 
-void ServerImpl::writeRequestPacket(
-  const boost::asio::ip::udp::endpoint &remote,
-  const Packets::WriteRequestPacket &writeRequestPacket )
-{
-  SPDLOG_TRACE( "RX: {}", static_cast< std::string>( writeRequestPacket ) );
+  SPDLOG_TRACE( "RX: {}", static_cast< std::string >( request ) );
 
   // check handler
   if ( !requestHandlerV )
@@ -335,21 +583,80 @@ void ServerImpl::writeRequestPacket(
     SPDLOG_WARN( "No registered handler - reject" );
 
     // execute error operation
-    errorOperation( remote, Packets::ErrorCode::FileNotFound, "WRQ" );
+    serverErrorOperation( remote, ServerError::RequestNotAccepted );
+    return;
+  }
+
+  // admission control - before any operation is created
+  if ( const auto admission{ admissionControlV->admit( remote.address() ) };
+    AdmissionControl::Result::Accepted != admission )
+  {
+    SPDLOG_DEBUG( "Request from {} rejected by admission control", remote.address().to_string() );
+
+    if ( !rejectSilentlyV )
+    {
+      serverErrorOperation( remote, ServerError::TooManyRequests );
+    }
+
+    return;
   }
 
-  // extract known TFTP Options
-  auto receivedOptions{ writeRequestPacket.options() };
-  const auto decodedOptions{ tftpOptions( receivedOptions ) };
+  // extract known TFTP Options, all other options are passed as additional options
+  Packets::TftpOptions decodedOptions{};
+  Packets::Options additionalOptions{};
+
+  for ( const auto &[ name, value ] : request.options() )
+  {
+    if ( name == Packets::TftpOptions_name( Packets::KnownOptions::BlockSize ) )
+    {
+      decodedOptions.blockSize = Packets::Options_decodeOption< uint16_t >(
+        value,
+        Packets::BlockSizeOptionMin,
+        Packets::BlockSizeOptionMax );
+    }
+    else if ( name == Packets::TftpOptions_name( Packets::KnownOptions::Timeout ) )
+    {
+      decodedOptions.timeout = Packets::Options_decodeOption< uint8_t >(
+        value,
+        Packets::TimeoutOptionMin,
+        Packets::TimeoutOptionMax );
+    }
+    else if ( name == Packets::TftpOptions_name( Packets::KnownOptions::TransferSize ) )
+    {
+      decodedOptions.transferSize = Packets::Options_decodeOption< uint64_t >( value );
+    }
+    else
+    {
+      additionalOptions.emplace( name, value );
+    }
+  }
 
   // call the handler, which handles the received request
   requestHandlerV(
     remote,
-    RequestType::Write,
-    writeRequestPacket.filename(),
-    writeRequestPacket.mode(),
+    ( Packets::PacketType::ReadRequest == request.packetType() ) ? RequestType::Read : RequestType::Write,
+    request.filename(),
+    request.mode(),
     decodedOptions,
-    receivedOptions );
+    additionalOptions );
+}
+
+void ServerImpl::readRequestPacket(
+  const boost::asio::ip::udp::endpoint &remote,
+  const Packets::ReadRequestPacket &readRequestPacket )
+{
+  // Requests are handled by requestPacket() - re-encode decoded packet
+  const auto rawPacket{ static_cast< Helper::RawData >( readRequestPacket ) };
+  requestPacket( remote, rawPacket );
+}
+
+void ServerImpl::writeRequestPacket(
+  const boost::asio::ip::udp::endpoint &remote,
+  const Packets::WriteRequestPacket &writeRequestPacket )
+{
+  // Requests are handled by requestPacket() - re-encode decoded packet
+  const auto rawPacket{ static_cast< Helper::RawData >( writeRequestPacket ) };
+  requestPacket( remote, rawPacket );
 }
 
 void ServerImpl::dataPacket( const boost::asio::ip::udp::endpoint &remote, const Packets::DataPacket &dataPacket )
@@ -357,7 +664,7 @@ void ServerImpl::dataPacket( const boost::asio::ip::udp::endpoint &remote, const
   SPDLOG_WARN( "RX Error: {}", static_cast< std::string >( dataPacket ) );
 
   // execute error operation
-  errorOperation( remote, Packets::ErrorCode::IllegalTftpOperation, "DATA packet isn't expected" );
+  serverErrorOperation( remote, ServerError::DataNotExpected );
 }
 
 void ServerImpl::acknowledgementPacket(
@@ -367,7 +674,7 @@ void ServerImpl::acknowledgementPacket(
   SPDLOG_WARN( "RX Error: {}", static_cast< std::string >( acknowledgementPacket ) );
 
   // execute error operation
-  errorOperation( remote, Packets::ErrorCode::IllegalTftpOperation, "ACK packet isn't expected" );
+  serverErrorOperation( remote, ServerError::AcknowledgementNotExpected );
 }
 
 void ServerImpl::errorPacket( const boost::asio::ip::udp::endpoint &remote, const Packets::ErrorPacket &errorPacket )
@@ -375,7 +682,7 @@ void ServerImpl::errorPacket( const boost::asio::ip::udp::endpoint &remote, cons
   SPDLOG_WARN( "RX Error: {}", static_cast< std::string>( errorPacket ) );
 
   // execute error operation
-  errorOperation( remote, Packets::ErrorCode::IllegalTftpOperation, "ERR packet isn't expected" );
+  serverErrorOperation( remote, ServerError::ErrorNotExpected );
 }
 
 void ServerImpl::optionsAcknowledgementPacket(
@@ -385,7 +692,7 @@ void ServerImpl::optionsAcknowledgementPacket(
   SPDLOG_WARN( "RX Error: {}", static_cast< std::string >( optionsAcknowledgementPacket ) );
 
   // execute error operation
-  errorOperation( remote, Packets::ErrorCode::IllegalTftpOperation, "OACK packet isn't expected" );
+  serverErrorOperation( remote, ServerError::OptionsAcknowledgementNotExpected );
 }
 
 void ServerImpl::invalidPacket(
@@ -395,47 +702,4 @@ void ServerImpl::invalidPacket(
   SPDLOG_WARN( "RX: UNKNOWN: *Error* - IGNORE" );
 }
 
-Packets::TftpOptions ServerImpl::tftpOptions( Packets::Options &clientOptions ) const
-{
-  Packets::TftpOptions decodedOptions;
-
-  // check the block size option - if set, use it
-  const auto [ blockSizeValid, blockSize ] =
-    Packets::Options_getOption< uint16_t >(
-      clientOptions,
-      Packets::TftpOptions_name( Packets::KnownOptions::BlockSize ),
-      Packets::BlockSizeOptionMin,
-      Packets::BlockSizeOptionMax );
-
-  decodedOptions.blockSize = blockSize;
-  // remove block size option
-  // TODO remove std::string generation if P2077R3 is implemented within stdlibc++ (GCC)
-  clientOptions.erase( std::string{ Packets::TftpOptions_name( Packets::KnownOptions::BlockSize ) } );
-
-  // check the timeout option - if set, use it
-  const auto [ timeoutValid, timeout ] =
-    Packets::Options_getOption< uint8_t >(
-      clientOptions,
-      Packets::TftpOptions_name( Packets::KnownOptions::Timeout ),
-      Packets::TimeoutOptionMin,
-      Packets::TimeoutOptionMax );
-
-  decodedOptions.timeout = timeout;
-  // remove timeout option
-  // TODO remove std::string generation if P2077R3 is implemented within stdlibc++ (GCC)
-  clientOptions.erase( std::string{ Packets::TftpOptions_name( Packets::KnownOptions::Timeout ) } );
-
-  // check transfer size option
-  const auto [ transferSizeValid, transferSize ] = Packets::Options_getOption< uint64_t >(
-    clientOptions,
-    Packets::TftpOptions_name( Packets::KnownOptions::TransferSize ) );
-
-  decodedOptions.transferSize = transferSize;
-  // remove timeout option
-  // TODO remove std::string generation if P2077R3 is implemented within stdlibc++ (GCC)
-  clientOptions.erase( std::string{ Packets::TftpOptions_name( Packets::KnownOptions::TransferSize ) } );
-
-  return decodedOptions;
-}
-
 }
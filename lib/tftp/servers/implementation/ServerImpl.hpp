@@ -16,15 +16,29 @@
 #include <tftp/servers/Servers.hpp>
 #include <tftp/servers/Server.hpp>
 
+#include <tftp/servers/implementation/AdmissionControl.hpp>
+#include <tftp/servers/implementation/OperationPool.hpp>
+#include <tftp/servers/implementation/ReadOperationImpl.hpp>
+#include <tftp/servers/implementation/SharedSocket.hpp>
+#include <tftp/servers/implementation/TransmitShaper.hpp>
+#include <tftp/servers/implementation/TuningProfiles.hpp>
+#include <tftp/servers/implementation/WriteOperationImpl.hpp>
+
 #include <tftp/packets/PacketHandler.hpp>
 
+#include <tftp/SocketBufferSizes.hpp>
 #include <tftp/TftpOptionsConfiguration.hpp>
 
 #include <boost/asio/ip/udp.hpp>
 #include <boost/asio/io_context.hpp>
 
+#include <array>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace Tftp::Servers {
 
@@ -61,6 +75,24 @@ class ServerImpl final : public Server, private Packets::PacketHandler
     //! @copydoc Server::serverAddress()
     Server& serverAddress( boost::asio::ip::udp::endpoint serverAddress ) override;
 
+    //! @copydoc Server::admissionConfiguration()
+    Server& admissionConfiguration( AdmissionConfiguration admissionConfiguration ) override;
+
+    //! @copydoc Server::admissionStatistic()
+    [[nodiscard]] AdmissionStatistic admissionStatistic() const override;
+
+    //! @copydoc Server::shapingConfiguration()
+    Server& shapingConfiguration( ShapingConfiguration shapingConfiguration ) override;
+
+    //! @copydoc Server::shapingStatistic()
+    [[nodiscard]] ShapingStatistic shapingStatistic() const override;
+
+    //! @copydoc Server::tuningConfiguration()
+    Server& tuningConfiguration( TuningConfiguration tuningConfiguration ) override;
+
+    //! @copydoc Server::operationPoolStatistic()
+    [[nodiscard]] OperationPoolStatistic operationPoolStatistic() const override;
+
     //! @copydoc Server::localEndpoint()
     [[nodiscard]] boost::asio::ip::udp::endpoint localEndpoint() const override;
 
@@ -79,6 +111,15 @@ class ServerImpl final : public Server, private Packets::PacketHandler
     //! @copydoc Server::localDefault()
     Server& localDefault( boost::asio::ip::address local ) override;
 
+    //! @copydoc Server::sharedSockets()
+    Server& sharedSockets( std::size_t sharedSockets ) override;
+
+    //! @copydoc Server::socketBufferSizes()
+    Server& socketBufferSizes( SocketBufferSizes socketBufferSizes ) override;
+
+    //! @copydoc Server::operationPoolSize()
+    Server& operationPoolSize( std::size_t operationPoolSize ) override;
+
     //! @copydoc Server::start()
     void start() override;
 
@@ -88,16 +129,37 @@ class ServerImpl final : public Server, private Packets::PacketHandler
     //! @copydoc Server::readOperation()
     [[nodiscard]] ReadOperationPtr readOperation() override;
 
+    //! @copydoc Server::readOperation(const boost::asio::ip::address&,std::string_view)
+    [[nodiscard]] ReadOperationPtr readOperation(
+      const boost::asio::ip::address &remote,
+      std::string_view filename ) override;
+
     //! @copydoc Server::writeOperation()
     [[nodiscard]] WriteOperationPtr writeOperation() override;
 
-    //! @copydoc Server::errorOperation(const boost::asio::ip::udp::endpoint&,Packets::ErrorCode,std::string)
+    //! @copydoc Server::writeOperation(const boost::asio::ip::address&,std::string_view)
+    [[nodiscard]] WriteOperationPtr writeOperation(
+      const boost::asio::ip::address &remote,
+      std::string_view filename ) override;
+
+    /**
+     * @copydoc Server::errorOperation(const boost::asio::ip::udp::endpoint&,Packets::ErrorCode,std::string)
+     *
+     * The error packet is sent from the listening socket, when the server is started.
+     * Otherwise, a dedicated socket is used.
+     * Error packets without error message are encoded once on construction.
+     **/
     void errorOperation(
       const boost::asio::ip::udp::endpoint &remote,
       Packets::ErrorCode errorCode,
       std::string errorMessage = {} ) override;
 
-    //! @copydoc Server::errorOperation(const boost::asio::ip::udp::endpoint&,const boost::asio::ip::udp::endpoint&,Packets::ErrorCode,std::string)
+    /**
+     * @copydoc Server::errorOperation(const boost::asio::ip::udp::endpoint&,const boost::asio::ip::udp::endpoint&,Packets::ErrorCode,std::string)
+     *
+     * When @p local is the server address, the error packet is sent from the listening socket.
+     * Otherwise, a dedicated socket is used.
+     **/
     void errorOperation(
       const boost::asio::ip::udp::endpoint &remote,
       const boost::asio::ip::udp::endpoint &local,
@@ -105,6 +167,116 @@ class ServerImpl final : public Server, private Packets::PacketHandler
       std::string errorMessage = {} ) override;
 
   private:
+    //! Error Responses generated by the Server itself
+    enum class ServerError : std::size_t
+    {
+      RequestNotAccepted,
+      TooManyRequests,
+      DataNotExpected,
+      AcknowledgementNotExpected,
+      ErrorNotExpected,
+      OptionsAcknowledgementNotExpected,
+      Count
+    };
+
+    /**
+     * @brief Sends an Error Response generated by the Server.
+     *
+     * These error packets are encoded once on construction, so rejecting requests and unexpected packets does not
+     * encode the packet again.
+     *
+     * @param[in] remote
+     *   Where the error packet shall be transmitted to.
+     * @param[in] serverError
+     *   Server error response.
+     **/
+    void serverErrorOperation( const boost::asio::ip::udp::endpoint &remote, ServerError serverError );
+
+    /**
+     * @brief Sends the Error Packet to the Remote.
+     *
+     * Uses the listening socket, if possible.
+     *
+     * @param[in] remote
+     *   Where the error packet shall be transmitted to.
+     * @param[in] rawPacket
+     *   Encoded Error Packet.
+     **/
+    void errorOperation( const boost::asio::ip::udp::endpoint &remote, Helper::ConstRawDataSpan rawPacket );
+
+    /**
+     * @brief Sends the Error Packet from the Listening Socket.
+     *
+     * @param[in] remote
+     *   Where the error packet shall be transmitted to.
+     * @param[in] rawPacket
+     *   Encoded Error Packet.
+     **/
+    void sendErrorPacket( const boost::asio::ip::udp::endpoint &remote, Helper::ConstRawDataSpan rawPacket );
+
+    /**
+     * @brief Sends the Error Packet from a Dedicated Socket.
+     *
+     * @param[in] remote
+     *   Where the error packet shall be transmitted to.
+     * @param[in] local
+     *   Communication source.
+     *   When not set, the socket is not bound explicitly.
+     * @param[in] rawPacket
+     *   Encoded Error Packet.
+     **/
+    void sendErrorPacket(
+      const boost::asio::ip::udp::endpoint &remote,
+      const std::optional< boost::asio::ip::udp::endpoint > &local,
+      Helper::ConstRawDataSpan rawPacket );
+
+    /**
+     * @brief Returns the Shared Socket with the fewest attached Operations.
+     *
+     * @return Shared Socket
+     * @retval {}
+     *   When socket sharing is disabled or the server is not started.
+     **/
+    [[nodiscard]] SharedSocketPtr sharedSocket() const;
+
+    /**
+     * @brief Creates a Read Operation initialised with the Defaults.
+     *
+     * @param[in] profile
+     *   Tuning profile applied on start.
+     *   If not set, the defaults are used.
+     *
+     * @return TFTP server read operation.
+     **/
+    [[nodiscard]] ReadOperationPtr readOperation( const TuningConfiguration::Profile * profile );
+
+    /**
+     * @brief Creates a Write Operation initialised with the Defaults.
+     *
+     * @param[in] profile
+     *   Tuning profile applied on start.
+     *   If not set, the defaults are used.
+     *
+     * @return TFTP server write operation.
+     **/
+    [[nodiscard]] WriteOperationPtr writeOperation( const TuningConfiguration::Profile * profile );
+
+    /**
+     * @brief Returns the Tuning Profile matching the Request.
+     *
+     * @param[in] remote
+     *   Client address of the request.
+     * @param[in] filename
+     *   Requested filename.
+     *
+     * @return Matching tuning profile.
+     * @retval nullptr
+     *   If no profile matches.
+     **/
+    [[nodiscard]] const TuningConfiguration::Profile * tuningProfile(
+      const boost::asio::ip::address &remote,
+      std::string_view filename ) const;
+
     /**
      * @brief Waits for an incoming response from the server.
      *
@@ -126,11 +298,29 @@ class ServerImpl final : public Server, private Packets::PacketHandler
      **/
     void receiveHandler( const boost::system::error_code &errorCode, std::size_t bytesTransferred );
 
+    /**
+     * @brief Handles a received Read or Write Request.
+     *
+     * The request is validated by Packets::ReadWriteRequestPacketView without copying filename, mode, and options.
+     * Malformed requests are counted as invalid packets and ignored.
+     * Valid requests are checked by the admission control.
+     * Rejected requests are responded with an error packet or dropped, as configured.
+     * When valid, the known TFTP options are decoded and the handler ReceivedTftpRequestHandler is called, which
+     * actually handles the request.
+     * While the handler is called, the tuning profile matching the request is applied to created operations.
+     *
+     * @param[in] remote
+     *   Remote Endpoint
+     * @param[in] rawPacket
+     *   Raw RRQ/ WRQ Packet.
+     **/
+    void requestPacket( const boost::asio::ip::udp::endpoint &remote, Helper::ConstRawDataSpan rawPacket );
+
     /**
      * @copydoc Packets::PacketHandler::readRequestPacket
      *
-     * The packet is decoded, and when valid the handler
-     * NewRequestHandler::receivedReadRequest() is called, which actually handles the request.
+     * Requests are normally handled by requestPacket() directly.
+     * This handler forwards the packet to requestPacket().
      **/
     void readRequestPacket(
       const boost::asio::ip::udp::endpoint &remote,
@@ -139,8 +329,8 @@ class ServerImpl final : public Server, private Packets::PacketHandler
     /**
      * @copydoc Packets::PacketHandler::writeRequestPacket
      *
-     * The packet is decoded, and when valid the handler
-     * NewRequestHandler::receivedWriteRequest() is called, which actually handles the request.
+     * Requests are normally handled by requestPacket() directly.
+     * This handler forwards the packet to requestPacket().
      **/
     void writeRequestPacket(
       const boost::asio::ip::udp::endpoint &remote,
@@ -192,21 +382,18 @@ class ServerImpl final : public Server, private Packets::PacketHandler
      **/
     void invalidPacket( const boost::asio::ip::udp::endpoint &remote, Helper::ConstRawDataSpan rawPacket ) override;
 
-    /**
-     * @brief Decodes the TFTP Options.
-     *
-     * @param[in,out] clientOptions
-     *   Received TFTP Options.
-     *   Will remove all options decoded by this operation.
-     *
-     * @return Decoded TFTP Options
-     **/
-    Packets::TftpOptions tftpOptions( Packets::Options &clientOptions ) const;
-
     //! TFTP Request Received Handler
     ReceivedTftpRequestHandler requestHandlerV;
     //! Address where the TFTP server should listen on.
     boost::asio::ip::udp::endpoint serverAddressV{ DefaultLocalEndpoint };
+    //! Admission Control (shared with the created operations)
+    std::shared_ptr< AdmissionControl > admissionControlV;
+    //! If set, rejected requests are dropped silently
+    bool rejectSilentlyV{ false };
+    //! Transmit Shaper (shared with the created read operations)
+    std::shared_ptr< TransmitShaper > transmitShaperV;
+    //! Tuning Profiles
+    TuningProfiles tuningProfilesV;
 
     //! TFTP Server I/O context
     boost::asio::io_context &ioContextV;
@@ -225,8 +412,24 @@ class ServerImpl final : public Server, private Packets::PacketHandler
     Packets::Options additionalOptionsV;
     //! Default local IP address
     boost::asio::ip::address localV;
-
-    //! Buffer, which holds the received TFTP packet.
+    //! Socket buffer sizes
+    SocketBufferSizes socketBufferSizesV;
+    //! Number of shared sockets
+    std::size_t sharedSocketsCountV{ 0U };
+    //! Sockets shared by the operations
+    std::vector< SharedSocketPtr > sharedSocketsV;
+    //! Pool of Read Operations
+    OperationPool< ReadOperationImpl > readOperationPoolV;
+    //! Pool of Write Operations
+    OperationPool< WriteOperationImpl > writeOperationPoolV;
+
+    //! Encoded Error Packets generated by the Server (indexed by ServerError)
+    std::array< Helper::RawData, static_cast< std::size_t >( ServerError::Count ) > serverErrorPacketsV;
+    //! Encoded Error Packets without Error Message (indexed by Packets::ErrorCode)
+    std::array< Helper::RawData, static_cast< std::size_t >( Packets::ErrorCode::TftpOptionRefused ) + 1U >
+      errorCodePacketsV;
+
+    //! Buffer, which holds the received TFTP packet (maximum UDP payload - requests may carry large option lists)
     Helper::RawData receivePacketV;
     //! Remote endpoint on receive.
     boost::asio::ip::udp::endpoint remoteEndpointV;
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::SharedSocket.
+ **/
+
+#include "SharedSocket.hpp"
+
+#include <tftp/packets/ErrorPacket.hpp>
+#include <tftp/packets/PacketStatistic.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/container_hash/hash.hpp>
+
+#include <cassert>
+#include <limits>
+
+namespace Tftp::Servers {
+
+SharedSocket::SharedSocket(
+  boost::asio::io_context &ioContext,
+  const boost::asio::ip::udp::endpoint &local,
+  const SocketBufferSizes &socketBufferSizes ) :
+  ioContextV{ ioContext },
+  socketV{ ioContext },
+  receivePacketV( std::numeric_limits< uint16_t >::max() )
+{
+  socketV.open( local.protocol() );
+  // the shared socket receives the packets of many operations
+  socketBufferSizes.apply( socketV );
+  socketV.bind( local );
+  localEndpointV = socketV.local_endpoint();
+
+  SPDLOG_INFO(
+    "Shared socket on {}:{}",
+    localEndpointV.address().to_string(),
+    localEndpointV.port() );
+
+  receive();
+}
+
+SharedSocket::~SharedSocket() noexcept
+{
+  boost::system::error_code errorCode;
+  socketV.close( errorCode );
+}
+
+const boost::asio::ip::udp::endpoint& SharedSocket::localEndpoint() const noexcept
+{
+  return localEndpointV;
+}
+
+bool SharedSocket::attach( const boost::asio::ip::udp::endpoint &remote, ReceiveHandler handler )
+{
+  checkThread();
+
+  if ( remote.protocol() != localEndpointV.protocol() )
+  {
+    return false;
+  }
+
+  return operationsV.try_emplace( remote, std::move( handler ) ).second;
+}
+
+void SharedSocket::detach( const boost::asio::ip::udp::endpoint &remote ) noexcept
+{
+  checkThread();
+  operationsV.erase( remote );
+}
+
+std::size_t SharedSocket::size() const noexcept
+{
+  return operationsV.size();
+}
+
+void SharedSocket::send( const boost::asio::ip::udp::endpoint &remote, const Helper::ConstRawDataSpan rawPacket )
+{
+  socketV.send_to( boost::asio::buffer( rawPacket.data(), rawPacket.size() ), remote );
+}
+
+std::size_t SharedSocket::EndpointHash::operator()(
+  const boost::asio::ip::udp::endpoint &endpoint ) const noexcept
+{
+  std::size_t seed{ 0U };
+
+  if ( endpoint.address().is_v4() )
+  {
+    boost::hash_combine( seed, endpoint.address().to_v4().to_uint() );
+  }
+  else
+  {
+    const auto bytes{ endpoint.address().to_v6().to_bytes() };
+    boost::hash_range( seed, bytes.begin(), bytes.end() );
+  }
+
+  boost::hash_combine( seed, endpoint.port() );
+
+  return seed;
+}
+
+void SharedSocket::receive()
+{
+  socketV.async_receive_from(
+    boost::asio::buffer( receivePacketV ),
+    remoteEndpointV,
+    std::bind_front( &SharedSocket::receiveHandler, this ) );
+}
+
+void SharedSocket::receiveHandler( const boost::system::error_code &errorCode, const std::size_t bytesTransferred )
+{
+  // socket closed
+  if ( boost::asio::error::operation_aborted == errorCode )
+  {
+    return;
+  }
+
+  checkThread();
+
+  // keep the socket alive, even if the last operation is released by its handler
+  const auto self{ shared_from_this() };
+
+  if ( errorCode )
+  {
+    // e.g. ICMP port unreachable of a previous send - keep the socket running
+    SPDLOG_WARN( "Shared socket receive error: {}", errorCode.message() );
+    receive();
+    return;
+  }
+
+  const Helper::ConstRawDataSpan rawPacket{ receivePacketV.begin(), bytesTransferred };
+
+  if ( const auto operation{ operationsV.find( remoteEndpointV ) }; operation != operationsV.end() )
+  {
+    // the handler may detach the operation
+    const auto handler{ operation->second };
+    handler( rawPacket );
+  }
+  else
+  {
+    SPDLOG_DEBUG( "Received packet from unknown source: {}", remoteEndpointV.address().to_string() );
+
+    const auto rawErrorPacket{ static_cast< Helper::RawData >(
+      Packets::ErrorPacket{ Packets::ErrorCode::UnknownTransferId, "Unknown transfer ID" } ) };
+
+    boost::system::error_code sendErrorCode;
+    socketV.send_to( boost::asio::buffer( rawErrorPacket ), remoteEndpointV, 0, sendErrorCode );
+
+    if ( !sendErrorCode )
+    {
+      // Update statistic
+      Packets::PacketStatistic::globalTransmit().packet( Packets::PacketType::Error, rawErrorPacket.size() );
+    }
+  }
+
+  receive();
+}
+
+void SharedSocket::checkThread() noexcept
+{
+  if ( !ioContextV.get_executor().running_in_this_thread() )
+  {
+    return;
+  }
+
+  const auto thisThread{ std::this_thread::get_id() };
+  auto runThread{ std::thread::id{} };
+
+  // the first thread running a handler becomes the owner
+  if ( !runThreadV.compare_exchange_strong( runThread, thisThread ) )
+  {
+    assert( ( runThread == thisThread ) && "The I/O context of a shared socket must be run by a single thread" );
+  }
+}
+
+}
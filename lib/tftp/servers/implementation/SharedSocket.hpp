@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::SharedSocket.
+ **/
+
+#ifndef TFTP_SERVERS_SHAREDSOCKET_HPP
+#define TFTP_SERVERS_SHAREDSOCKET_HPP
+
+#include <tftp/servers/Servers.hpp>
+
+#include <tftp/SocketBufferSizes.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+namespace Tftp::Servers {
+
+class SharedSocket;
+
+//! Shared Socket Instance Pointer
+using SharedSocketPtr = std::shared_ptr< SharedSocket >;
+
+/**
+ * @brief UDP Socket shared by multiple TFTP %Server Operations.
+ *
+ * Instead of one ephemeral socket per operation, all attached operations send from and receive on this socket.
+ * Received datagrams are demultiplexed by the remote endpoint and routed to the handler of the attached operation.
+ * Datagrams from unknown remote endpoints are answered with an _Unknown Transfer ID_ error packet.
+ *
+ * As the remote endpoint is the demultiplexing key, only one operation per remote endpoint can be attached.
+ *
+ * The attached operations are not synchronised.
+ * Like the operations themselves, the socket must only be used by the single thread running the I/O context.
+ **/
+class SharedSocket final : public std::enable_shared_from_this< SharedSocket >
+{
+  public:
+    //! Handler for Received Packets of an attached Operation
+    using ReceiveHandler = std::function< void( Helper::ConstRawDataSpan rawPacket ) >;
+
+    /**
+     * @brief Opens and binds the Socket and starts receiving.
+     *
+     * @param[in] ioContext
+     *   I/O context used for communication.
+     * @param[in] local
+     *   Local endpoint, where the socket is bound to.
+     * @param[in] socketBufferSizes
+     *   Socket buffer sizes.
+     *
+     * @throw boost::system::system_error
+     *   When the socket cannot be opened or bound.
+     **/
+    SharedSocket(
+      boost::asio::io_context &ioContext,
+      const boost::asio::ip::udp::endpoint &local,
+      const SocketBufferSizes &socketBufferSizes = {} );
+
+    //! Closes the Socket.
+    ~SharedSocket() noexcept;
+
+    SharedSocket( const SharedSocket & ) = delete;
+    SharedSocket& operator=( const SharedSocket & ) = delete;
+
+    /**
+     * @brief Returns the Local Endpoint of the Socket.
+     *
+     * @return Local Endpoint.
+     **/
+    [[nodiscard]] const boost::asio::ip::udp::endpoint& localEndpoint() const noexcept;
+
+    /**
+     * @brief Attaches an Operation.
+     *
+     * @param[in] remote
+     *   Remote endpoint of the operation.
+     * @param[in] handler
+     *   Handler, which is called for packets received from @p remote.
+     *
+     * @return If the operation has been attached.
+     * @retval false
+     *   When the protocol does not match, or an operation with the same remote endpoint is already attached.
+     **/
+    [[nodiscard]] bool attach( const boost::asio::ip::udp::endpoint &remote, ReceiveHandler handler );
+
+    /**
+     * @brief Detaches the Operation of the given Remote Endpoint.
+     *
+     * @param[in] remote
+     *   Remote endpoint of the operation.
+     **/
+    void detach( const boost::asio::ip::udp::endpoint &remote ) noexcept;
+
+    /**
+     * @brief Returns the number of attached Operations.
+     *
+     * @return Number of attached operations.
+     **/
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Sends the raw Packet to the Remote Endpoint.
+     *
+     * @param[in] remote
+     *   Remote endpoint.
+     * @param[in] rawPacket
+     *   Encoded packet.
+     *
+     * @throw boost::system::system_error
+     *   On send error.
+     **/
+    void send( const boost::asio::ip::udp::endpoint &remote, Helper::ConstRawDataSpan rawPacket );
+
+  private:
+    //! Hash of UDP Endpoints
+    struct EndpointHash
+    {
+      /**
+       * @brief Calculates the Hash of the Endpoint.
+       *
+       * @param[in] endpoint
+       *   UDP Endpoint.
+       *
+       * @return Hash value.
+       **/
+      std::size_t operator()( const boost::asio::ip::udp::endpoint &endpoint ) const noexcept;
+    };
+
+    //! Waits for the next Datagram.
+    void receive();
+
+    /**
+     * @brief Called, when a Datagram is received.
+     *
+     * @param[in] errorCode
+     *   error status of operation.
+     * @param[in] bytesTransferred
+     *   Number of bytes transferred.
+     **/
+    void receiveHandler( const boost::system::error_code &errorCode, std::size_t bytesTransferred );
+
+    /**
+     * @brief Asserts, that the I/O context is run by a single thread.
+     *
+     * Only checked, when called from within a handler of the I/O context.
+     **/
+    void checkThread() noexcept;
+
+    //! I/O Context
+    boost::asio::io_context &ioContextV;
+    //! Thread, which runs the I/O context
+    std::atomic< std::thread::id > runThreadV;
+    //! UDP Socket
+    boost::asio::ip::udp::socket socketV;
+    //! Local Endpoint
+    boost::asio::ip::udp::endpoint localEndpointV;
+    //! Attached Operations
+    std::unordered_map< boost::asio::ip::udp::endpoint, ReceiveHandler, EndpointHash > operationsV;
+    //! Receive Buffer (maximum UDP payload size)
+    Helper::RawData receivePacketV;
+    //! Remote endpoint on receive.
+    boost::asio::ip::udp::endpoint remoteEndpointV;
+};
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::TransmitShaper.
+ **/
+
+#include "TransmitShaper.hpp"
+
+#include <algorithm>
+
+namespace Tftp::Servers {
+
+void TransmitShaper::configuration( ShapingConfiguration configuration )
+{
+  std::lock_guard lock{ mutexV };
+
+  configurationV = std::move( configuration );
+  theoreticalTransmissionTimeV = {};
+}
+
+TransmitShaper::Clock::duration TransmitShaper::schedule( SessionState &session, const std::size_t size )
+{
+  std::lock_guard lock{ mutexV };
+
+  ++statisticV.packets;
+  statisticV.bytes += size;
+
+  if ( !configurationV.sessionRate && !configurationV.globalRate )
+  {
+    return Clock::duration::zero();
+  }
+
+  const auto now{ Clock::now() };
+  auto transmissionTime{ now };
+
+  // session limit first - the global time slot is reserved, when the session may send
+  if ( configurationV.sessionRate )
+  {
+    transmissionTime = schedule(
+      session.theoreticalTransmissionTime,
+      *configurationV.sessionRate,
+      configurationV.sessionBurst,
+      transmissionTime,
+      size );
+  }
+
+  if ( configurationV.globalRate )
+  {
+    transmissionTime = schedule(
+      theoreticalTransmissionTimeV,
+      *configurationV.globalRate,
+      configurationV.globalBurst,
+      transmissionTime,
+      size );
+  }
+
+  const auto delay{ transmissionTime - now };
+
+  if ( delay > Clock::duration::zero() )
+  {
+    const auto delayUs{ std::chrono::duration_cast< std::chrono::microseconds >( delay ) };
+
+    ++statisticV.delayedPackets;
+    ++statisticV.pendingPackets;
+    statisticV.totalDelay += delayUs;
+    statisticV.maximumDelay = std::max( statisticV.maximumDelay, delayUs );
+  }
+
+  return delay;
+}
+
+void TransmitShaper::delayedPacketSent() noexcept
+{
+  std::lock_guard lock{ mutexV };
+
+  if ( statisticV.pendingPackets > 0U )
+  {
+    --statisticV.pendingPackets;
+  }
+}
+
+ShapingStatistic TransmitShaper::statistic() const
+{
+  std::lock_guard lock{ mutexV };
+  return statisticV;
+}
+
+TransmitShaper::Clock::time_point TransmitShaper::schedule(
+  Clock::time_point &theoreticalTransmissionTime,
+  const uint64_t rate,
+  const uint64_t burst,
+  const Clock::time_point earliest,
+  const std::size_t size )
+{
+  if ( 0U == rate )
+  {
+    return earliest;
+  }
+
+  const auto transmissionDuration{ std::chrono::duration_cast< Clock::duration >(
+    std::chrono::duration< double >{ static_cast< double >( size ) / static_cast< double >( rate ) } ) };
+  const auto burstTolerance{ std::chrono::duration_cast< Clock::duration >(
+    std::chrono::duration< double >{ static_cast< double >( burst ) / static_cast< double >( rate ) } ) };
+
+  // an idle limit does not accumulate credit beyond the burst size
+  theoreticalTransmissionTime = std::max( theoreticalTransmissionTime, earliest ) + transmissionDuration;
+
+  return std::max( earliest, theoreticalTransmissionTime - burstTolerance );
+}
+
+}
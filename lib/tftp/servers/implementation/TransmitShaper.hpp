@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::TransmitShaper.
+ **/
+
+#ifndef TFTP_SERVERS_TRANSMITSHAPER_HPP
+#define TFTP_SERVERS_TRANSMITSHAPER_HPP
+
+#include <tftp/servers/Servers.hpp>
+#include <tftp/servers/ShapingConfiguration.hpp>
+#include <tftp/servers/ShapingStatistic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server Transmit Shaper.
+ *
+ * Pacing scheduler for DATA packets of server read operations.
+ * For each packet the shaper calculates the delay, after which the packet may be sent without exceeding the session
+ * and global rate limits configured by ShapingConfiguration.
+ *
+ * The limits are implemented as virtual scheduling (generic cell rate algorithm):
+ * Each limit holds the theoretical transmission time of the next packet, which is advanced by the transmission
+ * duration of every scheduled packet.
+ * Up to the burst size may be transmitted ahead of the schedule.
+ * As the time slot is reserved at scheduling, concurrent sessions are spaced instead of sent back to back.
+ *
+ * The instance is shared between the server and its operations.
+ * The statistic may be queried from other threads than the one running the I/O context.
+ **/
+class TransmitShaper final
+{
+  public:
+    //! Clock used for Pacing
+    using Clock = std::chrono::steady_clock;
+
+    //! Per Session Shaping State
+    struct SessionState
+    {
+      //! Theoretical Transmission Time of the next Packet
+      Clock::time_point theoreticalTransmissionTime{};
+    };
+
+    /**
+     * @brief Updates the Shaping Configuration.
+     *
+     * @param[in] configuration
+     *   Shaping Configuration.
+     **/
+    void configuration( ShapingConfiguration configuration );
+
+    /**
+     * @brief Schedules a Packet and returns the Delay to wait, before it may be sent.
+     *
+     * When the returned delay is not zero, @ref delayedPacketSent() must be called, when the packet is sent or
+     * the transmission is cancelled.
+     *
+     * @param[in,out] session
+     *   Shaping state of the session.
+     * @param[in] size
+     *   Packet Size in bytes.
+     *
+     * @return Delay until the packet may be sent.
+     **/
+    [[nodiscard]] Clock::duration schedule( SessionState &session, std::size_t size );
+
+    /**
+     * @brief Informs the Shaper that a delayed Packet has been sent or cancelled.
+     **/
+    void delayedPacketSent() noexcept;
+
+    /**
+     * @brief Returns the Shaping Statistic.
+     *
+     * @return Shaping Statistic.
+     **/
+    [[nodiscard]] ShapingStatistic statistic() const;
+
+  private:
+    /**
+     * @brief Schedules a Packet at the given Limit.
+     *
+     * @param[in,out] theoreticalTransmissionTime
+     *   Theoretical Transmission Time of the limit.
+     * @param[in] rate
+     *   Rate in bytes per second.
+     * @param[in] burst
+     *   Burst size in bytes.
+     * @param[in] earliest
+     *   Earliest possible transmission time.
+     * @param[in] size
+     *   Packet Size in bytes.
+     *
+     * @return Transmission Time of the packet.
+     **/
+    static Clock::time_point schedule(
+      Clock::time_point &theoreticalTransmissionTime,
+      uint64_t rate,
+      uint64_t burst,
+      Clock::time_point earliest,
+      std::size_t size );
+
+    //! Mutex protecting configuration, global state and statistic
+    mutable std::mutex mutexV;
+    //! Shaping Configuration
+    ShapingConfiguration configurationV;
+    //! Global Theoretical Transmission Time
+    Clock::time_point theoreticalTransmissionTimeV{};
+    //! Shaping Statistic
+    ShapingStatistic statisticV;
+};
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class Tftp::Servers::TuningProfiles.
+ **/
+
+#include "TuningProfiles.hpp"
+
+#include <boost/asio/ip/network_v4.hpp>
+#include <boost/asio/ip/network_v6.hpp>
+
+#include <algorithm>
+
+namespace Tftp::Servers {
+
+void TuningProfiles::configuration( TuningConfiguration configuration )
+{
+  profilesV.clear();
+  profilesV.reserve( configuration.profiles.size() );
+
+  for ( auto &profile : configuration.profiles )
+  {
+    std::optional< std::regex > filename{};
+
+    if ( !profile.filename.empty() )
+    {
+      filename.emplace( profile.filename, std::regex::optimize );
+    }
+
+    profilesV.emplace_back( std::move( profile ), std::move( filename ) );
+  }
+}
+
+const TuningConfiguration::Profile * TuningProfiles::match(
+  const boost::asio::ip::address &address,
+  const std::string_view filename ) const
+{
+  const auto profile{ std::ranges::find_if(
+    profilesV,
+    [ &address, &filename ]( const auto &compiledProfile )
+    {
+      return subnetMatches( compiledProfile.profile, address )
+        && ( !compiledProfile.filename
+          || std::regex_match( filename.begin(), filename.end(), *compiledProfile.filename ) );
+    } ) };
+
+  if ( profile == profilesV.end() )
+  {
+    return nullptr;
+  }
+
+  return &profile->profile;
+}
+
+bool TuningProfiles::subnetMatches(
+  const TuningConfiguration::Profile &profile,
+  const boost::asio::ip::address &address )
+{
+  if ( !profile.subnet )
+  {
+    return true;
+  }
+
+  auto clientAddress{ address };
+
+  if ( clientAddress.is_v6() && clientAddress.to_v6().is_v4_mapped() )
+  {
+    clientAddress = boost::asio::ip::make_address_v4( boost::asio::ip::v4_mapped, clientAddress.to_v6() );
+  }
+
+  if ( profile.subnet->is_v4() != clientAddress.is_v4() )
+  {
+    return false;
+  }
+
+  if ( clientAddress.is_v4() )
+  {
+    return boost::asio::ip::make_network_v4( clientAddress.to_v4(), profile.subnetPrefixLength ).network()
+      == boost::asio::ip::make_network_v4( profile.subnet->to_v4(), profile.subnetPrefixLength ).network();
+  }
+
+  return boost::asio::ip::make_network_v6( clientAddress.to_v6(), profile.subnetPrefixLength ).network()
+    == boost::asio::ip::make_network_v6( profile.subnet->to_v6(), profile.subnetPrefixLength ).network();
+}
+
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class Tftp::Servers::TuningProfiles.
+ **/
+
+#ifndef TFTP_SERVERS_TUNINGPROFILES_HPP
+#define TFTP_SERVERS_TUNINGPROFILES_HPP
+
+#include <tftp/servers/Servers.hpp>
+#include <tftp/servers/TuningConfiguration.hpp>
+
+#include <boost/asio/ip/address.hpp>
+
+#include <optional>
+#include <regex>
+#include <string_view>
+#include <vector>
+
+namespace Tftp::Servers {
+
+/**
+ * @brief TFTP %Server Tuning Profiles.
+ *
+ * Matches requests against the profiles of the TuningConfiguration.
+ * The filename patterns are compiled once, when the configuration is updated.
+ **/
+class TuningProfiles final
+{
+  public:
+    /**
+     * @brief Updates the Tuning Configuration.
+     *
+     * @param[in] configuration
+     *   Tuning Configuration.
+     **/
+    void configuration( TuningConfiguration configuration );
+
+    /**
+     * @brief Returns the first Profile matching the Request.
+     *
+     * @param[in] address
+     *   Client address.
+     * @param[in] filename
+     *   Requested filename.
+     *
+     * @return Matching profile.
+     * @retval nullptr
+     *   If no profile matches.
+     **/
+    [[nodiscard]] const TuningConfiguration::Profile * match(
+      const boost::asio::ip::address &address,
+      std::string_view filename ) const;
+
+  private:
+    //! Profile with compiled Filename Pattern
+    struct CompiledProfile
+    {
+      //! Profile
+      TuningConfiguration::Profile profile;
+      //! Filename Pattern (if set)
+      std::optional< std::regex > filename;
+    };
+
+    /**
+     * @brief Checks, if the Address is within the Subnet of the Profile.
+     *
+     * IPv4-mapped IPv6 addresses are matched against IPv4 subnets.
+     *
+     * @param[in] profile
+     *   Profile.
+     * @param[in] address
+     *   Client address.
+     *
+     * @return If the address is within the subnet.
+     **/
+    [[nodiscard]] static bool subnetMatches(
+      const TuningConfiguration::Profile &profile,
+      const boost::asio::ip::address &address );
+
+    //! Profiles
+    std::vector< CompiledProfile > profilesV;
+};
+
+}
+
+#endif
@@ -25,15 +25,35 @@
 
 #include <boost/exception/all.hpp>
 
+#include <exception>
 #include <utility>
 
 namespace Tftp::Servers {
 
-WriteOperationImpl::WriteOperationImpl( boost::asio::io_context &ioContext ) :
-  OperationImpl{ ioContext }
+WriteOperationImpl::WriteOperationImpl(
+  boost::asio::io_context &ioContext,
+  AdmissionControl::Session session,
+  SharedSocketPtr sharedSocket ) :
+  OperationImpl{ ioContext, std::move( session ), {}, std::move( sharedSocket ) }
 {
 }
 
+void WriteOperationImpl::reset(
+  AdmissionControl::Session session,
+  SharedSocketPtr sharedSocket )
+{
+  OperationImpl::reset( std::move( session ), {}, std::move( sharedSocket ) );
+
+  dallyV = false;
+  optionsConfigurationV = {};
+  dataHandlerV.reset();
+  clientOptionsV = {};
+  additionalNegotiatedOptionsV.clear();
+  receiveDataSize = Packets::DefaultDataSize;
+  lastReceivedBlockNumber = Packets::BlockNumber{ 0U };
+  dataHandlerFinishedV = false;
+}
+
 WriteOperation& WriteOperationImpl::tftpTimeout(
   const std::chrono::seconds timeout )
 {
@@ -53,17 +73,15 @@ WriteOperation& WriteOperationImpl::dally( const bool dally )
   return *this;
 }
 
+void WriteOperationImpl::tuningProfile( TuningConfiguration::Profile profile )
+{
+  OperationImpl::tuningProfile( std::move( profile ) );
+}
+
 WriteOperation &WriteOperationImpl::optionsConfiguration( TftpOptionsConfiguration optionsConfiguration )
 {
   optionsConfigurationV = std::move( optionsConfiguration );
 
-  maxReceivePacketSize(
-    static_cast< uint16_t >(
-      Packets::DefaultTftpDataPacketHeaderSize
-      + std::max(
-        Packets::DefaultDataSize,
-        optionsConfigurationV.blockSizeOption.get_value_or( Packets::DefaultDataSize ) ) ) );
-
   return *this;
 }
 
@@ -91,6 +109,12 @@ WriteOperation& WriteOperationImpl::local( boost::asio::ip::udp::endpoint local
   return *this;
 }
 
+WriteOperation& WriteOperationImpl::socketBufferSizes( SocketBufferSizes socketBufferSizes )
+{
+  OperationImpl::socketBufferSizes( std::move( socketBufferSizes ) );
+  return *this;
+}
+
 WriteOperation& WriteOperationImpl::clientOptions( Packets::TftpOptions clientOptions )
 {
   clientOptionsV = std::move( clientOptions );
@@ -112,12 +136,16 @@ void WriteOperationImpl::start()
       << TransferPhaseInfo{ TransferPhase::Initialisation } );
   }
 
+  // the tuning profile overrides the configuration of the operation
+  applyTuningProfile( optionsConfigurationV );
+
   try
   {
     // initialise socket
     initialise();
 
     // Reset data handler
+    dataHandlerFinishedV = false;
     dataHandlerV->start();
 
     // option negotiation leads to an empty option list
@@ -132,9 +160,9 @@ void WriteOperationImpl::start()
       Packets::Options serverOptions{ additionalNegotiatedOptionsV };
 
       // check for the block size option - if set, use it
-      if ( optionsConfigurationV.blockSizeOption && clientOptionsV.blockSize )
+      if ( const auto blockSize{ negotiateBlockSize( optionsConfigurationV, clientOptionsV.blockSize ) }; blockSize )
       {
-        receiveDataSize = std::min( *clientOptionsV.blockSize, *optionsConfigurationV.blockSizeOption );
+        receiveDataSize = *blockSize;
 
         // respond option string
         serverOptions.try_emplace(
@@ -217,8 +245,19 @@ const Packets::ErrorInformation& WriteOperationImpl::errorInformation() const
 
 void WriteOperationImpl::finished( const TransferStatus status, Packets::ErrorInformation errorInformation ) noexcept
 {
-  // Complete data handler
-  dataHandlerV->finished();
+  // Complete data handler, if not already done on the last data packet
+  if ( !std::exchange( dataHandlerFinishedV, true ) )
+  {
+    // the transfer has failed already - the error is not reported
+    try
+    {
+      dataHandlerV->finished();
+    }
+    catch ( const std::exception &e )
+    {
+      SPDLOG_ERROR( "Error finishing data: {}", e.what() );
+    }
+  }
 
   // Inform base class
   OperationImpl::finished( status, std::move( errorInformation ) );
@@ -233,7 +272,7 @@ void WriteOperationImpl::dataPacket(
   // Check retransmission of last packet
   if ( dataPacket.blockNumber() == lastReceivedBlockNumber )
   {
-    SPDLOG_INFO( "Retransmission of last packet - only send ACK" );
+    SPDLOG_DEBUG( "Retransmission of last packet - only send ACK" );
 
     // Retransmit last ACK packet
     send( Packets::AcknowledgementPacket{ lastReceivedBlockNumber } );
@@ -289,8 +328,32 @@ void WriteOperationImpl::dataPacket(
     return;
   }
 
+  // the last packet is smaller than the expected data size
+  const bool lastPacket{ dataPacket.dataSize() < receiveDataSize };
+
   // pass data
-  dataHandlerV->receivedData( dataPacket.data() );
+  try
+  {
+    dataHandlerV->receivedData( dataPacket.data() );
+
+    // complete the data handler before the last packet is acknowledged
+    if ( lastPacket )
+    {
+      dataHandlerFinishedV = true;
+      dataHandlerV->finished();
+    }
+  }
+  catch ( const std::exception &e )
+  {
+    SPDLOG_ERROR( "Error storing data: {}", e.what() );
+
+    const Packets::ErrorPacket errorPacket{ Packets::ErrorCode::NotDefined, "Error storing data" };
+    send( errorPacket );
+
+    // Operation completed
+    finished( TransferStatus::TransferError, errorPacket.errorInformation() );
+    return;
+  }
 
   // increment received block number
   ++lastReceivedBlockNumber;
@@ -298,8 +361,7 @@ void WriteOperationImpl::dataPacket(
   // send ACK
   send( Packets::AcknowledgementPacket{ lastReceivedBlockNumber } );
 
-  // if the received data size is smaller than the expected
-  if ( dataPacket.dataSize() < receiveDataSize )
+  if ( lastPacket )
   {
     // the last packet has been received and the operation is finished
     if ( dallyV )
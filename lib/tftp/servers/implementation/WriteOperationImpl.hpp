@@ -46,12 +46,31 @@ class WriteOperationImpl final : public WriteOperation, private OperationImpl
      *
      * @param[in] ioContext
      *   I/O context used for communication.
+     * @param[in] session
+     *   Admission Control Session, which is held until the operation is finished.
+     * @param[in] sharedSocket
+     *   Socket shared with other operations.
      **/
-    explicit WriteOperationImpl( boost::asio::io_context &ioContext );
+    explicit WriteOperationImpl(
+      boost::asio::io_context &ioContext,
+      AdmissionControl::Session session = {},
+      SharedSocketPtr sharedSocket = {} );
 
     //! Destructor.
     ~WriteOperationImpl() override = default;
 
+    /**
+     * @brief Resets the Operation for Reuse by the OperationPool.
+     *
+     * @param[in] session
+     *   Admission Control Session, which is held until the operation is finished.
+     * @param[in] sharedSocket
+     *   Socket shared with other operations.
+     **/
+    void reset(
+      AdmissionControl::Session session = {},
+      SharedSocketPtr sharedSocket = {} );
+
     //! @copydoc WriteOperation::tftpTimeout()
     WriteOperation& tftpTimeout( std::chrono::seconds timeout ) override;
 
@@ -61,6 +80,9 @@ class WriteOperationImpl final : public WriteOperation, private OperationImpl
     //! @copydoc WriteOperation::dally()
     WriteOperation& dally( bool dally ) override;
 
+    //! @copydoc OperationImpl::tuningProfile()
+    void tuningProfile( TuningConfiguration::Profile profile );
+
     //! @copydoc WriteOperation::optionsConfiguration()
     WriteOperation& optionsConfiguration( TftpOptionsConfiguration optionsConfiguration ) override;
 
@@ -76,6 +98,9 @@ class WriteOperationImpl final : public WriteOperation, private OperationImpl
     //! @copydoc WriteOperation::local()
     WriteOperation& local( boost::asio::ip::udp::endpoint local ) override;
 
+    //! @copydoc WriteOperation::socketBufferSizes()
+    WriteOperation& socketBufferSizes( SocketBufferSizes socketBufferSizes ) override;
+
     //! @copydoc WriteOperation::clientOptions()
     WriteOperation& clientOptions( Packets::TftpOptions clientOptions ) override;
 
@@ -103,6 +128,8 @@ class WriteOperationImpl final : public WriteOperation, private OperationImpl
      *
      * The received data packet is checked, and the TftpReadOperationHandler::receivedData() operation of the registered
      * handler is called.
+     * On the last data packet, the handler is finished before the packet is acknowledged, so errors of the handler are
+     * reported to the client.
      **/
     void dataPacket( const boost::asio::ip::udp::endpoint &remote, const Packets::DataPacket &dataPacket ) override;
 
@@ -131,6 +158,8 @@ class WriteOperationImpl final : public WriteOperation, private OperationImpl
     uint16_t receiveDataSize{ Packets::DefaultDataSize };
     //! Last received block number.
     Packets::BlockNumber lastReceivedBlockNumber{ 0U };
+    //! The data handler has been finished on reception of the last data packet.
+    bool dataHandlerFinishedV{ false };
 };
 
 }
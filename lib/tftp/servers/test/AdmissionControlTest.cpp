@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::Servers::AdmissionControl.
+ **/
+
+#include <tftp/servers/implementation/AdmissionControl.hpp>
+
+#include <tftp/TftpException.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+namespace Tftp::Servers {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( ServersTest )
+BOOST_AUTO_TEST_SUITE( AdmissionControlTest )
+
+//! Burst of an address bucket and rejection, when it is empty
+BOOST_AUTO_TEST_CASE( addressBurst )
+{
+  AdmissionControl admissionControl{};
+
+  AdmissionConfiguration configuration{};
+  configuration.addressRate = 1.0;
+  configuration.addressBurst = 3U;
+  admissionControl.configuration( configuration );
+
+  const auto client1{ boost::asio::ip::make_address( "192.168.1.1" ) };
+  const auto client2{ boost::asio::ip::make_address( "192.168.1.2" ) };
+  const AdmissionControl::Clock::time_point now{};
+
+  for ( unsigned int request{ 0U }; request < 3U; ++request )
+  {
+    BOOST_CHECK( admissionControl.admit( client1, now ) == AdmissionControl::Result::Accepted );
+  }
+
+  BOOST_CHECK( admissionControl.admit( client1, now ) == AdmissionControl::Result::AddressRateExceeded );
+
+  // other clients have their own bucket
+  BOOST_CHECK( admissionControl.admit( client2, now ) == AdmissionControl::Result::Accepted );
+
+  const auto statistic{ admissionControl.statistic() };
+  BOOST_CHECK_EQUAL( statistic.accepted, 4U );
+  BOOST_CHECK_EQUAL( statistic.rejectedAddressRate, 1U );
+}
+
+//! Refill of a bucket with the configured rate, limited to the burst
+BOOST_AUTO_TEST_CASE( refill )
+{
+  AdmissionControl admissionControl{};
+
+  AdmissionConfiguration configuration{};
+  configuration.addressRate = 2.0;
+  configuration.addressBurst = 2U;
+  admissionControl.configuration( configuration );
+
+  const auto client{ boost::asio::ip::make_address( "10.0.0.1" ) };
+  const AdmissionControl::Clock::time_point now{};
+
+  BOOST_CHECK( admissionControl.admit( client, now ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK( admissionControl.admit( client, now ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK( admissionControl.admit( client, now ) == AdmissionControl::Result::AddressRateExceeded );
+
+  // half a token after 250 ms
+  BOOST_CHECK(
+    admissionControl.admit( client, now + std::chrono::milliseconds{ 250 } )
+      == AdmissionControl::Result::AddressRateExceeded );
+
+  // one token after 500 ms
+  BOOST_CHECK(
+    admissionControl.admit( client, now + std::chrono::milliseconds{ 500 } ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK(
+    admissionControl.admit( client, now + std::chrono::milliseconds{ 500 } )
+      == AdmissionControl::Result::AddressRateExceeded );
+
+  // a long pause refills the bucket up to the burst only
+  const auto later{ now + std::chrono::seconds{ 60 } };
+  BOOST_CHECK( admissionControl.admit( client, later ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK( admissionControl.admit( client, later ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK( admissionControl.admit( client, later ) == AdmissionControl::Result::AddressRateExceeded );
+}
+
+//! Tokens are only consumed, when all limits are met
+BOOST_AUTO_TEST_CASE( subnetAndGlobal )
+{
+  AdmissionControl admissionControl{};
+
+  AdmissionConfiguration configuration{};
+  configuration.addressRate = 1.0;
+  configuration.addressBurst = 1U;
+  configuration.subnetRate = 1.0;
+  configuration.subnetBurst = 2U;
+  configuration.globalRate = 1.0;
+  configuration.globalBurst = 3U;
+  admissionControl.configuration( configuration );
+
+  const AdmissionControl::Clock::time_point now{};
+
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "10.0.0.1" ), now ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "10.0.0.1" ), now )
+      == AdmissionControl::Result::AddressRateExceeded );
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "10.0.0.2" ), now ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "10.0.0.3" ), now )
+      == AdmissionControl::Result::SubnetRateExceeded );
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "10.0.1.1" ), now ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "10.0.2.1" ), now )
+      == AdmissionControl::Result::GlobalRateExceeded );
+
+  const auto statistic{ admissionControl.statistic() };
+  BOOST_CHECK_EQUAL( statistic.accepted, 3U );
+  BOOST_CHECK_EQUAL( statistic.rejectedAddressRate, 1U );
+  BOOST_CHECK_EQUAL( statistic.rejectedSubnetRate, 1U );
+  BOOST_CHECK_EQUAL( statistic.rejectedGlobalRate, 1U );
+}
+
+//! Session limit
+BOOST_AUTO_TEST_CASE( sessions )
+{
+  auto admissionControl{ std::make_shared< AdmissionControl >() };
+
+  AdmissionConfiguration configuration{};
+  configuration.maxSessions = 1U;
+  admissionControl->configuration( configuration );
+
+  const auto client{ boost::asio::ip::make_address( "10.0.0.1" ) };
+
+  {
+    AdmissionControl::Session session{ admissionControl };
+    BOOST_CHECK( admissionControl->admit( client ) == AdmissionControl::Result::SessionsExceeded );
+    BOOST_CHECK_EQUAL( admissionControl->statistic().activeSessions, 1U );
+  }
+
+  BOOST_CHECK( admissionControl->admit( client ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK_EQUAL( admissionControl->statistic().activeSessions, 0U );
+}
+
+//! IPv4-mapped IPv6 client addresses are assigned to their IPv4 subnet
+BOOST_AUTO_TEST_CASE( mappedSubnet )
+{
+  AdmissionControl admissionControl{};
+
+  AdmissionConfiguration configuration{};
+  configuration.subnetRate = 1.0;
+  configuration.subnetBurst = 1U;
+  admissionControl.configuration( configuration );
+
+  const AdmissionControl::Clock::time_point now{};
+
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "::ffff:10.0.0.1" ), now )
+      == AdmissionControl::Result::Accepted );
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "::ffff:10.0.0.2" ), now )
+      == AdmissionControl::Result::SubnetRateExceeded );
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "::ffff:10.0.1.1" ), now )
+      == AdmissionControl::Result::Accepted );
+}
+
+//! The number of buckets is bounded, also when no bucket is full
+BOOST_AUTO_TEST_CASE( maxBuckets )
+{
+  AdmissionControl admissionControl{};
+
+  AdmissionConfiguration configuration{};
+  configuration.addressRate = 0.001;
+  configuration.addressBurst = 1U;
+  admissionControl.configuration( configuration );
+
+  const AdmissionControl::Clock::time_point now{};
+
+  // flood with many source addresses - every bucket is emptied and does not refill in time
+  for ( uint32_t client{ 0U }; client < AdmissionControl::MaxBuckets; ++client )
+  {
+    const boost::asio::ip::address_v4 address{ 0x0a000000U + client };
+
+    BOOST_CHECK( admissionControl.admit( address, now + std::chrono::milliseconds{ client } )
+      == AdmissionControl::Result::Accepted );
+  }
+
+  BOOST_CHECK_EQUAL( admissionControl.buckets(), AdmissionControl::MaxBuckets );
+
+  // further clients share the overflow bucket - no bucket is evicted, which would grant a new burst
+  const auto flood{ now + std::chrono::seconds{ 10 } };
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "10.1.0.1" ), flood ) == AdmissionControl::Result::Accepted );
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "10.1.0.2" ), flood )
+      == AdmissionControl::Result::AddressRateExceeded );
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::address_v4{ 0x0a000000U }, flood )
+      == AdmissionControl::Result::AddressRateExceeded );
+  BOOST_CHECK_EQUAL( admissionControl.buckets(), AdmissionControl::MaxBuckets );
+
+  // refilled buckets are removed
+  BOOST_CHECK(
+    admissionControl.admit( boost::asio::ip::make_address( "10.1.0.3" ), now + std::chrono::hours{ 1 } )
+      == AdmissionControl::Result::Accepted );
+  BOOST_CHECK_EQUAL( admissionControl.buckets(), 1U );
+}
+
+//! Limits, which would reject every request, are rejected
+BOOST_AUTO_TEST_CASE( invalidConfiguration )
+{
+  AdmissionControl admissionControl{};
+
+  AdmissionConfiguration configuration{};
+  configuration.addressRate = 0.0;
+  BOOST_CHECK_THROW( admissionControl.configuration( configuration ), TftpException );
+
+  configuration.addressRate = 1.0;
+  configuration.addressBurst = 0U;
+  BOOST_CHECK_THROW( admissionControl.configuration( configuration ), TftpException );
+
+  configuration.addressBurst = 1U;
+  configuration.globalRate = -1.0;
+  BOOST_CHECK_THROW( admissionControl.configuration( configuration ), TftpException );
+
+  configuration.globalRate = 1.0;
+  BOOST_CHECK_NO_THROW( admissionControl.configuration( configuration ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::Servers::ContentRouter.
+ **/
+
+#include <tftp/servers/ContentRouter.hpp>
+
+#include <tftp/files/File.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <expected>
+#include <optional>
+#include <regex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+
+namespace Tftp::Servers {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( ServersTest )
+BOOST_AUTO_TEST_SUITE( ContentRouterTest )
+
+namespace {
+
+//! Remote Endpoint of the Requests
+const boost::asio::ip::udp::endpoint Remote{ boost::asio::ip::make_address( "192.168.1.10" ), 1234U };
+
+//! Returns the content of the resolved file
+std::string content( const std::optional< ContentRouter::Result > &result )
+{
+  if ( !result || !*result )
+  {
+    return {};
+  }
+
+  const auto &file{ **result };
+  file->start();
+  const auto data{ file->sendData( 1024U ) };
+  file->finished();
+
+  // NOLINTNEXTLINE( cppcoreguidelines-pro-type-reinterpret-cast ): std::byte to char view
+  return { reinterpret_cast< const char * >( data.data() ), data.size() };
+}
+
+//! Returns a generator, which renders @p text and counts its calls
+ContentRouter::ContentGenerator generator( const std::string_view text, unsigned int &calls )
+{
+  return [ text, &calls ]( const auto &, const std::smatch &match ) -> ContentRouter::Content
+  {
+    ++calls;
+    const auto rendered{ std::string{ text } + match[ 0 ].str() };
+    const auto bytes{ std::as_bytes( std::span{ rendered } ) };
+    return Helper::RawData{ bytes.begin(), bytes.end() };
+  };
+}
+
+}
+
+//! The first route, which matches the whole filename, is used
+BOOST_AUTO_TEST_CASE( matchOrder )
+{
+  unsigned int calls1{ 0U };
+  unsigned int calls2{ 0U };
+
+  ContentRouter router{};
+  router
+    .route( std::regex{ "a.*" }, generator( "1:", calls1 ) )
+    .route( std::regex{ "ab.*" }, generator( "2:", calls2 ) )
+    .route( std::regex{ "b" }, generator( "3:", calls2 ) );
+
+  BOOST_CHECK_EQUAL( content( router.resolve( Remote, RequestType::Read, "abc" ) ), "1:abc" );
+  BOOST_CHECK_EQUAL( calls1, 1U );
+  BOOST_CHECK_EQUAL( calls2, 0U );
+
+  // partial matches are not routed
+  BOOST_CHECK( !router.resolve( Remote, RequestType::Read, "bc" ) );
+  BOOST_CHECK( !router.resolve( Remote, RequestType::Read, "cab" ) );
+  BOOST_CHECK_EQUAL( content( router.resolve( Remote, RequestType::Read, "b" ) ), "3:b" );
+
+  // the transfer size is the size of the rendered content
+  const auto result{ router.resolve( Remote, RequestType::Read, "abcd" ) };
+  BOOST_REQUIRE( result && *result );
+  BOOST_CHECK( ( **result )->requestedTransferSize() == 6U );
+}
+
+//! Write requests to routed files are rejected without rendering
+BOOST_AUTO_TEST_CASE( writeRequest )
+{
+  unsigned int calls{ 0U };
+
+  ContentRouter router{};
+  router.route( std::regex{ "cfg/.*" }, generator( "", calls ) );
+
+  const auto result{ router.resolve( Remote, RequestType::Write, "cfg/device" ) };
+  BOOST_REQUIRE( result );
+  BOOST_CHECK( *result == std::unexpected( Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK_EQUAL( calls, 0U );
+
+  // not routed write requests are handled otherwise
+  BOOST_CHECK( !router.resolve( Remote, RequestType::Write, "upload" ) );
+}
+
+//! Errors of generators are responded
+BOOST_AUTO_TEST_CASE( generatorError )
+{
+  ContentRouter router{};
+  router
+    .route(
+      std::regex{ "missing" },
+      []( const auto &, const auto & ) -> ContentRouter::Content
+      {
+        return std::unexpected( Packets::ErrorCode::FileNotFound );
+      } )
+    .route(
+      std::regex{ "throw" },
+      []( const auto &, const auto & ) -> ContentRouter::Content { throw std::runtime_error{ "generator" }; } );
+
+  BOOST_CHECK( router.resolve( Remote, RequestType::Read, "missing" )
+    == std::unexpected( Packets::ErrorCode::FileNotFound ) );
+  BOOST_CHECK( router.resolve( Remote, RequestType::Read, "throw" )
+    == std::unexpected( Packets::ErrorCode::NotDefined ) );
+}
+
+//! Content is shared by the cache key and the cache keys of different routes do not collide
+BOOST_AUTO_TEST_CASE( cacheKey )
+{
+  unsigned int calls1{ 0U };
+  unsigned int calls2{ 0U };
+
+  const auto deviceClass{ []( const auto &, const std::smatch &match ){ return match[ 1 ].str(); } };
+
+  ContentRouter router{};
+  router
+    .cache( std::chrono::hours{ 1 }, 10U )
+    .route( std::regex{ "a/([a-z]+)-[0-9]+" }, generator( "1:", calls1 ), deviceClass )
+    .route( std::regex{ "b/([a-z]+)-[0-9]+" }, generator( "2:", calls2 ), deviceClass );
+
+  BOOST_CHECK_EQUAL( content( router.resolve( Remote, RequestType::Read, "a/switch-1" ) ), "1:a/switch-1" );
+  // same device class - served from cache
+  BOOST_CHECK_EQUAL( content( router.resolve( Remote, RequestType::Read, "a/switch-2" ) ), "1:a/switch-1" );
+  BOOST_CHECK_EQUAL( calls1, 1U );
+
+  // same key of another route
+  BOOST_CHECK_EQUAL( content( router.resolve( Remote, RequestType::Read, "b/switch-1" ) ), "2:b/switch-1" );
+  BOOST_CHECK_EQUAL( calls2, 1U );
+
+  BOOST_CHECK_EQUAL( content( router.resolve( Remote, RequestType::Read, "a/router-1" ) ), "1:a/router-1" );
+  BOOST_CHECK_EQUAL( calls1, 2U );
+
+  router.clearCache();
+  BOOST_CHECK_EQUAL( content( router.resolve( Remote, RequestType::Read, "a/switch-2" ) ), "1:a/switch-2" );
+  BOOST_CHECK_EQUAL( calls1, 3U );
+}
+
+//! Cached content expires
+BOOST_AUTO_TEST_CASE( timeToLive )
+{
+  unsigned int calls{ 0U };
+
+  ContentRouter router{};
+  router.route( std::regex{ ".*" }, generator( "", calls ) );
+
+  // not cached by default
+  std::ignore = router.resolve( Remote, RequestType::Read, "file" );
+  std::ignore = router.resolve( Remote, RequestType::Read, "file" );
+  BOOST_CHECK_EQUAL( calls, 2U );
+
+  router.cache( std::chrono::milliseconds{ 100 }, 10U );
+  std::ignore = router.resolve( Remote, RequestType::Read, "file" );
+  std::ignore = router.resolve( Remote, RequestType::Read, "file" );
+  BOOST_CHECK_EQUAL( calls, 3U );
+
+  std::this_thread::sleep_for( std::chrono::milliseconds{ 150 } );
+  std::ignore = router.resolve( Remote, RequestType::Read, "file" );
+  BOOST_CHECK_EQUAL( calls, 4U );
+}
+
+//! Further content is not cached, when the cache is full
+BOOST_AUTO_TEST_CASE( capacity )
+{
+  unsigned int calls{ 0U };
+
+  ContentRouter router{};
+  router
+    .cache( std::chrono::hours{ 1 }, 1U )
+    .route( std::regex{ ".*" }, generator( "", calls ) );
+
+  std::ignore = router.resolve( Remote, RequestType::Read, "file1" );
+  std::ignore = router.resolve( Remote, RequestType::Read, "file2" );
+  BOOST_CHECK_EQUAL( calls, 2U );
+
+  // the first entry is kept
+  std::ignore = router.resolve( Remote, RequestType::Read, "file1" );
+  BOOST_CHECK_EQUAL( calls, 2U );
+
+  std::ignore = router.resolve( Remote, RequestType::Read, "file2" );
+  BOOST_CHECK_EQUAL( calls, 3U );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::Servers::FileResolver.
+ **/
+
+#include <tftp/servers/FileResolver.hpp>
+#include <tftp/servers/implementation/OpenBeneath.hpp>
+
+#include <tftp/files/File.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cerrno>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Tftp::Servers {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( ServersTest )
+BOOST_AUTO_TEST_SUITE( FileResolverTest )
+
+namespace {
+
+//! Root Directory with Files, Directories, FIFOs, and Symbolic Links within a temporary Directory
+struct RootFixture
+{
+  RootFixture() :
+    directory{ std::filesystem::temp_directory_path() / std::format( "tftp-root-{}", std::random_device{}() ) },
+    root{ directory / "root" }
+  {
+    std::filesystem::create_directories( root / "sub" );
+    std::filesystem::create_directory( root / "dir" );
+    writeFile( directory / "outside", "outside" );
+    writeFile( root / "file", "file" );
+    writeFile( root / "sub" / "file", "sub file" );
+    ::mkfifo( ( root / "fifo" ).c_str(), 0600 );
+    // escaping the root directory
+    std::filesystem::create_symlink( "../outside", root / "link" );
+    std::filesystem::create_symlink( directory / "outside", root / "absoluteLink" );
+    // within the root directory
+    std::filesystem::create_directory_symlink( "sub", root / "subLink" );
+
+    rootDescriptor = ::open( root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+  }
+
+  ~RootFixture()
+  {
+    ::close( rootDescriptor );
+
+    std::error_code error;
+    std::filesystem::remove_all( directory, error );
+  }
+
+  //! Writes @p content to the file at @p path
+  static void writeFile( const std::filesystem::path &path, const std::string_view content )
+  {
+    std::ofstream{ path } << content;
+  }
+
+  //! Returns the content of the file at @p path
+  static std::string readFile( const std::filesystem::path &path )
+  {
+    std::ifstream stream{ path };
+    return { std::istreambuf_iterator< char >{ stream }, std::istreambuf_iterator< char >{} };
+  }
+
+  //! Returns, if opening @p filename by openComponents() fails with @p error
+  bool componentsError( const std::string_view filename, const int flags, const int error ) const
+  {
+    errno = 0;
+    const auto fileDescriptor{ openComponents( rootDescriptor, filename, flags ) };
+
+    if ( fileDescriptor >= 0 )
+    {
+      ::close( fileDescriptor );
+      return false;
+    }
+
+    return error == errno;
+  }
+
+  //! Returns, if @p filename can be opened by @p open
+  template< typename OpenT >
+  bool opens( const OpenT &open, const std::string &filename, const int flags ) const
+  {
+    const auto fileDescriptor{ open( rootDescriptor, filename, flags ) };
+
+    if ( fileDescriptor < 0 )
+    {
+      return false;
+    }
+
+    ::close( fileDescriptor );
+    return true;
+  }
+
+  std::filesystem::path directory;
+  std::filesystem::path root;
+  int rootDescriptor{ -1 };
+};
+
+//! Returns, if opening @p filename by @p resolver fails with @p errorCode
+bool fails(
+  const FileResolver &resolver,
+  const std::string_view filename,
+  const RequestType requestType,
+  const Packets::ErrorCode errorCode )
+{
+  const auto result{ resolver.open( filename, requestType ) };
+  return !result && ( errorCode == result.error() );
+}
+
+//! Data as raw data span
+Helper::ConstRawDataSpan rawData( const std::string_view data )
+{
+  return std::as_bytes( std::span{ data } );
+}
+
+}
+
+//! Read requests are contained within the root directory
+BOOST_FIXTURE_TEST_CASE( readRequest, RootFixture )
+{
+  const FileResolver resolver{ root };
+
+  BOOST_CHECK( resolver.open( "file", RequestType::Read ) );
+  BOOST_CHECK( resolver.open( "sub/file", RequestType::Read ) );
+  BOOST_CHECK( resolver.open( "./sub//file", RequestType::Read ) );
+
+  BOOST_CHECK( fails( resolver, "../outside", RequestType::Read, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK( fails( resolver, "sub/../../outside", RequestType::Read, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK(
+    fails( resolver, ( directory / "outside" ).string(), RequestType::Read, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK( fails( resolver, "link", RequestType::Read, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK( fails( resolver, "absoluteLink", RequestType::Read, Packets::ErrorCode::AccessViolation ) );
+
+  // not regular files
+  BOOST_CHECK( fails( resolver, "fifo", RequestType::Read, Packets::ErrorCode::FileNotFound ) );
+  BOOST_CHECK( fails( resolver, "dir", RequestType::Read, Packets::ErrorCode::FileNotFound ) );
+  BOOST_CHECK( fails( resolver, "missing", RequestType::Read, Packets::ErrorCode::FileNotFound ) );
+}
+
+//! Write requests are contained within the root directory and create the file on the first data
+BOOST_FIXTURE_TEST_CASE( writeRequest, RootFixture )
+{
+  const FileResolver resolver{ root };
+
+  BOOST_CHECK( fails( resolver, "../created", RequestType::Write, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK(
+    fails( resolver, ( directory / "created" ).string(), RequestType::Write, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK( fails( resolver, "link", RequestType::Write, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK( fails( resolver, "fifo", RequestType::Write, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK( fails( resolver, "dir", RequestType::Write, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK( fails( resolver, "sub/..", RequestType::Write, Packets::ErrorCode::AccessViolation ) );
+  BOOST_CHECK( fails( resolver, "missing/created", RequestType::Write, Packets::ErrorCode::FileNotFound ) );
+  BOOST_CHECK( !std::filesystem::exists( directory / "created" ) );
+  BOOST_CHECK_EQUAL( readFile( directory / "outside" ), "outside" );
+
+  // a failed transfer does not create the file
+  {
+    const auto file{ resolver.open( "sub/created", RequestType::Write ) };
+    BOOST_REQUIRE( file );
+    ( *file )->start();
+    ( *file )->finished();
+    BOOST_CHECK( !std::filesystem::exists( root / "sub" / "created" ) );
+  }
+
+  // the file is created on the first data
+  {
+    const auto file{ resolver.open( "sub/created", RequestType::Write ) };
+    BOOST_REQUIRE( file );
+    ( *file )->start();
+    BOOST_CHECK( !std::filesystem::exists( root / "sub" / "created" ) );
+    ( *file )->receivedData( rawData( "created" ) );
+    ( *file )->finished();
+    BOOST_CHECK_EQUAL( readFile( root / "sub" / "created" ), "created" );
+  }
+
+  // an existing file is truncated on the first data
+  {
+    const auto file{ resolver.open( "file", RequestType::Write ) };
+    BOOST_REQUIRE( file );
+    ( *file )->start();
+    BOOST_CHECK_EQUAL( readFile( root / "file" ), "file" );
+    ( *file )->receivedData( rawData( "new" ) );
+    ( *file )->finished();
+    BOOST_CHECK_EQUAL( readFile( root / "file" ), "new" );
+  }
+
+  // the file is replaced by a FIFO after the request
+  {
+    const auto file{ resolver.open( "replaced", RequestType::Write ) };
+    BOOST_REQUIRE( file );
+    ( *file )->start();
+    ::mkfifo( ( root / "replaced" ).c_str(), 0600 );
+    BOOST_CHECK_THROW( ( *file )->receivedData( rawData( "replaced" ) ), std::exception );
+  }
+}
+
+//! The NETASCII transfer size is determined on request and follows changes of the file
+BOOST_FIXTURE_TEST_CASE( netascii, RootFixture )
+{
+  const FileResolver resolver{ root };
+
+  writeFile( root / "text", "a\nb\n" );
+  {
+    const auto file{ resolver.open( "text", RequestType::Read, Packets::TransferMode::NETASCII ) };
+    BOOST_REQUIRE( file );
+    ( *file )->start();
+    BOOST_CHECK( ( *file )->requestedTransferSize() == 6U );
+    BOOST_CHECK( ( *file )->sendData( 512U ).size() == 6U );
+  }
+
+  // the file is changed (size and modification time)
+  writeFile( root / "text", "a\nb\nc\n" );
+  {
+    const auto file{ resolver.open( "text", RequestType::Read, Packets::TransferMode::NETASCII ) };
+    BOOST_REQUIRE( file );
+    ( *file )->start();
+    BOOST_CHECK( ( *file )->requestedTransferSize() == 9U );
+  }
+}
+
+//! Component-wise resolution (fallback without `openat2()`)
+BOOST_FIXTURE_TEST_CASE( components, RootFixture )
+{
+  BOOST_CHECK( opens( openComponents, "file", O_RDONLY ) );
+  BOOST_CHECK( opens( openComponents, "sub/file", O_RDONLY ) );
+  BOOST_CHECK( opens( openComponents, "./sub//file", O_RDONLY ) );
+  BOOST_CHECK( opens( openComponents, "fifo", O_RDONLY | O_NONBLOCK ) );
+  BOOST_CHECK( opens( openComponents, "dir", O_RDONLY | O_DIRECTORY ) );
+
+  BOOST_CHECK( componentsError( "../outside", O_RDONLY, EXDEV ) );
+  BOOST_CHECK( componentsError( "sub/../file", O_RDONLY, EXDEV ) );
+  BOOST_CHECK( componentsError( ( directory / "outside" ).string(), O_RDONLY, EXDEV ) );
+  BOOST_CHECK( componentsError( "link", O_RDONLY, ELOOP ) );
+  BOOST_CHECK( componentsError( "absoluteLink", O_RDONLY, ELOOP ) );
+  // all symbolic links are rejected, also within the root directory (not followed as directory)
+  BOOST_CHECK( componentsError( "subLink/file", O_RDONLY, ENOTDIR ) );
+  BOOST_CHECK( componentsError( "missing/file", O_RDONLY, ENOENT ) );
+
+  // create a file
+  BOOST_CHECK( opens( openComponents, "sub/created", O_WRONLY | O_CREAT ) );
+  BOOST_CHECK( std::filesystem::is_regular_file( root / "sub" / "created" ) );
+  BOOST_CHECK( componentsError( "../created", O_WRONLY | O_CREAT, EXDEV ) );
+  BOOST_CHECK( componentsError( "link", O_WRONLY | O_CREAT, ELOOP ) );
+  BOOST_CHECK( !std::filesystem::exists( directory / "created" ) );
+  BOOST_CHECK_EQUAL( readFile( directory / "outside" ), "outside" );
+}
+
+//! Resolution beneath the root directory (`openat2()`, if supported by the kernel)
+BOOST_FIXTURE_TEST_CASE( beneath, RootFixture )
+{
+  BOOST_CHECK( opens( openBeneath, "file", O_RDONLY ) );
+  BOOST_CHECK( opens( openBeneath, "sub/file", O_RDONLY ) );
+  BOOST_CHECK( opens( openBeneath, "dir", O_RDONLY | O_DIRECTORY ) );
+
+  BOOST_CHECK( !opens( openBeneath, "../outside", O_RDONLY ) );
+  BOOST_CHECK( !opens( openBeneath, "sub/../../outside", O_RDONLY ) );
+  BOOST_CHECK( !opens( openBeneath, ( directory / "outside" ).string(), O_RDONLY ) );
+  BOOST_CHECK( !opens( openBeneath, "link", O_RDONLY ) );
+  BOOST_CHECK( !opens( openBeneath, "absoluteLink", O_RDONLY ) );
+
+  BOOST_CHECK( opens( openBeneath, "created", O_WRONLY | O_CREAT ) );
+  BOOST_CHECK( std::filesystem::is_regular_file( root / "created" ) );
+  BOOST_CHECK( !opens( openBeneath, "../created", O_WRONLY | O_CREAT ) );
+  BOOST_CHECK( !opens( openBeneath, "link", O_WRONLY | O_CREAT ) );
+  BOOST_CHECK( !std::filesystem::exists( directory / "created" ) );
+  BOOST_CHECK_EQUAL( readFile( directory / "outside" ), "outside" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Template Tftp::Servers::OperationPool.
+ **/
+
+#include <tftp/servers/implementation/OperationPool.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+#include <memory>
+#include <utility>
+
+namespace Tftp::Servers {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( ServersTest )
+BOOST_AUTO_TEST_SUITE( OperationPoolTest )
+
+namespace {
+
+//! Operation, which records its construction, reset and destruction
+class TestOperation final
+{
+  public:
+    //! Operation Counters
+    struct Counters
+    {
+      //! Number of constructed Operations
+      unsigned int constructed{ 0U };
+      //! Number of destroyed Operations
+      unsigned int destroyed{ 0U };
+      //! Number of Resets on Release
+      unsigned int released{ 0U };
+    };
+
+    explicit TestOperation( boost::asio::io_context &, std::shared_ptr< Counters > counters = {} ) :
+      countersV{ std::move( counters ) }
+    {
+      if ( countersV )
+      {
+        ++countersV->constructed;
+      }
+    }
+
+    TestOperation( const TestOperation & ) = delete;
+    TestOperation &operator=( const TestOperation & ) = delete;
+
+    ~TestOperation()
+    {
+      if ( countersV )
+      {
+        ++countersV->destroyed;
+      }
+    }
+
+    //! Reset on Release
+    void reset()
+    {
+      if ( countersV )
+      {
+        ++countersV->released;
+      }
+
+      argumentV.reset();
+    }
+
+    //! Reset on Reuse
+    void reset( std::shared_ptr< Counters > counters )
+    {
+      countersV = std::move( counters );
+    }
+
+    //! Argument held until release
+    std::shared_ptr< int > argumentV;
+
+  private:
+    //! Counters
+    std::shared_ptr< Counters > countersV;
+};
+
+}
+
+//! Operations are constructed, when the pool is empty or disabled
+BOOST_AUTO_TEST_CASE( acquire )
+{
+  boost::asio::io_context ioContext{ 1 };
+  OperationPool< TestOperation > pool{ ioContext };
+
+  // pooling disabled
+  {
+    const auto operation{ pool.acquire() };
+    BOOST_CHECK( operation );
+  }
+
+  auto statistic{ pool.statistic() };
+  BOOST_CHECK_EQUAL( statistic.misses, 1U );
+  BOOST_CHECK_EQUAL( statistic.recycled, 0U );
+  BOOST_CHECK_EQUAL( statistic.available, 0U );
+
+  pool.capacity( 2U );
+  pool.fill();
+  BOOST_CHECK_EQUAL( pool.statistic().available, 2U );
+
+  {
+    const auto operation1{ pool.acquire() };
+    const auto operation2{ pool.acquire() };
+    const auto operation3{ pool.acquire() };
+    BOOST_CHECK_EQUAL( pool.statistic().available, 0U );
+  }
+
+  // the third operation exceeds the capacity
+  statistic = pool.statistic();
+  BOOST_CHECK_EQUAL( statistic.hits, 2U );
+  BOOST_CHECK_EQUAL( statistic.misses, 2U );
+  BOOST_CHECK_EQUAL( statistic.recycled, 2U );
+  BOOST_CHECK_EQUAL( statistic.discarded, 1U );
+  BOOST_CHECK_EQUAL( statistic.available, 2U );
+
+  pool.capacity( 1U );
+  BOOST_CHECK_EQUAL( pool.statistic().available, 1U );
+}
+
+//! Released operations are reset and reused, operations outliving the pool are destroyed
+BOOST_AUTO_TEST_CASE( recycle )
+{
+  boost::asio::io_context ioContext{ 1 };
+  auto counters{ std::make_shared< TestOperation::Counters >() };
+  std::shared_ptr< TestOperation > outliving;
+
+  {
+    OperationPool< TestOperation > pool{ ioContext };
+    pool.capacity( 1U );
+
+    auto operation{ pool.acquire( counters ) };
+    const auto * const recycledOperation{ operation.get() };
+    BOOST_CHECK_EQUAL( counters->constructed, 1U );
+
+    auto argument{ std::make_shared< int >( 0 ) };
+    operation->argumentV = argument;
+
+    // the released operation is reset and its references are released
+    operation.reset();
+    BOOST_CHECK_EQUAL( counters->released, 1U );
+    BOOST_CHECK_EQUAL( counters->destroyed, 0U );
+    BOOST_CHECK_EQUAL( argument.use_count(), 1 );
+    BOOST_CHECK_EQUAL( pool.statistic().recycled, 1U );
+    BOOST_CHECK_EQUAL( pool.statistic().available, 1U );
+
+    // reuse with new arguments
+    outliving = pool.acquire( counters );
+    BOOST_CHECK( outliving.get() == recycledOperation );
+    BOOST_CHECK_EQUAL( counters->constructed, 1U );
+    BOOST_CHECK_EQUAL( pool.statistic().hits, 1U );
+  }
+
+  // the operation is destroyed without reset, when the pool is gone
+  outliving.reset();
+  BOOST_CHECK_EQUAL( counters->released, 1U );
+  BOOST_CHECK_EQUAL( counters->destroyed, 1U );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
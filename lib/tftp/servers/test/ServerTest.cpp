@@ -0,0 +1,442 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::Servers::Server.
+ **/
+
+#include <tftp/servers/Server.hpp>
+#include <tftp/servers/ReadOperation.hpp>
+#include <tftp/servers/WriteOperation.hpp>
+#include <tftp/servers/ShapingConfiguration.hpp>
+#include <tftp/servers/TuningConfiguration.hpp>
+
+#include <tftp/files/NullSourceFile.hpp>
+
+#include <tftp/packets/AcknowledgementPacket.hpp>
+#include <tftp/packets/DataPacket.hpp>
+#include <tftp/packets/ErrorPacket.hpp>
+#include <tftp/packets/OptionsAcknowledgementPacket.hpp>
+#include <tftp/packets/Packet.hpp>
+#include <tftp/packets/ReadRequestPacket.hpp>
+#include <tftp/packets/TftpOptions.hpp>
+#include <tftp/packets/WriteRequestPacket.hpp>
+
+#include <tftp/ReceiveDataHandler.hpp>
+#include <tftp/TftpOptionsConfiguration.hpp>
+#include <tftp/TransmitDataHandler.hpp>
+
+#include <helper/RawData.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace Tftp::Servers {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( ServersTest )
+BOOST_AUTO_TEST_SUITE( ServerTest )
+
+namespace {
+
+//! Data Handler, which fails after the given Number of Blocks
+class FailingDataHandler final : public TransmitDataHandler
+{
+  public:
+    explicit FailingDataHandler( const unsigned int blocks ) :
+      blocksV{ blocks }
+    {
+    }
+
+    void start() override
+    {
+    }
+
+    void finished() override
+    {
+      ++finishedV;
+    }
+
+    [[nodiscard]] std::optional< uint64_t > requestedTransferSize() override
+    {
+      return {};
+    }
+
+    [[nodiscard]] Helper::RawData sendData( const std::size_t maxSize ) override
+    {
+      if ( 0U == blocksV )
+      {
+        throw std::runtime_error{ "read error" };
+      }
+
+      --blocksV;
+      return Helper::RawData( maxSize );
+    }
+
+    //! Number of finished() calls
+    unsigned int finishedV{ 0U };
+
+  private:
+    //! Remaining Blocks
+    unsigned int blocksV;
+};
+
+//! Data Handler, which optionally fails, when it is finished
+class FinishingDataHandler final : public ReceiveDataHandler
+{
+  public:
+    explicit FinishingDataHandler( const bool fail ) :
+      failV{ fail }
+    {
+    }
+
+    void start() override
+    {
+    }
+
+    void finished() override
+    {
+      ++finishedV;
+
+      if ( failV )
+      {
+        throw std::runtime_error{ "write error" };
+      }
+    }
+
+    [[nodiscard]] bool receivedTransferSize( uint64_t ) override
+    {
+      return true;
+    }
+
+    void receivedData( Helper::ConstRawDataSpan ) override
+    {
+    }
+
+    //! Number of finished() calls
+    unsigned int finishedV{ 0U };
+
+  private:
+    //! Fail on finished()
+    const bool failV;
+};
+
+//! Handler, which is called with the remote endpoint of a received request
+using RequestHandler = std::function< void( const boost::asio::ip::udp::endpoint &remote ) >;
+
+//! Starts a server on the loopback address, which calls @p requestHandler on received requests
+ServerPtr startServer( boost::asio::io_context &ioContext, const RequestHandler &requestHandler )
+{
+  auto server{ Server::instance( ioContext ) };
+  server->serverAddress( { boost::asio::ip::address_v4::loopback(), 0U } )
+    .requestHandler(
+      [ requestHandler ](
+        const boost::asio::ip::udp::endpoint &remote,
+        RequestType,
+        std::string_view,
+        Packets::TransferMode,
+        const Packets::TftpOptions &,
+        const Packets::Options & )
+      {
+        requestHandler( remote );
+      } )
+    .tftpTimeoutDefault( std::chrono::seconds{ 1 } );
+
+  return server;
+}
+
+//! Sends @p packet from @p client to @p remote and processes it
+void send(
+  boost::asio::io_context &ioContext,
+  boost::asio::ip::udp::socket &client,
+  const Helper::ConstRawDataSpan packet,
+  const boost::asio::ip::udp::endpoint &remote )
+{
+  client.send_to( boost::asio::buffer( packet.data(), packet.size() ), remote );
+  ioContext.run_for( std::chrono::milliseconds{ 200 } );
+  ioContext.restart();
+}
+
+//! Receives the next packet by @p client and returns its type
+Packets::PacketType receive(
+  boost::asio::ip::udp::socket &client,
+  boost::asio::ip::udp::endpoint &remote,
+  Helper::RawData &buffer )
+{
+  buffer.resize( 1024U );
+  buffer.resize( client.receive_from( boost::asio::buffer( buffer ), remote ) );
+  return Packets::Packet::packetType( buffer );
+}
+
+}
+
+//! An error of the data handler of a read operation is answered with an ERROR packet and finishes the operation
+BOOST_AUTO_TEST_CASE( readDataHandlerError )
+{
+  boost::asio::io_context ioContext{ 1 };
+
+  const boost::asio::ip::address loopback{ boost::asio::ip::address_v4::loopback() };
+  boost::asio::ip::udp::socket client{ ioContext, boost::asio::ip::udp::endpoint{ loopback, 0U } };
+
+  ReadOperationPtr operation;
+  std::optional< TransferStatus > status;
+  std::shared_ptr< FailingDataHandler > dataHandler;
+
+  const ServerPtr server{ startServer(
+    ioContext,
+    [ & ]( const boost::asio::ip::udp::endpoint &remote )
+    {
+      operation = server->readOperation();
+      operation->completionHandler( [ &status ]( const TransferStatus transferStatus ){ status = transferStatus; } )
+        .dataHandler( dataHandler )
+        .remote( remote );
+      operation->start();
+    } ) };
+  server->start();
+
+  const auto request{
+    static_cast< Helper::RawData >( Packets::ReadRequestPacket{ "file", Packets::TransferMode::OCTET, {} } ) };
+  boost::asio::ip::udp::endpoint remote;
+  Helper::RawData buffer;
+
+  // on the first DATA packet
+  dataHandler = std::make_shared< FailingDataHandler >( 0U );
+  send( ioContext, client, request, server->localEndpoint() );
+
+  BOOST_CHECK( status == TransferStatus::TransferError );
+  BOOST_CHECK_EQUAL( dataHandler->finishedV, 1U );
+  BOOST_REQUIRE( receive( client, remote, buffer ) == Packets::PacketType::Error );
+  BOOST_CHECK( Packets::ErrorPacket{ buffer }.errorCode() == Packets::ErrorCode::NotDefined );
+
+  // on a following DATA packet
+  status.reset();
+  dataHandler = std::make_shared< FailingDataHandler >( 1U );
+  send( ioContext, client, request, server->localEndpoint() );
+
+  BOOST_REQUIRE( receive( client, remote, buffer ) == Packets::PacketType::Data );
+  send(
+    ioContext,
+    client,
+    static_cast< Helper::RawData >( Packets::AcknowledgementPacket{ Packets::BlockNumber{ 1U } } ),
+    remote );
+
+  BOOST_CHECK( status == TransferStatus::TransferError );
+  BOOST_CHECK_EQUAL( dataHandler->finishedV, 1U );
+  BOOST_REQUIRE( receive( client, remote, buffer ) == Packets::PacketType::Error );
+  BOOST_CHECK( Packets::ErrorPacket{ buffer }.errorCode() == Packets::ErrorCode::NotDefined );
+}
+
+//! The data handler of a write operation is finished, before the last data packet is acknowledged
+BOOST_AUTO_TEST_CASE( writeLastDataPacket )
+{
+  boost::asio::io_context ioContext{ 1 };
+
+  const boost::asio::ip::address loopback{ boost::asio::ip::address_v4::loopback() };
+  boost::asio::ip::udp::socket client{ ioContext, boost::asio::ip::udp::endpoint{ loopback, 0U } };
+
+  WriteOperationPtr operation;
+  std::optional< TransferStatus > status;
+  std::shared_ptr< FinishingDataHandler > dataHandler;
+
+  const ServerPtr server{ startServer(
+    ioContext,
+    [ & ]( const boost::asio::ip::udp::endpoint &remote )
+    {
+      operation = server->writeOperation();
+      operation->completionHandler( [ &status ]( const TransferStatus transferStatus ){ status = transferStatus; } )
+        .dataHandler( dataHandler )
+        .remote( remote );
+      operation->start();
+    } ) };
+  server->start();
+
+  const auto request{
+    static_cast< Helper::RawData >( Packets::WriteRequestPacket{ "file", Packets::TransferMode::OCTET, {} } ) };
+  const auto data{
+    static_cast< Helper::RawData >( Packets::DataPacket{ Packets::BlockNumber{ 1U }, Helper::RawData( 10U ) } ) };
+  boost::asio::ip::udp::endpoint remote;
+  Helper::RawData buffer;
+
+  for ( const bool fail : { false, true } )
+  {
+    status.reset();
+    dataHandler = std::make_shared< FinishingDataHandler >( fail );
+    send( ioContext, client, request, server->localEndpoint() );
+
+    // ACK of the request
+    BOOST_REQUIRE( receive( client, remote, buffer ) == Packets::PacketType::Acknowledgement );
+    send( ioContext, client, data, remote );
+
+    // an error of the data handler fails the transfer
+    BOOST_CHECK( receive( client, remote, buffer )
+      == ( fail ? Packets::PacketType::Error : Packets::PacketType::Acknowledgement ) );
+    BOOST_CHECK( status == ( fail ? TransferStatus::TransferError : TransferStatus::Successful ) );
+    BOOST_CHECK_EQUAL( dataHandler->finishedV, 1U );
+  }
+}
+
+//! A recycled operation does not keep the handlers, remote, timers and pacing state of its previous use
+BOOST_AUTO_TEST_CASE( recycledOperation )
+{
+  boost::asio::io_context ioContext{ 1 };
+
+  const boost::asio::ip::address loopback{ boost::asio::ip::address_v4::loopback() };
+  boost::asio::ip::udp::socket client1{ ioContext, boost::asio::ip::udp::endpoint{ loopback, 0U } };
+  boost::asio::ip::udp::socket client2{ ioContext, boost::asio::ip::udp::endpoint{ loopback, 0U } };
+
+  ReadOperationPtr operation;
+  std::function< void( ReadOperation &operation ) > configure;
+
+  const ServerPtr server{ startServer(
+    ioContext,
+    [ & ]( const boost::asio::ip::udp::endpoint &remote )
+    {
+      operation = server->readOperation();
+      configure( *operation );
+      operation->remote( remote );
+      operation->start();
+    } ) };
+
+  // the first DATA packet is delayed by about 500 ms
+  ShapingConfiguration shapingConfiguration{};
+  shapingConfiguration.sessionRate = 1024U;
+  shapingConfiguration.sessionBurst = 0U;
+  server->shapingConfiguration( shapingConfiguration ).operationPoolSize( 1U );
+  server->start();
+
+  const auto request{
+    static_cast< Helper::RawData >( Packets::ReadRequestPacket{ "file", Packets::TransferMode::OCTET, {} } ) };
+
+  auto completions1{ std::make_shared< unsigned int >( 0U ) };
+  auto dataHandler1{ std::make_shared< Files::NullSourceFile >( 1024U ) };
+  configure = [ completions1, dataHandler1 ]( ReadOperation &readOperation )
+  {
+    readOperation.completionHandler( [ completions1 ]( TransferStatus ){ ++*completions1; } )
+      .dataHandler( dataHandler1 );
+  };
+  send( ioContext, client1, request, server->localEndpoint() );
+  configure = {};
+
+  const auto * const recycledOperation{ operation.get() };
+  BOOST_CHECK_EQUAL( server->operationPoolStatistic().hits, 1U );
+
+  // the paced DATA packet is pending and the receive timer is armed
+  BOOST_CHECK_EQUAL( server->shapingStatistic().pendingPackets, 1U );
+  BOOST_CHECK_EQUAL( client1.available(), 0U );
+
+  // release without finishing the operation
+  operation.reset();
+
+  // the read and the write operation pool hold one operation each
+  BOOST_CHECK_EQUAL( server->operationPoolStatistic().recycled, 1U );
+  BOOST_CHECK_EQUAL( server->operationPoolStatistic().available, 2U );
+
+  // pacing cancelled and all references released
+  BOOST_CHECK_EQUAL( server->shapingStatistic().pendingPackets, 0U );
+  BOOST_CHECK_EQUAL( completions1.use_count(), 1 );
+  BOOST_CHECK_EQUAL( dataHandler1.use_count(), 1 );
+
+  // reuse for another client
+  auto completions2{ std::make_shared< unsigned int >( 0U ) };
+  configure = [ completions2 ]( ReadOperation &readOperation )
+  {
+    readOperation.completionHandler( [ completions2 ]( TransferStatus ){ ++*completions2; } )
+      .dataHandler( std::make_shared< Files::NullSourceFile >( 1024U ) );
+  };
+  send( ioContext, client2, request, server->localEndpoint() );
+
+  BOOST_CHECK( operation.get() == recycledOperation );
+  BOOST_CHECK_EQUAL( server->operationPoolStatistic().hits, 2U );
+
+  // neither the pacing timer nor the receive timer of the previous use fire
+  ioContext.run_for( std::chrono::milliseconds{ 800 } );
+  BOOST_CHECK_EQUAL( client1.available(), 0U );
+  BOOST_CHECK_GT( client2.available(), 0U );
+  BOOST_CHECK_EQUAL( *completions1, 0U );
+  BOOST_CHECK_EQUAL( *completions2, 0U );
+
+  operation->abort();
+  BOOST_CHECK_EQUAL( *completions1, 0U );
+  BOOST_CHECK_EQUAL( *completions2, 1U );
+}
+
+//! The tuning profile matching the request takes precedence over the configuration of the operation
+BOOST_AUTO_TEST_CASE( tuningProfile )
+{
+  boost::asio::io_context ioContext{ 1 };
+
+  const boost::asio::ip::address loopback{ boost::asio::ip::address_v4::loopback() };
+  boost::asio::ip::udp::socket client{ ioContext, boost::asio::ip::udp::endpoint{ loopback, 0U } };
+
+  ReadOperationPtr operation;
+
+  auto server{ Server::instance( ioContext ) };
+  server->serverAddress( { loopback, 0U } )
+    .requestHandler(
+      [ & ](
+        const boost::asio::ip::udp::endpoint &remote,
+        RequestType,
+        const std::string_view filename,
+        Packets::TransferMode,
+        const Packets::TftpOptions &clientOptions,
+        const Packets::Options & )
+      {
+        TftpOptionsConfiguration optionsConfiguration{};
+        optionsConfiguration.blockSizeOption = 8192U;
+
+        // the options configuration is updated after the operation is created
+        operation = server->readOperation( remote.address(), filename );
+        operation->dataHandler( std::make_shared< Files::NullSourceFile >( 4096U ) )
+          .optionsConfiguration( optionsConfiguration )
+          .remote( remote )
+          .clientOptions( clientOptions );
+        operation->start();
+      } )
+    .tftpTimeoutDefault( std::chrono::seconds{ 1 } );
+
+  TuningConfiguration tuningConfiguration{};
+  tuningConfiguration.profiles.emplace_back(
+    TuningConfiguration::Profile::fromString( "filename=tuned,block-size=1024" ) );
+  server->tuningConfiguration( std::move( tuningConfiguration ) );
+  server->start();
+
+  boost::asio::ip::udp::endpoint remote;
+  Helper::RawData buffer;
+
+  for ( const auto &[ filename, blockSize ] : { std::pair{ "tuned", "1024" }, std::pair{ "other", "4096" } } )
+  {
+    send(
+      ioContext,
+      client,
+      static_cast< Helper::RawData >(
+        Packets::ReadRequestPacket{ filename, Packets::TransferMode::OCTET, { { "blksize", "4096" } } } ),
+      server->localEndpoint() );
+
+    BOOST_REQUIRE( receive( client, remote, buffer ) == Packets::PacketType::OptionsAcknowledgement );
+    BOOST_CHECK_EQUAL( Packets::OptionsAcknowledgementPacket{ buffer }.options().at( "blksize" ), blockSize );
+    operation->abort();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
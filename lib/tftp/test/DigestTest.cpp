@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Classes Tftp::Crc32c and Tftp::Sha256.
+ **/
+
+#include <tftp/Crc32c.hpp>
+#include <tftp/Sha256.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <string_view>
+
+namespace Tftp {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( DigestTest )
+
+namespace {
+
+//! Returns the characters of @p text as raw data
+Helper::RawData rawData( const std::string_view text )
+{
+  Helper::RawData data( text.size() );
+  std::ranges::transform( text, data.begin(), []( const char c ){ return static_cast< std::byte >( c ); } );
+  return data;
+}
+
+//! Returns the digest as hex string
+std::string hex( const Sha256::Digest &digest )
+{
+  std::string result;
+
+  for ( const auto byte : digest )
+  {
+    result += std::format( "{:02x}", std::to_integer< unsigned int >( byte ) );
+  }
+
+  return result;
+}
+
+}
+
+//! CRC-32C check values
+BOOST_AUTO_TEST_CASE( crc32c )
+{
+  Crc32c crc{};
+  BOOST_CHECK_EQUAL( crc.value(), 0U );
+
+  crc.update( rawData( "123456789" ) );
+  BOOST_CHECK_EQUAL( crc.value(), 0xE306'9283U );
+
+  // incremental update with unaligned parts
+  const auto data{ rawData( "The quick brown fox jumps over the lazy dog" ) };
+  Crc32c complete{};
+  complete.update( data );
+
+  for ( size_t split{ 0U }; split <= data.size(); ++split )
+  {
+    crc.reset();
+    crc.update( Helper::ConstRawDataSpan{ data }.first( split ) );
+    crc.update( Helper::ConstRawDataSpan{ data }.subspan( split ) );
+    BOOST_CHECK_EQUAL( crc.value(), complete.value() );
+  }
+
+  BOOST_CHECK_EQUAL( complete.value(), 0x2262'0404U );
+}
+
+//! SHA-256 test vectors
+BOOST_AUTO_TEST_CASE( sha256 )
+{
+  Sha256 sha256{};
+  BOOST_CHECK_EQUAL( hex( sha256.value() ), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" );
+
+  sha256.update( rawData( "abc" ) );
+  BOOST_CHECK_EQUAL( hex( sha256.value() ), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" );
+
+  // continued calculation
+  sha256.update( rawData( "dbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq" ) );
+  BOOST_CHECK_EQUAL( hex( sha256.value() ), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" );
+
+  // block wise update of 1,000,000 'a'
+  const Helper::RawData block( 1000U, std::byte{ 'a' } );
+  sha256.reset();
+
+  for ( int count{ 0 }; count < 1000; ++count )
+  {
+    sha256.update( block );
+  }
+
+  BOOST_CHECK_EQUAL( hex( sha256.value() ), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
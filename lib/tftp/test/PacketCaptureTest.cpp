@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::PacketCapture.
+ **/
+
+#include <tftp/PacketCapture.hpp>
+
+#include <tftp/TftpException.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <sstream>
+
+namespace Tftp {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( PacketCaptureTest )
+
+namespace {
+
+//! Client Endpoint
+const boost::asio::ip::udp::endpoint client{ boost::asio::ip::make_address( "192.168.1.10" ), 4711U };
+//! Other Client Endpoint
+const boost::asio::ip::udp::endpoint otherClient{ boost::asio::ip::make_address( "fe80::1" ), 4712U };
+
+//! Test Datagram
+const Helper::RawData datagram{ std::byte{ 0x00 }, std::byte{ 0x04 }, std::byte{ 0x00 }, std::byte{ 0x01 } };
+
+}
+
+//! Capture and read test
+BOOST_AUTO_TEST_CASE( captureRead )
+{
+  auto &capture{ PacketCapture::instance() };
+  const auto stream{ std::make_shared< std::stringstream >() };
+
+  BOOST_CHECK_THROW( capture.start( {} ), TftpException );
+  BOOST_CHECK( !capture.enabled() );
+
+  // not recorded, when disabled
+  capture.record( CaptureRecord::Role::Client, CaptureRecord::Direction::Transmit, 1U, client, datagram );
+
+  capture.start( stream );
+  BOOST_CHECK( capture.enabled() );
+  capture.record( CaptureRecord::Role::Server, CaptureRecord::Direction::Receive, 0U, client, datagram );
+  capture.record( CaptureRecord::Role::Server, CaptureRecord::Direction::Transmit, 1U, otherClient, {} );
+  capture.stop();
+  BOOST_CHECK( !capture.enabled() );
+
+  capture.record( CaptureRecord::Role::Client, CaptureRecord::Direction::Transmit, 1U, client, datagram );
+
+  const auto records{ PacketCapture::read( *stream ) };
+  BOOST_REQUIRE_EQUAL( records.size(), 2U );
+
+  BOOST_CHECK_EQUAL( records[ 0 ].session, 0U );
+  BOOST_CHECK( records[ 0 ].role == CaptureRecord::Role::Server );
+  BOOST_CHECK( records[ 0 ].direction == CaptureRecord::Direction::Receive );
+  BOOST_CHECK( records[ 0 ].remote == client );
+  BOOST_CHECK( records[ 0 ].packet == datagram );
+  BOOST_CHECK( records[ 0 ].sentByClient() );
+
+  BOOST_CHECK_EQUAL( records[ 1 ].session, 1U );
+  BOOST_CHECK( records[ 1 ].remote == otherClient );
+  BOOST_CHECK( records[ 1 ].packet.empty() );
+  BOOST_CHECK( !records[ 1 ].sentByClient() );
+  BOOST_CHECK( records[ 0 ].timestamp <= records[ 1 ].timestamp );
+}
+
+//! Read of invalid captures
+BOOST_AUTO_TEST_CASE( readInvalid )
+{
+  std::stringstream empty;
+  BOOST_CHECK_THROW( static_cast< void >( PacketCapture::read( empty ) ), TftpException );
+
+  std::stringstream truncated{ std::string{ PacketCapture::FileMagic } + "short" };
+  BOOST_CHECK_THROW( static_cast< void >( PacketCapture::read( truncated ) ), TftpException );
+
+  std::stringstream headerOnly{ std::string{ PacketCapture::FileMagic } };
+  BOOST_CHECK( PacketCapture::read( headerOnly ).empty() );
+}
+
+//! Session selection test
+BOOST_AUTO_TEST_CASE( sessionRecords )
+{
+  using enum CaptureRecord::Direction;
+  const std::vector< CaptureRecord > records{
+    { 1U, 0U, CaptureRecord::Role::Server, Receive, client, datagram },
+    { 2U, 0U, CaptureRecord::Role::Server, Receive, otherClient, datagram },
+    { 3U, 5U, CaptureRecord::Role::Server, Transmit, client, datagram },
+    { 4U, 6U, CaptureRecord::Role::Server, Transmit, otherClient, datagram },
+    { 5U, 5U, CaptureRecord::Role::Server, Receive, client, datagram },
+    { 6U, 7U, CaptureRecord::Role::Client, Transmit, client, datagram } };
+
+  const auto session5{ PacketCapture::sessionRecords( records, 5U ) };
+  BOOST_REQUIRE_EQUAL( session5.size(), 3U );
+  BOOST_CHECK_EQUAL( session5[ 0 ].timestamp, 1U );
+  BOOST_CHECK_EQUAL( session5[ 1 ].timestamp, 3U );
+  BOOST_CHECK_EQUAL( session5[ 2 ].timestamp, 5U );
+
+  const auto session6{ PacketCapture::sessionRecords( records, 6U ) };
+  BOOST_REQUIRE_EQUAL( session6.size(), 2U );
+  BOOST_CHECK_EQUAL( session6[ 0 ].timestamp, 2U );
+
+  // client captures contain the request within the session
+  BOOST_CHECK_EQUAL( PacketCapture::sessionRecords( records, 7U ).size(), 1U );
+  BOOST_CHECK( PacketCapture::sessionRecords( records, 8U ).empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::PathMtu.
+ **/
+
+#include <tftp/PathMtu.hpp>
+
+#include <tftp/packets/Packets.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+
+namespace Tftp {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( PathMtuTest )
+
+//! Block size calculation test
+BOOST_AUTO_TEST_CASE( blockSize )
+{
+  BOOST_CHECK_EQUAL( PathMtu::blockSize( 1500U, false ), 1468U );
+  BOOST_CHECK_EQUAL( PathMtu::blockSize( 1500U, true ), 1448U );
+  BOOST_CHECK_EQUAL( PathMtu::blockSize( 9000U, false ), 8968U );
+
+  // limited to the block size option range
+  BOOST_CHECK_EQUAL( PathMtu::blockSize( 20U, false ), Packets::BlockSizeOptionMin );
+  BOOST_CHECK_EQUAL( PathMtu::blockSize( 65535U, false ), Packets::BlockSizeOptionMax );
+}
+
+//! Fall-back on timeout test
+BOOST_AUTO_TEST_CASE( timeout )
+{
+  PathMtu pathMtu{};
+  const boost::asio::ip::udp::endpoint remote{ boost::asio::ip::make_address( "127.0.0.1" ), 69U };
+  const auto queried{ PathMtu::query( remote ) };
+
+  BOOST_CHECK( pathMtu.mtu( remote ) == queried );
+
+  // 8968 bytes blocks fit into 9000 bytes frames - fall back to the next plateau
+  pathMtu.timeout( remote.address(), 8968U );
+  BOOST_REQUIRE( pathMtu.mtu( remote ) );
+  BOOST_CHECK( *pathMtu.mtu( remote ) <= 8166U );
+
+  pathMtu.timeout( remote.address(), 1468U );
+  BOOST_CHECK_EQUAL( *pathMtu.mtu( remote ), 1492U );
+  BOOST_CHECK_EQUAL( *pathMtu.blockSize( remote ), 1460U );
+
+  // a later timeout with a larger block size does not raise the fall-back
+  pathMtu.timeout( remote.address(), 4000U );
+  BOOST_CHECK_EQUAL( *pathMtu.mtu( remote ), 1492U );
+
+  // step down to the minimum MTU, which is not reduced
+  pathMtu.timeout( remote.address(), 1460U );
+  BOOST_CHECK_EQUAL( *pathMtu.mtu( remote ), 1280U );
+  pathMtu.timeout( remote.address(), 1248U );
+  BOOST_CHECK_EQUAL( *pathMtu.mtu( remote ), 1006U );
+  pathMtu.timeout( remote.address(), 974U );
+  BOOST_CHECK_EQUAL( *pathMtu.mtu( remote ), 576U );
+  pathMtu.timeout( remote.address(), 544U );
+  BOOST_CHECK_EQUAL( *pathMtu.mtu( remote ), 576U );
+
+  // other remotes are not affected
+  const boost::asio::ip::udp::endpoint other{ boost::asio::ip::make_address( "127.0.0.2" ), 69U };
+  BOOST_CHECK( pathMtu.mtu( other ) == PathMtu::query( other ) );
+
+  pathMtu.reset();
+  BOOST_CHECK( pathMtu.mtu( remote ) == queried );
+}
+
+//! Expiry of the fall-backs test
+BOOST_AUTO_TEST_CASE( expiry )
+{
+  PathMtu pathMtu{};
+  const boost::asio::ip::udp::endpoint remote{ boost::asio::ip::make_address( "127.0.0.1" ), 69U };
+  const auto queried{ PathMtu::query( remote ) };
+  const auto now{ PathMtu::Clock::now() };
+
+  pathMtu.timeout( remote.address(), 1468U, now );
+  BOOST_CHECK_EQUAL( *pathMtu.mtu( remote, now ), 1492U );
+  BOOST_CHECK_EQUAL( *pathMtu.mtu( remote, now + PathMtu::FallbackTtl - std::chrono::seconds{ 1 } ), 1492U );
+
+  // the repaired path is used at full size again
+  BOOST_CHECK( pathMtu.mtu( remote, now + PathMtu::FallbackTtl ) == queried );
+
+  // a timeout after the expiry starts from the failed block size
+  pathMtu.timeout( remote.address(), 8968U, now + PathMtu::FallbackTtl );
+  BOOST_REQUIRE( pathMtu.mtu( remote, now + PathMtu::FallbackTtl ) );
+  BOOST_CHECK( *pathMtu.mtu( remote, now + PathMtu::FallbackTtl ) <= 8166U );
+  BOOST_CHECK( *pathMtu.mtu( remote, now + PathMtu::FallbackTtl ) > 1492U );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
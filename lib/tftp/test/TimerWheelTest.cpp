@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::TimerWheel.
+ **/
+
+#include <tftp/TimerWheel.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace Tftp {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( TimerWheelTest )
+
+//! Timer expiry order
+BOOST_AUTO_TEST_CASE( expiry )
+{
+  boost::asio::io_context ioContext;
+  auto &timerWheel{ TimerWheel::instance( ioContext ) };
+
+  BOOST_CHECK( &timerWheel == &TimerWheel::instance( ioContext ) );
+
+  std::vector< int > expired;
+
+  TimerWheel::Timer timer1{ timerWheel };
+  TimerWheel::Timer timer2{ timerWheel };
+  TimerWheel::Timer timer3{ timerWheel };
+
+  timer1.expiresAfter( std::chrono::milliseconds{ 50 }, [ &expired ]{ expired.push_back( 1 ); } );
+  timer2.expiresAfter( std::chrono::milliseconds{ 20 }, [ &expired ]{ expired.push_back( 2 ); } );
+  timer3.expiresAfter( std::chrono::milliseconds{ 30 }, [ &expired ]{ expired.push_back( 3 ); } );
+
+  BOOST_CHECK( timer1.armed() );
+  BOOST_CHECK_EQUAL( timerWheel.size(), 3U );
+
+  // cancel timer 3
+  timer3.cancel();
+  BOOST_CHECK( !timer3.armed() );
+  BOOST_CHECK_EQUAL( timerWheel.size(), 2U );
+
+  ioContext.run();
+
+  BOOST_CHECK( ( expired == std::vector< int >{ 2, 1 } ) );
+  BOOST_CHECK_EQUAL( timerWheel.size(), 0U );
+  BOOST_CHECK( !timer1.armed() );
+}
+
+//! One timer wheel per I/O context, independent of the calling thread
+BOOST_AUTO_TEST_CASE( instance )
+{
+  boost::asio::io_context ioContext1;
+  boost::asio::io_context ioContext2;
+
+  auto * const timerWheel1{ &TimerWheel::instance( ioContext1 ) };
+  TimerWheel * otherThreadTimerWheel{ nullptr };
+
+  std::thread{ [ & ]{ otherThreadTimerWheel = &TimerWheel::instance( ioContext1 ); } }.join();
+
+  BOOST_CHECK( timerWheel1 == otherThreadTimerWheel );
+  BOOST_CHECK( timerWheel1 != &TimerWheel::instance( ioContext2 ) );
+}
+
+//! Re-arm timer, also from within handler
+BOOST_AUTO_TEST_CASE( rearm )
+{
+  boost::asio::io_context ioContext;
+  TimerWheel::Timer timer{ ioContext };
+
+  int firstHandler{ 0 };
+  int secondHandler{ 0 };
+
+  timer.expiresAfter( std::chrono::milliseconds{ 10 }, [ &firstHandler ]{ ++firstHandler; } );
+  // re-arm replaces handler
+  timer.expiresAfter(
+    std::chrono::milliseconds{ 10 },
+    [ &timer, &secondHandler ]
+    {
+      if ( ++secondHandler < 3 )
+      {
+        timer.expiresAfter( std::chrono::milliseconds{ 10 }, [ &secondHandler ]{ ++secondHandler; } );
+      }
+    } );
+
+  ioContext.run();
+
+  BOOST_CHECK_EQUAL( firstHandler, 0 );
+  BOOST_CHECK_EQUAL( secondHandler, 2 );
+}
+
+//! Timer beyond the level 0 range is cascaded
+BOOST_AUTO_TEST_CASE( cascade )
+{
+  boost::asio::io_context ioContext;
+  TimerWheel::Timer timer{ ioContext };
+
+  const auto start{ TimerWheel::Clock::now() };
+  const auto duration{ TimerWheel::Level0Slots * TimerWheel::Resolution + std::chrono::milliseconds{ 100 } };
+  TimerWheel::Clock::time_point expiry{};
+
+  timer.expiresAfter( duration, [ &expiry ]{ expiry = TimerWheel::Clock::now(); } );
+
+  ioContext.run();
+
+  BOOST_CHECK( expiry >= start + duration );
+  BOOST_CHECK( expiry < start + duration + std::chrono::milliseconds{ 500 } );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Implementation of Unit Tests of Class Tftp::TraceRing.
+ **/
+
+#include <tftp/TraceRing.hpp>
+
+#include <tftp/packets/AcknowledgementPacket.hpp>
+#include <tftp/packets/Packets.hpp>
+
+#include <tftp/TftpException.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace Tftp {
+
+BOOST_AUTO_TEST_SUITE( TftpTest )
+BOOST_AUTO_TEST_SUITE( TraceRingTest )
+
+namespace {
+
+//! Returns the records of @p session
+std::vector< TraceRecord > sessionRecords( const TraceRing &traceRing, const uint32_t session )
+{
+  auto records{ traceRing.snapshot() };
+  std::erase_if( records, [ session ]( const TraceRecord &record ){ return record.session != session; } );
+  return records;
+}
+
+}
+
+//! Record and snapshot test
+BOOST_AUTO_TEST_CASE( record )
+{
+  auto &traceRing{ TraceRing::instance() };
+  const auto session{ TraceRing::session() };
+  BOOST_CHECK( 0U != session );
+  BOOST_CHECK( session != TraceRing::session() );
+
+  traceRing.record( TraceEvent::Started, session );
+  traceRing.record(
+    TraceEvent::Transmit,
+    session,
+    static_cast< Helper::RawData >( Packets::AcknowledgementPacket{ Packets::BlockNumber{ 4711U } } ) );
+  traceRing.record( TraceEvent::Finished, session, static_cast< uint16_t >( TransferStatus::Aborted ) );
+
+  const auto records{ sessionRecords( traceRing, session ) };
+  BOOST_REQUIRE_EQUAL( records.size(), 3U );
+
+  BOOST_CHECK( records[ 0 ].event == TraceEvent::Started );
+  BOOST_CHECK( records[ 1 ].event == TraceEvent::Transmit );
+  BOOST_CHECK_EQUAL( records[ 1 ].packetType, static_cast< uint8_t >( Packets::PacketType::Acknowledgement ) );
+  BOOST_CHECK_EQUAL( records[ 1 ].value, 4711U );
+  BOOST_CHECK( records[ 2 ].event == TraceEvent::Finished );
+  BOOST_CHECK( records[ 0 ].timestamp <= records[ 2 ].timestamp );
+
+  BOOST_CHECK( !records[ 1 ].toString( records[ 0 ].timestamp ).empty() );
+}
+
+//! The ring keeps the last records
+BOOST_AUTO_TEST_CASE( wrapAround )
+{
+  auto &traceRing{ TraceRing::instance() };
+  const auto session{ TraceRing::session() };
+
+  for ( size_t index{ 0U }; index < TraceRing::Capacity + 10U; ++index )
+  {
+    traceRing.record( TraceEvent::Receive, session, static_cast< uint16_t >( index ) );
+  }
+
+  const auto records{ sessionRecords( traceRing, session ) };
+  BOOST_REQUIRE_EQUAL( records.size(), TraceRing::Capacity );
+  BOOST_CHECK_EQUAL( records.front().value, 10U );
+  BOOST_CHECK_EQUAL( records.back().value, static_cast< uint16_t >( TraceRing::Capacity + 9U ) );
+}
+
+//! Concurrent recording
+BOOST_AUTO_TEST_CASE( concurrent )
+{
+  auto &traceRing{ TraceRing::instance() };
+  std::vector< uint32_t > sessions;
+  std::vector< std::jthread > threads;
+
+  for ( size_t thread{ 0U }; thread < 4U; ++thread )
+  {
+    sessions.push_back( TraceRing::session() );
+    threads.emplace_back( [ &traceRing, session = sessions.back() ]
+    {
+      for ( uint16_t index{ 0U }; index < 1000U; ++index )
+      {
+        traceRing.record( TraceEvent::Transmit, session, index );
+      }
+    } );
+  }
+
+  threads.clear();
+
+  for ( const auto session : sessions )
+  {
+    const auto records{ sessionRecords( traceRing, session ) };
+    BOOST_REQUIRE_EQUAL( records.size(), 1000U );
+    BOOST_CHECK( std::ranges::is_sorted( records, {}, &TraceRecord::value ) );
+  }
+}
+
+//! Save and load test
+BOOST_AUTO_TEST_CASE( writeRead )
+{
+  const std::vector< TraceRecord > records{
+    { 1U, 2U, 3U, TraceEvent::Receive, static_cast< uint8_t >( Packets::PacketType::Data ) },
+    { 0xFFFF'FFFF'FFFF'FFFFU, 0xFFFF'FFFFU, 0xFFFFU, TraceEvent::Finished, 0U } };
+
+  std::stringstream stream;
+  TraceRing::write( stream, records );
+  BOOST_CHECK_EQUAL( stream.str().size(), 16U + ( 2U * TraceRecord::EncodedSize ) );
+
+  const auto loaded{ TraceRing::read( stream ) };
+  BOOST_REQUIRE_EQUAL( loaded.size(), 2U );
+  BOOST_CHECK_EQUAL( loaded[ 1 ].timestamp, records[ 1 ].timestamp );
+  BOOST_CHECK_EQUAL( loaded[ 1 ].session, records[ 1 ].session );
+  BOOST_CHECK_EQUAL( loaded[ 0 ].value, 3U );
+  BOOST_CHECK( loaded[ 0 ].event == TraceEvent::Receive );
+  BOOST_CHECK_EQUAL( loaded[ 0 ].packetType, records[ 0 ].packetType );
+
+  std::stringstream invalid{ "TFTPTRC0" };
+  BOOST_CHECK_THROW( static_cast< void >( TraceRing::read( invalid ) ), TftpException );
+
+  auto truncatedData{ stream.str() };
+  truncatedData.pop_back();
+  std::stringstream truncated{ truncatedData };
+  BOOST_CHECK_THROW( static_cast< void >( TraceRing::read( truncated ) ), TftpException );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -16,6 +16,7 @@
 
 #include <helper_qt/String.hpp>
 
+#include <algorithm>
 #include <utility>
 
 namespace TftpQt {
@@ -114,9 +115,26 @@ QVariant PacketStatisticModel::headerData( int const section, Qt::Orientation co
 
 void PacketStatisticModel::statistic( Tftp::Packets::PacketStatistic::Statistic statistic )
 {
-  beginResetModel();
+  using Packet = Tftp::Packets::PacketStatistic::Statistic::value_type;
+
+  // the packet types are added only once, so the counters are updated in place normally
+  if ( !std::ranges::equal( statisticV, statistic, {}, &Packet::first, &Packet::first ) )
+  {
+    beginResetModel();
+    statisticV = std::move( statistic );
+    endResetModel();
+    return;
+  }
+
   statisticV = std::move( statistic );
-  endResetModel();
+
+  if ( !statisticV.empty() )
+  {
+    emit dataChanged(
+      index( 0, std::to_underlying( Columns::PacketCount ) ),
+      index( static_cast< int >( statisticV.size() ) - 1, std::to_underlying( Columns::PacketSize ) ),
+      { Qt::ItemDataRole::DisplayRole } );
+  }
 }
 
 }
@@ -112,6 +112,8 @@ class TFTP_QT_EXPORT PacketStatisticModel final : public QAbstractTableModel
     /**
      * @brief Update Packet Statistic of Model.
      *
+     * When the packet types are unchanged, the counters are updated in place, otherwise the model is reset.
+     *
      * @param[in] statistic
      *   New packet statistic.
      **/
@@ -0,0 +1,293 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class TftpQt::SessionTableModel.
+ **/
+
+#include "SessionTableModel.hpp"
+
+#include <QLocale>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace TftpQt {
+
+SessionTableModel::SessionTableModel( QObject * const parent ) :
+  QAbstractTableModel{ parent }
+{
+  refreshTimerV.setSingleShot( true );
+  refreshTimerV.setInterval( DefaultRefreshInterval );
+  connect( &refreshTimerV, &QTimer::timeout, this, &SessionTableModel::refresh );
+}
+
+int SessionTableModel::rowCount( const QModelIndex &parent ) const
+{
+  if ( parent.isValid() )
+  {
+    return 0;
+  }
+
+  return static_cast< int >( rowsV.size() );
+}
+
+int SessionTableModel::columnCount( const QModelIndex &parent ) const
+{
+  if ( parent.isValid() )
+  {
+    return 0;
+  }
+
+  return std::to_underlying( Columns::ColumnsCount );
+}
+
+QVariant SessionTableModel::data( const QModelIndex &index, const int role ) const
+{
+  if ( !index.isValid() )
+  {
+    return {};
+  }
+
+  if ( std::cmp_greater_equal( index.row(), rowsV.size() ) )
+  {
+    return {};
+  }
+
+  const auto &row{ rowsV[ static_cast< std::size_t >( index.row() ) ] };
+
+  switch ( role )
+  {
+    case Qt::ItemDataRole::DisplayRole:
+      switch ( static_cast< Columns >( index.column() ) )
+      {
+        case Columns::Session:
+          return QString::number( row.session.id );
+
+        case Columns::Remote:
+          return row.session.remote;
+
+        case Columns::Filename:
+          return row.session.filename;
+
+        case Columns::Progress:
+        {
+          const auto transferred{
+            QLocale{}.formattedDataSize( static_cast< qint64 >( row.session.transferred ) ) };
+
+          if ( !row.session.size || ( 0U == *row.session.size ) )
+          {
+            return transferred;
+          }
+
+          return QStringLiteral( "%1 (%2 %)" )
+            .arg( transferred )
+            .arg(
+              100.0 * static_cast< double >( row.session.transferred ) / static_cast< double >( *row.session.size ),
+              0,
+              'f',
+              0 );
+        }
+
+        case Columns::Rate:
+          return QLocale{}.formattedDataSize( static_cast< qint64 >( row.rate ) ) + tr( "/s" );
+
+        case Columns::Retries:
+          return QString::number( row.session.retries );
+
+        default:
+          return {};
+      }
+
+    default:
+      return {};
+  }
+}
+
+QVariant SessionTableModel::headerData( int const section, Qt::Orientation const orientation, int const role ) const
+{
+  if ( role != Qt::DisplayRole )
+  {
+    return {};
+  }
+
+  if ( orientation == Qt::Vertical )
+  {
+    return section;
+  }
+
+  switch ( Columns{ section } )
+  {
+    case Columns::Session:
+      return tr( "Session" );
+
+    case Columns::Remote:
+      return tr( "Remote" );
+
+    case Columns::Filename:
+      return tr( "Filename" );
+
+    case Columns::Progress:
+      return tr( "Progress" );
+
+    case Columns::Rate:
+      return tr( "Rate" );
+
+    case Columns::Retries:
+      return tr( "Retries" );
+
+    default:
+      return {};
+  }
+}
+
+void SessionTableModel::refreshInterval( const std::chrono::milliseconds interval )
+{
+  refreshTimerV.setInterval( interval );
+}
+
+void SessionTableModel::sessions( std::vector< Session > sessions )
+{
+  pendingV = std::move( sessions );
+
+  // bound the refresh rate - later snapshots replace the pending one
+  if ( !refreshTimerV.isActive() )
+  {
+    refreshTimerV.start();
+  }
+}
+
+void SessionTableModel::refresh()
+{
+  if ( !pendingV )
+  {
+    return;
+  }
+
+  auto sessions{ std::move( *pendingV ) };
+  pendingV.reset();
+  std::ranges::sort( sessions, {}, &Session::id );
+
+  const auto now{ std::chrono::steady_clock::now() };
+  const auto active{ [ &sessions ]( const uint32_t id )
+  {
+    return std::ranges::binary_search( sessions, id, {}, &Session::id );
+  } };
+
+  // remove finished sessions - contiguous ranges from the end
+  for ( auto last{ static_cast< int >( rowsV.size() ) - 1 }; last >= 0; --last )
+  {
+    if ( active( rowsV[ static_cast< std::size_t >( last ) ].session.id ) )
+    {
+      continue;
+    }
+
+    auto first{ last };
+    while ( ( first > 0 ) && !active( rowsV[ static_cast< std::size_t >( first - 1 ) ].session.id ) )
+    {
+      --first;
+    }
+
+    beginRemoveRows( {}, first, last );
+    rowsV.erase( rowsV.begin() + first, rowsV.begin() + last + 1 );
+    endRemoveRows();
+
+    last = first;
+  }
+
+  // update existing and insert new sessions
+  std::size_t row{ 0U };
+  std::optional< int > changedFirst{};
+  int changedLast{ 0 };
+
+  for ( auto session{ sessions.begin() }; session != sessions.end(); )
+  {
+    if ( ( row < rowsV.size() ) && ( rowsV[ row ].session.id == session->id ) )
+    {
+      auto &current{ rowsV[ row ] };
+      const std::chrono::duration< double > elapsed{ now - current.updated };
+
+      if ( ( session->transferred >= current.session.transferred ) && ( elapsed.count() > 0.0 ) )
+      {
+        current.rate =
+          static_cast< double >( session->transferred - current.session.transferred ) / elapsed.count();
+      }
+
+      current.session = std::move( *session );
+      current.updated = now;
+
+      // changed rows are reported in contiguous ranges
+      const auto changedRow{ static_cast< int >( row ) };
+      if ( changedFirst && ( changedRow == changedLast + 1 ) )
+      {
+        changedLast = changedRow;
+      }
+      else
+      {
+        if ( changedFirst )
+        {
+          rowsChanged( *changedFirst, changedLast );
+        }
+
+        changedFirst = changedRow;
+        changedLast = changedRow;
+      }
+
+      ++row;
+      ++session;
+      continue;
+    }
+
+    // new sessions up to the next existing row
+    auto end{ session };
+    while ( ( end != sessions.end() ) && ( ( row == rowsV.size() ) || ( end->id != rowsV[ row ].session.id ) ) )
+    {
+      ++end;
+    }
+
+    if ( changedFirst )
+    {
+      rowsChanged( *changedFirst, changedLast );
+      changedFirst.reset();
+    }
+
+    const auto count{ std::distance( session, end ) };
+    beginInsertRows( {}, static_cast< int >( row ), static_cast< int >( row ) + static_cast< int >( count ) - 1 );
+
+    std::vector< Row > newRows;
+    newRows.reserve( static_cast< std::size_t >( count ) );
+    for ( ; session != end; ++session )
+    {
+      newRows.push_back( Row{ std::move( *session ), 0.0, now } );
+    }
+
+    rowsV.insert(
+      rowsV.begin() + static_cast< std::ptrdiff_t >( row ),
+      std::make_move_iterator( newRows.begin() ),
+      std::make_move_iterator( newRows.end() ) );
+    endInsertRows();
+
+    row += static_cast< std::size_t >( count );
+  }
+
+  if ( changedFirst )
+  {
+    rowsChanged( *changedFirst, changedLast );
+  }
+}
+
+void SessionTableModel::rowsChanged( const int first, const int last )
+{
+  emit dataChanged(
+    index( first, 0 ),
+    index( last, std::to_underlying( Columns::ColumnsCount ) - 1 ),
+    { Qt::ItemDataRole::DisplayRole } );
+}
+
+}
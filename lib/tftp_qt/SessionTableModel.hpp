@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class TftpQt::SessionTableModel.
+ **/
+
+#ifndef TFTP_QT_SESSIONTABLEMODEL_HPP
+#define TFTP_QT_SESSIONTABLEMODEL_HPP
+
+#include <tftp_qt/TftpQt.hpp>
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <QTimer>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace TftpQt {
+
+/**
+ * @brief Qt Table Model listing the active TFTP Transfers.
+ *
+ * Each row represents an active transfer (session).
+ * Columns expose session identifier, remote, filename, progress, transfer rate, and retransmissions.
+ *
+ * The application provides snapshots of the active sessions by sessions() as often as it likes.
+ * The model applies the latest snapshot at most once per refresh interval.
+ * Finished sessions are removed, new sessions are inserted, and changed rows are reported by one `dataChanged`
+ * signal per contiguous range, so views keep their selection and scroll position and are not reset.
+ **/
+class TFTP_QT_EXPORT SessionTableModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+  public:
+    //! Default Refresh Interval
+    static constexpr std::chrono::milliseconds DefaultRefreshInterval{ 500 };
+
+    //! Active Transfer
+    struct Session
+    {
+      //! Session Identifier (unique while active)
+      uint32_t id{ 0U };
+      //! Remote Endpoint
+      QString remote;
+      //! Filename
+      QString filename;
+      //! Transferred Bytes
+      uint64_t transferred{ 0U };
+      //! Transfer Size (if known)
+      std::optional< uint64_t > size;
+      //! Number of Retransmissions
+      unsigned int retries{ 0U };
+    };
+
+    //! Columns of Model
+    enum class Columns : int
+    {
+      //! Session Identifier
+      Session,
+      //! Remote Endpoint
+      Remote,
+      //! Filename
+      Filename,
+      //! Progress (transferred bytes and percentage, if the size is known)
+      Progress,
+      //! Transfer Rate
+      Rate,
+      //! Number of Retransmissions
+      Retries,
+
+      //! Column Count Indicator
+      ColumnsCount
+    };
+
+    /**
+     * @brief Constructs the Session Table Model.
+     *
+     * @param[in] parent
+     *   Parent QObject
+     **/
+    explicit SessionTableModel( QObject * parent = nullptr );
+
+    //! Destructor
+    ~SessionTableModel() override = default;
+
+    /**
+     * @brief Returns the number of rows.
+     *
+     * @param[in] parent
+     *   Parent Model Index.
+     *
+     * @return Number of active Sessions.
+     * @retval 0
+     *   If @p is valid.
+     **/
+    [[nodiscard]] int rowCount( const QModelIndex &parent ) const override;
+
+    /**
+     * @brief Returns the number of columns.
+     *
+     * @param[in] parent
+     *   Parent Model Index.
+     *
+     * @return Always @ref Columns::ColumnsCount.
+     * @retval 0
+     *   If @p is valid.
+     **/
+    [[nodiscard]] int columnCount( const QModelIndex &parent ) const override;
+
+    /**
+     * @brief Returns the requested data.
+     *
+     * @param[in] index
+     *   Index of the requested item.
+     * @param[in] role
+     *   Requested role.
+     *
+     * @return Data dependent of the index and role.
+     **/
+    [[nodiscard]] QVariant data( const QModelIndex &index, int role ) const override;
+
+    /**
+     * @brief Returns the data for the given role and section in the header with the specified orientation.
+     *
+     * @param[in] section
+     *   Section number
+     * @param[in] orientation
+     *   Orientation
+     * @param[in] role
+     *   Item role.
+     *
+     * @return Header data for the given parameters.
+     **/
+    [[nodiscard]] QVariant headerData( int section, Qt::Orientation orientation, int role ) const override;
+
+    /**
+     * @brief Updates the Refresh Interval.
+     *
+     * @param[in] interval
+     *   Minimum time between two model updates.
+     **/
+    void refreshInterval( std::chrono::milliseconds interval );
+
+    /**
+     * @brief Updates the active Sessions.
+     *
+     * The snapshot replaces a not yet applied one and is applied on the next refresh.
+     *
+     * @param[in] sessions
+     *   Active sessions.
+     **/
+    void sessions( std::vector< Session > sessions );
+
+  private:
+    //! Row of the Model
+    struct Row
+    {
+      //! Session
+      Session session;
+      //! Transfer Rate [bytes/s]
+      double rate{ 0.0 };
+      //! Time of the last Update
+      std::chrono::steady_clock::time_point updated;
+    };
+
+    /**
+     * @brief Applies the pending Snapshot.
+     **/
+    void refresh();
+
+    /**
+     * @brief Emits dataChanged for the Rows @p first to @p last.
+     *
+     * @param[in] first
+     *   First changed row.
+     * @param[in] last
+     *   Last changed row.
+     **/
+    void rowsChanged( int first, int last );
+
+    //! Rows (ordered by session identifier)
+    std::vector< Row > rowsV;
+    //! Pending Snapshot
+    std::optional< std::vector< Session > > pendingV;
+    //! Refresh Timer
+    QTimer refreshTimerV;
+};
+
+}
+
+#endif
@@ -26,6 +26,8 @@
 namespace TftpQt {
 
 class PacketStatisticModel;
+class SessionTableModel;
+class ThroughputModel;
 
 }
 
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Definition of Class TftpQt::ThroughputModel.
+ **/
+
+#include "ThroughputModel.hpp"
+
+#include <QLocale>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+namespace TftpQt {
+
+ThroughputModel::ThroughputModel( QObject * const parent ) :
+  QAbstractTableModel{ parent }
+{
+  sampleTimerV.setInterval( DefaultSampleInterval );
+  connect( &sampleTimerV, &QTimer::timeout, this, &ThroughputModel::sample );
+}
+
+int ThroughputModel::rowCount( const QModelIndex &parent ) const
+{
+  if ( parent.isValid() )
+  {
+    return 0;
+  }
+
+  return static_cast< int >( samplesV.size() );
+}
+
+int ThroughputModel::columnCount( const QModelIndex &parent ) const
+{
+  if ( parent.isValid() )
+  {
+    return 0;
+  }
+
+  return std::to_underlying( Columns::ColumnsCount );
+}
+
+QVariant ThroughputModel::data( const QModelIndex &index, const int role ) const
+{
+  if ( !index.isValid() )
+  {
+    return {};
+  }
+
+  if ( std::cmp_greater_equal( index.row(), samplesV.size() ) )
+  {
+    return {};
+  }
+
+  const auto &sample{ samplesV[ static_cast< std::size_t >( index.row() ) ] };
+  const auto column{ static_cast< Columns >( index.column() ) };
+
+  switch ( role )
+  {
+    case Qt::ItemDataRole::DisplayRole:
+      switch ( column )
+      {
+        case Columns::Time:
+          return QString::number( sample.time, 'f', 1 );
+
+        case Columns::ReceiveRate:
+        case Columns::TransmitRate:
+          return QLocale{}.formattedDataSize(
+            static_cast< qint64 >( sample.rates[ static_cast< std::size_t >( index.column() - 1 ) ] ) ) + tr( "/s" );
+
+        case Columns::ReceivePacketRate:
+        case Columns::TransmitPacketRate:
+          return QString::number( sample.rates[ static_cast< std::size_t >( index.column() - 1 ) ], 'f', 0 );
+
+        default:
+          return {};
+      }
+
+    case Qt::ItemDataRole::UserRole:
+      switch ( column )
+      {
+        case Columns::Time:
+          return sample.time;
+
+        case Columns::ReceiveRate:
+        case Columns::TransmitRate:
+        case Columns::ReceivePacketRate:
+        case Columns::TransmitPacketRate:
+          return sample.rates[ static_cast< std::size_t >( index.column() - 1 ) ];
+
+        default:
+          return {};
+      }
+
+    default:
+      return {};
+  }
+}
+
+QVariant ThroughputModel::headerData( int const section, Qt::Orientation const orientation, int const role ) const
+{
+  if ( role != Qt::DisplayRole )
+  {
+    return {};
+  }
+
+  if ( orientation == Qt::Vertical )
+  {
+    return section;
+  }
+
+  switch ( Columns{ section } )
+  {
+    case Columns::Time:
+      return tr( "Time [s]" );
+
+    case Columns::ReceiveRate:
+      return tr( "RX Rate" );
+
+    case Columns::TransmitRate:
+      return tr( "TX Rate" );
+
+    case Columns::ReceivePacketRate:
+      return tr( "RX Packets/s" );
+
+    case Columns::TransmitPacketRate:
+      return tr( "TX Packets/s" );
+
+    default:
+      return {};
+  }
+}
+
+void ThroughputModel::sampleInterval( const std::chrono::milliseconds interval )
+{
+  sampleTimerV.setInterval( interval );
+}
+
+void ThroughputModel::capacity( const std::size_t capacity )
+{
+  capacityV = std::max< std::size_t >( capacity, 1U );
+
+  if ( samplesV.size() > capacityV )
+  {
+    const auto remove{ samplesV.size() - capacityV };
+    beginRemoveRows( {}, 0, static_cast< int >( remove ) - 1 );
+    samplesV.erase( samplesV.begin(), samplesV.begin() + static_cast< std::ptrdiff_t >( remove ) );
+    endRemoveRows();
+  }
+}
+
+void ThroughputModel::statistic(
+  const Tftp::Packets::PacketStatistic::Value receive,
+  const Tftp::Packets::PacketStatistic::Value transmit )
+{
+  latestV = Totals{ std::chrono::steady_clock::now(), receive, transmit };
+
+  // the first totals are the reference of the first sample
+  if ( !previousV )
+  {
+    previousV = latestV;
+    startV = latestV->time;
+    sampleTimerV.start();
+  }
+}
+
+void ThroughputModel::sample()
+{
+  if ( !latestV || !previousV )
+  {
+    return;
+  }
+
+  const std::chrono::duration< double > elapsed{ latestV->time - previousV->time };
+
+  // no new totals since the last sample
+  if ( elapsed.count() <= 0.0 )
+  {
+    return;
+  }
+
+  const auto rate{ [ &elapsed ]( const std::size_t latest, const std::size_t previous )
+  {
+    return ( latest >= previous ) ? static_cast< double >( latest - previous ) / elapsed.count() : 0.0;
+  } };
+
+  const Sample newSample{
+    std::chrono::duration< double >{ latestV->time - startV }.count(),
+    {
+      rate( std::get< 1 >( latestV->receive ), std::get< 1 >( previousV->receive ) ),
+      rate( std::get< 1 >( latestV->transmit ), std::get< 1 >( previousV->transmit ) ),
+      rate( std::get< 0 >( latestV->receive ), std::get< 0 >( previousV->receive ) ),
+      rate( std::get< 0 >( latestV->transmit ), std::get< 0 >( previousV->transmit ) ) } };
+
+  previousV = latestV;
+
+  if ( samplesV.size() == capacityV )
+  {
+    beginRemoveRows( {}, 0, 0 );
+    samplesV.pop_front();
+    endRemoveRows();
+  }
+
+  const auto row{ static_cast< int >( samplesV.size() ) };
+  beginInsertRows( {}, row, row );
+  samplesV.push_back( newSample );
+  endInsertRows();
+}
+
+}
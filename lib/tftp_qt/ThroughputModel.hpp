@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: MPL-2.0
+/**
+ * @file
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @author Thomas Vogt, thomas@thomas-vogt.de
+ *
+ * @brief Declaration of Class TftpQt::ThroughputModel.
+ **/
+
+#ifndef TFTP_QT_THROUGHPUTMODEL_HPP
+#define TFTP_QT_THROUGHPUTMODEL_HPP
+
+#include <tftp_qt/TftpQt.hpp>
+
+#include <tftp/packets/PacketStatistic.hpp>
+
+#include <QAbstractTableModel>
+#include <QTimer>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <optional>
+
+namespace TftpQt {
+
+/**
+ * @brief Qt Table Model of the TFTP Throughput over Time.
+ *
+ * Each row represents a sample interval (oldest first), suitable as data source of charts.
+ * Columns expose the time and the receive and transmit rates in bytes and packets per second.
+ *
+ * The application provides the cumulative packet totals by statistic() as often as it likes.
+ * Once per sample interval, the model appends a row with the rates since the previous sample.
+ * When the capacity is reached, the oldest row is removed.
+ * The model is never reset.
+ **/
+class TFTP_QT_EXPORT ThroughputModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+  public:
+    //! Default Sample Interval
+    static constexpr std::chrono::milliseconds DefaultSampleInterval{ 1000 };
+    //! Default Number of Samples
+    static constexpr std::size_t DefaultCapacity{ 300U };
+
+    //! Columns of Model
+    enum class Columns : int
+    {
+      //! Time since the first Sample [s]
+      Time,
+      //! Receive Rate [bytes/s]
+      ReceiveRate,
+      //! Transmit Rate [bytes/s]
+      TransmitRate,
+      //! Receive Packet Rate [packets/s]
+      ReceivePacketRate,
+      //! Transmit Packet Rate [packets/s]
+      TransmitPacketRate,
+
+      //! Column Count Indicator
+      ColumnsCount
+    };
+
+    /**
+     * @brief Constructs the Throughput Model.
+     *
+     * @param[in] parent
+     *   Parent QObject
+     **/
+    explicit ThroughputModel( QObject * parent = nullptr );
+
+    //! Destructor
+    ~ThroughputModel() override = default;
+
+    /**
+     * @brief Returns the number of rows.
+     *
+     * @param[in] parent
+     *   Parent Model Index.
+     *
+     * @return Number of Samples.
+     * @retval 0
+     *   If @p is valid.
+     **/
+    [[nodiscard]] int rowCount( const QModelIndex &parent ) const override;
+
+    /**
+     * @brief Returns the number of columns.
+     *
+     * @param[in] parent
+     *   Parent Model Index.
+     *
+     * @return Always @ref Columns::ColumnsCount.
+     * @retval 0
+     *   If @p is valid.
+     **/
+    [[nodiscard]] int columnCount( const QModelIndex &parent ) const override;
+
+    /**
+     * @brief Returns the requested data.
+     *
+     * The display role returns formatted values, Qt::UserRole the plain numbers (e.g. for charts).
+     *
+     * @param[in] index
+     *   Index of the requested item.
+     * @param[in] role
+     *   Requested role.
+     *
+     * @return Data dependent of the index and role.
+     **/
+    [[nodiscard]] QVariant data( const QModelIndex &index, int role ) const override;
+
+    /**
+     * @brief Returns the data for the given role and section in the header with the specified orientation.
+     *
+     * @param[in] section
+     *   Section number
+     * @param[in] orientation
+     *   Orientation
+     * @param[in] role
+     *   Item role.
+     *
+     * @return Header data for the given parameters.
+     **/
+    [[nodiscard]] QVariant headerData( int section, Qt::Orientation orientation, int role ) const override;
+
+    /**
+     * @brief Updates the Sample Interval.
+     *
+     * @param[in] interval
+     *   Time between two samples.
+     **/
+    void sampleInterval( std::chrono::milliseconds interval );
+
+    /**
+     * @brief Updates the Capacity.
+     *
+     * @param[in] capacity
+     *   Maximum number of samples (at least 1).
+     **/
+    void capacity( std::size_t capacity );
+
+    /**
+     * @brief Update the cumulative Packet Totals.
+     *
+     * The first call starts the sampling.
+     *
+     * @param[in] receive
+     *   Total received packets (see Tftp::Packets::PacketStatistic::total()).
+     * @param[in] transmit
+     *   Total transmitted packets.
+     **/
+    void statistic( Tftp::Packets::PacketStatistic::Value receive, Tftp::Packets::PacketStatistic::Value transmit );
+
+  private:
+    //! Sample
+    struct Sample
+    {
+      //! Time since the first Sample [s]
+      double time;
+      //! Rates (ordered like Columns)
+      std::array< double, 4U > rates;
+    };
+
+    //! Cumulative Totals
+    struct Totals
+    {
+      //! Time
+      std::chrono::steady_clock::time_point time;
+      //! Received Packets
+      Tftp::Packets::PacketStatistic::Value receive;
+      //! Transmitted Packets
+      Tftp::Packets::PacketStatistic::Value transmit;
+    };
+
+    /**
+     * @brief Appends a Sample.
+     **/
+    void sample();
+
+    //! Samples (oldest first)
+    std::deque< Sample > samplesV;
+    //! Maximum Number of Samples
+    std::size_t capacityV{ DefaultCapacity };
+    //! Latest Totals
+    std::optional< Totals > latestV;
+    //! Totals of the previous Sample
+    std::optional< Totals > previousV;
+    //! Time of the first Sample
+    std::chrono::steady_clock::time_point startV;
+    //! Sample Timer
+    QTimer sampleTimerV;
+};
+
+}
+
+#endif